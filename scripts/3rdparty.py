@@ -223,6 +223,7 @@ def execute_cmake(srcdir, variant, toolchain, env, log, args=None):
         if not 'android' in toolchain:
             args += [
                 '-DCMAKE_C_COMPILER=%s' % quote(compiler),
+                '-DCMAKE_CXX_COMPILER=%s' % quote(getvar(env, 'CXX', toolchain, 'g++')),
             ]
         args += [
             '-DCMAKE_LINKER=%s' % quote(getvar(env, 'CCLD', toolchain, 'gcc')),
@@ -242,11 +243,13 @@ def execute_cmake(srcdir, variant, toolchain, env, log, args=None):
         args += [
             '-DCMAKE_BUILD_TYPE=Debug',
             '-DCMAKE_C_FLAGS_DEBUG:STRING=%s' % quote(' '.join(cc_flags)),
+            '-DCMAKE_CXX_FLAGS_DEBUG:STRING=%s' % quote(' '.join(cc_flags)),
         ]
     else:
         args += [
             '-DCMAKE_BUILD_TYPE=Release',
             '-DCMAKE_C_FLAGS_RELEASE:STRING=%s' % quote(' '.join(cc_flags)),
+            '-DCMAKE_CXX_FLAGS_RELEASE:STRING=%s' % quote(' '.join(cc_flags)),
         ]
 
     args += [
@@ -836,6 +839,25 @@ elif name == 'cpputest':
     execute_make(logfile)
     install_tree('include', os.path.join(builddir, 'include'))
     install_files('lib/libCppUTest.a', os.path.join(builddir, 'lib'))
+elif name == 'google-benchmark':
+    download(
+        'https://github.com/google/benchmark/archive/v%s.tar.gz' % ver,
+        'benchmark_v%s.tar.gz' % ver,
+        logfile,
+        vendordir)
+    extract('benchmark_v%s.tar.gz' % ver,
+            'benchmark-%s' % ver)
+    os.chdir('src/benchmark-%s' % ver)
+    mkpath('build')
+    os.chdir('build')
+    execute_cmake('..', variant, toolchain, env, logfile, args=[
+        '-DBENCHMARK_ENABLE_GTEST_TESTS=OFF',
+        '-DBENCHMARK_ENABLE_TESTING=OFF',
+        ])
+    execute_make(logfile)
+    os.chdir('..')
+    install_tree('include', os.path.join(builddir, 'include'))
+    install_files('build/src/libbenchmark.a', os.path.join(builddir, 'lib'))
 else:
     print("error: unknown 3rdparty '%s'" % fullname, file=sys.stderr)
     exit(1)
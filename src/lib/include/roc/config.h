@@ -50,7 +50,20 @@ typedef enum roc_protocol {
     ROC_PROTO_RTP_LDPC_SOURCE = 4,
 
     /** FEC repair packet + FECFRAME LDPC-Staircase header (RFC 6816). */
-    ROC_PROTO_LDPC_REPAIR = 5
+    ROC_PROTO_LDPC_REPAIR = 5,
+
+    /** RTP source packet (RFC 3550) + FECFRAME sliding window RLC footer (RFC 8681).
+     */
+    ROC_PROTO_RTP_RLC_SOURCE = 6,
+
+    /** FEC repair packet + FECFRAME sliding window RLC header (RFC 8681). */
+    ROC_PROTO_RLC_REPAIR = 7,
+
+    /** RTP source packet (RFC 3550) + FECFRAME XOR parity footer. */
+    ROC_PROTO_RTP_PARITY_SOURCE = 8,
+
+    /** FEC repair packet + FECFRAME XOR parity header. */
+    ROC_PROTO_PARITY_REPAIR = 9
 } roc_protocol;
 
 /** Forward Error Correction code. */
@@ -77,7 +90,27 @@ typedef enum roc_fec_code {
      * Compatible with @c ROC_PROTO_RTP_LDPC_SOURCE and @c ROC_PROTO_LDPC_REPAIR
      * protocols for source and repair ports.
      */
-    ROC_FEC_LDPC_STAIRCASE = 2
+    ROC_FEC_LDPC_STAIRCASE = 2,
+
+    /** Sliding window Random Linear Codes over GF(2^8) (RFC 8681).
+     * Good for low latency. Repair packets protect a sliding window of recent
+     * source packets instead of a block, so a lost packet can be restored as
+     * soon as the next repair packet arrives.
+     * Compatible with @c ROC_PROTO_RTP_RLC_SOURCE and @c ROC_PROTO_RLC_REPAIR
+     * protocols for source and repair ports.
+     */
+    ROC_FEC_RLC = 3,
+
+    /** XOR row and column parity FEC code.
+     * Good for senders with limited CPU. Repairs a single lost packet per row,
+     * and optionally per column, of a block. Rows and columns are derived from
+     * the block size: if the block has L x D source packets and L + D repair
+     * packets, there are D rows and L columns, otherwise every repair packet
+     * protects a row of consecutive source packets.
+     * Compatible with @c ROC_PROTO_RTP_PARITY_SOURCE and @c ROC_PROTO_PARITY_REPAIR
+     * protocols for source and repair ports.
+     */
+    ROC_FEC_PARITY = 4
 } roc_fec_code;
 
 /** Packet encoding. */
@@ -87,7 +120,41 @@ typedef enum roc_packet_encoding {
      * Uncompressed samples coded as interleaved 16-bit signed big-endian
      * integers in two's complement notation.
      */
-    ROC_PACKET_ENCODING_AVP_L16 = 2
+    ROC_PACKET_ENCODING_AVP_L16 = 2,
+
+    /** PCM signed 24-bit.
+     * "L24" encoding from RTP A/V Profile (RFC 3190).
+     * Uncompressed samples coded as interleaved 24-bit signed big-endian
+     * integers in two's complement notation.
+     */
+    ROC_PACKET_ENCODING_AVP_L24 = 3,
+
+    /** PCM floats.
+     * Uncompressed samples coded as interleaved 32-bit big-endian IEEE 754
+     * floats. Samples are transferred without quantization and clamping.
+     * This encoding is not registered in RTP A/V Profile and is supported
+     * only if both sender and receiver use this library.
+     */
+    ROC_PACKET_ENCODING_PCM_FLOAT = 4,
+
+    /** IMA ADPCM.
+     * Lossy compression with 4 bits per sample, four times smaller than L16.
+     * Every packet carries the decoder state, so lost packets don't affect
+     * decoding of other packets.
+     * This encoding is supported only if both sender and receiver use this
+     * library.
+     */
+    ROC_PACKET_ENCODING_IMA_ADPCM = 5,
+
+    /** Lossless compression.
+     * Samples are quantized to 16 bits, like in "L16" encoding, and then
+     * compressed without further losses using linear prediction and Rice
+     * coding. Packet size depends on the signal. Every packet can be decoded
+     * independently.
+     * This encoding is supported only if both sender and receiver use this
+     * library.
+     */
+    ROC_PACKET_ENCODING_LOSSLESS = 6
 } roc_packet_encoding;
 
 /** Frame encoding. */
@@ -124,7 +191,19 @@ typedef enum roc_resampler_profile {
     ROC_RESAMPLER_MEDIUM = 2,
 
     /** Low quality, high speed. */
-    ROC_RESAMPLER_LOW = 3
+    ROC_RESAMPLER_LOW = 3,
+
+    /** Cubic interpolation, lower quality, very high speed.
+     * Has no anti-aliasing filter and is suitable mainly for compensating
+     * small clock drift, when sender and receiver use the same sample rate.
+     */
+    ROC_RESAMPLER_CUBIC = 4,
+
+    /** Linear interpolation, lowest quality, highest speed.
+     * Has no anti-aliasing filter and is suitable mainly for compensating
+     * small clock drift, when sender and receiver use the same sample rate.
+     */
+    ROC_RESAMPLER_LINEAR = 5
 } roc_resampler_profile;
 
 /** Context configuration.
@@ -144,6 +223,15 @@ typedef struct roc_context_config {
      * If zero, default value is used.
      */
     unsigned int max_frame_size;
+
+    /** Number of worker threads used by every receiver to render sessions.
+     * If non-zero, frames of sessions connected to a receiver are rendered
+     * in parallel by this number of threads and the thread that reads frames
+     * from the receiver, and then mixed. The output doesn't depend on the
+     * number of threads.
+     * If zero, all sessions are rendered in the thread that reads frames.
+     */
+    unsigned int receiver_workers;
 } roc_context_config;
 
 /** Sender configuration.
@@ -170,6 +258,8 @@ typedef struct roc_sender_config {
 
     /** The rate of the samples in the packets generated by sender.
      * Number of samples per channel per second.
+     * Supported values are 44100, 48000, and 96000. If it's equal to
+     * @c frame_sample_rate, sender doesn't need resampling.
      * If zero, default value is used.
      */
     unsigned int packet_sample_rate;
@@ -229,6 +319,11 @@ typedef struct roc_sender_config {
      * Used if some FEC code is selected.
      * Larger number increases robustness but also increases traffic.
      * If zero, default value is used.
+     *
+     * For @c ROC_FEC_RLC, there are no blocks. Instead, the number of source
+     * packets defines the encoding window length, and repair packets are
+     * spread evenly over the window, keeping the same ratio of source and
+     * repair packets.
      */
     unsigned int fec_block_repair_packets;
 } roc_sender_config;
@@ -14,6 +14,60 @@
 
 using namespace roc;
 
+namespace {
+
+size_t gcd(size_t a, size_t b) {
+    while (b != 0) {
+        const size_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+bool make_payload_type(rtp::PayloadType& out,
+                       roc_packet_encoding encoding,
+                       unsigned int sample_rate) {
+    rtp::PayloadEncoding payload_encoding;
+
+    switch ((int)encoding) {
+    case 0:
+    case ROC_PACKET_ENCODING_AVP_L16:
+        payload_encoding = rtp::PayloadEncoding_L16;
+        break;
+    case ROC_PACKET_ENCODING_AVP_L24:
+        payload_encoding = rtp::PayloadEncoding_L24;
+        break;
+    case ROC_PACKET_ENCODING_PCM_FLOAT:
+        payload_encoding = rtp::PayloadEncoding_Float32;
+        break;
+    case ROC_PACKET_ENCODING_IMA_ADPCM:
+        payload_encoding = rtp::PayloadEncoding_ADPCM;
+        break;
+    case ROC_PACKET_ENCODING_LOSSLESS:
+        payload_encoding = rtp::PayloadEncoding_Lossless;
+        break;
+    default:
+        roc_log(LogError, "roc_config: invalid packet_encoding");
+        return false;
+    }
+
+    rtp::FormatMap format_map;
+
+    const rtp::Format* format = format_map.find(payload_encoding, sample_rate, 0x3);
+    if (!format) {
+        roc_log(LogError,
+                "roc_config: invalid packet_sample_rate,"
+                " only 44100, 48000, and 96000 are currently supported");
+        return false;
+    }
+
+    out = format->payload_type;
+    return true;
+}
+
+} // namespace
+
 bool make_context_config(roc_context_config& out, const roc_context_config& in) {
     if (in.max_packet_size != 0) {
         out.max_packet_size = in.max_packet_size;
@@ -27,6 +81,8 @@ bool make_context_config(roc_context_config& out, const roc_context_config& in)
         out.max_frame_size = 4096;
     }
 
+    out.receiver_workers = in.receiver_workers;
+
     return true;
 }
 
@@ -48,20 +104,15 @@ bool make_sender_config(pipeline::SenderConfig& out, const roc_sender_config& in
         return false;
     }
 
-    if (in.packet_sample_rate != 0 && in.packet_sample_rate != 44100) {
-        roc_log(
-            LogError,
-            "roc_config: invalid packet_sample_rate, only 44100 is currently supported");
-        return false;
-    }
-
     if (in.packet_channels != 0 && in.packet_channels != ROC_CHANNEL_SET_STEREO) {
         roc_log(LogError, "roc_config: invalid packet_channels");
         return false;
     }
 
-    if (in.packet_encoding != 0 && in.packet_encoding != ROC_PACKET_ENCODING_AVP_L16) {
-        roc_log(LogError, "roc_config: invalid packet_encoding");
+    const unsigned int packet_sample_rate =
+        in.packet_sample_rate != 0 ? in.packet_sample_rate : 44100;
+
+    if (!make_payload_type(out.payload_type, in.packet_encoding, packet_sample_rate)) {
         return false;
     }
 
@@ -87,6 +138,12 @@ bool make_sender_config(pipeline::SenderConfig& out, const roc_sender_config& in
     case ROC_RESAMPLER_HIGH:
         out.resampler = audio::resampler_profile(audio::ResamplerProfile_High);
         break;
+    case ROC_RESAMPLER_CUBIC:
+        out.resampler = audio::resampler_profile(audio::ResamplerProfile_Cubic);
+        break;
+    case ROC_RESAMPLER_LINEAR:
+        out.resampler = audio::resampler_profile(audio::ResamplerProfile_Linear);
+        break;
     default:
         roc_log(LogError, "roc_config: invalid resampler_profile");
         return false;
@@ -103,6 +160,12 @@ bool make_sender_config(pipeline::SenderConfig& out, const roc_sender_config& in
     case ROC_FEC_LDPC_STAIRCASE:
         out.fec_encoder.scheme = packet::FEC_LDPC_Staircase;
         break;
+    case ROC_FEC_RLC:
+        out.fec_encoder.scheme = packet::FEC_RLC;
+        break;
+    case ROC_FEC_PARITY:
+        out.fec_encoder.scheme = packet::FEC_Parity;
+        break;
     default:
         roc_log(LogError, "roc_config: invalid fec_scheme");
         return false;
@@ -111,6 +174,13 @@ bool make_sender_config(pipeline::SenderConfig& out, const roc_sender_config& in
     if (in.fec_block_source_packets != 0 || in.fec_block_repair_packets != 0) {
         out.fec_writer.n_source_packets = in.fec_block_source_packets;
         out.fec_writer.n_repair_packets = in.fec_block_repair_packets;
+
+        const size_t ratio =
+            gcd(in.fec_block_source_packets, in.fec_block_repair_packets);
+
+        out.rlc_writer.window_length = in.fec_block_source_packets;
+        out.rlc_writer.n_source_packets = in.fec_block_source_packets / ratio;
+        out.rlc_writer.n_repair_packets = in.fec_block_repair_packets / ratio;
     }
 
     return true;
@@ -154,6 +224,14 @@ bool make_receiver_config(pipeline::ReceiverConfig& out, const roc_receiver_conf
         out.default_session.resampler =
             audio::resampler_profile(audio::ResamplerProfile_High);
         break;
+    case ROC_RESAMPLER_CUBIC:
+        out.default_session.resampler =
+            audio::resampler_profile(audio::ResamplerProfile_Cubic);
+        break;
+    case ROC_RESAMPLER_LINEAR:
+        out.default_session.resampler =
+            audio::resampler_profile(audio::ResamplerProfile_Linear);
+        break;
     default:
         roc_log(LogError, "roc_config: invalid resampler_profile");
         return false;
@@ -229,6 +307,12 @@ bool make_port_config(pipeline::PortConfig& out,
         case ROC_PROTO_RTP_LDPC_SOURCE:
             out.protocol = pipeline::Proto_RTP_LDPC_Source;
             break;
+        case ROC_PROTO_RTP_RLC_SOURCE:
+            out.protocol = pipeline::Proto_RTP_RLC_Source;
+            break;
+        case ROC_PROTO_RTP_PARITY_SOURCE:
+            out.protocol = pipeline::Proto_RTP_Parity_Source;
+            break;
         default:
             roc_log(LogError, "roc_config: invalid protocol for audio source port");
             return false;
@@ -243,6 +327,12 @@ bool make_port_config(pipeline::PortConfig& out,
         case ROC_PROTO_LDPC_REPAIR:
             out.protocol = pipeline::Proto_LDPC_Repair;
             break;
+        case ROC_PROTO_RLC_REPAIR:
+            out.protocol = pipeline::Proto_RLC_Repair;
+            break;
+        case ROC_PROTO_PARITY_REPAIR:
+            out.protocol = pipeline::Proto_Parity_Repair;
+            break;
         default:
             roc_log(LogError, "roc_config: invalid protocol for audio repair port");
             return false;
@@ -17,6 +17,7 @@ roc_context::roc_context(const roc_context_config& cfg)
     , byte_buffer_pool(allocator, cfg.max_packet_size, false)
     , sample_buffer_pool(allocator, cfg.max_frame_size / sizeof(audio::sample_t), false)
     , trx(packet_pool, byte_buffer_pool, allocator)
+    , receiver_workers(cfg.receiver_workers)
     , counter(0) {
 }
 
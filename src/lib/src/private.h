@@ -53,6 +53,8 @@ struct roc_context {
 
     roc::netio::Transceiver trx;
 
+    size_t receiver_workers;
+
     roc::core::Atomic counter;
 };
 
@@ -55,6 +55,8 @@ roc_receiver* roc_receiver_open(roc_context* context, const roc_receiver_config*
         return NULL;
     }
 
+    private_config.common.num_workers = context->receiver_workers;
+
     core::UniquePtr<roc_receiver> receiver(new (context->allocator)
                                                roc_receiver(*context, private_config),
                                            context->allocator);
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/adpcm_decoder.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+ADPCMDecoder::ADPCMDecoder(packet::channel_mask_t channels)
+    : channels_(channels)
+    , num_channels_(packet::num_channels(channels))
+    , stream_pos_(0)
+    , stream_avail_(0)
+    , frame_data_(NULL)
+    , frame_pos_(0) {
+    if (num_channels_ == 0 || num_channels_ > MaxChannels) {
+        roc_panic("adpcm decoder: unsupported number of channels: %lu",
+                  (unsigned long)num_channels_);
+    }
+}
+
+packet::timestamp_t ADPCMDecoder::position() const {
+    return stream_pos_;
+}
+
+packet::timestamp_t ADPCMDecoder::available() const {
+    return stream_avail_;
+}
+
+void ADPCMDecoder::begin(packet::timestamp_t frame_position,
+                         const void* frame_data,
+                         size_t frame_size) {
+    roc_panic_if_not(frame_data);
+
+    if (frame_data_) {
+        roc_panic("adpcm decoder: unpaired begin/end");
+    }
+
+    frame_data_ = (const uint8_t*)frame_data;
+
+    stream_pos_ = frame_position;
+    stream_avail_ = 0;
+
+    const size_t header_size = num_channels_ * IMAADPCM_HeaderSize;
+    if (frame_size < header_size) {
+        return;
+    }
+
+    for (size_t ch = 0; ch < num_channels_; ch++) {
+        const uint8_t* header = frame_data_ + ch * IMAADPCM_HeaderSize;
+
+        state_[ch].predictor = (int16_t)(((uint16_t)header[0] << 8) | header[1]);
+        state_[ch].step_index =
+            std::min((int32_t)header[2], (int32_t)IMAADPCM_MaxStepIndex);
+    }
+
+    size_t n_codes = (frame_size - header_size) * 2;
+    if (n_codes != 0 && (frame_data_[3] & IMAADPCM_FlagOddPadding)) {
+        n_codes--;
+    }
+
+    stream_avail_ = (packet::timestamp_t)(n_codes / num_channels_);
+}
+
+size_t ADPCMDecoder::read(audio::sample_t* samples,
+                          size_t n_samples,
+                          packet::channel_mask_t channels) {
+    if (!frame_data_) {
+        roc_panic("adpcm decoder: read should be called only between begin/end");
+    }
+
+    n_samples = limit_(n_samples);
+
+    size_t code_index = frame_pos_ * num_channels_;
+
+    if (channels == channels_) {
+        // fast path: channels are the same, no remapping needed
+        for (size_t ns = 0; ns < n_samples; ns++) {
+            for (size_t ch = 0; ch < num_channels_; ch++) {
+                *samples++ =
+                    sample_t(ima_adpcm_decode(state_[ch], get_code_(code_index++)))
+                    / 32768.0f;
+            }
+        }
+
+        advance_(n_samples);
+        return n_samples;
+    }
+
+    const packet::channel_mask_t inout_channels = channels | channels_;
+
+    for (size_t ns = 0; ns < n_samples; ns++) {
+        size_t in_ch = 0;
+
+        for (packet::channel_mask_t ch = 1; ch <= inout_channels && ch != 0; ch <<= 1) {
+            sample_t s = 0;
+            if (channels_ & ch) {
+                s = sample_t(ima_adpcm_decode(state_[in_ch++], get_code_(code_index++)))
+                    / 32768.0f;
+            }
+            if (channels & ch) {
+                *samples++ = s;
+            }
+        }
+    }
+
+    advance_(n_samples);
+
+    return n_samples;
+}
+
+size_t ADPCMDecoder::shift(size_t n_samples) {
+    if (!frame_data_) {
+        roc_panic("adpcm decoder: shift should be called only between begin/end");
+    }
+
+    n_samples = limit_(n_samples);
+
+    // decoder state depends on all previous codes, so shifted samples
+    // are decoded as well
+    size_t code_index = frame_pos_ * num_channels_;
+
+    for (size_t ns = 0; ns < n_samples; ns++) {
+        for (size_t ch = 0; ch < num_channels_; ch++) {
+            (void)ima_adpcm_decode(state_[ch], get_code_(code_index++));
+        }
+    }
+
+    advance_(n_samples);
+
+    return n_samples;
+}
+
+void ADPCMDecoder::end() {
+    if (!frame_data_) {
+        roc_panic("adpcm decoder: unpaired begin/end");
+    }
+
+    stream_avail_ = 0;
+
+    frame_data_ = NULL;
+    frame_pos_ = 0;
+}
+
+size_t ADPCMDecoder::limit_(size_t n_samples) const {
+    if (n_samples > (size_t)stream_avail_) {
+        n_samples = (size_t)stream_avail_;
+    }
+    return n_samples;
+}
+
+void ADPCMDecoder::advance_(size_t n_samples) {
+    stream_pos_ += (packet::timestamp_t)n_samples;
+    stream_avail_ -= (packet::timestamp_t)n_samples;
+
+    frame_pos_ += n_samples;
+}
+
+uint8_t ADPCMDecoder::get_code_(size_t code_index) const {
+    const uint8_t byte =
+        frame_data_[num_channels_ * IMAADPCM_HeaderSize + code_index / 2];
+
+    return code_index % 2 == 0 ? uint8_t(byte >> 4) : uint8_t(byte & 0xf);
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/adpcm_decoder.h
+//! @brief IMA ADPCM decoder.
+
+#ifndef ROC_AUDIO_ADPCM_DECODER_H_
+#define ROC_AUDIO_ADPCM_DECODER_H_
+
+#include "roc_audio/iframe_decoder.h"
+#include "roc_audio/ima_adpcm.h"
+#include "roc_core/noncopyable.h"
+#include "roc_packet/units.h"
+
+namespace roc {
+namespace audio {
+
+//! IMA ADPCM decoder.
+//! @remarks
+//!  Decoder state is restored from the frame header on every begin(), so
+//!  frames don't depend on each other.
+class ADPCMDecoder : public IFrameDecoder, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    explicit ADPCMDecoder(packet::channel_mask_t channels);
+
+    //! Get current stream position.
+    virtual packet::timestamp_t position() const;
+
+    //! Get number of samples available for decoding.
+    virtual packet::timestamp_t available() const;
+
+    //! Start decoding a new frame.
+    virtual void
+    begin(packet::timestamp_t frame_position, const void* frame_data, size_t frame_size);
+
+    //! Read samples from current frame.
+    virtual size_t
+    read(sample_t* samples, size_t n_samples, packet::channel_mask_t channels);
+
+    //! Shift samples from current frame.
+    virtual size_t shift(size_t n_samples);
+
+    //! Finish decoding current frame.
+    virtual void end();
+
+    //! Maximum number of channels.
+    enum { MaxChannels = 8 };
+
+private:
+    size_t limit_(size_t n_samples) const;
+    void advance_(size_t n_samples);
+
+    uint8_t get_code_(size_t code_index) const;
+
+    const packet::channel_mask_t channels_;
+    const size_t num_channels_;
+
+    IMAADPCMState state_[MaxChannels];
+
+    packet::timestamp_t stream_pos_;
+    packet::timestamp_t stream_avail_;
+
+    const uint8_t* frame_data_;
+    size_t frame_pos_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_ADPCM_DECODER_H_
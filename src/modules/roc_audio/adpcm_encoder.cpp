@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/adpcm_encoder.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+ADPCMEncoder::ADPCMEncoder(packet::channel_mask_t channels)
+    : channels_(channels)
+    , num_channels_(packet::num_channels(channels))
+    , primed_(false)
+    , frame_data_(NULL)
+    , frame_size_(0)
+    , frame_pos_(0) {
+    if (num_channels_ == 0 || num_channels_ > MaxChannels) {
+        roc_panic("adpcm encoder: unsupported number of channels: %lu",
+                  (unsigned long)num_channels_);
+    }
+}
+
+size_t ADPCMEncoder::encoded_size(size_t num_samples) const {
+    return ima_adpcm_payload_size(num_samples, num_channels_);
+}
+
+void ADPCMEncoder::begin(void* frame_data, size_t frame_size) {
+    roc_panic_if_not(frame_data);
+
+    if (frame_data_) {
+        roc_panic("adpcm encoder: unpaired begin/end");
+    }
+
+    frame_data_ = (uint8_t*)frame_data;
+    frame_size_ = frame_size;
+
+    if (frame_size_ < num_channels_ * IMAADPCM_HeaderSize) {
+        frame_size_ = 0;
+    }
+}
+
+size_t ADPCMEncoder::write(const audio::sample_t* samples,
+                           size_t n_samples,
+                           packet::channel_mask_t channels) {
+    if (!frame_data_) {
+        roc_panic("adpcm encoder: write should be called only between begin/end");
+    }
+
+    const size_t max_samples = ima_adpcm_num_samples(frame_size_, num_channels_);
+
+    if (n_samples > max_samples - frame_pos_) {
+        n_samples = max_samples - frame_pos_;
+    }
+
+    if (n_samples == 0) {
+        return 0;
+    }
+
+    if (frame_pos_ == 0) {
+        if (!primed_) {
+            prime_(samples, channels);
+        }
+        put_headers_();
+    }
+
+    size_t code_index = frame_pos_ * num_channels_;
+
+    if (channels == channels_) {
+        // fast path: channels are the same, no remapping needed
+        for (size_t ns = 0; ns < n_samples; ns++) {
+            for (size_t ch = 0; ch < num_channels_; ch++) {
+                put_code_(code_index++,
+                          ima_adpcm_encode(state_[ch], ima_adpcm_quantize(*samples++)));
+            }
+        }
+
+        frame_pos_ += n_samples;
+        return n_samples;
+    }
+
+    const packet::channel_mask_t inout_channels = channels | channels_;
+
+    for (size_t ns = 0; ns < n_samples; ns++) {
+        size_t out_ch = 0;
+
+        for (packet::channel_mask_t ch = 1; ch <= inout_channels && ch != 0; ch <<= 1) {
+            sample_t s = 0;
+            if (channels & ch) {
+                s = *samples++;
+            }
+            if (channels_ & ch) {
+                put_code_(code_index++,
+                          ima_adpcm_encode(state_[out_ch++], ima_adpcm_quantize(s)));
+            }
+        }
+    }
+
+    frame_pos_ += n_samples;
+
+    return n_samples;
+}
+
+size_t ADPCMEncoder::end() {
+    if (!frame_data_) {
+        roc_panic("adpcm encoder: unpaired begin/end");
+    }
+
+    size_t size = 0;
+
+    if (frame_size_ != 0) {
+        size = ima_adpcm_payload_size(frame_pos_, num_channels_);
+
+        if (frame_pos_ == 0) {
+            put_headers_();
+        } else if ((frame_pos_ * num_channels_) % 2 != 0) {
+            frame_data_[3] |= IMAADPCM_FlagOddPadding;
+        }
+    }
+
+    frame_data_ = NULL;
+    frame_size_ = 0;
+    frame_pos_ = 0;
+
+    return size;
+}
+
+void ADPCMEncoder::prime_(const sample_t* samples, packet::channel_mask_t channels) {
+    // start from the first sample instead of zero, so that the beginning of
+    // the stream doesn't need to wait until the step size grows
+    const packet::channel_mask_t inout_channels = channels | channels_;
+
+    size_t out_ch = 0;
+
+    for (packet::channel_mask_t ch = 1; ch <= inout_channels && ch != 0; ch <<= 1) {
+        sample_t s = 0;
+        if (channels & ch) {
+            s = *samples++;
+        }
+        if (channels_ & ch) {
+            state_[out_ch++].predictor = ima_adpcm_quantize(s);
+        }
+    }
+
+    primed_ = true;
+}
+
+void ADPCMEncoder::put_headers_() {
+    for (size_t ch = 0; ch < num_channels_; ch++) {
+        uint8_t* header = frame_data_ + ch * IMAADPCM_HeaderSize;
+
+        const uint16_t predictor = (uint16_t)(int16_t)state_[ch].predictor;
+
+        header[0] = uint8_t(predictor >> 8);
+        header[1] = uint8_t(predictor);
+        header[2] = uint8_t(state_[ch].step_index);
+        header[3] = 0;
+    }
+}
+
+void ADPCMEncoder::put_code_(size_t code_index, uint8_t code) {
+    uint8_t& byte = frame_data_[num_channels_ * IMAADPCM_HeaderSize + code_index / 2];
+
+    if (code_index % 2 == 0) {
+        byte = uint8_t(code << 4);
+    } else {
+        byte |= code;
+    }
+}
+
+} // namespace audio
+} // namespace roc
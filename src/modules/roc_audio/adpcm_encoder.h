@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/adpcm_encoder.h
+//! @brief IMA ADPCM encoder.
+
+#ifndef ROC_AUDIO_ADPCM_ENCODER_H_
+#define ROC_AUDIO_ADPCM_ENCODER_H_
+
+#include "roc_audio/iframe_encoder.h"
+#include "roc_audio/ima_adpcm.h"
+#include "roc_core/noncopyable.h"
+#include "roc_packet/units.h"
+
+namespace roc {
+namespace audio {
+
+//! IMA ADPCM encoder.
+//! @remarks
+//!  Encodes 16-bit samples into 4-bit codes. Encoder state is carried
+//!  between frames, so the signal is coded without discontinuities, but
+//!  every frame header contains the state at the beginning of the frame,
+//!  so frames can be decoded independently and in any order.
+class ADPCMEncoder : public IFrameEncoder, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    explicit ADPCMEncoder(packet::channel_mask_t channels);
+
+    //! Calculate encoded frame size for given number of samples per channel.
+    virtual size_t encoded_size(size_t num_samples) const;
+
+    //! Start encoding a new frame.
+    virtual void begin(void* frame, size_t frame_size);
+
+    //! Encode samples.
+    virtual size_t
+    write(const sample_t* samples, size_t n_samples, packet::channel_mask_t channels);
+
+    //! Finish encoding frame.
+    virtual size_t end();
+
+    //! Maximum number of channels.
+    enum { MaxChannels = 8 };
+
+private:
+    void prime_(const sample_t* samples, packet::channel_mask_t channels);
+
+    void put_headers_();
+    void put_code_(size_t code_index, uint8_t code);
+
+    const packet::channel_mask_t channels_;
+    const size_t num_channels_;
+
+    IMAADPCMState state_[MaxChannels];
+    bool primed_;
+
+    uint8_t* frame_data_;
+    size_t frame_size_;
+    size_t frame_pos_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_ADPCM_ENCODER_H_
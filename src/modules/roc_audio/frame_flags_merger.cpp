@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/frame_flags_merger.h"
+
+namespace roc {
+namespace audio {
+
+FrameFlagsMerger::FrameFlagsMerger()
+    : flags_(0)
+    , has_blank_(false)
+    , has_data_(false) {
+}
+
+void FrameFlagsMerger::add(unsigned flags) {
+    if (flags & Frame::FlagBlank) {
+        has_blank_ = true;
+    } else {
+        has_data_ = true;
+    }
+    flags_ |= flags & ~(unsigned)Frame::FlagBlank;
+}
+
+unsigned FrameFlagsMerger::flags() const {
+    if (!has_blank_) {
+        return flags_;
+    }
+    return flags_ | (has_data_ ? Frame::FlagIncomplete : Frame::FlagBlank);
+}
+
+} // namespace audio
+} // namespace roc
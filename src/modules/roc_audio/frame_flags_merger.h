@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/frame_flags_merger.h
+//! @brief Frame flags merger.
+
+#ifndef ROC_AUDIO_FRAME_FLAGS_MERGER_H_
+#define ROC_AUDIO_FRAME_FLAGS_MERGER_H_
+
+#include "roc_audio/frame.h"
+#include "roc_core/noncopyable.h"
+
+namespace roc {
+namespace audio {
+
+//! Merges flags of frames that are parts of a larger frame.
+//! @remarks
+//!  Merged frame is blank if all parts are blank, and incomplete if only
+//!  some of them are blank. Other flags are combined.
+class FrameFlagsMerger : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    FrameFlagsMerger();
+
+    //! Add flags of the next part.
+    void add(unsigned flags);
+
+    //! Get flags of the merged frame.
+    unsigned flags() const;
+
+private:
+    unsigned flags_;
+    bool has_blank_;
+    bool has_data_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_FRAME_FLAGS_MERGER_H_
@@ -26,6 +26,9 @@ public:
     virtual ~IFrameEncoder();
 
     //! Get encoded frame size for given number of samples per channel.
+    //! @remarks
+    //!  If the encoded frame size depends on the samples, returns the maximum
+    //!  possible size. The actual size is returned by end().
     virtual size_t encoded_size(size_t num_samples) const = 0;
 
     //! Start encoding a new frame.
@@ -64,7 +67,11 @@ public:
     //! @remarks
     //!  After this call, the frame is fully encoded and no more samples will be
     //!  written to the frame. A new frame should be started by calling begin().
-    virtual void end() = 0;
+    //!
+    //! @returns
+    //!  number of bytes actually written to the frame. It never exceeds the
+    //!  encoded_size() for the number of samples written.
+    virtual size_t end() = 0;
 };
 
 } // namespace audio
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/ima_adpcm.h
+//! @brief IMA ADPCM primitives.
+
+#ifndef ROC_AUDIO_IMA_ADPCM_H_
+#define ROC_AUDIO_IMA_ADPCM_H_
+
+#include "roc_audio/units.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! IMA ADPCM frame layout.
+//! @remarks
+//!  Frame starts with a header for every channel, followed by 4-bit codes of
+//!  interleaved samples, two codes per byte, first code in the high nibble.
+//!  Channel header consists of 16-bit big-endian predicted value, 8-bit step
+//!  index, and 8-bit flags. The header holds the complete decoder state at the
+//!  beginning of the frame, so every frame can be decoded independently.
+enum {
+    //! Size of per-channel header in bytes.
+    IMAADPCM_HeaderSize = 4,
+
+    //! Flag in first channel header meaning that the low nibble of the last
+    //! byte is padding and doesn't hold a sample.
+    IMAADPCM_FlagOddPadding = 0x1,
+
+    //! Maximum value of step index.
+    IMAADPCM_MaxStepIndex = 88
+};
+
+//! IMA ADPCM step table.
+extern const int16_t IMAADPCM_StepTable[IMAADPCM_MaxStepIndex + 1];
+
+//! IMA ADPCM step index adjustment table.
+extern const int8_t IMAADPCM_IndexTable[16];
+
+//! IMA ADPCM per-channel state.
+struct IMAADPCMState {
+    //! Last reconstructed sample.
+    int32_t predictor;
+
+    //! Index in step table.
+    int32_t step_index;
+
+    IMAADPCMState()
+        : predictor(0)
+        , step_index(0) {
+    }
+};
+
+//! Get payload size in bytes from number of samples per channel.
+inline size_t ima_adpcm_payload_size(size_t num_samples, size_t num_channels) {
+    return num_channels * IMAADPCM_HeaderSize + (num_samples * num_channels + 1) / 2;
+}
+
+//! Get number of samples per channel from payload size in bytes.
+//! @remarks
+//!  If the last byte is half-filled, the padding nibble is counted as a
+//!  sample; use IMAADPCM_FlagOddPadding from the header to get exact number.
+inline size_t ima_adpcm_num_samples(size_t payload_size, size_t num_channels) {
+    if (payload_size < num_channels * IMAADPCM_HeaderSize) {
+        return 0;
+    }
+    return (payload_size - num_channels * IMAADPCM_HeaderSize) * 2 / num_channels;
+}
+
+//! Convert sample to 16-bit integer, the same way as PCM encoder does.
+inline int16_t ima_adpcm_quantize(sample_t s) {
+    s *= 32768.0f;
+    s = std::min(s, +32767.0f);
+    s = std::max(s, -32768.0f);
+    return (int16_t)s;
+}
+
+//! Update state with given code and return reconstructed sample.
+inline int16_t ima_adpcm_decode(IMAADPCMState& state, uint8_t code) {
+    const int32_t step = IMAADPCM_StepTable[state.step_index];
+
+    int32_t diff = step >> 3;
+    if (code & 4) {
+        diff += step;
+    }
+    if (code & 2) {
+        diff += step >> 1;
+    }
+    if (code & 1) {
+        diff += step >> 2;
+    }
+
+    int32_t predictor = (code & 8) ? state.predictor - diff : state.predictor + diff;
+    predictor = std::min(predictor, (int32_t)32767);
+    predictor = std::max(predictor, (int32_t)-32768);
+
+    int32_t step_index = state.step_index + IMAADPCM_IndexTable[code];
+    step_index = std::min(step_index, (int32_t)IMAADPCM_MaxStepIndex);
+    step_index = std::max(step_index, (int32_t)0);
+
+    state.predictor = predictor;
+    state.step_index = step_index;
+
+    return (int16_t)predictor;
+}
+
+//! Compute code for given sample and update state.
+//! @remarks
+//!  State is updated exactly as ima_adpcm_decode() would update it,
+//!  so encoder and decoder states never diverge.
+inline uint8_t ima_adpcm_encode(IMAADPCMState& state, int16_t sample) {
+    int32_t diff = (int32_t)sample - state.predictor;
+    int32_t step = IMAADPCM_StepTable[state.step_index];
+
+    uint8_t code = 0;
+    if (diff < 0) {
+        code = 8;
+        diff = -diff;
+    }
+    if (diff >= step) {
+        code |= 4;
+        diff -= step;
+    }
+    step >>= 1;
+    if (diff >= step) {
+        code |= 2;
+        diff -= step;
+    }
+    step >>= 1;
+    if (diff >= step) {
+        code |= 1;
+    }
+
+    (void)ima_adpcm_decode(state, code);
+
+    return code;
+}
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_IMA_ADPCM_H_
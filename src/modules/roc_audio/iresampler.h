@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/iresampler.h
+//! @brief Audio resampler interface.
+
+#ifndef ROC_AUDIO_IRESAMPLER_H_
+#define ROC_AUDIO_IRESAMPLER_H_
+
+#include "roc_audio/frame.h"
+#include "roc_audio/units.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Audio resampler interface.
+//! @remarks
+//!  Resampler consumes interleaved input samples of any size and produces output
+//!  frames. Input is kept in an internal ring buffer, and output sample is
+//!  computed as soon as the window around its time position is available, so
+//!  the resampler adds a delay of about half window.
+class IResampler {
+public:
+    virtual ~IResampler();
+
+    //! Set new resample factor.
+    //! @returns
+    //!  false if the factor is not supported.
+    virtual bool set_scaling(float) = 0;
+
+    //! Resamples the whole output frame.
+    //! @returns
+    //!  false if more input is needed and push_input() should be called before
+    //!  continuing; in this case the output frame is only partially filled and
+    //!  the next call will continue filling it.
+    virtual bool resample_buff(Frame& out) = 0;
+
+    //! Push interleaved input samples.
+    //! @returns
+    //!  number of samples consumed, which is less than @p n_samples if the
+    //!  internal buffer is full. After resample_buff() returned false, at least
+    //!  one frame of the size passed to resampler constructor is accepted.
+    virtual size_t push_input(const sample_t* samples, size_t n_samples) = 0;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_IRESAMPLER_H_
@@ -19,7 +19,7 @@ const core::nanoseconds_t LogInterval = 5 * core::Second;
 
 } // namespace
 
-LatencyMonitor::LatencyMonitor(const packet::SortedQueue& queue,
+LatencyMonitor::LatencyMonitor(const packet::SeqnumQueue& queue,
                                const Depacketizer& depacketizer,
                                ResamplerReader* resampler,
                                const LatencyMonitorConfig& config,
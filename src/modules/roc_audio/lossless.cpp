@@ -0,0 +1,454 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/lossless.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+class BitWriter {
+public:
+    explicit BitWriter(uint8_t* data)
+        : data_(data)
+        , pos_(0)
+        , acc_(0)
+        , n_bits_(0) {
+    }
+
+    // n_bits should be at most 32
+    void put(uint32_t value, size_t n_bits) {
+        acc_ = (acc_ << n_bits) | value;
+        n_bits_ += n_bits;
+
+        while (n_bits_ >= 8) {
+            n_bits_ -= 8;
+            data_[pos_++] = uint8_t(acc_ >> n_bits_);
+        }
+    }
+
+    size_t flush() {
+        if (n_bits_ != 0) {
+            data_[pos_++] = uint8_t(acc_ << (8 - n_bits_));
+            n_bits_ = 0;
+        }
+        return pos_;
+    }
+
+private:
+    uint8_t* data_;
+    size_t pos_;
+    uint64_t acc_;
+    size_t n_bits_;
+};
+
+class BitReader {
+public:
+    BitReader(const uint8_t* data, size_t size)
+        : data_(data)
+        , size_(size)
+        , byte_pos_(0)
+        , cache_(0)
+        , cache_bits_(0)
+        , bit_pos_(0) {
+    }
+
+    bool get_rice(uint32_t& value, size_t param) {
+        uint32_t quotient = 0;
+
+        for (;;) {
+            refill_();
+            if (cache_ != 0) {
+                break;
+            }
+            quotient += (uint32_t)cache_bits_;
+            skip_(cache_bits_);
+            if (bit_pos_ > size_ * 8) {
+                return false;
+            }
+        }
+
+        size_t n_zeros = 0;
+        while (!(cache_ & ((uint64_t)1 << 63))) {
+            cache_ <<= 1;
+            n_zeros++;
+        }
+        cache_bits_ -= n_zeros;
+        bit_pos_ += n_zeros;
+
+        // stop bit
+        skip_(1);
+
+        quotient += (uint32_t)n_zeros;
+        if (quotient >= (1u << (31 - param))) {
+            return false;
+        }
+
+        value = quotient << param;
+
+        if (param != 0) {
+            refill_();
+            value |= (uint32_t)(cache_ >> (64 - param));
+            skip_(param);
+        }
+
+        return bit_pos_ <= size_ * 8;
+    }
+
+    size_t consumed() const {
+        return (bit_pos_ + 7) / 8;
+    }
+
+private:
+    // fill cache with at least 57 bits, zero-padded after end
+    void refill_() {
+        while (cache_bits_ <= 56) {
+            const uint64_t byte = byte_pos_ < size_ ? data_[byte_pos_] : 0;
+            cache_ |= byte << (56 - cache_bits_);
+            cache_bits_ += 8;
+            byte_pos_++;
+        }
+    }
+
+    void skip_(size_t n_bits) {
+        cache_ = n_bits < 64 ? cache_ << n_bits : 0;
+        cache_bits_ -= n_bits;
+        bit_pos_ += n_bits;
+    }
+
+    const uint8_t* data_;
+    const size_t size_;
+    size_t byte_pos_;
+
+    // bits starting from bit_pos_, aligned to the most significant bit
+    uint64_t cache_;
+    size_t cache_bits_;
+    size_t bit_pos_;
+};
+
+inline uint32_t zigzag(int32_t r) {
+    return r >= 0 ? (uint32_t)r << 1 : ((uint32_t)-r << 1) - 1;
+}
+
+inline int32_t unzigzag(uint32_t u) {
+    return (u & 1) ? -(int32_t)(u >> 1) - 1 : (int32_t)(u >> 1);
+}
+
+inline void put_int16(uint8_t* data, int16_t value) {
+    data[0] = uint8_t((uint16_t)value >> 8);
+    data[1] = uint8_t((uint16_t)value);
+}
+
+inline int16_t get_int16(const uint8_t* data) {
+    return (int16_t)(((uint16_t)data[0] << 8) | data[1]);
+}
+
+// Prediction of fixed polynomial predictor for sample x[0] from x[-Order..-1].
+template <size_t Order> inline int32_t fixed_predict(const int16_t* x);
+
+template <> inline int32_t fixed_predict<0>(const int16_t*) {
+    return 0;
+}
+
+template <> inline int32_t fixed_predict<1>(const int16_t* x) {
+    return x[-1];
+}
+
+template <> inline int32_t fixed_predict<2>(const int16_t* x) {
+    return 2 * x[-1] - x[-2];
+}
+
+template <> inline int32_t fixed_predict<3>(const int16_t* x) {
+    return 3 * x[-1] - 3 * x[-2] + x[-3];
+}
+
+template <> inline int32_t fixed_predict<4>(const int16_t* x) {
+    return 4 * x[-1] - 6 * x[-2] + 4 * x[-3] - x[-4];
+}
+
+template <size_t Order>
+uint64_t fixed_residuals(uint32_t* residuals, const int16_t* samples, size_t n_samples) {
+    uint64_t sum = 0;
+    for (size_t n = Order; n < n_samples; n++) {
+        const uint32_t u = zigzag(samples[n] - fixed_predict<Order>(samples + n));
+        residuals[n - Order] = u;
+        sum += u;
+    }
+    return sum;
+}
+
+uint64_t compute_residuals(uint32_t* residuals,
+                           const int16_t* samples,
+                           size_t n_samples,
+                           size_t order) {
+    switch (order) {
+    case 0:
+        return fixed_residuals<0>(residuals, samples, n_samples);
+    case 1:
+        return fixed_residuals<1>(residuals, samples, n_samples);
+    case 2:
+        return fixed_residuals<2>(residuals, samples, n_samples);
+    case 3:
+        return fixed_residuals<3>(residuals, samples, n_samples);
+    case 4:
+        return fixed_residuals<4>(residuals, samples, n_samples);
+    default:
+        break;
+    }
+    roc_panic("lossless: unexpected predictor order: %lu", (unsigned long)order);
+}
+
+template <size_t Order>
+bool fixed_restore(int16_t* samples, size_t n_samples, BitReader& reader, size_t param) {
+    for (size_t n = Order; n < n_samples; n++) {
+        uint32_t u = 0;
+        if (!reader.get_rice(u, param)) {
+            return false;
+        }
+        const int32_t s = fixed_predict<Order>(samples + n) + unzigzag(u);
+        if (s < -32768 || s > 32767) {
+            return false;
+        }
+        samples[n] = (int16_t)s;
+    }
+    return true;
+}
+
+bool restore_residuals(int16_t* samples,
+                       size_t n_samples,
+                       BitReader& reader,
+                       size_t order,
+                       size_t param) {
+    switch (order) {
+    case 0:
+        return fixed_restore<0>(samples, n_samples, reader, param);
+    case 1:
+        return fixed_restore<1>(samples, n_samples, reader, param);
+    case 2:
+        return fixed_restore<2>(samples, n_samples, reader, param);
+    case 3:
+        return fixed_restore<3>(samples, n_samples, reader, param);
+    case 4:
+        return fixed_restore<4>(samples, n_samples, reader, param);
+    default:
+        break;
+    }
+    return false;
+}
+
+// Select predictor order with the smallest sum of absolute residuals.
+size_t select_order(const int16_t* x, size_t n_samples) {
+    uint64_t sums[Lossless_MaxOrder + 1] = {};
+
+    for (size_t n = Lossless_MaxOrder; n < n_samples; n++) {
+        const int32_t e0 = x[n];
+        const int32_t e1 = e0 - x[n - 1];
+        const int32_t e2 = e1 - (x[n - 1] - x[n - 2]);
+        const int32_t e3 = e2 - (x[n - 1] - 2 * x[n - 2] + x[n - 3]);
+        const int32_t e4 = e3 - (x[n - 1] - 3 * x[n - 2] + 3 * x[n - 3] - x[n - 4]);
+
+        sums[0] += (uint32_t)std::abs(e0);
+        sums[1] += (uint32_t)std::abs(e1);
+        sums[2] += (uint32_t)std::abs(e2);
+        sums[3] += (uint32_t)std::abs(e3);
+        sums[4] += (uint32_t)std::abs(e4);
+    }
+
+    size_t order = 0;
+    for (size_t o = 1; o <= Lossless_MaxOrder; o++) {
+        if (sums[o] < sums[order]) {
+            order = o;
+        }
+    }
+
+    return order;
+}
+
+// Select Rice parameter using estimated code length, which assumes that
+// residuals are distributed evenly around their mean.
+size_t select_param(uint64_t sum, size_t n_residuals) {
+    size_t param = 0;
+    uint64_t best_bits = (uint64_t)n_residuals + sum;
+
+    for (size_t p = 1; p <= Lossless_MaxRiceParam; p++) {
+        const uint64_t bits = (uint64_t)n_residuals * (p + 1) + (sum >> p);
+        if (bits < best_bits) {
+            best_bits = bits;
+            param = p;
+        }
+    }
+
+    return param;
+}
+
+size_t encode_verbatim(uint8_t* data, const int16_t* samples, size_t n_samples) {
+    data[0] = uint8_t(Lossless_Verbatim << 4);
+
+    for (size_t n = 0; n < n_samples; n++) {
+        put_int16(data + Lossless_SubframeHeaderSize + n * 2, samples[n]);
+    }
+
+    return Lossless_SubframeHeaderSize + n_samples * 2;
+}
+
+} // namespace
+
+size_t lossless_encode_subframe(uint8_t* data,
+                                const int16_t* samples,
+                                size_t n_samples,
+                                uint32_t* scratch) {
+    roc_panic_if_not(data);
+    roc_panic_if_not(samples || n_samples == 0);
+
+    if (n_samples <= Lossless_MaxOrder) {
+        return encode_verbatim(data, samples, n_samples);
+    }
+
+    bool is_constant = true;
+    for (size_t n = 1; n < n_samples; n++) {
+        if (samples[n] != samples[0]) {
+            is_constant = false;
+            break;
+        }
+    }
+
+    if (is_constant) {
+        data[0] = uint8_t(Lossless_Constant << 4);
+        put_int16(data + Lossless_SubframeHeaderSize, samples[0]);
+        return Lossless_SubframeHeaderSize + 2;
+    }
+
+    const size_t order = select_order(samples, n_samples);
+    const size_t n_residuals = n_samples - order;
+
+    const uint64_t sum = compute_residuals(scratch, samples, n_samples, order);
+    const size_t param = select_param(sum, n_residuals);
+
+    uint64_t n_bits = (uint64_t)n_residuals * (param + 1);
+    for (size_t n = 0; n < n_residuals; n++) {
+        n_bits += scratch[n] >> param;
+    }
+
+    const uint64_t fixed_size =
+        Lossless_SubframeHeaderSize + order * 2 + 1 + (n_bits + 7) / 8;
+
+    if (fixed_size >= Lossless_SubframeHeaderSize + n_samples * 2) {
+        return encode_verbatim(data, samples, n_samples);
+    }
+
+    data[0] = uint8_t((Lossless_Fixed << 4) | order);
+
+    size_t pos = Lossless_SubframeHeaderSize;
+    for (size_t n = 0; n < order; n++) {
+        put_int16(data + pos, samples[n]);
+        pos += 2;
+    }
+    data[pos++] = uint8_t(param);
+
+    BitWriter writer(data + pos);
+
+    const uint32_t low_mask = (1u << param) - 1;
+
+    for (size_t n = 0; n < n_residuals; n++) {
+        uint32_t quotient = scratch[n] >> param;
+
+        while (quotient >= 32) {
+            writer.put(0, 32);
+            quotient -= 32;
+        }
+
+        // quotient zeros, stop bit, and param low bits
+        if (quotient + 1 + param <= 32) {
+            writer.put((1u << param) | (scratch[n] & low_mask), quotient + 1 + param);
+        } else {
+            writer.put(1, quotient + 1);
+            writer.put(scratch[n] & low_mask, param);
+        }
+    }
+
+    pos += writer.flush();
+
+    roc_panic_if_not(pos == fixed_size);
+
+    return pos;
+}
+
+size_t lossless_decode_subframe(int16_t* samples,
+                                size_t n_samples,
+                                const uint8_t* data,
+                                size_t size) {
+    roc_panic_if_not(samples || n_samples == 0);
+    roc_panic_if_not(data);
+
+    if (size < Lossless_SubframeHeaderSize) {
+        return 0;
+    }
+
+    const size_t type = data[0] >> 4;
+    const size_t order = data[0] & 0xf;
+
+    switch (type) {
+    case Lossless_Constant: {
+        if (size < Lossless_SubframeHeaderSize + 2) {
+            return 0;
+        }
+        const int16_t value = get_int16(data + Lossless_SubframeHeaderSize);
+        for (size_t n = 0; n < n_samples; n++) {
+            samples[n] = value;
+        }
+        return Lossless_SubframeHeaderSize + 2;
+    }
+
+    case Lossless_Verbatim: {
+        if (size < Lossless_SubframeHeaderSize + n_samples * 2) {
+            return 0;
+        }
+        for (size_t n = 0; n < n_samples; n++) {
+            samples[n] = get_int16(data + Lossless_SubframeHeaderSize + n * 2);
+        }
+        return Lossless_SubframeHeaderSize + n_samples * 2;
+    }
+
+    case Lossless_Fixed: {
+        if (order > Lossless_MaxOrder || order > n_samples) {
+            return 0;
+        }
+
+        size_t pos = Lossless_SubframeHeaderSize;
+        if (size < pos + order * 2 + 1) {
+            return 0;
+        }
+        for (size_t n = 0; n < order; n++) {
+            samples[n] = get_int16(data + pos);
+            pos += 2;
+        }
+
+        const size_t param = data[pos++];
+        if (param > Lossless_MaxRiceParam) {
+            return 0;
+        }
+
+        BitReader reader(data + pos, size - pos);
+        if (!restore_residuals(samples, n_samples, reader, order, param)) {
+            return 0;
+        }
+
+        return pos + reader.consumed();
+    }
+
+    default:
+        break;
+    }
+
+    return 0;
+}
+
+} // namespace audio
+} // namespace roc
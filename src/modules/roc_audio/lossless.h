@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/lossless.h
+//! @brief Lossless codec primitives.
+
+#ifndef ROC_AUDIO_LOSSLESS_H_
+#define ROC_AUDIO_LOSSLESS_H_
+
+#include "roc_audio/units.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Lossless frame layout.
+//! @remarks
+//!  Frame starts with 16-bit big-endian number of samples per channel, followed
+//!  by a subframe for every channel. Subframe starts at a byte boundary with a
+//!  byte holding subframe type in the high nibble and predictor order in the
+//!  low nibble. Constant subframe holds a single 16-bit sample repeated for the
+//!  whole frame. Verbatim subframe holds all samples as 16-bit big-endian
+//!  integers. Fixed subframe holds first "order" samples as 16-bit integers,
+//!  a byte with Rice parameter, and Rice-coded residuals of the fixed
+//!  polynomial predictor of that order, padded to a byte boundary.
+//!
+//!  Samples are quantized to 16 bits the same way as for L16 payloads, so the
+//!  decoded stream is bit-exact with the L16 stream.
+enum {
+    //! Size of frame header in bytes.
+    Lossless_FrameHeaderSize = 2,
+
+    //! Size of subframe header in bytes.
+    Lossless_SubframeHeaderSize = 1,
+
+    //! Maximum order of fixed predictor.
+    Lossless_MaxOrder = 4,
+
+    //! Maximum Rice parameter.
+    Lossless_MaxRiceParam = 24,
+
+    //! Maximum number of samples per channel in frame.
+    Lossless_MaxSamples = 0xffff
+};
+
+//! Lossless subframe type.
+enum LosslessSubframe {
+    Lossless_Constant = 0, //!< All samples are equal.
+    Lossless_Verbatim = 1, //!< Samples are stored as is.
+    Lossless_Fixed = 2     //!< Residuals of fixed predictor are Rice-coded.
+};
+
+//! Get maximum payload size in bytes for given number of samples per channel.
+//! @remarks
+//!  Every subframe is never larger than a verbatim one.
+inline size_t lossless_max_payload_size(size_t num_samples, size_t num_channels) {
+    return Lossless_FrameHeaderSize
+        + num_channels * (Lossless_SubframeHeaderSize + num_samples * 2);
+}
+
+//! Get maximum number of samples per channel that fit into given payload size.
+inline size_t lossless_max_num_samples(size_t payload_size, size_t num_channels) {
+    const size_t header_size =
+        Lossless_FrameHeaderSize + num_channels * Lossless_SubframeHeaderSize;
+    if (payload_size < header_size) {
+        return 0;
+    }
+    return std::min((payload_size - header_size) / num_channels / 2,
+                    (size_t)Lossless_MaxSamples);
+}
+
+//! Get number of samples per channel from frame header.
+inline size_t lossless_num_samples(const void* payload, size_t payload_size) {
+    if (payload_size < Lossless_FrameHeaderSize) {
+        return 0;
+    }
+    const uint8_t* data = (const uint8_t*)payload;
+    return ((size_t)data[0] << 8) | data[1];
+}
+
+//! Convert sample to 16-bit integer, the same way as PCM encoder does.
+inline int16_t lossless_quantize(sample_t s) {
+    s *= 32768.0f;
+    s = std::min(s, +32767.0f);
+    s = std::max(s, -32768.0f);
+    return (int16_t)s;
+}
+
+//! Encode subframe.
+//!
+//! @b Parameters
+//!  - @p data - buffer for subframe, should have space for a verbatim subframe
+//!  - @p samples - samples of one channel
+//!  - @p n_samples - number of samples
+//!  - @p scratch - temporary buffer for @p n_samples residuals
+//!
+//! @returns
+//!  number of bytes written.
+size_t lossless_encode_subframe(uint8_t* data,
+                                const int16_t* samples,
+                                size_t n_samples,
+                                uint32_t* scratch);
+
+//! Decode subframe.
+//!
+//! @b Parameters
+//!  - @p samples - buffer for decoded samples of one channel
+//!  - @p n_samples - number of samples
+//!  - @p data - subframe data
+//!  - @p size - maximum subframe size
+//!
+//! @returns
+//!  number of bytes consumed, or zero if subframe is malformed.
+size_t lossless_decode_subframe(int16_t* samples,
+                                size_t n_samples,
+                                const uint8_t* data,
+                                size_t size);
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_LOSSLESS_H_
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/lossless_decoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+LosslessDecoder::LosslessDecoder(core::IAllocator& allocator,
+                                 packet::channel_mask_t channels)
+    : channels_(channels)
+    , num_channels_(packet::num_channels(channels))
+    , samples_(allocator)
+    , stream_pos_(0)
+    , stream_avail_(0)
+    , frame_started_(false)
+    , frame_samples_(0)
+    , frame_pos_(0) {
+    if (num_channels_ == 0) {
+        roc_panic("lossless decoder: channel mask is empty");
+    }
+}
+
+packet::timestamp_t LosslessDecoder::position() const {
+    return stream_pos_;
+}
+
+packet::timestamp_t LosslessDecoder::available() const {
+    return stream_avail_;
+}
+
+void LosslessDecoder::begin(packet::timestamp_t frame_position,
+                            const void* frame_data,
+                            size_t frame_size) {
+    roc_panic_if_not(frame_data);
+
+    if (frame_started_) {
+        roc_panic("lossless decoder: unpaired begin/end");
+    }
+
+    frame_started_ = true;
+
+    stream_pos_ = frame_position;
+    stream_avail_ = (packet::timestamp_t)decode_((const uint8_t*)frame_data, frame_size);
+}
+
+size_t LosslessDecoder::read(audio::sample_t* samples,
+                             size_t n_samples,
+                             packet::channel_mask_t channels) {
+    if (!frame_started_) {
+        roc_panic("lossless decoder: read should be called only between begin/end");
+    }
+
+    n_samples = limit_(n_samples);
+
+    if (n_samples == 0) {
+        return 0;
+    }
+
+    if (channels == channels_) {
+        // fast path: channels are the same, no remapping needed
+        for (size_t ch = 0; ch < num_channels_; ch++) {
+            const int16_t* in = &samples_[ch * frame_samples_ + frame_pos_];
+            for (size_t ns = 0; ns < n_samples; ns++) {
+                samples[ns * num_channels_ + ch] = sample_t(in[ns]) / 32768.0f;
+            }
+        }
+
+        advance_(n_samples);
+        return n_samples;
+    }
+
+    const packet::channel_mask_t inout_channels = channels | channels_;
+
+    for (size_t ns = 0; ns < n_samples; ns++) {
+        size_t in_ch = 0;
+
+        for (packet::channel_mask_t ch = 1; ch <= inout_channels && ch != 0; ch <<= 1) {
+            sample_t s = 0;
+            if (channels_ & ch) {
+                s = sample_t(samples_[in_ch++ * frame_samples_ + frame_pos_ + ns])
+                    / 32768.0f;
+            }
+            if (channels & ch) {
+                *samples++ = s;
+            }
+        }
+    }
+
+    advance_(n_samples);
+
+    return n_samples;
+}
+
+size_t LosslessDecoder::shift(size_t n_samples) {
+    if (!frame_started_) {
+        roc_panic("lossless decoder: shift should be called only between begin/end");
+    }
+
+    n_samples = limit_(n_samples);
+    advance_(n_samples);
+
+    return n_samples;
+}
+
+void LosslessDecoder::end() {
+    if (!frame_started_) {
+        roc_panic("lossless decoder: unpaired begin/end");
+    }
+
+    stream_avail_ = 0;
+
+    frame_started_ = false;
+    frame_samples_ = 0;
+    frame_pos_ = 0;
+}
+
+size_t LosslessDecoder::decode_(const uint8_t* frame_data, size_t frame_size) {
+    const size_t n_samples = lossless_num_samples(frame_data, frame_size);
+    if (n_samples == 0) {
+        return 0;
+    }
+
+    if (!samples_.resize(n_samples * num_channels_)) {
+        roc_log(LogError, "lossless decoder: can't allocate buffer: n_samples=%lu",
+                (unsigned long)n_samples);
+        return 0;
+    }
+
+    size_t pos = Lossless_FrameHeaderSize;
+
+    for (size_t ch = 0; ch < num_channels_; ch++) {
+        const size_t size = lossless_decode_subframe(
+            &samples_[ch * n_samples], n_samples, frame_data + pos, frame_size - pos);
+
+        if (size == 0) {
+            roc_log(LogDebug, "lossless decoder: malformed frame: channel=%lu",
+                    (unsigned long)ch);
+            return 0;
+        }
+
+        pos += size;
+    }
+
+    frame_samples_ = n_samples;
+
+    return n_samples;
+}
+
+size_t LosslessDecoder::limit_(size_t n_samples) const {
+    if (n_samples > (size_t)stream_avail_) {
+        n_samples = (size_t)stream_avail_;
+    }
+    return n_samples;
+}
+
+void LosslessDecoder::advance_(size_t n_samples) {
+    stream_pos_ += (packet::timestamp_t)n_samples;
+    stream_avail_ -= (packet::timestamp_t)n_samples;
+
+    frame_pos_ += n_samples;
+}
+
+} // namespace audio
+} // namespace roc
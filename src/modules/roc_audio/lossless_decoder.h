@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/lossless_decoder.h
+//! @brief Lossless decoder.
+
+#ifndef ROC_AUDIO_LOSSLESS_DECODER_H_
+#define ROC_AUDIO_LOSSLESS_DECODER_H_
+
+#include "roc_audio/iframe_decoder.h"
+#include "roc_audio/lossless.h"
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_packet/units.h"
+
+namespace roc {
+namespace audio {
+
+//! Lossless decoder.
+//! @remarks
+//!  Decompresses the whole frame in begin(). If the frame is malformed,
+//!  it is treated as empty.
+class LosslessDecoder : public IFrameDecoder, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    LosslessDecoder(core::IAllocator& allocator, packet::channel_mask_t channels);
+
+    //! Get current stream position.
+    virtual packet::timestamp_t position() const;
+
+    //! Get number of samples available for decoding.
+    virtual packet::timestamp_t available() const;
+
+    //! Start decoding a new frame.
+    virtual void
+    begin(packet::timestamp_t frame_position, const void* frame_data, size_t frame_size);
+
+    //! Read samples from current frame.
+    virtual size_t
+    read(sample_t* samples, size_t n_samples, packet::channel_mask_t channels);
+
+    //! Shift samples from current frame.
+    virtual size_t shift(size_t n_samples);
+
+    //! Finish decoding current frame.
+    virtual void end();
+
+private:
+    size_t decode_(const uint8_t* frame_data, size_t frame_size);
+
+    size_t limit_(size_t n_samples) const;
+    void advance_(size_t n_samples);
+
+    const packet::channel_mask_t channels_;
+    const size_t num_channels_;
+
+    // samples of current frame, one row of frame_samples_ samples per channel
+    core::Array<int16_t> samples_;
+
+    packet::timestamp_t stream_pos_;
+    packet::timestamp_t stream_avail_;
+
+    bool frame_started_;
+    size_t frame_samples_;
+    size_t frame_pos_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_LOSSLESS_DECODER_H_
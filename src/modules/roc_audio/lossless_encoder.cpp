@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/lossless_encoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+LosslessEncoder::LosslessEncoder(core::IAllocator& allocator,
+                                 packet::channel_mask_t channels)
+    : channels_(channels)
+    , num_channels_(packet::num_channels(channels))
+    , samples_(allocator)
+    , residuals_(allocator)
+    , frame_data_(NULL)
+    , frame_size_(0)
+    , frame_capacity_(0)
+    , frame_pos_(0) {
+    if (num_channels_ == 0) {
+        roc_panic("lossless encoder: channel mask is empty");
+    }
+}
+
+size_t LosslessEncoder::encoded_size(size_t num_samples) const {
+    return lossless_max_payload_size(num_samples, num_channels_);
+}
+
+void LosslessEncoder::begin(void* frame_data, size_t frame_size) {
+    roc_panic_if_not(frame_data);
+
+    if (frame_data_) {
+        roc_panic("lossless encoder: unpaired begin/end");
+    }
+
+    frame_data_ = (uint8_t*)frame_data;
+    frame_size_ = frame_size;
+    frame_capacity_ = lossless_max_num_samples(frame_size, num_channels_);
+
+    if (!samples_.resize(frame_capacity_ * num_channels_)
+        || !residuals_.resize(frame_capacity_)) {
+        roc_log(LogError, "lossless encoder: can't allocate buffers: n_samples=%lu",
+                (unsigned long)frame_capacity_);
+        frame_capacity_ = 0;
+    }
+}
+
+size_t LosslessEncoder::write(const audio::sample_t* samples,
+                              size_t n_samples,
+                              packet::channel_mask_t channels) {
+    if (!frame_data_) {
+        roc_panic("lossless encoder: write should be called only between begin/end");
+    }
+
+    if (n_samples > frame_capacity_ - frame_pos_) {
+        n_samples = frame_capacity_ - frame_pos_;
+    }
+
+    if (n_samples == 0) {
+        return 0;
+    }
+
+    if (channels == channels_) {
+        // fast path: channels are the same, no remapping needed
+        for (size_t ch = 0; ch < num_channels_; ch++) {
+            int16_t* out = &samples_[ch * frame_capacity_ + frame_pos_];
+            for (size_t ns = 0; ns < n_samples; ns++) {
+                out[ns] = lossless_quantize(samples[ns * num_channels_ + ch]);
+            }
+        }
+
+        frame_pos_ += n_samples;
+        return n_samples;
+    }
+
+    const packet::channel_mask_t inout_channels = channels | channels_;
+
+    for (size_t ns = 0; ns < n_samples; ns++) {
+        size_t out_ch = 0;
+
+        for (packet::channel_mask_t ch = 1; ch <= inout_channels && ch != 0; ch <<= 1) {
+            sample_t s = 0;
+            if (channels & ch) {
+                s = *samples++;
+            }
+            if (channels_ & ch) {
+                samples_[out_ch++ * frame_capacity_ + frame_pos_ + ns] =
+                    lossless_quantize(s);
+            }
+        }
+    }
+
+    frame_pos_ += n_samples;
+
+    return n_samples;
+}
+
+size_t LosslessEncoder::end() {
+    if (!frame_data_) {
+        roc_panic("lossless encoder: unpaired begin/end");
+    }
+
+    size_t pos = 0;
+
+    if (frame_size_ >= Lossless_FrameHeaderSize) {
+        frame_data_[pos++] = uint8_t(frame_pos_ >> 8);
+        frame_data_[pos++] = uint8_t(frame_pos_);
+
+        if (frame_pos_ != 0) {
+            for (size_t ch = 0; ch < num_channels_; ch++) {
+                pos += lossless_encode_subframe(frame_data_ + pos,
+                                                &samples_[ch * frame_capacity_],
+                                                frame_pos_, &residuals_[0]);
+            }
+        }
+
+        roc_panic_if_not(pos <= frame_size_);
+
+        // the rest of the frame is sent when packet size can't be changed
+        memset(frame_data_ + pos, 0, frame_size_ - pos);
+    }
+
+    frame_data_ = NULL;
+    frame_size_ = 0;
+    frame_capacity_ = 0;
+    frame_pos_ = 0;
+
+    return pos;
+}
+
+} // namespace audio
+} // namespace roc
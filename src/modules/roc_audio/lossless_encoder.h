@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/lossless_encoder.h
+//! @brief Lossless encoder.
+
+#ifndef ROC_AUDIO_LOSSLESS_ENCODER_H_
+#define ROC_AUDIO_LOSSLESS_ENCODER_H_
+
+#include "roc_audio/iframe_encoder.h"
+#include "roc_audio/lossless.h"
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_packet/units.h"
+
+namespace roc {
+namespace audio {
+
+//! Lossless encoder.
+//! @remarks
+//!  Buffers samples of the frame and compresses them when the frame is
+//!  finished, using fixed polynomial prediction and Rice coding of residuals.
+//!  Every frame is self-contained and holds its number of samples, so the
+//!  encoded frame size varies and is known only after end().
+class LosslessEncoder : public IFrameEncoder, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    LosslessEncoder(core::IAllocator& allocator, packet::channel_mask_t channels);
+
+    //! Calculate maximum encoded frame size for given number of samples per channel.
+    virtual size_t encoded_size(size_t num_samples) const;
+
+    //! Start encoding a new frame.
+    virtual void begin(void* frame, size_t frame_size);
+
+    //! Encode samples.
+    virtual size_t
+    write(const sample_t* samples, size_t n_samples, packet::channel_mask_t channels);
+
+    //! Finish encoding frame.
+    virtual size_t end();
+
+private:
+    const packet::channel_mask_t channels_;
+    const size_t num_channels_;
+
+    // samples of current frame, one row of frame_capacity_ samples per channel
+    core::Array<int16_t> samples_;
+    core::Array<uint32_t> residuals_;
+
+    uint8_t* frame_data_;
+    size_t frame_size_;
+    size_t frame_capacity_;
+    size_t frame_pos_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_LOSSLESS_ENCODER_H_
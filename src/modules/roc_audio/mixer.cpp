@@ -7,6 +7,7 @@
  */
 
 #include "roc_audio/mixer.h"
+#include "roc_audio/frame_flags_merger.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 #include "roc_core/stddefs.h"
@@ -14,23 +15,12 @@
 namespace roc {
 namespace audio {
 
-namespace {
-
-sample_t clamp(const sample_t x) {
-    if (x > SampleMax) {
-        return SampleMax;
-    } else if (x < SampleMin) {
-        return SampleMin;
-    } else {
-        return x;
-    }
-}
-
-} // namespace
-
-Mixer::Mixer(core::BufferPool<sample_t>& pool, size_t frame_size)
-    : valid_(false) {
-    roc_log(LogDebug, "mixer: initializing: frame_size=%lu", (unsigned long)frame_size);
+Mixer::Mixer(core::BufferPool<sample_t>& pool, size_t frame_size, bool skip_blank)
+    : kernel_(mixer_kernel(MixerKernel_Auto))
+    , skip_blank_(skip_blank)
+    , valid_(false) {
+    roc_log(LogDebug, "mixer: initializing: frame_size=%lu skip_blank=%d kernel=%s",
+            (unsigned long)frame_size, (int)skip_blank, kernel_->name);
 
     temp_buf_ = new (pool) core::Buffer<sample_t>(pool);
     if (!temp_buf_) {
@@ -76,35 +66,68 @@ void Mixer::read(Frame& frame) {
     sample_t* samples = frame.data();
     size_t n_samples = frame.size();
 
+    FrameFlagsMerger flags;
+
     while (n_samples != 0) {
         size_t n_read = n_samples;
         if (n_read > max_read) {
             n_read = max_read;
         }
 
-        read_(samples, n_read);
+        flags.add(read_(samples, n_read));
 
         samples += n_read;
         n_samples -= n_read;
     }
+
+    frame.set_flags(flags.flags());
 }
 
-void Mixer::read_(sample_t* data, size_t size) {
+unsigned Mixer::read_(sample_t* data, size_t size) {
     roc_panic_if(!data);
     roc_panic_if(size == 0);
 
-    memset(data, 0, size * sizeof(sample_t));
+    unsigned flags = 0;
+    size_t n_mixed = 0;
+    size_t n_blank = 0;
 
     for (IReader* rp = readers_.front(); rp; rp = readers_.nextof(*rp)) {
-        sample_t* temp_data = temp_buf_.data();
+        // First mixed reader writes directly to output, so that we don't need
+        // to zero it. Skipped readers may write there too, and are overwritten.
+        sample_t* temp_data = n_mixed == 0 ? data : temp_buf_.data();
 
         Frame temp_frame(temp_data, size);
         rp->read(temp_frame);
 
-        for (size_t n = 0; n < size; n++) {
-            data[n] = clamp(data[n] + temp_data[n]);
+        const unsigned temp_flags = temp_frame.flags();
+
+        flags |= temp_flags & ~(unsigned)Frame::FlagBlank;
+
+        if (temp_flags & Frame::FlagBlank) {
+            n_blank++;
+            if (skip_blank_) {
+                continue;
+            }
+        }
+
+        if (n_mixed != 0) {
+            kernel_->accumulate(data, temp_data, size);
         }
+        n_mixed++;
     }
+
+    if (n_mixed == 0) {
+        // Output may contain samples of skipped frames.
+        memset(data, 0, size * sizeof(sample_t));
+    } else {
+        kernel_->clamp(data, size);
+    }
+
+    if (n_blank == readers_.size()) {
+        flags |= Frame::FlagBlank;
+    }
+
+    return flags;
 }
 
 } // namespace audio
@@ -13,6 +13,7 @@
 #define ROC_AUDIO_MIXER_H_
 
 #include "roc_audio/ireader.h"
+#include "roc_audio/mixer_kernel.h"
 #include "roc_audio/units.h"
 #include "roc_core/list.h"
 #include "roc_core/noncopyable.h"
@@ -35,6 +36,9 @@ namespace audio {
 //! @code
 //!  5, 7, 9, ...
 //! @endcode
+//!
+//! Samples are summed without clamping, and the sum is clamped once when
+//! all readers are mixed. Blank frames returned by readers may be skipped.
 class Mixer : public IReader, public core::NonCopyable<> {
 public:
     //! Initialize.
@@ -43,7 +47,10 @@ public:
     //!  - @p pool is used to allocate a temporary buffer of samples
     //!  - @p frame_size defines the temporary buffer size used to read from
     //!    attached readers
-    explicit Mixer(core::BufferPool<sample_t>& pool, size_t frame_size);
+    //!  - @p skip_blank defines whether samples of blank frames are skipped
+    //!    instead of being mixed; should be false if blank frames may contain
+    //!    something other than zeros, e.g. beeps
+    Mixer(core::BufferPool<sample_t>& pool, size_t frame_size, bool skip_blank);
 
     //! Check if the mixer was succefully constructed.
     bool valid() const;
@@ -57,15 +64,19 @@ public:
     //! Read audio frame.
     //! @remarks
     //!  Reads samples from every input reader, mixes them, and fills @p frame
-    //!  with the result.
+    //!  with the result. Output frame is blank only if all input frames are
+    //!  blank; other flags of input frames are merged.
     virtual void read(Frame& frame);
 
 private:
-    void read_(sample_t* out_data, size_t out_sz);
+    unsigned read_(sample_t* out_data, size_t out_sz);
+
+    const MixerKernel* kernel_;
 
     core::List<IReader, core::NoOwnership> readers_;
     core::Slice<sample_t> temp_buf_;
 
+    const bool skip_blank_;
     bool valid_;
 };
 
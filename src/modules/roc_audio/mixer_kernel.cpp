@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/mixer_kernel.h"
+#include "roc_core/panic.h"
+
+#ifdef ROC_TARGET_X86
+#include "roc_audio/mixer_kernel_x86.h"
+#include "roc_core/cpu_features.h"
+#endif // ROC_TARGET_X86
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+void generic_accumulate(sample_t* acc, const sample_t* samples, size_t n_samples) {
+    for (size_t n = 0; n < n_samples; n++) {
+        acc[n] += samples[n];
+    }
+}
+
+void generic_clamp(sample_t* samples, size_t n_samples) {
+    for (size_t n = 0; n < n_samples; n++) {
+        if (samples[n] > SampleMax) {
+            samples[n] = SampleMax;
+        } else if (samples[n] < SampleMin) {
+            samples[n] = SampleMin;
+        }
+    }
+}
+
+const MixerKernel GenericMixerKernel = {
+    MixerKernel_Generic,
+    "generic",
+    generic_accumulate,
+    generic_clamp,
+};
+
+} // namespace
+
+const MixerKernel* mixer_kernel(MixerKernelType type) {
+    switch (type) {
+    case MixerKernel_Auto:
+#ifdef ROC_TARGET_X86
+        if (const MixerKernel* kernel = mixer_kernel(MixerKernel_AVX2)) {
+            return kernel;
+        }
+        if (const MixerKernel* kernel = mixer_kernel(MixerKernel_SSE2)) {
+            return kernel;
+        }
+#endif // ROC_TARGET_X86
+        return &GenericMixerKernel;
+
+    case MixerKernel_Generic:
+        return &GenericMixerKernel;
+
+    case MixerKernel_SSE2:
+#ifdef ROC_TARGET_X86
+        if (core::cpu_supports(core::CpuFeature_SSE2)) {
+            return &SSE2MixerKernel;
+        }
+#endif // ROC_TARGET_X86
+        return NULL;
+
+    case MixerKernel_AVX2:
+#ifdef ROC_TARGET_X86
+        if (core::cpu_supports(core::CpuFeature_AVX2)) {
+            return &AVX2MixerKernel;
+        }
+#endif // ROC_TARGET_X86
+        return NULL;
+    }
+
+    roc_panic("mixer kernel: unknown kernel type %d", (int)type);
+}
+
+} // namespace audio
+} // namespace roc
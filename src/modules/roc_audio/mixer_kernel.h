@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/mixer_kernel.h
+//! @brief Mixer kernel.
+
+#ifndef ROC_AUDIO_MIXER_KERNEL_H_
+#define ROC_AUDIO_MIXER_KERNEL_H_
+
+#include "roc_audio/units.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Mixer kernel type.
+enum MixerKernelType {
+    //! Select the fastest kernel supported by the CPU.
+    MixerKernel_Auto,
+
+    //! Portable scalar implementation.
+    MixerKernel_Generic,
+
+    //! SSE2 implementation.
+    MixerKernel_SSE2,
+
+    //! AVX2 implementation.
+    MixerKernel_AVX2
+};
+
+//! Mixer kernel.
+//! @remarks
+//!  Function table implementing the innermost loops of the mixer.
+//!  All implementations produce identical results for finite samples.
+struct MixerKernel {
+    //! Kernel type.
+    MixerKernelType type;
+
+    //! Kernel name.
+    const char* name;
+
+    //! Add samples to accumulator.
+    //! @remarks
+    //!  Adds @p samples[K] to @p acc[K] for K in [0; n_samples), without
+    //!  clamping.
+    void (*accumulate)(sample_t* acc, const sample_t* samples, size_t n_samples);
+
+    //! Clamp samples.
+    //! @remarks
+    //!  Limits every sample to [SampleMin; SampleMax] range in-place.
+    void (*clamp)(sample_t* samples, size_t n_samples);
+};
+
+//! Get mixer kernel.
+//! @returns
+//!  NULL if the given kernel is not supported by the build or by the CPU.
+//!  If @p type is MixerKernel_Auto, never returns NULL.
+const MixerKernel* mixer_kernel(MixerKernelType type);
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_MIXER_KERNEL_H_
@@ -106,23 +106,46 @@ bool Packetizer::begin_packet_() {
 }
 
 void Packetizer::end_packet_() {
-    payload_encoder_.end();
+    const size_t payload_size = payload_encoder_.end();
+    roc_panic_if_not(payload_size <= payload_size_);
 
     packet_->rtp()->duration = (packet::timestamp_t)packet_pos_;
 
-    if (packet_pos_ < samples_per_packet_) {
-        pad_packet_();
+    if (payload_size < payload_size_) {
+        shrink_packet_(payload_size);
     }
 
+    packet_->set_data(packet_data_);
+
     writer_.write(packet_);
 
     seqnum_++;
     timestamp_ += (packet::timestamp_t)packet_pos_;
 
     packet_ = NULL;
+    packet_data_ = core::Slice<uint8_t>();
     packet_pos_ = 0;
 }
 
+void Packetizer::shrink_packet_(size_t payload_size) {
+    packet::RTP& rtp = *packet_->rtp();
+
+    const uint8_t* payload_end = rtp.payload.data() + rtp.payload.size();
+    const uint8_t* packet_end = packet_data_.data() + packet_data_.size();
+
+    if (payload_end != packet_end) {
+        if (packet_pos_ < samples_per_packet_) {
+            pad_packet_();
+        }
+        return;
+    }
+
+    const size_t trim_size = rtp.payload.size() - payload_size;
+
+    rtp.payload = rtp.payload.range(0, payload_size);
+    packet_data_ = packet_data_.range(0, packet_data_.size() - trim_size);
+}
+
 void Packetizer::pad_packet_() {
     const size_t actual_payload_size = payload_encoder_.encoded_size(packet_pos_);
     roc_panic_if_not(actual_payload_size <= payload_size_);
@@ -157,7 +180,9 @@ packet::PacketPtr Packetizer::create_packet_() {
         return NULL;
     }
 
-    packet->set_data(data);
+    // data is attached to the packet in end_packet_(), after it is
+    // truncated to the actual payload size
+    packet_data_ = data;
 
     return packet;
 }
@@ -30,6 +30,11 @@ namespace audio {
 //! @remarks
 //!  Gets an audio stream, encodes samples to packets using an encoder, and
 //!  writes packets to a packet writer.
+//!
+//!  Packet buffer is allocated for the maximum encoded size. If the encoder
+//!  produces a smaller payload, the packet is truncated when the payload is
+//!  the last part of the packet. Otherwise, e.g. when an FEC footer follows
+//!  the payload, the packet keeps the fixed size, which is required by FEC.
 class Packetizer : public IWriter, public core::NonCopyable<> {
 public:
     //! Initialization.
@@ -66,6 +71,7 @@ private:
     bool begin_packet_();
     void end_packet_();
 
+    void shrink_packet_(size_t payload_size);
     void pad_packet_();
 
     packet::PacketPtr create_packet_();
@@ -84,6 +90,7 @@ private:
     const size_t payload_size_;
 
     packet::PacketPtr packet_;
+    core::Slice<uint8_t> packet_data_;
     size_t packet_pos_;
 
     const packet::source_t source_;
@@ -48,14 +48,18 @@ size_t PCMEncoder::write(const audio::sample_t* samples,
     return wr_samples;
 }
 
-void PCMEncoder::end() {
+size_t PCMEncoder::end() {
     if (!frame_data_) {
         roc_panic("pcm encoder: unpaired begin/end");
     }
 
+    const size_t size = funcs_.payload_size_from_samples(frame_pos_);
+
     frame_data_ = NULL;
     frame_size_ = 0;
     frame_pos_ = 0;
+
+    return size;
 }
 
 } // namespace audio
@@ -36,7 +36,7 @@ public:
     write(const sample_t* samples, size_t n_samples, packet::channel_mask_t channels);
 
     //! Finish encoding frame.
-    virtual void end();
+    virtual size_t end();
 
 private:
     const PCMFuncs& funcs_;
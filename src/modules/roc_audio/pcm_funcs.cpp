@@ -7,6 +7,7 @@
  */
 
 #include "roc_audio/pcm_funcs.h"
+#include "roc_audio/pcm_kernel.h"
 #include "roc_core/endian.h"
 
 namespace roc {
@@ -24,6 +25,16 @@ size_t pcm_payload_size_from_samples(size_t num_samples) {
     return num_samples * NumCh * sizeof(Sample);
 }
 
+// 24-bit big-endian signed integer.
+struct pcm_int24_t {
+    uint8_t bytes[3];
+};
+
+// 32-bit big-endian IEEE 754 float.
+struct pcm_float32_t {
+    uint8_t bytes[4];
+};
+
 template <class T> T pcm_encode_one_sample(sample_t);
 
 template <> int16_t inline pcm_encode_one_sample(float s) {
@@ -33,10 +44,78 @@ template <> int16_t inline pcm_encode_one_sample(float s) {
     return (int16_t)core::hton16((uint16_t)(int16_t)s);
 }
 
+template <> pcm_int24_t inline pcm_encode_one_sample(float s) {
+    s *= 8388608.0f;
+    s = std::min(s, +8388607.0f);
+    s = std::max(s, -8388608.0f);
+    const uint32_t v = (uint32_t)(int32_t)s;
+    pcm_int24_t ret;
+    ret.bytes[0] = uint8_t(v >> 16);
+    ret.bytes[1] = uint8_t(v >> 8);
+    ret.bytes[2] = uint8_t(v);
+    return ret;
+}
+
+template <> pcm_float32_t inline pcm_encode_one_sample(float s) {
+    uint32_t v;
+    memcpy(&v, &s, sizeof(v));
+    pcm_float32_t ret;
+    ret.bytes[0] = uint8_t(v >> 24);
+    ret.bytes[1] = uint8_t(v >> 16);
+    ret.bytes[2] = uint8_t(v >> 8);
+    ret.bytes[3] = uint8_t(v);
+    return ret;
+}
+
 inline float pcm_decode_one_sample(int16_t s) {
     return float((int16_t)core::ntoh16((uint16_t)s)) / 32768.0f;
 }
 
+inline float pcm_decode_one_sample(pcm_int24_t s) {
+    // place sign bit into bit 31 and shift back to sign-extend
+    const int32_t v = (int32_t)(((uint32_t)s.bytes[0] << 24)
+                                | ((uint32_t)s.bytes[1] << 16)
+                                | ((uint32_t)s.bytes[2] << 8))
+        >> 8;
+    return float(v) / 8388608.0f;
+}
+
+inline float pcm_decode_one_sample(pcm_float32_t s) {
+    const uint32_t v = ((uint32_t)s.bytes[0] << 24) | ((uint32_t)s.bytes[1] << 16)
+        | ((uint32_t)s.bytes[2] << 8) | (uint32_t)s.bytes[3];
+    float ret;
+    memcpy(&ret, &v, sizeof(ret));
+    return ret;
+}
+
+// Kernel is selected once, on first use.
+const PCMKernel* pcm_fast_kernel() {
+    static const PCMKernel* kernel = pcm_kernel(PCMKernel_Auto);
+    return kernel;
+}
+
+template <class Sample>
+void pcm_encode_contiguous(Sample* out, const sample_t* in, size_t n_samples) {
+    for (size_t n = 0; n < n_samples; n++) {
+        out[n] = pcm_encode_one_sample<Sample>(in[n]);
+    }
+}
+
+inline void pcm_encode_contiguous(int16_t* out, const sample_t* in, size_t n_samples) {
+    pcm_fast_kernel()->encode_int16(out, in, n_samples);
+}
+
+template <class Sample>
+void pcm_decode_contiguous(sample_t* out, const Sample* in, size_t n_samples) {
+    for (size_t n = 0; n < n_samples; n++) {
+        out[n] = pcm_decode_one_sample(in[n]);
+    }
+}
+
+inline void pcm_decode_contiguous(sample_t* out, const int16_t* in, size_t n_samples) {
+    pcm_fast_kernel()->decode_int16(out, in, n_samples);
+}
+
 template <class Sample, size_t NumCh>
 size_t pcm_encode_samples(void* out_data,
                           size_t out_size,
@@ -59,6 +138,12 @@ size_t pcm_encode_samples(void* out_data,
 
     Sample* out_samples = (Sample*)out_data + (off * NumCh);
 
+    // fast path: channels are the same, no remapping needed
+    if (in_chan_mask == out_chan_mask) {
+        pcm_encode_contiguous(out_samples, in_samples, in_n_samples * NumCh);
+        return in_n_samples;
+    }
+
     for (size_t ns = 0; ns < in_n_samples; ns++) {
         for (packet::channel_mask_t ch = 1; ch <= inout_chan_mask && ch != 0; ch <<= 1) {
             if (in_chan_mask & ch) {
@@ -68,7 +153,7 @@ size_t pcm_encode_samples(void* out_data,
                 in_samples++;
             } else {
                 if (out_chan_mask & ch) {
-                    *out_samples++ = 0;
+                    *out_samples++ = pcm_encode_one_sample<Sample>(0);
                 }
             }
         }
@@ -99,6 +184,12 @@ size_t pcm_decode_samples(const void* in_data,
 
     const Sample* in_samples = (const Sample*)in_data + (off * NumCh);
 
+    // fast path: channels are the same, no remapping needed
+    if (in_chan_mask == out_chan_mask) {
+        pcm_decode_contiguous(out_samples, in_samples, out_n_samples * NumCh);
+        return out_n_samples;
+    }
+
     for (size_t ns = 0; ns < out_n_samples; ns++) {
         for (packet::channel_mask_t ch = 1; ch <= inout_chan_mask && ch != 0; ch <<= 1) {
             sample_t s = 0;
@@ -130,5 +221,33 @@ const PCMFuncs PCM_int16_2ch = {
     pcm_decode_samples<int16_t, 2>,
 };
 
+const PCMFuncs PCM_int24_1ch = {
+    pcm_samples_from_payload_size<pcm_int24_t, 1>,
+    pcm_payload_size_from_samples<pcm_int24_t, 1>,
+    pcm_encode_samples<pcm_int24_t, 1>,
+    pcm_decode_samples<pcm_int24_t, 1>,
+};
+
+const PCMFuncs PCM_int24_2ch = {
+    pcm_samples_from_payload_size<pcm_int24_t, 2>,
+    pcm_payload_size_from_samples<pcm_int24_t, 2>,
+    pcm_encode_samples<pcm_int24_t, 2>,
+    pcm_decode_samples<pcm_int24_t, 2>,
+};
+
+const PCMFuncs PCM_float32_1ch = {
+    pcm_samples_from_payload_size<pcm_float32_t, 1>,
+    pcm_payload_size_from_samples<pcm_float32_t, 1>,
+    pcm_encode_samples<pcm_float32_t, 1>,
+    pcm_decode_samples<pcm_float32_t, 1>,
+};
+
+const PCMFuncs PCM_float32_2ch = {
+    pcm_samples_from_payload_size<pcm_float32_t, 2>,
+    pcm_payload_size_from_samples<pcm_float32_t, 2>,
+    pcm_encode_samples<pcm_float32_t, 2>,
+    pcm_decode_samples<pcm_float32_t, 2>,
+};
+
 } // namespace audio
 } // namespace roc
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/pcm_kernel.h"
+#include "roc_core/endian.h"
+#include "roc_core/panic.h"
+
+#ifdef ROC_TARGET_X86
+#include "roc_audio/pcm_kernel_x86.h"
+#include "roc_core/cpu_features.h"
+#endif // ROC_TARGET_X86
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+void generic_encode_int16(int16_t* out, const sample_t* in, size_t n_samples) {
+    for (size_t n = 0; n < n_samples; n++) {
+        float s = in[n] * 32768.0f;
+        s = std::min(s, +32767.0f);
+        s = std::max(s, -32768.0f);
+        out[n] = (int16_t)core::hton16((uint16_t)(int16_t)s);
+    }
+}
+
+void generic_decode_int16(sample_t* out, const int16_t* in, size_t n_samples) {
+    for (size_t n = 0; n < n_samples; n++) {
+        out[n] = float((int16_t)core::ntoh16((uint16_t)in[n])) / 32768.0f;
+    }
+}
+
+const PCMKernel GenericPCMKernel = {
+    PCMKernel_Generic,
+    "generic",
+    generic_encode_int16,
+    generic_decode_int16,
+};
+
+} // namespace
+
+const PCMKernel* pcm_kernel(PCMKernelType type) {
+    switch (type) {
+    case PCMKernel_Auto:
+#ifdef ROC_TARGET_X86
+        if (const PCMKernel* kernel = pcm_kernel(PCMKernel_AVX2)) {
+            return kernel;
+        }
+        if (const PCMKernel* kernel = pcm_kernel(PCMKernel_SSE2)) {
+            return kernel;
+        }
+#endif // ROC_TARGET_X86
+        return &GenericPCMKernel;
+
+    case PCMKernel_Generic:
+        return &GenericPCMKernel;
+
+    case PCMKernel_SSE2:
+#ifdef ROC_TARGET_X86
+        if (core::cpu_supports(core::CpuFeature_SSE2)) {
+            return &SSE2PCMKernel;
+        }
+#endif // ROC_TARGET_X86
+        return NULL;
+
+    case PCMKernel_AVX2:
+#ifdef ROC_TARGET_X86
+        if (core::cpu_supports(core::CpuFeature_AVX2)) {
+            return &AVX2PCMKernel;
+        }
+#endif // ROC_TARGET_X86
+        return NULL;
+    }
+
+    roc_panic("pcm kernel: unknown kernel type %d", (int)type);
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/pcm_kernel.h
+//! @brief PCM kernel.
+
+#ifndef ROC_AUDIO_PCM_KERNEL_H_
+#define ROC_AUDIO_PCM_KERNEL_H_
+
+#include "roc_audio/units.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! PCM kernel type.
+enum PCMKernelType {
+    //! Select the fastest kernel supported by the CPU.
+    PCMKernel_Auto,
+
+    //! Portable scalar implementation.
+    PCMKernel_Generic,
+
+    //! SSE2 implementation.
+    PCMKernel_SSE2,
+
+    //! AVX2 implementation.
+    PCMKernel_AVX2
+};
+
+//! PCM kernel.
+//! @remarks
+//!  Function table implementing conversion of contiguous runs of samples
+//!  between native and network format. Used by PCM functions when the
+//!  channel mask of the stream matches the channel mask of the payload.
+//!  All implementations produce identical results for finite samples.
+struct PCMKernel {
+    //! Kernel type.
+    PCMKernelType type;
+
+    //! Kernel name.
+    const char* name;
+
+    //! Encode samples to 16-bit big-endian integers.
+    //! @remarks
+    //!  Samples are scaled to [-32768; 32767] range, saturated, and
+    //!  truncated towards zero.
+    void (*encode_int16)(int16_t* out, const sample_t* in, size_t n_samples);
+
+    //! Decode samples from 16-bit big-endian integers.
+    void (*decode_int16)(sample_t* out, const int16_t* in, size_t n_samples);
+};
+
+//! Get PCM kernel.
+//! @returns
+//!  NULL if the given kernel is not supported by the build or by the CPU.
+//!  If @p type is PCMKernel_Auto, never returns NULL.
+const PCMKernel* pcm_kernel(PCMKernelType type);
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_PCM_KERNEL_H_
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/polynomial_resampler.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+// One in terms of Q0.32.
+const double FractOne = 4294967296.0;
+
+// Interpolate between s[0] and s[1].
+inline sample_t linear_interp(const sample_t* s, sample_t t) {
+    return s[0] + t * (s[1] - s[0]);
+}
+
+// Catmull-Rom cubic Hermite spline between s[1] and s[2].
+inline sample_t cubic_interp(const sample_t* s, sample_t t) {
+    const sample_t c1 = 0.5f * (s[2] - s[0]);
+    const sample_t c2 = s[0] - 2.5f * s[1] + 2.0f * s[2] - 0.5f * s[3];
+    const sample_t c3 = 0.5f * (s[3] - s[0]) + 1.5f * (s[1] - s[2]);
+
+    return ((c3 * t + c2) * t + c1) * t + s[1];
+}
+
+size_t num_before(ResamplerMethod method) {
+    return method == ResamplerMethod_Cubic ? 1 : 0;
+}
+
+size_t num_after(ResamplerMethod method) {
+    return method == ResamplerMethod_Cubic ? 2 : 1;
+}
+
+} // namespace
+
+PolynomialResampler::PolynomialResampler(core::IAllocator& allocator,
+                                         const ResamplerConfig& config,
+                                         packet::channel_mask_t channels,
+                                         size_t frame_size)
+    : method_(config.method)
+    , channels_num_(packet::num_channels(channels))
+    , frame_size_(frame_size)
+    , frame_size_ch_(channels_num_ ? frame_size / channels_num_ : 0)
+    , n_before_(num_before(method_))
+    , n_after_(num_after(method_))
+    , buffer_(allocator, channels_num_, frame_size_ch_, frame_size_ch_)
+    , out_frame_pos_(0)
+    , step_int_(0)
+    , step_fract_(0)
+    , fract_(0)
+    , valid_(false) {
+    if (method_ != ResamplerMethod_Linear && method_ != ResamplerMethod_Cubic) {
+        roc_log(LogError, "polynomial resampler: unsupported method: method=%d",
+                (int)method_);
+        return;
+    }
+
+    if (channels_num_ < 1 || frame_size_ != frame_size_ch_ * channels_num_
+        || frame_size_ch_ < n_after_ + 1) {
+        roc_log(LogError,
+                "polynomial resampler: invalid frame size:"
+                " frame_size=%lu num_channels=%lu",
+                (unsigned long)frame_size_, (unsigned long)channels_num_);
+        return;
+    }
+
+    if (!buffer_.valid()) {
+        return;
+    }
+
+    if (!set_scaling(1.0f)) {
+        return;
+    }
+
+    roc_log(LogDebug,
+            "polynomial resampler: initializing: "
+            "method=%s frame_size=%lu channels_num=%lu",
+            method_ == ResamplerMethod_Cubic ? "cubic" : "linear",
+            (unsigned long)frame_size_, (unsigned long)channels_num_);
+
+    valid_ = true;
+}
+
+bool PolynomialResampler::valid() const {
+    return valid_;
+}
+
+bool PolynomialResampler::set_scaling(float new_scaling) {
+    // Input buffer should be able to hold all samples skipped by one step.
+    if (new_scaling <= 0 || new_scaling >= frame_size_ch_) {
+        roc_log(LogError,
+                "polynomial resampler: scaling does not fit frame size:"
+                " frame_size=%lu scaling=%.5f",
+                (unsigned long)frame_size_, (double)new_scaling);
+        return false;
+    }
+
+    const double step = (double)new_scaling;
+
+    step_int_ = (size_t)step;
+    step_fract_ = (uint32_t)((step - (double)step_int_) * FractOne);
+
+    return true;
+}
+
+bool PolynomialResampler::resample_buff(Frame& out) {
+    roc_panic_if_not(valid_);
+
+    const size_t channel_stride = buffer_.channel_stride();
+
+    sample_t* out_data = out.data();
+
+    for (; out_frame_pos_ < out.size(); out_frame_pos_ += channels_num_) {
+        const uint32_t next_fract = fract_ + step_fract_;
+        const size_t n_advance = step_int_ + (next_fract < fract_ ? 1 : 0);
+
+        if (buffer_.available() < n_after_ + 1 || buffer_.available() < n_advance) {
+            return false;
+        }
+
+        const sample_t t = (sample_t)fract_ * (sample_t)(1.0 / FractOne);
+        const sample_t* samples = buffer_.window(n_before_);
+
+        if (method_ == ResamplerMethod_Cubic) {
+            for (size_t channel = 0; channel < channels_num_; ++channel) {
+                out_data[out_frame_pos_ + channel] = cubic_interp(samples, t);
+                samples += channel_stride;
+            }
+        } else {
+            for (size_t channel = 0; channel < channels_num_; ++channel) {
+                out_data[out_frame_pos_ + channel] = linear_interp(samples, t);
+                samples += channel_stride;
+            }
+        }
+
+        fract_ = next_fract;
+        buffer_.advance(n_advance);
+    }
+
+    out_frame_pos_ = 0;
+    return true;
+}
+
+size_t PolynomialResampler::push_input(const sample_t* samples, size_t n_samples) {
+    roc_panic_if_not(valid_);
+
+    return buffer_.write(samples, n_samples);
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/polynomial_resampler.h
+//! @brief Polynomial resampler.
+
+#ifndef ROC_AUDIO_POLYNOMIAL_RESAMPLER_H_
+#define ROC_AUDIO_POLYNOMIAL_RESAMPLER_H_
+
+#include "roc_audio/frame.h"
+#include "roc_audio/iresampler.h"
+#include "roc_audio/resampler.h"
+#include "roc_audio/resampler_buffer.h"
+#include "roc_audio/units.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_packet/units.h"
+
+namespace roc {
+namespace audio {
+
+//! Resamples audio stream using linear or cubic interpolation.
+//! @remarks
+//!  Every output sample is interpolated from two (linear) or four (cubic Hermite)
+//!  nearest input samples. There is no anti-aliasing filter, so the quality is
+//!  much lower than with sinc interpolation, but it takes only a few operations
+//!  per sample. It is suitable for compensating small clock drift, when the
+//!  scaling factor is close to 1.
+class PolynomialResampler : public IResampler, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  @p config method should be ResamplerMethod_Linear or ResamplerMethod_Cubic.
+    PolynomialResampler(core::IAllocator& allocator,
+                        const ResamplerConfig& config,
+                        packet::channel_mask_t channels,
+                        size_t frame_size);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Set new resample factor.
+    virtual bool set_scaling(float);
+
+    //! Resamples the whole output frame.
+    virtual bool resample_buff(Frame& out);
+
+    //! Push interleaved input samples.
+    virtual size_t push_input(const sample_t* samples, size_t n_samples);
+
+private:
+    const ResamplerMethod method_;
+
+    const size_t channels_num_;
+
+    const size_t frame_size_;
+    const size_t frame_size_ch_;
+
+    // number of input samples used before and after the current position
+    const size_t n_before_;
+    const size_t n_after_;
+
+    // input samples, see Resampler
+    ResamplerBuffer buffer_;
+
+    size_t out_frame_pos_;
+
+    // scaling factor in Q32.32
+    size_t step_int_;
+    uint32_t step_fract_;
+
+    // position of output sample relative to the current position of
+    // input buffer, in Q0.32
+    uint32_t fract_;
+
+    bool valid_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_POLYNOMIAL_RESAMPLER_H_
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/polyphase_resampler.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+// Maximum relative difference between requested scaling factor and its
+// rational approximation.
+const double RatioTolerance = 1e-6;
+
+// Find ratio num / den equal to x with at most max_den denominator,
+// using continued fraction expansion.
+bool find_ratio(double x, size_t max_den, size_t& num, size_t& den) {
+    size_t h0 = 0, h1 = 1;
+    size_t k0 = 1, k1 = 0;
+
+    double r = x;
+
+    for (size_t i = 0; i < 64; i++) {
+        const size_t a = (size_t)std::floor(r);
+
+        const size_t h2 = a * h1 + h0;
+        const size_t k2 = a * k1 + k0;
+
+        if (k2 > max_den) {
+            break;
+        }
+
+        h0 = h1;
+        h1 = h2;
+        k0 = k1;
+        k1 = k2;
+
+        if (std::fabs((double)h1 / (double)k1 - x) <= x * RatioTolerance) {
+            num = h1;
+            den = k1;
+            return true;
+        }
+
+        const double fract = r - (double)a;
+        if (fract < 1e-12) {
+            break;
+        }
+        r = 1.0 / fract;
+    }
+
+    return false;
+}
+
+} // namespace
+
+PolyphaseResampler::PolyphaseResampler(core::IAllocator& allocator,
+                                       const ResamplerConfig& config,
+                                       packet::channel_mask_t channels,
+                                       size_t frame_size)
+    : kernel_(resampler_kernel(config.kernel))
+    , channels_num_(packet::num_channels(channels))
+    , frame_size_(frame_size)
+    , frame_size_ch_(channels_num_ ? frame_size / channels_num_ : 0)
+    , window_size_(config.window_size)
+    , cutoff_freq_(0.9)
+    , filter_(allocator)
+    , n_phases_(0)
+    , n_taps_(0)
+    , buffer_(allocator, channels_num_, frame_size_ch_, frame_size_ch_)
+    , out_frame_pos_(0)
+    , step_int_(0)
+    , step_fract_(0)
+    , phase_(0)
+    , valid_(false) {
+    if (channels_num_ < 1 || frame_size_ != frame_size_ch_ * channels_num_) {
+        roc_log(LogError,
+                "polyphase resampler: invalid frame size:"
+                " frame_size=%lu num_channels=%lu",
+                (unsigned long)frame_size_, (unsigned long)channels_num_);
+        return;
+    }
+
+    if (!kernel_) {
+        roc_log(LogError,
+                "polyphase resampler: requested kernel is not supported by cpu");
+        return;
+    }
+
+    if (!buffer_.valid()) {
+        return;
+    }
+
+    if (!set_scaling(1.0f)) {
+        return;
+    }
+
+    roc_log(LogDebug,
+            "polyphase resampler: initializing: "
+            "window_size=%lu frame_size=%lu channels_num=%lu kernel=%s",
+            (unsigned long)window_size_, (unsigned long)frame_size_,
+            (unsigned long)channels_num_, kernel_->name);
+
+    valid_ = true;
+}
+
+bool PolyphaseResampler::valid() const {
+    return valid_;
+}
+
+bool PolyphaseResampler::set_scaling(float new_scaling) {
+    size_t num = 0, den = 0;
+    if (new_scaling <= 0 || !find_ratio(new_scaling, MaxPhases, num, den)) {
+        roc_log(LogDebug,
+                "polyphase resampler: scaling can't be represented as a ratio:"
+                " scaling=%.5f max_phases=%lu",
+                (double)new_scaling, (unsigned long)MaxPhases);
+        return false;
+    }
+
+    if (den == n_phases_ && num == step_int_ * n_phases_ + step_fract_) {
+        return true;
+    }
+
+    // Same filter as in Resampler: in case of downsampling, cutoff frequency
+    // and gain are decreased by the scaling factor, and the window is widened.
+    const double ratio = (double)num / (double)den;
+    const double stretch = ratio > 1 ? ratio : 1;
+    const double sinc_step = cutoff_freq_ / stretch;
+
+    const size_t half_taps =
+        (size_t)std::ceil((double)window_size_ / cutoff_freq_ * stretch);
+
+    if (half_taps > frame_size_ch_) {
+        roc_log(LogError,
+                "polyphase resampler: scaling does not fit frame size:"
+                " window_size=%lu frame_size=%lu scaling=%.5f",
+                (unsigned long)window_size_, (unsigned long)frame_size_,
+                (double)new_scaling);
+        return false;
+    }
+
+    if (!fill_filter_(den, half_taps, sinc_step, stretch)) {
+        return false;
+    }
+
+    roc_log(LogDebug,
+            "polyphase resampler: setting scaling: scaling=%.5f ratio=%lu/%lu taps=%lu",
+            (double)new_scaling, (unsigned long)num, (unsigned long)den,
+            (unsigned long)n_taps_);
+
+    step_int_ = num / den;
+    step_fract_ = num % den;
+
+    phase_ = 0;
+
+    return true;
+}
+
+bool PolyphaseResampler::resample_buff(Frame& out) {
+    roc_panic_if_not(valid_);
+
+    const size_t channel_stride = buffer_.channel_stride();
+    const size_t half_taps = n_taps_ / 2;
+
+    sample_t* out_data = out.data();
+
+    for (; out_frame_pos_ < out.size(); out_frame_pos_ += channels_num_) {
+        if (buffer_.available() < half_taps + 1) {
+            return false;
+        }
+
+        const sample_t* coeffs = &filter_[0] + phase_ * n_taps_;
+        const sample_t* samples = buffer_.window(half_taps - 1);
+
+        for (size_t channel = 0; channel < channels_num_; ++channel) {
+            out_data[out_frame_pos_ + channel] =
+                kernel_->convolve(coeffs, samples, 1, n_taps_);
+            samples += channel_stride;
+        }
+
+        size_t n_advance = step_int_;
+        phase_ += step_fract_;
+        if (phase_ >= n_phases_) {
+            phase_ -= n_phases_;
+            n_advance++;
+        }
+
+        buffer_.advance(n_advance);
+    }
+
+    out_frame_pos_ = 0;
+    return true;
+}
+
+size_t PolyphaseResampler::push_input(const sample_t* samples, size_t n_samples) {
+    roc_panic_if_not(valid_);
+
+    return buffer_.write(samples, n_samples);
+}
+
+bool PolyphaseResampler::fill_filter_(size_t n_phases,
+                                      size_t half_taps,
+                                      double sinc_step,
+                                      double divisor) {
+    const size_t n_taps = half_taps * 2;
+
+    if (!filter_.resize(n_phases * n_taps)) {
+        roc_log(LogError, "polyphase resampler: can't allocate filter");
+        return false;
+    }
+
+    // Phase P computes output sample at position (I + P / n_phases), where I is
+    // index of an input sample. Tap K is applied to input sample (I + 1 - half_taps
+    // + K). Coefficients are values of Hamming windowed sinc, the same as in the
+    // Resampler sinc table.
+    for (size_t p = 0; p < n_phases; p++) {
+        for (size_t k = 0; k < n_taps; k++) {
+            const double dist = (double)k + 1 - (double)half_taps - (double)p / n_phases;
+            const double t = std::fabs(dist) * sinc_step;
+
+            double h = 0;
+            if (t < (double)window_size_) {
+                const double window =
+                    0.54 + 0.46 * std::cos(M_PI * t / (double)window_size_);
+                h = t < 1e-9 ? 1.0 : std::sin(M_PI * t) / (M_PI * t) * window;
+            }
+
+            filter_[p * n_taps + k] = (sample_t)(h / divisor);
+        }
+    }
+
+    n_phases_ = n_phases;
+    n_taps_ = n_taps;
+
+    return true;
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/polyphase_resampler.h
+//! @brief Polyphase resampler.
+
+#ifndef ROC_AUDIO_POLYPHASE_RESAMPLER_H_
+#define ROC_AUDIO_POLYPHASE_RESAMPLER_H_
+
+#include "roc_audio/frame.h"
+#include "roc_audio/iresampler.h"
+#include "roc_audio/resampler.h"
+#include "roc_audio/resampler_buffer.h"
+#include "roc_audio/resampler_kernel.h"
+#include "roc_audio/units.h"
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_packet/units.h"
+
+namespace roc {
+namespace audio {
+
+//! Resamples audio stream with constant rational factor.
+//! @remarks
+//!  Scaling factor is represented as a ratio M / L, and the filter is
+//!  precomputed for all L phases when the factor is set, so resampling
+//!  doesn't need to interpolate sinc table for every output sample.
+//!  Changing the factor recomputes the filter and may allocate memory,
+//!  so this resampler is suitable only when the factor never changes;
+//!  use Resampler otherwise.
+class PolyphaseResampler : public IResampler, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    PolyphaseResampler(core::IAllocator& allocator,
+                       const ResamplerConfig& config,
+                       packet::channel_mask_t channels,
+                       size_t frame_size);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Set new resample factor.
+    //! @returns
+    //!  false if the factor can't be represented as a ratio with at most
+    //!  MaxPhases phases, or the filter doesn't fit frame size.
+    virtual bool set_scaling(float);
+
+    //! Resamples the whole output frame.
+    virtual bool resample_buff(Frame& out);
+
+    //! Push interleaved input samples.
+    virtual size_t push_input(const sample_t* samples, size_t n_samples);
+
+    //! Maximum number of filter phases.
+    enum { MaxPhases = 1024 };
+
+private:
+    bool
+    fill_filter_(size_t n_phases, size_t half_taps, double sinc_step, double divisor);
+
+    const ResamplerKernel* kernel_;
+
+    const size_t channels_num_;
+
+    const size_t frame_size_;
+    const size_t frame_size_ch_;
+
+    const size_t window_size_;
+    const double cutoff_freq_;
+
+    // filter coefficients, n_phases_ rows of n_taps_ coefficients
+    core::Array<sample_t> filter_;
+    size_t n_phases_;
+    size_t n_taps_;
+
+    // input samples, see Resampler
+    ResamplerBuffer buffer_;
+
+    size_t out_frame_pos_;
+
+    // scaling factor is (step_int_ * n_phases_ + step_fract_) / n_phases_
+    size_t step_int_;
+    size_t step_fract_;
+
+    // position of output sample relative to the current position of
+    // input buffer, in 1 / n_phases_ units
+    size_t phase_;
+
+    bool valid_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_POLYPHASE_RESAMPLER_H_
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/prefetch_reader.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+PrefetchReader::PrefetchReader(IReader& reader,
+                               core::BufferPool<sample_t>& buffer_pool,
+                               size_t frame_size)
+    : reader_(reader)
+    , buffer_flags_(0)
+    , prefetched_(false)
+    , valid_(false) {
+    buffer_ = new (buffer_pool) core::Buffer<sample_t>(buffer_pool);
+    if (!buffer_) {
+        roc_log(LogError, "prefetch reader: can't allocate buffer");
+        return;
+    }
+
+    if (buffer_.capacity() < frame_size) {
+        roc_log(LogError, "prefetch reader: allocated buffer is too small");
+        return;
+    }
+
+    valid_ = true;
+}
+
+bool PrefetchReader::valid() const {
+    return valid_;
+}
+
+void PrefetchReader::prefetch(size_t size) {
+    roc_panic_if_not(valid_);
+
+    if (prefetched_) {
+        roc_panic("prefetch reader: previous frame was not read");
+    }
+
+    if (size > buffer_.capacity()) {
+        roc_panic("prefetch reader: frame is too large: size=%lu max=%lu",
+                  (unsigned long)size, (unsigned long)buffer_.capacity());
+    }
+
+    buffer_.resize(size);
+
+    Frame frame(buffer_.data(), buffer_.size());
+    reader_.read(frame);
+
+    buffer_flags_ = frame.flags();
+    prefetched_ = true;
+}
+
+void PrefetchReader::read(Frame& frame) {
+    roc_panic_if_not(valid_);
+
+    if (!prefetched_) {
+        reader_.read(frame);
+        return;
+    }
+
+    if (frame.size() != buffer_.size()) {
+        roc_panic("prefetch reader: unexpected frame size: prefetched=%lu requested=%lu",
+                  (unsigned long)buffer_.size(), (unsigned long)frame.size());
+    }
+
+    memcpy(frame.data(), buffer_.data(), buffer_.size() * sizeof(sample_t));
+    frame.set_flags(buffer_flags_);
+
+    prefetched_ = false;
+}
+
+} // namespace audio
+} // namespace roc
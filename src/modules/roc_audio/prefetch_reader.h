@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/prefetch_reader.h
+//! @brief Prefetch reader.
+
+#ifndef ROC_AUDIO_PREFETCH_READER_H_
+#define ROC_AUDIO_PREFETCH_READER_H_
+
+#include "roc_audio/frame.h"
+#include "roc_audio/ireader.h"
+#include "roc_audio/units.h"
+#include "roc_core/buffer_pool.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Reads frame from underlying reader in advance.
+//! @remarks
+//!  Allows to read frame in one thread, e.g. in a worker thread, and then
+//!  return it from read() in another thread.
+class PrefetchReader : public IReader, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - @p reader specifies input audio stream
+    //!  - @p buffer_pool is used to allocate buffer for prefetched frame
+    //!  - @p frame_size is maximum number of samples to prefetch
+    PrefetchReader(IReader& reader,
+                   core::BufferPool<sample_t>& buffer_pool,
+                   size_t frame_size);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Read frame of given size from underlying reader and store it.
+    //! @remarks
+    //!  Next read() should request the same number of samples.
+    void prefetch(size_t size);
+
+    //! Read audio frame.
+    //! @remarks
+    //!  Returns prefetched frame if there is one, or reads underlying reader
+    //!  otherwise.
+    virtual void read(Frame&);
+
+private:
+    IReader& reader_;
+
+    core::Slice<sample_t> buffer_;
+    unsigned buffer_flags_;
+    bool prefetched_;
+
+    bool valid_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_PREFETCH_READER_H_
@@ -7,6 +7,7 @@
  */
 
 #include "roc_audio/resampler.h"
+#include "roc_audio/sinc_table_cache.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 #include "roc_core/stddefs.h"
@@ -16,48 +17,36 @@ namespace audio {
 
 namespace {
 
-//! Fixed point type Q8.24 for realizing computations of curr_frame_ in fixed point
-//! arithmetic. Sometimes this computations requires ceil(...) and floor(...) and
-//! it is very CPU-time hungry in floating point variant on x86.
-typedef uint32_t fixedpoint_t;
+// Fixed point type Q32.32 for time positions and steps. Computations of window
+// bounds require ceil(...) and floor(...), which are CPU-time hungry in floating
+// point on x86. 32 integer bits allow any reasonable frame size, and 32 fractional
+// bits keep the scaling factor precise enough for long-running sessions.
+typedef uint64_t fixedpoint_t;
 
-// Signed version of fixedpoint_t.
-typedef int32_t signed_fixedpoint_t;
+// Fixed point type for sinc table positions. Number of fractional bits depends
+// on window size, see Resampler::sinc_fract_bits_. Kept 32-bit so that kernels
+// can process more positions per vector register.
+typedef uint32_t sinc_fixedpoint_t;
 
-const uint32_t INTEGER_PART_MASK = 0xFFF00000;
-const uint32_t FRACT_PART_MASK = 0x000FFFFF;
-const uint32_t FRACT_BIT_COUNT = 20;
+const fixedpoint_t FRACT_PART_MASK = 0xFFFFFFFF;
+const size_t FRACT_BIT_COUNT = 32;
 
-// One in terms of Q8.24.
-const fixedpoint_t qt_one = 1 << FRACT_BIT_COUNT;
+// One in terms of Q32.32.
+const fixedpoint_t qt_one = (fixedpoint_t)1 << FRACT_BIT_COUNT;
 
 // Convert float to fixed-point.
-inline fixedpoint_t float_to_fixedpoint(const float t) {
-    return (fixedpoint_t)(t * (float)qt_one);
+inline fixedpoint_t float_to_fixedpoint(const double t) {
+    return (fixedpoint_t)(t * (double)qt_one);
 }
 
 inline size_t fixedpoint_to_size(const fixedpoint_t t) {
-    return t >> FRACT_BIT_COUNT;
+    return (size_t)(t >> FRACT_BIT_COUNT);
 }
 
-// Rounds x (Q8.24) upward.
-inline fixedpoint_t qceil(const fixedpoint_t x) {
-    if ((x & FRACT_PART_MASK) == 0) {
-        return x & INTEGER_PART_MASK;
-    } else {
-        return (x & INTEGER_PART_MASK) + qt_one;
-    }
-}
-
-// Rounds x (Q8.24) downward.
-inline fixedpoint_t qfloor(const fixedpoint_t x) {
-    // Just remove fractional part.
-    return x & INTEGER_PART_MASK;
-}
-
-// Returns fractional part of x in f32.
-inline float fractional(const fixedpoint_t x) {
-    return (float)(x & FRACT_PART_MASK) * ((float)1. / (float)qt_one);
+// Returns fractional part of sinc table position in f32.
+inline float sinc_fractional(const sinc_fixedpoint_t x, size_t fract_bits) {
+    const sinc_fixedpoint_t mask = ((sinc_fixedpoint_t)1 << fract_bits) - 1;
+    return (float)(x & mask) * ((float)1. / (float)((uint64_t)1 << fract_bits));
 }
 
 // Returns log2(n) assuming that n is a power of two.
@@ -70,6 +59,16 @@ inline size_t calc_bits(size_t n) {
     return c;
 }
 
+// Returns number of bits needed to represent n.
+inline size_t calc_width(size_t n) {
+    size_t c = 0;
+    while (n != 0) {
+        n >>= 1;
+        c++;
+    }
+    return c;
+}
+
 } // namespace
 
 Resampler::Resampler(core::IAllocator& allocator,
@@ -78,42 +77,62 @@ Resampler::Resampler(core::IAllocator& allocator,
                      size_t frame_size)
     : channel_mask_(channels)
     , channels_num_(packet::num_channels(channel_mask_))
-    , prev_frame_(NULL)
-    , curr_frame_(NULL)
-    , next_frame_(NULL)
     , out_frame_pos_(0)
     , scaling_(1.0)
     , frame_size_(frame_size)
     , frame_size_ch_(channels_num_ ? frame_size / channels_num_ : 0)
     , window_size_(config.window_size)
-    , qt_half_sinc_window_size_(float_to_fixedpoint(window_size_))
     , window_interp_(config.window_interp)
     , window_interp_bits_(calc_bits(config.window_interp))
-    , sinc_table_(allocator)
+    , sinc_fract_bits_(sizeof(sinc_fixedpoint_t) * 8 - calc_width(window_size_) - 1)
     , sinc_table_ptr_(NULL)
-    , qt_half_window_size_(float_to_fixedpoint((float)window_size_ / scaling_))
-    , qt_epsilon_(float_to_fixedpoint(5e-8f))
-    , qt_frame_size_(fixedpoint_t(frame_size_ch_ << FRACT_BIT_COUNT))
-    , qt_sample_(float_to_fixedpoint(0))
+    , kernel_(resampler_kernel(config.kernel))
+    , window_(allocator)
+    , buffer_(allocator, channels_num_, frame_size_ch_, frame_size_ch_)
+    , qt_half_window_size_(0)
+    , qt_sample_(0)
     , qt_dt_(0)
+    , qt_sinc_step_(0)
     , cutoff_freq_(0.9f)
     , valid_(false) {
     if (!check_config_()) {
         return;
     }
-    if (!fill_sinc_()) {
+    sinc_table_ptr_ = SincTableCache::instance().acquire(window_size_, window_interp_);
+    if (!sinc_table_ptr_) {
+        roc_log(LogError, "resampler: can't acquire sinc table");
+        return;
+    }
+
+    // Half window can't be longer than frame.
+    if (!window_.resize(frame_size_ch_ * 2)) {
+        roc_log(LogError, "resampler: can't allocate window");
+        return;
+    }
+
+    if (!buffer_.valid()) {
+        return;
+    }
+
+    if (!set_scaling(scaling_)) {
         return;
     }
 
     roc_log(LogDebug,
             "resampler: initializing: "
-            "window_interp=%lu window_size=%lu frame_size=%lu channels_num=%lu",
+            "window_interp=%lu window_size=%lu frame_size=%lu channels_num=%lu kernel=%s",
             (unsigned long)window_interp_, (unsigned long)window_size_,
-            (unsigned long)frame_size_, (unsigned long)channels_num_);
+            (unsigned long)frame_size_, (unsigned long)channels_num_, kernel_->name);
 
     valid_ = true;
 }
 
+Resampler::~Resampler() {
+    if (sinc_table_ptr_) {
+        SincTableCache::instance().release(sinc_table_ptr_);
+    }
+}
+
 bool Resampler::valid() const {
     return valid_;
 }
@@ -133,65 +152,78 @@ bool Resampler::set_scaling(float new_scaling) {
     // In case of upscaling one should properly shift the edge frequency
     // of the digital filter. In both cases it's sensible to decrease the
     // edge frequency to leave some.
-    if (new_scaling > 1.0f) {
-        const fixedpoint_t new_qt_half_window_len =
-            float_to_fixedpoint((float)window_size_ / cutoff_freq_ * new_scaling);
-
-        // Check that resample_() will not go out of bounds.
-        // Otherwise -- deny changes.
-        const bool out_of_bounds =
-            fixedpoint_to_size(qceil(qt_frame_size_ - new_qt_half_window_len))
-                > frame_size_ch_
-            || fixedpoint_to_size(qfloor(new_qt_half_window_len)) + 1 > frame_size_ch_;
-
-        if (out_of_bounds) {
-            roc_log(LogError,
-                    "resampler: scaling does not fit window size:"
-                    " window_size=%lu frame_size=%lu scaling=%.5f",
-                    (unsigned long)window_size_, (unsigned long)frame_size_,
-                    (double)new_scaling);
-            return false;
-        }
+    const float stretch = new_scaling > 1.0f ? new_scaling : 1.0f;
+
+    // Sinc step is rounded to the sinc table precision, so that fractional part
+    // of sinc table position is the same for all window taps on each side.
+    const size_t new_sinc_step_interp = (size_t)(
+        (double)cutoff_freq_ / (double)stretch * (double)window_interp_ + 0.5);
+
+    const fixedpoint_t new_qt_half_window_len = float_to_fixedpoint(
+        (double)(window_size_ * window_interp_) / (double)new_sinc_step_interp);
 
-        qt_sinc_step_ = float_to_fixedpoint(cutoff_freq_ / new_scaling);
-        qt_half_window_size_ = new_qt_half_window_len;
-    } else {
-        qt_sinc_step_ = float_to_fixedpoint(cutoff_freq_);
-        qt_half_window_size_ = float_to_fixedpoint((float)window_size_ / cutoff_freq_);
+    // Check that input buffer keeps enough samples before and after
+    // the output sample position. Otherwise -- deny changes.
+    if (new_sinc_step_interp == 0
+        || fixedpoint_to_size(new_qt_half_window_len) + 1 > frame_size_ch_) {
+        roc_log(LogError,
+                "resampler: scaling does not fit window size:"
+                " window_size=%lu frame_size=%lu scaling=%.5f",
+                (unsigned long)window_size_, (unsigned long)frame_size_,
+                (double)new_scaling);
+        return false;
     }
 
+    qt_sinc_step_ = sinc_fixedpoint_t(new_sinc_step_interp)
+        << (sinc_fract_bits_ - window_interp_bits_);
+    qt_half_window_size_ = new_qt_half_window_len;
+    qt_dt_ = float_to_fixedpoint((double)new_scaling);
+
     scaling_ = new_scaling;
 
     return true;
 }
 
 bool Resampler::resample_buff(Frame& out) {
-    roc_panic_if(!prev_frame_);
-    roc_panic_if(!curr_frame_);
-    roc_panic_if(!next_frame_);
+    roc_panic_if_not(valid_);
+
+    const size_t channel_stride = buffer_.channel_stride();
+
+    sample_t* out_data = out.data();
 
     for (; out_frame_pos_ < out.size(); out_frame_pos_ += channels_num_) {
-        if (qt_sample_ >= qt_frame_size_) {
+        size_t n_before = 0;
+        size_t n_taps = 0;
+        if (!compute_window_(n_before, n_taps)) {
             return false;
         }
 
-        if ((qt_sample_ & FRACT_PART_MASK) < qt_epsilon_) {
-            qt_sample_ &= INTEGER_PART_MASK;
-        } else if ((qt_one - (qt_sample_ & FRACT_PART_MASK)) < qt_epsilon_) {
-            qt_sample_ &= INTEGER_PART_MASK;
-            qt_sample_ += qt_one;
-        }
+        const sample_t* samples = buffer_.window(n_before);
 
-        sample_t* out_data = out.data();
         for (size_t channel = 0; channel < channels_num_; ++channel) {
-            out_data[out_frame_pos_ + channel] = resample_(channel);
+            out_data[out_frame_pos_ + channel] =
+                kernel_->convolve(&window_[0], samples, 1, n_taps);
+            samples += channel_stride;
         }
+
+        // Move integer part of the time position to the input buffer.
         qt_sample_ += qt_dt_;
+
+        const size_t n_advance = fixedpoint_to_size(qt_sample_);
+        qt_sample_ &= FRACT_PART_MASK;
+
+        buffer_.advance(n_advance);
     }
     out_frame_pos_ = 0;
     return true;
 }
 
+size_t Resampler::push_input(const sample_t* samples, size_t n_samples) {
+    roc_panic_if_not(valid_);
+
+    return buffer_.write(samples, n_samples);
+}
+
 bool Resampler::check_config_() const {
     if (channels_num_ < 1) {
         roc_log(LogError, "resampler: invalid num_channels: num_channels=%lu",
@@ -207,14 +239,12 @@ bool Resampler::check_config_() const {
         return false;
     }
 
-    const size_t max_frame_size =
-        (((fixedpoint_t)(signed_fixedpoint_t)-1 >> FRACT_BIT_COUNT) + 1) * channels_num_;
-    if (frame_size_ > max_frame_size) {
+    if ((fixedpoint_t)frame_size_ch_ > (FRACT_PART_MASK >> 1)) {
         roc_log(LogError,
                 "resampler: frame_size is too much: "
                 "max_frame_size=%lu frame_size=%lu num_channels=%lu",
-                (unsigned long)max_frame_size, (unsigned long)frame_size_,
-                (unsigned long)channels_num_);
+                (unsigned long)(FRACT_PART_MASK >> 1) * channels_num_,
+                (unsigned long)frame_size_, (unsigned long)channels_num_);
         return false;
     }
 
@@ -225,173 +255,76 @@ bool Resampler::check_config_() const {
         return false;
     }
 
-    return true;
-}
-
-void Resampler::renew_buffers(core::Slice<sample_t>& prev,
-                              core::Slice<sample_t>& cur,
-                              core::Slice<sample_t>& next) {
-    roc_panic_if(window_size_ * scaling_ >= frame_size_ch_);
-
-    roc_panic_if(prev.size() != frame_size_);
-    roc_panic_if(cur.size() != frame_size_);
-    roc_panic_if(next.size() != frame_size_);
-
-    if (qt_sample_ >= qt_frame_size_) {
-        qt_sample_ -= qt_frame_size_;
-    }
-
-    // scaling_ may change every frame so it have to be smooth
-    qt_dt_ = float_to_fixedpoint(scaling_);
-
-    prev_frame_ = prev.data();
-    curr_frame_ = cur.data();
-    next_frame_ = next.data();
-}
-
-bool Resampler::fill_sinc_() {
-    if (!sinc_table_.resize(window_size_ * window_interp_ + 2)) {
-        roc_log(LogError, "resampler: can't allocate sinc table");
+    // Sinc table position should keep window size in integer part and
+    // window_interp in fractional part.
+    if (calc_width(window_size_) + 1 + window_interp_bits_
+        > sizeof(sinc_fixedpoint_t) * 8) {
+        roc_log(LogError,
+                "resampler: window_size and window_interp are too much:"
+                " window_size=%lu window_interp=%lu",
+                (unsigned long)window_size_, (unsigned long)window_interp_);
         return false;
     }
 
-    const double sinc_step = 1.0 / (double)window_interp_;
-    double sinc_t = sinc_step;
-
-    sinc_table_[0] = 1.0f;
-    for (size_t i = 1; i < sinc_table_.size(); ++i) {
-        const double window = 0.54
-            - 0.46
-                * std::cos(2 * M_PI
-                           * ((double)(i - 1) / 2.0 / (double)sinc_table_.size() + 0.5));
-        sinc_table_[i] = (float)(std::sin(M_PI * sinc_t) / M_PI / sinc_t * window);
-        sinc_t += sinc_step;
+    if (!kernel_) {
+        roc_log(LogError, "resampler: requested kernel is not supported by cpu");
+        return false;
     }
-    sinc_table_[sinc_table_.size() - 2] = 0;
-    sinc_table_[sinc_table_.size() - 1] = 0;
-
-    sinc_table_ptr_ = &sinc_table_[0];
 
     return true;
 }
 
-// Computes sinc value in x position using linear interpolation between
-// table values from sinc_table.h
-//
-// During going through input signal window only integer part of argument changes,
-// that's why there are two arguments in this function: integer part and fractional
-// part of time coordinate.
-sample_t Resampler::sinc_(const fixedpoint_t x, const float fract_x) {
-    const size_t index = (x >> (FRACT_BIT_COUNT - window_interp_bits_));
-
-    const sample_t hl = sinc_table_ptr_[index];     // table index smaller than x
-    const sample_t hh = sinc_table_ptr_[index + 1]; // table index next to x
-
-    const sample_t result = hl + fract_x * (hh - hl);
+bool Resampler::compute_window_(size_t& n_before, size_t& n_taps) {
+    // Number of window taps at and before the output sample position, and
+    // number of taps after it. Window covers input samples within half window
+    // from the output sample position.
+    const size_t n_left = fixedpoint_to_size(qt_half_window_size_ - qt_sample_) + 1;
+    const size_t n_right = fixedpoint_to_size(qt_half_window_size_ + qt_sample_);
 
-    return scaling_ > 1.0f ? result / scaling_ : result;
-}
+    if (buffer_.available() < n_right + 1) {
+        return false;
+    }
 
-sample_t Resampler::resample_(const size_t channel_offset) {
-    // Index of first input sample in window.
-    size_t ind_begin_prev;
-
-    // Window lasts till that index.
-    const size_t ind_end_prev = channelize_index(frame_size_ch_, channel_offset);
-
-    size_t ind_begin_cur;
-    size_t ind_end_cur;
-
-    const size_t ind_begin_next = channelize_index(0, channel_offset);
-    size_t ind_end_next;
-
-    ind_begin_prev = (qt_sample_ >= qt_half_window_size_)
-        ? frame_size_ch_
-        : fixedpoint_to_size(qceil(qt_sample_ + (qt_frame_size_ - qt_half_window_size_)));
-    // ind_begin_prev is comparable with channel_len_ till we'll convert it to channalyzed
-    // presentation.
-    roc_panic_if(ind_begin_prev > frame_size_ch_);
-    ind_begin_prev = channelize_index(ind_begin_prev, channel_offset);
-
-    ind_begin_cur = (qt_sample_ >= qt_half_window_size_)
-        ? fixedpoint_to_size(qceil(qt_sample_ - qt_half_window_size_))
-        : 0;
-    roc_panic_if(ind_begin_cur > frame_size_ch_);
-    ind_begin_cur = channelize_index(ind_begin_cur, channel_offset);
-
-    ind_end_cur = ((qt_sample_ + qt_half_window_size_) > qt_frame_size_)
-        ? frame_size_ch_ - 1
-        : fixedpoint_to_size(qfloor(qt_sample_ + qt_half_window_size_));
-    roc_panic_if(ind_end_cur > frame_size_ch_);
-    ind_end_cur = channelize_index(ind_end_cur, channel_offset);
-
-    ind_end_next = ((qt_sample_ + qt_half_window_size_) > qt_frame_size_)
-        ? fixedpoint_to_size(qfloor(qt_sample_ + qt_half_window_size_ - qt_frame_size_))
-            + 1
-        : 0;
-    roc_panic_if(ind_end_next > frame_size_ch_);
-    ind_end_next = channelize_index(ind_end_next, channel_offset);
+    roc_panic_if(n_left + n_right > window_.size());
 
     // Counter inside window.
     // t_sinc = (t_sample - ceil( t_sample - window_len/cutoff*scale )) * sinc_step
-    const long_fixedpoint_t qt_cur_ = qt_frame_size_ + qt_sample_
-        - qceil(qt_frame_size_ + qt_sample_ - qt_half_window_size_);
-    fixedpoint_t qt_sinc_cur =
-        (fixedpoint_t)((qt_cur_ * (long_fixedpoint_t)qt_sinc_step_) >> FRACT_BIT_COUNT);
-
     // sinc_table defined in positive half-plane, so at the begining of the window
-    // qt_sinc_cur starts decreasing and after we cross 0 it will be increasing
+    // sinc position starts decreasing and after we cross 0 it will be increasing
     // till the end of the window.
-    fixedpoint_t qt_sinc_inc = qt_sinc_step_;
-
-    // Compute fractional part of time position at the begining. It wont change during
-    // the run.
-    float f_sinc_cur_fract = fractional(qt_sinc_cur << window_interp_bits_);
-    sample_t accumulator = 0;
-
-    size_t i;
-
-    // Run through previous frame.
-    for (i = ind_begin_prev; i < ind_end_prev; i += channels_num_) {
-        accumulator += prev_frame_[i] * sinc_(qt_sinc_cur, f_sinc_cur_fract);
-        qt_sinc_cur -= qt_sinc_inc;
-    }
-
-    // Run through current frame through the left windows side. qt_sinc_cur is decreasing.
-    i = ind_begin_cur;
+    //
+    // Crossing zero -- we just need to switch sinc position.
+    // -1 ------------ 0 ------------- +1
+    //      ^                  ^
+    //      |                  |
+    //   -qt_sinc_end  ->  +qt_sinc_end     <=> qt_sinc_end = 1 - qt_sinc_end
+    //
+    // Output sample position is always less than one input sample, so only its
+    // fractional part is multiplied by sinc step.
+    const sinc_fixedpoint_t qt_sinc_end = (sinc_fixedpoint_t)(
+        ((qt_sample_ & FRACT_PART_MASK) * qt_sinc_step_) >> FRACT_BIT_COUNT);
+    const sinc_fixedpoint_t qt_sinc_begin =
+        qt_sinc_end + sinc_fixedpoint_t(n_left - 1) * qt_sinc_step_;
+    const sinc_fixedpoint_t qt_sinc_right = qt_sinc_step_ - qt_sinc_end;
 
-    accumulator += curr_frame_[i] * sinc_(qt_sinc_cur, f_sinc_cur_fract);
-    while (qt_sinc_cur >= qt_sinc_step_) {
-        i += channels_num_;
-        qt_sinc_cur -= qt_sinc_inc;
-        accumulator += curr_frame_[i] * sinc_(qt_sinc_cur, f_sinc_cur_fract);
-    }
+    // Fractional part of sinc position doesn't change during the run on each side.
+    const sample_t divisor = scaling_ > 1.0f ? scaling_ : 1.0f;
+    const size_t shift = sinc_fract_bits_ - window_interp_bits_;
 
-    i += channels_num_;
+    sample_t* window = &window_[0];
 
-    roc_panic_if(i > channelize_index(frame_size_ch_, channel_offset));
+    kernel_->compute_window(window, n_left, sinc_table_ptr_, qt_sinc_begin,
+                            sinc_fixedpoint_t(0) - qt_sinc_step_, shift,
+                            sinc_fractional(qt_sinc_begin, shift), divisor);
 
-    // Crossing zero -- we just need to switch qt_sinc_cur.
-    // -1 ------------ 0 ------------- +1
-    //      ^                  ^
-    //      |                  |
-    //   -qt_sinc_cur  ->  +qt_sinc_cur     <=> qt_sinc_cur = 1 - qt_sinc_cur
-    qt_sinc_cur = qt_sinc_step_ - qt_sinc_cur; // qt_sinc_cur = -qt_sinc_cur + 1;
-    f_sinc_cur_fract = fractional(qt_sinc_cur << window_interp_bits_);
-
-    // Run through right side of the window, increasing qt_sinc_cur.
-    for (; i <= ind_end_cur; i += channels_num_) {
-        accumulator += curr_frame_[i] * sinc_(qt_sinc_cur, f_sinc_cur_fract);
-        qt_sinc_cur += qt_sinc_inc;
-    }
+    kernel_->compute_window(window + n_left, n_right, sinc_table_ptr_, qt_sinc_right,
+                            qt_sinc_step_, shift,
+                            sinc_fractional(qt_sinc_right, shift), divisor);
 
-    // Next frames run.
-    for (i = ind_begin_next; i < ind_end_next; i += channels_num_) {
-        accumulator += next_frame_[i] * sinc_(qt_sinc_cur, f_sinc_cur_fract);
-        qt_sinc_cur += qt_sinc_inc;
-    }
+    n_before = n_left - 1;
+    n_taps = n_left + n_right;
 
-    return accumulator;
+    return true;
 }
 
 } // namespace audio
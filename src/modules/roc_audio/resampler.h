@@ -13,19 +13,43 @@
 #define ROC_AUDIO_RESAMPLER_H_
 
 #include "roc_audio/frame.h"
-#include "roc_audio/ireader.h"
+#include "roc_audio/iresampler.h"
+#include "roc_audio/resampler_buffer.h"
+#include "roc_audio/resampler_kernel.h"
 #include "roc_audio/units.h"
 #include "roc_core/array.h"
 #include "roc_core/noncopyable.h"
-#include "roc_core/slice.h"
 #include "roc_core/stddefs.h"
 #include "roc_packet/units.h"
 
 namespace roc {
 namespace audio {
 
+//! Resampling method.
+enum ResamplerMethod {
+    //! Windowed sinc interpolation.
+    //! @remarks
+    //!  Implemented by Resampler and PolyphaseResampler.
+    ResamplerMethod_Sinc,
+
+    //! Linear interpolation between two nearest samples.
+    //! @remarks
+    //!  Implemented by PolynomialResampler.
+    ResamplerMethod_Linear,
+
+    //! Cubic Hermite interpolation between four nearest samples.
+    //! @remarks
+    //!  Implemented by PolynomialResampler.
+    ResamplerMethod_Cubic
+};
+
 //! Resampler parameters.
 struct ResamplerConfig {
+    //! Resampling method.
+    //! @remarks
+    //!  Other parameters are used only by sinc interpolation.
+    ResamplerMethod method;
+
     //! Sinc table precision.
     //! @remarks
     //!  Affects sync table size.
@@ -38,14 +62,22 @@ struct ResamplerConfig {
     //!  Lower values give lower quality but higher speed and also rarer cache misses.
     size_t window_size;
 
+    //! Resampler kernel.
+    //! @remarks
+    //!  Implementation of the inner loops. By default, the fastest kernel
+    //!  supported by the CPU is selected at run time.
+    ResamplerKernelType kernel;
+
     ResamplerConfig()
-        : window_interp(128)
-        , window_size(32) {
+        : method(ResamplerMethod_Sinc)
+        , window_interp(128)
+        , window_size(32)
+        , kernel(ResamplerKernel_Auto) {
     }
 };
 
 //! Resamples audio stream with non-integer dynamically changing factor.
-class Resampler : public core::NonCopyable<> {
+class Resampler : public IResampler, public core::NonCopyable<> {
 public:
     //! Initialize.
     Resampler(core::IAllocator& allocator,
@@ -53,6 +85,9 @@ public:
               packet::channel_mask_t channels,
               size_t frame_size);
 
+    //! Release sinc table.
+    ~Resampler();
+
     //! Check if object is successfully constructed.
     bool valid() const;
 
@@ -63,44 +98,33 @@ public:
     //!  depends on current resampling factor. So we choose length of input buffers to let
     //!  it handle maximum length of input. If new scaling factor breaks equation this
     //!  function returns false.
-    bool set_scaling(float);
+    virtual bool set_scaling(float);
 
     //! Resamples the whole output frame.
-    bool resample_buff(Frame& out);
+    virtual bool resample_buff(Frame& out);
 
-    //! Push new buffer on the front of the internal FIFO, which comprisesthree window_.
-    void renew_buffers(core::Slice<sample_t>& prev,
-                       core::Slice<sample_t>& cur,
-                       core::Slice<sample_t>& next);
+    //! Push interleaved input samples.
+    virtual size_t push_input(const sample_t* samples, size_t n_samples);
 
 private:
-    typedef uint32_t fixedpoint_t;
-    typedef uint64_t long_fixedpoint_t;
-    typedef int32_t signed_fixedpoint_t;
-    typedef int64_t signed_long_fixedpoint_t;
+    typedef uint64_t fixedpoint_t;
+    typedef uint32_t sinc_fixedpoint_t;
 
     const packet::channel_mask_t channel_mask_;
     const size_t channels_num_;
 
-    inline size_t channelize_index(const size_t i, const size_t ch_offset) const {
-        return i * channels_num_ + ch_offset;
-    }
-
-    //! Computes single sample of the particular audio channel.
+    //! Computes window coefficients for the current output sample position.
     //!
-    //! @param channel_offset a serial number of the channel
-    //!  (e.g. left -- 0, right -- 1, etc.).
-    sample_t resample_(size_t channel_offset);
+    //! Coefficients are the same for all channels, so they are computed once
+    //! and then applied to every channel plane.
+    //!
+    //! @returns false if there are not enough input samples; otherwise
+    //!  @p n_before is set to the number of window taps before the current
+    //!  input position and @p n_taps is set to the number of window taps.
+    bool compute_window_(size_t& n_before, size_t& n_taps);
 
     bool check_config_() const;
 
-    bool fill_sinc_();
-    sample_t sinc_(fixedpoint_t x, float fract_x);
-
-    sample_t* prev_frame_;
-    sample_t* curr_frame_;
-    sample_t* next_frame_;
-
     size_t out_frame_pos_;
 
     float scaling_;
@@ -109,29 +133,36 @@ private:
     const size_t frame_size_ch_;
 
     const size_t window_size_;
-    const fixedpoint_t qt_half_sinc_window_size_;
 
     const size_t window_interp_;
     const size_t window_interp_bits_;
 
-    core::Array<sample_t> sinc_table_;
+    // number of fractional bits in sinc table position
+    const size_t sinc_fract_bits_;
+
+    // shared table from SincTableCache
     const sample_t* sinc_table_ptr_;
 
-    // half window len in Q8.24 in terms of input signal
-    fixedpoint_t qt_half_window_size_;
-    const fixedpoint_t qt_epsilon_;
+    const ResamplerKernel* kernel_;
+
+    // coefficients of the current window
+    core::Array<sample_t> window_;
 
-    const fixedpoint_t qt_frame_size_;
+    // input samples; window for every channel is a contiguous run of samples
+    ResamplerBuffer buffer_;
+
+    // half window len in Q32.32 in terms of input signal
+    fixedpoint_t qt_half_window_size_;
 
-    // time position of output sample in terms of input samples indexes
-    // for example 0 -- time position of first sample in curr_frame_
+    // time position of output sample relative to the current position of
+    // input buffer, always less than one input sample
     fixedpoint_t qt_sample_;
 
     // time distance between two output samples, equals to resampling factor
     fixedpoint_t qt_dt_;
 
-    // the step with which we iterate over the sinc_table_
-    fixedpoint_t qt_sinc_step_;
+    // the step with which we iterate over the sinc table, in sinc_fract_bits_
+    sinc_fixedpoint_t qt_sinc_step_;
 
     const sample_t cutoff_freq_;
 
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/resampler_buffer.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+ResamplerBuffer::ResamplerBuffer(core::IAllocator& allocator,
+                                 size_t num_channels,
+                                 size_t max_half_window,
+                                 size_t chunk_size)
+    : kernel_(resampler_kernel(ResamplerKernel_Auto))
+    , num_channels_(num_channels)
+    , history_size_(max_half_window)
+    , ring_size_(max_half_window * 2 + 1 + chunk_size)
+    , guard_size_(max_half_window * 2 + 1)
+    , plane_size_(ring_size_ + guard_size_)
+    , data_(allocator)
+    , pos_(history_size_)
+    , n_avail_(0)
+    , valid_(false) {
+    if (num_channels_ < 1) {
+        roc_log(LogError, "resampler buffer: invalid num_channels: num_channels=%lu",
+                (unsigned long)num_channels_);
+        return;
+    }
+
+    // Array zero-initializes new elements, so history is silence.
+    if (!data_.resize(plane_size_ * num_channels_)) {
+        roc_log(LogError, "resampler buffer: can't allocate buffer");
+        return;
+    }
+
+    valid_ = true;
+}
+
+bool ResamplerBuffer::valid() const {
+    return valid_;
+}
+
+size_t ResamplerBuffer::write(const sample_t* samples, size_t n_samples) {
+    roc_panic_if(n_samples % num_channels_ != 0);
+
+    size_t n_write = n_samples / num_channels_;
+    if (n_write > ring_size_ - history_size_ - n_avail_) {
+        n_write = ring_size_ - history_size_ - n_avail_;
+    }
+
+    size_t write_pos = (pos_ + n_avail_) % ring_size_;
+
+    for (size_t n_done = 0; n_done < n_write;) {
+        size_t n_seg = n_write - n_done;
+        if (n_seg > ring_size_ - write_pos) {
+            n_seg = ring_size_ - write_pos;
+        }
+
+        sample_t* planes = &data_[0] + write_pos;
+
+        kernel_->deinterleave(planes, plane_size_, samples, n_seg, num_channels_);
+        samples += n_seg * num_channels_;
+
+        // Mirror beginning of the ring into the guard region.
+        if (write_pos < guard_size_) {
+            size_t n_mirror = guard_size_ - write_pos;
+            if (n_mirror > n_seg) {
+                n_mirror = n_seg;
+            }
+
+            for (size_t channel = 0; channel < num_channels_; channel++) {
+                sample_t* plane = planes + channel * plane_size_;
+                memcpy(plane + ring_size_, plane, n_mirror * sizeof(sample_t));
+            }
+        }
+
+        write_pos = (write_pos + n_seg) % ring_size_;
+        n_done += n_seg;
+    }
+
+    n_avail_ += n_write;
+
+    return n_write * num_channels_;
+}
+
+const sample_t* ResamplerBuffer::window(size_t n_before) const {
+    roc_panic_if(n_before > history_size_);
+
+    return &data_[0] + (pos_ + ring_size_ - n_before) % ring_size_;
+}
+
+void ResamplerBuffer::advance(size_t n_samples) {
+    roc_panic_if(n_samples > n_avail_);
+
+    pos_ = (pos_ + n_samples) % ring_size_;
+    n_avail_ -= n_samples;
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/resampler_buffer.h
+//! @brief Resampler input buffer.
+
+#ifndef ROC_AUDIO_RESAMPLER_BUFFER_H_
+#define ROC_AUDIO_RESAMPLER_BUFFER_H_
+
+#include "roc_audio/resampler_kernel.h"
+#include "roc_audio/units.h"
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Input buffer of resampler.
+//! @remarks
+//!  Deinterleaved ring buffer: every channel has its own plane. Beginning of
+//!  every plane is mirrored into a guard region after its end, so that any
+//!  window around the current position is a contiguous run of samples and
+//!  can be passed to the kernel directly.
+//!
+//!  The buffer keeps up to @c max_half_window samples before the current
+//!  position, and can hold up to (@c max_half_window + 1 + @c chunk_size)
+//!  samples starting from the current position. Before the first write,
+//!  samples before the current position are zeros.
+class ResamplerBuffer : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - @p num_channels is number of channels in interleaved input
+    //!  - @p max_half_window is maximum number of samples per channel needed
+    //!    before and after the current position
+    //!  - @p chunk_size is number of samples per channel that can be always
+    //!    written when less than (@p max_half_window + 1) samples are available
+    ResamplerBuffer(core::IAllocator& allocator,
+                    size_t num_channels,
+                    size_t max_half_window,
+                    size_t chunk_size);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Write interleaved samples.
+    //! @returns
+    //!  number of samples for all channels written, which is less than
+    //!  @p n_samples if the buffer is full.
+    size_t write(const sample_t* samples, size_t n_samples);
+
+    //! Get number of samples per channel starting from the current position.
+    size_t available() const {
+        return n_avail_;
+    }
+
+    //! Get window of the first channel.
+    //! @remarks
+    //!  Window starts @p n_before samples before the current position and
+    //!  may continue up to available() samples after it. Windows of the
+    //!  other channels follow with channel_stride() step.
+    const sample_t* window(size_t n_before) const;
+
+    //! Get distance between windows of adjacent channels.
+    size_t channel_stride() const {
+        return plane_size_;
+    }
+
+    //! Move current position forward by @p n_samples per channel.
+    void advance(size_t n_samples);
+
+private:
+    // deinterleaving is exact, so the fastest kernel is always used
+    const ResamplerKernel* kernel_;
+
+    const size_t num_channels_;
+
+    const size_t history_size_;
+    const size_t ring_size_;
+    const size_t guard_size_;
+    const size_t plane_size_;
+
+    core::Array<sample_t> data_;
+
+    // index of the current position in ring
+    size_t pos_;
+    size_t n_avail_;
+
+    bool valid_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_RESAMPLER_BUFFER_H_
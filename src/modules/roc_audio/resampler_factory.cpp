@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/resampler_factory.h"
+#include "roc_audio/polynomial_resampler.h"
+#include "roc_audio/polyphase_resampler.h"
+#include "roc_core/unique_ptr.h"
+
+namespace roc {
+namespace audio {
+
+IResampler* new_constant_rate_resampler(core::IAllocator& allocator,
+                                        const ResamplerConfig& config,
+                                        packet::channel_mask_t channels,
+                                        size_t frame_size,
+                                        float scaling) {
+    if (config.method != ResamplerMethod_Sinc) {
+        core::UniquePtr<PolynomialResampler> resampler(
+            new (allocator) PolynomialResampler(allocator, config, channels, frame_size),
+            allocator);
+        if (!resampler || !resampler->valid() || !resampler->set_scaling(scaling)) {
+            return NULL;
+        }
+        return resampler.release();
+    }
+
+    // Scaling never changes, so use polyphase resampler if it supports the
+    // scaling factor, and fall back to the generic resampler otherwise.
+    core::UniquePtr<PolyphaseResampler> polyphase_resampler(
+        new (allocator) PolyphaseResampler(allocator, config, channels, frame_size),
+        allocator);
+    if (!polyphase_resampler) {
+        return NULL;
+    }
+    if (polyphase_resampler->valid() && polyphase_resampler->set_scaling(scaling)) {
+        return polyphase_resampler.release();
+    }
+
+    core::UniquePtr<Resampler> resampler(
+        new (allocator) Resampler(allocator, config, channels, frame_size), allocator);
+    if (!resampler || !resampler->valid() || !resampler->set_scaling(scaling)) {
+        return NULL;
+    }
+    return resampler.release();
+}
+
+} // namespace audio
+} // namespace roc
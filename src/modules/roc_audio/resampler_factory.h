@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/resampler_factory.h
+//! @brief Resampler factory.
+
+#ifndef ROC_AUDIO_RESAMPLER_FACTORY_H_
+#define ROC_AUDIO_RESAMPLER_FACTORY_H_
+
+#include "roc_audio/iresampler.h"
+#include "roc_audio/resampler.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/stddefs.h"
+#include "roc_packet/units.h"
+
+namespace roc {
+namespace audio {
+
+//! Create resampler for a scaling factor that never changes.
+//! @remarks
+//!  Selects resampler implementation using @p config method. For the sinc
+//!  method, polyphase resampler is used if it supports @p scaling, and the
+//!  generic resampler otherwise.
+//! @returns
+//!  resampler allocated using @p allocator with @p scaling already set, or
+//!  NULL if the resampler can't be created or doesn't support @p scaling.
+IResampler* new_constant_rate_resampler(core::IAllocator& allocator,
+                                        const ResamplerConfig& config,
+                                        packet::channel_mask_t channels,
+                                        size_t frame_size,
+                                        float scaling);
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_RESAMPLER_FACTORY_H_
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/resampler_kernel.h"
+#include "roc_core/panic.h"
+
+#ifdef ROC_TARGET_X86
+#include "roc_audio/resampler_kernel_x86.h"
+#include "roc_core/cpu_features.h"
+#endif // ROC_TARGET_X86
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+void generic_compute_window(sample_t* coeffs,
+                            size_t n_coeffs,
+                            const sample_t* sinc_table,
+                            uint32_t pos,
+                            uint32_t step,
+                            size_t shift,
+                            sample_t fract,
+                            sample_t divisor) {
+    for (size_t n = 0; n < n_coeffs; n++) {
+        const size_t index = pos >> shift;
+
+        const sample_t hl = sinc_table[index];     // table index smaller than pos
+        const sample_t hh = sinc_table[index + 1]; // table index next to pos
+
+        coeffs[n] = (hl + fract * (hh - hl)) / divisor;
+        pos += step;
+    }
+}
+
+sample_t generic_convolve(const sample_t* coeffs,
+                          const sample_t* samples,
+                          size_t stride,
+                          size_t n_coeffs) {
+    sample_t accumulator = 0;
+
+    for (size_t n = 0; n < n_coeffs; n++) {
+        accumulator += coeffs[n] * samples[n * stride];
+    }
+
+    return accumulator;
+}
+
+void generic_deinterleave(sample_t* planes,
+                          size_t plane_stride,
+                          const sample_t* samples,
+                          size_t n_frames,
+                          size_t num_channels) {
+    if (num_channels == 1) {
+        memcpy(planes, samples, n_frames * sizeof(sample_t));
+        return;
+    }
+
+    for (size_t channel = 0; channel < num_channels; channel++) {
+        sample_t* plane = planes + channel * plane_stride;
+        const sample_t* in = samples + channel;
+
+        for (size_t n = 0; n < n_frames; n++) {
+            plane[n] = in[n * num_channels];
+        }
+    }
+}
+
+const ResamplerKernel GenericResamplerKernel = {
+    ResamplerKernel_Generic,
+    "generic",
+    generic_compute_window,
+    generic_convolve,
+    generic_deinterleave,
+};
+
+} // namespace
+
+const ResamplerKernel* resampler_kernel(ResamplerKernelType type) {
+    switch (type) {
+    case ResamplerKernel_Auto:
+#ifdef ROC_TARGET_X86
+        if (const ResamplerKernel* kernel = resampler_kernel(ResamplerKernel_AVX512)) {
+            return kernel;
+        }
+        if (const ResamplerKernel* kernel = resampler_kernel(ResamplerKernel_AVX2)) {
+            return kernel;
+        }
+        if (const ResamplerKernel* kernel = resampler_kernel(ResamplerKernel_SSE2)) {
+            return kernel;
+        }
+#endif // ROC_TARGET_X86
+        return &GenericResamplerKernel;
+
+    case ResamplerKernel_Generic:
+        return &GenericResamplerKernel;
+
+    case ResamplerKernel_SSE2:
+#ifdef ROC_TARGET_X86
+        if (core::cpu_supports(core::CpuFeature_SSE2)) {
+            return &SSE2ResamplerKernel;
+        }
+#endif // ROC_TARGET_X86
+        return NULL;
+
+    case ResamplerKernel_AVX2:
+#ifdef ROC_TARGET_X86
+        if (core::cpu_supports(core::CpuFeature_AVX2)) {
+            return &AVX2ResamplerKernel;
+        }
+#endif // ROC_TARGET_X86
+        return NULL;
+
+    case ResamplerKernel_AVX512:
+#ifdef ROC_TARGET_X86
+        if (core::cpu_supports(core::CpuFeature_AVX512F)) {
+            return &AVX512ResamplerKernel;
+        }
+#endif // ROC_TARGET_X86
+        return NULL;
+    }
+
+    roc_panic("resampler kernel: unknown kernel type %d", (int)type);
+}
+
+} // namespace audio
+} // namespace roc
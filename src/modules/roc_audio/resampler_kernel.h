@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/resampler_kernel.h
+//! @brief Resampler kernel.
+
+#ifndef ROC_AUDIO_RESAMPLER_KERNEL_H_
+#define ROC_AUDIO_RESAMPLER_KERNEL_H_
+
+#include "roc_audio/units.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Resampler kernel type.
+enum ResamplerKernelType {
+    //! Select the fastest kernel supported by the CPU.
+    ResamplerKernel_Auto,
+
+    //! Portable scalar implementation.
+    ResamplerKernel_Generic,
+
+    //! SSE2 implementation.
+    ResamplerKernel_SSE2,
+
+    //! AVX2 implementation.
+    ResamplerKernel_AVX2,
+
+    //! AVX-512 implementation.
+    ResamplerKernel_AVX512
+};
+
+//! Resampler kernel.
+//! @remarks
+//!  Function table implementing the innermost loops of the resampler.
+//!  All implementations produce identical coefficients; convolution results
+//!  may differ only by floating point rounding, since vectorized kernels
+//!  sum products in a different order.
+struct ResamplerKernel {
+    //! Kernel type.
+    ResamplerKernelType type;
+
+    //! Kernel name.
+    const char* name;
+
+    //! Compute windowed sinc coefficients for a run of window taps.
+    //! @remarks
+    //!  Fills @p n_coeffs coefficients. K-th coefficient is the value of
+    //!  @p sinc_table at fixed-point position (@p pos + K * @p step), linearly
+    //!  interpolated using @p fract, and divided by @p divisor. Integer part of
+    //!  the position is obtained by shifting it right by @p shift bits. The
+    //!  position arithmetic wraps around, so a decreasing run is described by
+    //!  a negated step.
+    void (*compute_window)(sample_t* coeffs,
+                           size_t n_coeffs,
+                           const sample_t* sinc_table,
+                           uint32_t pos,
+                           uint32_t step,
+                           size_t shift,
+                           sample_t fract,
+                           sample_t divisor);
+
+    //! Convolve coefficients with input samples.
+    //! @returns
+    //!  sum of coeffs[K] * samples[K * stride] for K in [0; n_coeffs).
+    sample_t (*convolve)(const sample_t* coeffs,
+                         const sample_t* samples,
+                         size_t stride,
+                         size_t n_coeffs);
+
+    //! Deinterleave samples into channel planes.
+    //! @remarks
+    //!  Copies @p n_frames frames of @p num_channels interleaved samples from
+    //!  @p samples. Samples of K-th channel are written contiguously starting
+    //!  from (@p planes + K * @p plane_stride). Results are exact, so any
+    //!  kernel may be used for any input.
+    void (*deinterleave)(sample_t* planes,
+                         size_t plane_stride,
+                         const sample_t* samples,
+                         size_t n_frames,
+                         size_t num_channels);
+};
+
+//! Get resampler kernel.
+//! @returns
+//!  NULL if the given kernel is not supported by the build or by the CPU.
+//!  If @p type is ResamplerKernel_Auto, never returns NULL.
+const ResamplerKernel* resampler_kernel(ResamplerKernelType type);
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_RESAMPLER_KERNEL_H_
@@ -29,6 +29,14 @@ ResamplerConfig resampler_profile(ResamplerProfile profile) {
         config.window_interp = 512;
         config.window_size = 64;
         break;
+
+    case ResamplerProfile_Cubic:
+        config.method = ResamplerMethod_Cubic;
+        break;
+
+    case ResamplerProfile_Linear:
+        config.method = ResamplerMethod_Linear;
+        break;
     }
 
     return config;
@@ -26,7 +26,17 @@ enum ResamplerProfile {
     ResamplerProfile_Medium,
 
     //! Hight quality, low speed.
-    ResamplerProfile_High
+    ResamplerProfile_High,
+
+    //! Cubic interpolation, lower quality, very fast speed.
+    //! @remarks
+    //!  No anti-aliasing filter; suitable for scaling factors close to 1.
+    ResamplerProfile_Cubic,
+
+    //! Linear interpolation, lowest quality, fastest speed.
+    //! @remarks
+    //!  No anti-aliasing filter; suitable for scaling factors close to 1.
+    ResamplerProfile_Linear
 };
 
 //! Get parameters for given resampler profile.
@@ -7,7 +7,7 @@
  */
 
 #include "roc_audio/resampler_reader.h"
-#include "roc_core/helpers.h"
+#include "roc_audio/frame_flags_merger.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 #include "roc_core/stddefs.h"
@@ -16,20 +16,15 @@ namespace roc {
 namespace audio {
 
 ResamplerReader::ResamplerReader(IReader& reader,
+                                 IResampler& resampler,
                                  core::BufferPool<sample_t>& buffer_pool,
-                                 core::IAllocator& allocator,
-                                 const ResamplerConfig& config,
-                                 packet::channel_mask_t channels,
                                  size_t frame_size)
-    : resampler_(allocator, config, channels, frame_size)
+    : resampler_(resampler)
     , reader_(reader)
     , frame_size_(frame_size)
-    , frames_empty_(true)
+    , n_blank_(0)
     , valid_(false) {
-    if (!resampler_.valid()) {
-        return;
-    }
-    if (!init_frames_(buffer_pool)) {
+    if (!init_(buffer_pool)) {
         return;
     }
     valid_ = true;
@@ -48,48 +43,60 @@ bool ResamplerReader::set_scaling(float scaling) {
 void ResamplerReader::read(Frame& frame) {
     roc_panic_if_not(valid());
 
-    if (frames_empty_) {
-        renew_frames_();
-    }
+    FrameFlagsMerger flags;
+    size_t n_input = 0;
 
+    // Input is read only when resampler doesn't have enough samples for the
+    // next output sample, and only one frame at a time.
     while (!resampler_.resample_buff(frame)) {
-        renew_frames_();
-    }
-}
+        Frame input_frame(input_.data(), input_.size());
+        reader_.read(input_frame);
 
-bool ResamplerReader::init_frames_(core::BufferPool<sample_t>& buffer_pool) {
-    for (size_t n = 0; n < ROC_ARRAY_SIZE(frames_); n++) {
-        frames_[n] = new (buffer_pool) core::Buffer<sample_t>(buffer_pool);
+        if (resampler_.push_input(input_frame.data(), input_frame.size())
+            != input_frame.size()) {
+            roc_panic("resampler reader: resampler didn't accept input frame");
+        }
 
-        if (!frames_[n]) {
-            roc_log(LogError, "resampler reader: can't allocate buffer");
-            return false;
+        if (input_frame.flags() & Frame::FlagBlank) {
+            n_blank_++;
+        } else {
+            n_blank_ = 0;
         }
 
-        frames_[n].resize(frame_size_);
+        flags.add(input_frame.flags());
+        n_input++;
     }
 
-    return true;
+    frame.set_flags(output_flags_(flags.flags(), n_input));
 }
 
-void ResamplerReader::renew_frames_() {
-    if (frames_empty_) {
-        for (size_t n = 0; n < ROC_ARRAY_SIZE(frames_); ++n) {
-            Frame frame(frames_[n].data(), frames_[n].size());
-            reader_.read(frame);
-        }
-        frames_empty_ = false;
-    } else {
-        core::Slice<sample_t> temp = frames_[0];
-        frames_[0] = frames_[1];
-        frames_[1] = frames_[2];
-        frames_[2] = temp;
-
-        Frame frame(frames_[2].data(), frames_[2].size());
-        reader_.read(frame);
+unsigned ResamplerReader::output_flags_(unsigned input_flags, size_t n_input) const {
+    // Resampler window is not longer than input frame, and output position
+    // may lag behind the beginning of the last input frame by up to window
+    // size. So output depends on up to three frames read before this call,
+    // and is blank only if they and all frames read during this call are blank.
+    if (n_blank_ >= n_input + 3) {
+        return input_flags | Frame::FlagBlank;
     }
 
-    resampler_.renew_buffers(frames_[0], frames_[1], frames_[2]);
+    if (input_flags & Frame::FlagBlank) {
+        return (input_flags & ~(unsigned)Frame::FlagBlank) | Frame::FlagIncomplete;
+    }
+
+    return input_flags;
+}
+
+bool ResamplerReader::init_(core::BufferPool<sample_t>& buffer_pool) {
+    input_ = new (buffer_pool) core::Buffer<sample_t>(buffer_pool);
+
+    if (!input_) {
+        roc_log(LogError, "resampler reader: can't allocate buffer");
+        return false;
+    }
+
+    input_.resize(frame_size_);
+
+    return true;
 }
 
 } // namespace audio
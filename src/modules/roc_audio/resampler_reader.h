@@ -14,13 +14,12 @@
 
 #include "roc_audio/frame.h"
 #include "roc_audio/ireader.h"
-#include "roc_audio/resampler.h"
+#include "roc_audio/iresampler.h"
 #include "roc_audio/units.h"
-#include "roc_core/array.h"
+#include "roc_core/buffer_pool.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/slice.h"
 #include "roc_core/stddefs.h"
-#include "roc_packet/units.h"
 
 namespace roc {
 namespace audio {
@@ -34,14 +33,12 @@ public:
     //!
     //! @b Parameters
     //!  - @p reader specifies input audio stream used in read()
-    //!  - @p buffer_pool is used to allocate temporary buffers
-    //!  - @p frame_size is number of samples per resampler frame per audio channel
-    //!  - @p channels is the bitmask of audio channels
+    //!  - @p resampler is used to resample frames
+    //!  - @p buffer_pool is used to allocate input buffer
+    //!  - @p frame_size is number of samples per input frame for all channels
     ResamplerReader(IReader& reader,
+                    IResampler& resampler,
                     core::BufferPool<sample_t>& buffer_pool,
-                    core::IAllocator& allocator,
-                    const ResamplerConfig& config,
-                    packet::channel_mask_t channels,
                     size_t frame_size);
 
     //! Check if object is successfully constructed.
@@ -50,6 +47,8 @@ public:
     //! Read audio frame.
     //! @remarks
     //!  Calculates everything during this call so it may take time.
+    //!  Output frame is blank if all input samples it depends on came from
+    //!  blank frames. Other flags of input frames are merged.
     virtual void read(Frame&);
 
     //! Set new resample factor.
@@ -62,15 +61,17 @@ public:
     bool set_scaling(float);
 
 private:
-    bool init_frames_(core::BufferPool<sample_t>&);
-    void renew_frames_();
+    bool init_(core::BufferPool<sample_t>&);
+    unsigned output_flags_(unsigned input_flags, size_t n_input) const;
 
-    Resampler resampler_;
+    IResampler& resampler_;
     IReader& reader_;
 
-    core::Slice<sample_t> frames_[3];
+    core::Slice<sample_t> input_;
     const size_t frame_size_;
-    bool frames_empty_;
+
+    // number of blank frames read in a row
+    size_t n_blank_;
 
     bool valid_;
 };
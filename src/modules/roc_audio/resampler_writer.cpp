@@ -7,7 +7,6 @@
  */
 
 #include "roc_audio/resampler_writer.h"
-#include "roc_core/helpers.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 #include "roc_core/stddefs.h"
@@ -16,19 +15,13 @@ namespace roc {
 namespace audio {
 
 ResamplerWriter::ResamplerWriter(IWriter& writer,
+                                 IResampler& resampler,
                                  core::BufferPool<sample_t>& buffer_pool,
-                                 core::IAllocator& allocator,
-                                 const ResamplerConfig& config,
-                                 packet::channel_mask_t channels,
                                  size_t frame_size)
-    : resampler_(allocator, config, channels, frame_size)
+    : resampler_(resampler)
     , writer_(writer)
-    , frame_pos_(0)
     , frame_size_(frame_size)
     , valid_(false) {
-    if (!resampler_.valid()) {
-        return;
-    }
     if (!init_(buffer_pool)) {
         return;
     }
@@ -52,55 +45,20 @@ void ResamplerWriter::write(Frame& input) {
     const size_t input_size = input.size();
     size_t input_pos = 0;
 
-    sample_t* frame0_data = frames_[0].data();
-    for (; frame_pos_ < frame_size_ && input_pos < input_size;
-         ++frame_pos_, ++input_pos) {
-        frame0_data[frame_pos_] = input_data[input_pos];
-    }
-
-    sample_t* frame1_data = frames_[1].data();
-    for (; frame_pos_ < frame_size_ * 2 && input_pos < input_size;
-         ++frame_pos_, ++input_pos) {
-        frame1_data[frame_pos_ - frame_size_] = input_data[input_pos];
-    }
-
+    // Resampler copies input directly to its ring buffer and produces output
+    // as soon as enough input samples are available.
     while (input_pos < input_size) {
-        sample_t* frame2_data = frames_[2].data();
-        for (; frame_pos_ < frame_size_ * 3 && input_pos < input_size;
-             ++frame_pos_, ++input_pos) {
-            frame2_data[frame_pos_ - frame_size_ * 2] = input_data[input_pos];
-        }
+        input_pos +=
+            resampler_.push_input(input_data + input_pos, input_size - input_pos);
 
-        // All three slices are full, resampling frame_size_ samples.
-        if (frame_pos_ >= frame_size_ * 3) {
-            resampler_.renew_buffers(frames_[0], frames_[1], frames_[2]);
-
-            Frame out_frame(output_.data(), output_.size());
-            while (resampler_.resample_buff(out_frame)) {
-                writer_.write(out_frame);
-            }
-
-            frame_pos_ -= frames_[0].size();
-            core::Slice<sample_t> temp = frames_[0];
-            frames_[0] = frames_[1];
-            frames_[1] = frames_[2];
-            frames_[2] = temp;
+        Frame out_frame(output_.data(), output_.size());
+        while (resampler_.resample_buff(out_frame)) {
+            writer_.write(out_frame);
         }
     }
 }
 
 bool ResamplerWriter::init_(core::BufferPool<sample_t>& buffer_pool) {
-    for (size_t n = 0; n < ROC_ARRAY_SIZE(frames_); n++) {
-        frames_[n] = new (buffer_pool) core::Buffer<sample_t>(buffer_pool);
-
-        if (!frames_[n]) {
-            roc_log(LogError, "resampler writer: can't allocate buffer");
-            return false;
-        }
-
-        frames_[n].resize(frame_size_);
-    }
-
     output_ = new (buffer_pool) core::Buffer<sample_t>(buffer_pool);
 
     if (!output_) {
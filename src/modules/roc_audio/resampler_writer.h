@@ -14,13 +14,12 @@
 
 #include "roc_audio/frame.h"
 #include "roc_audio/iwriter.h"
-#include "roc_audio/resampler.h"
+#include "roc_audio/iresampler.h"
 #include "roc_audio/units.h"
-#include "roc_core/array.h"
+#include "roc_core/buffer_pool.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/slice.h"
 #include "roc_core/stddefs.h"
-#include "roc_packet/units.h"
 
 namespace roc {
 namespace audio {
@@ -34,14 +33,12 @@ public:
     //!
     //! @b Parameters
     //!  - @p writer specifies output audio stream used in write()
-    //!  - @p buffer_pool is used to allocate temporary buffers
-    //!  - @p frame_size is number of samples per resampler frame per audio channel
-    //!  - @p channels is the bitmask of audio channels
+    //!  - @p resampler is used to resample frames
+    //!  - @p buffer_pool is used to allocate output buffer
+    //!  - @p frame_size is number of samples per output frame for all channels
     ResamplerWriter(IWriter& writer,
+                    IResampler& resampler,
                     core::BufferPool<sample_t>& buffer_pool,
-                    core::IAllocator& allocator,
-                    const ResamplerConfig& config,
-                    packet::channel_mask_t channels,
                     size_t frame_size);
 
     //! Check if object is successfully constructed.
@@ -64,13 +61,11 @@ public:
 private:
     bool init_(core::BufferPool<sample_t>&);
 
-    Resampler resampler_;
+    IResampler& resampler_;
     IWriter& writer_;
 
     core::Slice<sample_t> output_;
 
-    core::Slice<sample_t> frames_[3];
-    size_t frame_pos_;
     const size_t frame_size_;
 
     bool valid_;
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/sinc_table_cache.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+SincTableCache::SincTableCache() {
+}
+
+const sample_t* SincTableCache::acquire(size_t window_size, size_t window_interp) {
+    core::Mutex::Lock lock(mutex_);
+
+    for (Entry* entry = entries_.front(); entry; entry = entries_.nextof(*entry)) {
+        if (entry->window_size == window_size && entry->window_interp == window_interp) {
+            entry->refcount++;
+            return &entry->table[0];
+        }
+    }
+
+    Entry* entry = new (allocator_) Entry(allocator_, window_size, window_interp);
+    if (!entry) {
+        roc_log(LogError, "sinc table cache: can't allocate entry");
+        return NULL;
+    }
+
+    if (!fill_table_(*entry)) {
+        allocator_.destroy(*entry);
+        return NULL;
+    }
+
+    roc_log(LogDebug, "sinc table cache: created table: window_size=%lu window_interp=%lu",
+            (unsigned long)window_size, (unsigned long)window_interp);
+
+    entry->refcount++;
+    entries_.push_back(*entry);
+
+    return &entry->table[0];
+}
+
+void SincTableCache::release(const sample_t* table) {
+    core::Mutex::Lock lock(mutex_);
+
+    for (Entry* entry = entries_.front(); entry; entry = entries_.nextof(*entry)) {
+        if (&entry->table[0] != table) {
+            continue;
+        }
+
+        roc_panic_if(entry->refcount == 0);
+
+        if (--entry->refcount == 0) {
+            roc_log(LogDebug,
+                    "sinc table cache: removed table: window_size=%lu window_interp=%lu",
+                    (unsigned long)entry->window_size,
+                    (unsigned long)entry->window_interp);
+
+            entries_.remove(*entry);
+            allocator_.destroy(*entry);
+        }
+
+        return;
+    }
+
+    roc_panic("sinc table cache: attempt to release unknown table");
+}
+
+size_t SincTableCache::num_tables() const {
+    core::Mutex::Lock lock(mutex_);
+
+    return entries_.size();
+}
+
+bool SincTableCache::fill_table_(Entry& entry) {
+    core::Array<sample_t>& table = entry.table;
+
+    if (!table.resize(entry.window_size * entry.window_interp + 2)) {
+        roc_log(LogError, "sinc table cache: can't allocate sinc table");
+        return false;
+    }
+
+    const double sinc_step = 1.0 / (double)entry.window_interp;
+    double sinc_t = sinc_step;
+
+    table[0] = 1.0f;
+    for (size_t i = 1; i < table.size(); ++i) {
+        const double window = 0.54
+            - 0.46
+                * std::cos(2 * M_PI
+                           * ((double)(i - 1) / 2.0 / (double)table.size() + 0.5));
+        table[i] = (float)(std::sin(M_PI * sinc_t) / M_PI / sinc_t * window);
+        sinc_t += sinc_step;
+    }
+    table[table.size() - 2] = 0;
+    table[table.size() - 1] = 0;
+
+    return true;
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/sinc_table_cache.h
+//! @brief Sinc table cache.
+
+#ifndef ROC_AUDIO_SINC_TABLE_CACHE_H_
+#define ROC_AUDIO_SINC_TABLE_CACHE_H_
+
+#include "roc_audio/units.h"
+#include "roc_core/array.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/list.h"
+#include "roc_core/list_node.h"
+#include "roc_core/mutex.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/singleton.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Process-wide cache of sinc tables used by resamplers.
+//! @remarks
+//!  Sinc table depends only on window size and window interpolation, so
+//!  resamplers with the same parameters share one read-only table. Tables
+//!  are reference counted and freed when the last user releases them.
+//!  Thread-safe.
+class SincTableCache : public core::NonCopyable<> {
+public:
+    //! Get instance.
+    static SincTableCache& instance() {
+        return core::Singleton<SincTableCache>::instance();
+    }
+
+    //! Acquire sinc table.
+    //! @returns
+    //!  pointer to (window_size * window_interp + 2) table values, or NULL
+    //!  if allocation failed. The table should be released using release().
+    const sample_t* acquire(size_t window_size, size_t window_interp);
+
+    //! Release sinc table returned by acquire().
+    void release(const sample_t* table);
+
+    //! Get number of tables in cache.
+    size_t num_tables() const;
+
+private:
+    friend class core::Singleton<SincTableCache>;
+
+    struct Entry : core::ListNode {
+        Entry(core::IAllocator& allocator, size_t size, size_t interp)
+            : window_size(size)
+            , window_interp(interp)
+            , refcount(0)
+            , table(allocator) {
+        }
+
+        const size_t window_size;
+        const size_t window_interp;
+        size_t refcount;
+        core::Array<sample_t> table;
+    };
+
+    SincTableCache();
+
+    bool fill_table_(Entry& entry);
+
+    core::Mutex mutex_;
+
+    core::HeapAllocator allocator_;
+    core::List<Entry, core::NoOwnership> entries_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_SINC_TABLE_CACHE_H_
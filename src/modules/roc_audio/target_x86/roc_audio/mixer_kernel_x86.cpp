@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <immintrin.h>
+
+#include "roc_audio/mixer_kernel_x86.h"
+#include "roc_core/cpu_attributes.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+// Clamp single sample.
+// Must match generic_clamp() exactly.
+inline sample_t clamp_sample(sample_t x) {
+    if (x > SampleMax) {
+        return SampleMax;
+    } else if (x < SampleMin) {
+        return SampleMin;
+    } else {
+        return x;
+    }
+}
+
+ROC_ATTR_SSE2 void
+sse2_accumulate(sample_t* acc, const sample_t* samples, size_t n_samples) {
+    size_t n = 0;
+
+    for (; n + 8 <= n_samples; n += 8) {
+        _mm_storeu_ps(acc + n,
+                      _mm_add_ps(_mm_loadu_ps(acc + n), _mm_loadu_ps(samples + n)));
+        _mm_storeu_ps(acc + n + 4, _mm_add_ps(_mm_loadu_ps(acc + n + 4),
+                                              _mm_loadu_ps(samples + n + 4)));
+    }
+
+    for (; n < n_samples; n++) {
+        acc[n] += samples[n];
+    }
+}
+
+ROC_ATTR_SSE2 void sse2_clamp(sample_t* samples, size_t n_samples) {
+    const __m128 v_max = _mm_set1_ps(SampleMax);
+    const __m128 v_min = _mm_set1_ps(SampleMin);
+
+    size_t n = 0;
+
+    for (; n + 4 <= n_samples; n += 4) {
+        _mm_storeu_ps(samples + n,
+                      _mm_max_ps(_mm_min_ps(_mm_loadu_ps(samples + n), v_max), v_min));
+    }
+
+    for (; n < n_samples; n++) {
+        samples[n] = clamp_sample(samples[n]);
+    }
+}
+
+ROC_ATTR_AVX2 void
+avx2_accumulate(sample_t* acc, const sample_t* samples, size_t n_samples) {
+    size_t n = 0;
+
+    for (; n + 16 <= n_samples; n += 16) {
+        _mm256_storeu_ps(acc + n, _mm256_add_ps(_mm256_loadu_ps(acc + n),
+                                                _mm256_loadu_ps(samples + n)));
+        _mm256_storeu_ps(acc + n + 8, _mm256_add_ps(_mm256_loadu_ps(acc + n + 8),
+                                                    _mm256_loadu_ps(samples + n + 8)));
+    }
+
+    for (; n < n_samples; n++) {
+        acc[n] += samples[n];
+    }
+}
+
+ROC_ATTR_AVX2 void avx2_clamp(sample_t* samples, size_t n_samples) {
+    const __m256 v_max = _mm256_set1_ps(SampleMax);
+    const __m256 v_min = _mm256_set1_ps(SampleMin);
+
+    size_t n = 0;
+
+    for (; n + 8 <= n_samples; n += 8) {
+        _mm256_storeu_ps(
+            samples + n,
+            _mm256_max_ps(_mm256_min_ps(_mm256_loadu_ps(samples + n), v_max), v_min));
+    }
+
+    for (; n < n_samples; n++) {
+        samples[n] = clamp_sample(samples[n]);
+    }
+}
+
+} // namespace
+
+const MixerKernel SSE2MixerKernel = {
+    MixerKernel_SSE2,
+    "sse2",
+    sse2_accumulate,
+    sse2_clamp,
+};
+
+const MixerKernel AVX2MixerKernel = {
+    MixerKernel_AVX2,
+    "avx2",
+    avx2_accumulate,
+    avx2_clamp,
+};
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/target_x86/roc_audio/mixer_kernel_x86.h
+//! @brief x86 SIMD mixer kernels.
+
+#ifndef ROC_AUDIO_MIXER_KERNEL_X86_H_
+#define ROC_AUDIO_MIXER_KERNEL_X86_H_
+
+#include "roc_audio/mixer_kernel.h"
+
+namespace roc {
+namespace audio {
+
+//! SSE2 mixer kernel.
+//! @remarks
+//!  Should be used only if the CPU supports SSE2.
+extern const MixerKernel SSE2MixerKernel;
+
+//! AVX2 mixer kernel.
+//! @remarks
+//!  Should be used only if the CPU supports AVX2.
+extern const MixerKernel AVX2MixerKernel;
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_MIXER_KERNEL_X86_H_
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <immintrin.h>
+
+#include "roc_audio/pcm_kernel_x86.h"
+#include "roc_core/cpu_attributes.h"
+#include "roc_core/endian.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+// Encode single sample.
+// Must match generic_encode_int16() exactly.
+inline int16_t encode_sample(sample_t x) {
+    float s = x * 32768.0f;
+    s = std::min(s, +32767.0f);
+    s = std::max(s, -32768.0f);
+    return (int16_t)core::hton16((uint16_t)(int16_t)s);
+}
+
+// Decode single sample.
+// Must match generic_decode_int16() exactly.
+inline sample_t decode_sample(int16_t x) {
+    return float((int16_t)core::ntoh16((uint16_t)x)) / 32768.0f;
+}
+
+// Scale, saturate and truncate 4 samples to 32-bit integers.
+ROC_ATTR_SSE2 inline __m128i sse2_quantize(__m128 x) {
+    x = _mm_mul_ps(x, _mm_set1_ps(32768.0f));
+    x = _mm_min_ps(x, _mm_set1_ps(+32767.0f));
+    x = _mm_max_ps(x, _mm_set1_ps(-32768.0f));
+    return _mm_cvttps_epi32(x);
+}
+
+// Swap bytes in every 16-bit word.
+ROC_ATTR_SSE2 inline __m128i sse2_swap16(__m128i x) {
+    return _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+}
+
+ROC_ATTR_SSE2 void sse2_encode_int16(int16_t* out, const sample_t* in, size_t n_samples) {
+    size_t n = 0;
+
+    for (; n + 8 <= n_samples; n += 8) {
+        const __m128i lo = sse2_quantize(_mm_loadu_ps(in + n));
+        const __m128i hi = sse2_quantize(_mm_loadu_ps(in + n + 4));
+
+        // values are already in int16 range, so saturation doesn't change them
+        _mm_storeu_si128((__m128i*)(out + n), sse2_swap16(_mm_packs_epi32(lo, hi)));
+    }
+
+    for (; n < n_samples; n++) {
+        out[n] = encode_sample(in[n]);
+    }
+}
+
+ROC_ATTR_SSE2 void sse2_decode_int16(sample_t* out, const int16_t* in, size_t n_samples) {
+    const __m128 v_scale = _mm_set1_ps(1.0f / 32768.0f);
+
+    size_t n = 0;
+
+    for (; n + 8 <= n_samples; n += 8) {
+        const __m128i x = sse2_swap16(_mm_loadu_si128((const __m128i*)(in + n)));
+
+        // sign-extend by moving each word to the upper half and shifting back
+        const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+        const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+
+        _mm_storeu_ps(out + n, _mm_mul_ps(_mm_cvtepi32_ps(lo), v_scale));
+        _mm_storeu_ps(out + n + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), v_scale));
+    }
+
+    for (; n < n_samples; n++) {
+        out[n] = decode_sample(in[n]);
+    }
+}
+
+// Scale, saturate and truncate 8 samples to 32-bit integers.
+ROC_ATTR_AVX2 inline __m256i avx2_quantize(__m256 x) {
+    x = _mm256_mul_ps(x, _mm256_set1_ps(32768.0f));
+    x = _mm256_min_ps(x, _mm256_set1_ps(+32767.0f));
+    x = _mm256_max_ps(x, _mm256_set1_ps(-32768.0f));
+    return _mm256_cvttps_epi32(x);
+}
+
+// Shuffle mask swapping bytes in every 16-bit word.
+ROC_ATTR_AVX2 inline __m256i avx2_swap16_mask() {
+    return _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14, //
+                            1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+}
+
+ROC_ATTR_AVX2 void avx2_encode_int16(int16_t* out, const sample_t* in, size_t n_samples) {
+    const __m256i v_swap = avx2_swap16_mask();
+
+    size_t n = 0;
+
+    for (; n + 16 <= n_samples; n += 16) {
+        const __m256i lo = avx2_quantize(_mm256_loadu_ps(in + n));
+        const __m256i hi = avx2_quantize(_mm256_loadu_ps(in + n + 8));
+
+        // packing works within 128-bit lanes, so 64-bit quarters come out as
+        // lo[0:3] hi[0:3] lo[4:7] hi[4:7] and have to be reordered
+        const __m256i x =
+            _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), _MM_SHUFFLE(3, 1, 2, 0));
+
+        _mm256_storeu_si256((__m256i*)(out + n), _mm256_shuffle_epi8(x, v_swap));
+    }
+
+    for (; n < n_samples; n++) {
+        out[n] = encode_sample(in[n]);
+    }
+}
+
+ROC_ATTR_AVX2 void avx2_decode_int16(sample_t* out, const int16_t* in, size_t n_samples) {
+    const __m256i v_swap = avx2_swap16_mask();
+    const __m256 v_scale = _mm256_set1_ps(1.0f / 32768.0f);
+
+    size_t n = 0;
+
+    for (; n + 16 <= n_samples; n += 16) {
+        const __m256i x = _mm256_shuffle_epi8(
+            _mm256_loadu_si256((const __m256i*)(in + n)), v_swap);
+
+        const __m256i lo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(x));
+        const __m256i hi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(x, 1));
+
+        _mm256_storeu_ps(out + n, _mm256_mul_ps(_mm256_cvtepi32_ps(lo), v_scale));
+        _mm256_storeu_ps(out + n + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(hi), v_scale));
+    }
+
+    for (; n < n_samples; n++) {
+        out[n] = decode_sample(in[n]);
+    }
+}
+
+} // namespace
+
+const PCMKernel SSE2PCMKernel = {
+    PCMKernel_SSE2,
+    "sse2",
+    sse2_encode_int16,
+    sse2_decode_int16,
+};
+
+const PCMKernel AVX2PCMKernel = {
+    PCMKernel_AVX2,
+    "avx2",
+    avx2_encode_int16,
+    avx2_decode_int16,
+};
+
+} // namespace audio
+} // namespace roc
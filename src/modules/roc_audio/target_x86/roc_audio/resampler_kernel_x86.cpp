@@ -0,0 +1,424 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <immintrin.h>
+
+#include "roc_audio/resampler_kernel_x86.h"
+#include "roc_core/cpu_attributes.h"
+
+// Some GCC versions produce false positive warnings for their own AVX-512
+// intrinsics, which use intentionally uninitialized variables.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+// Interpolate sinc table at given position.
+// Must match generic_compute_window() exactly.
+inline sample_t
+sinc_at(const sample_t* sinc_table, uint32_t pos, size_t shift, sample_t fract) {
+    const size_t index = pos >> shift;
+
+    const sample_t hl = sinc_table[index];
+    const sample_t hh = sinc_table[index + 1];
+
+    return hl + fract * (hh - hl);
+}
+
+// Deinterleave frames that are not handled by vectorized loops.
+// Must match generic_deinterleave() exactly.
+inline void scalar_deinterleave(sample_t* planes,
+                                size_t plane_stride,
+                                const sample_t* samples,
+                                size_t n_frames,
+                                size_t num_channels) {
+    for (size_t channel = 0; channel < num_channels; channel++) {
+        sample_t* plane = planes + channel * plane_stride;
+        const sample_t* in = samples + channel;
+
+        for (size_t n = 0; n < n_frames; n++) {
+            plane[n] = in[n * num_channels];
+        }
+    }
+}
+
+ROC_ATTR_SSE2 inline float sse2_hsum(__m128 v) {
+    v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    v = _mm_add_ss(v, _mm_shuffle_ps(v, v, 0x1));
+    return _mm_cvtss_f32(v);
+}
+
+ROC_ATTR_SSE2 void sse2_compute_window(sample_t* coeffs,
+                                       size_t n_coeffs,
+                                       const sample_t* sinc_table,
+                                       uint32_t pos,
+                                       uint32_t step,
+                                       size_t shift,
+                                       sample_t fract,
+                                       sample_t divisor) {
+    const __m128 v_fract = _mm_set1_ps(fract);
+    const __m128 v_divisor = _mm_set1_ps(divisor);
+
+    size_t n = 0;
+
+    // SSE2 has no gather, so indices are computed and loaded one by one,
+    // and only interpolation and scaling are vectorized.
+    for (; n + 4 <= n_coeffs; n += 4) {
+        const size_t i0 = pos >> shift;
+        const size_t i1 = (pos + step) >> shift;
+        const size_t i2 = (pos + step * 2) >> shift;
+        const size_t i3 = (pos + step * 3) >> shift;
+
+        const __m128 hl = _mm_setr_ps(sinc_table[i0], sinc_table[i1], sinc_table[i2],
+                                      sinc_table[i3]);
+        const __m128 hh = _mm_setr_ps(sinc_table[i0 + 1], sinc_table[i1 + 1],
+                                      sinc_table[i2 + 1], sinc_table[i3 + 1]);
+
+        const __m128 h = _mm_add_ps(hl, _mm_mul_ps(v_fract, _mm_sub_ps(hh, hl)));
+        _mm_storeu_ps(coeffs + n, _mm_div_ps(h, v_divisor));
+
+        pos += step * 4;
+    }
+
+    for (; n < n_coeffs; n++) {
+        coeffs[n] = sinc_at(sinc_table, pos, shift, fract) / divisor;
+        pos += step;
+    }
+}
+
+ROC_ATTR_SSE2 sample_t sse2_convolve(const sample_t* coeffs,
+                                     const sample_t* samples,
+                                     size_t stride,
+                                     size_t n_coeffs) {
+    __m128 v_acc = _mm_setzero_ps();
+
+    size_t n = 0;
+
+    if (stride == 1) {
+        for (; n + 4 <= n_coeffs; n += 4) {
+            v_acc = _mm_add_ps(
+                v_acc, _mm_mul_ps(_mm_loadu_ps(coeffs + n), _mm_loadu_ps(samples + n)));
+        }
+    } else {
+        for (; n + 4 <= n_coeffs; n += 4) {
+            const sample_t* s = samples + n * stride;
+            const __m128 v_samples =
+                _mm_setr_ps(s[0], s[stride], s[stride * 2], s[stride * 3]);
+            v_acc = _mm_add_ps(v_acc, _mm_mul_ps(_mm_loadu_ps(coeffs + n), v_samples));
+        }
+    }
+
+    sample_t accumulator = sse2_hsum(v_acc);
+
+    for (; n < n_coeffs; n++) {
+        accumulator += coeffs[n] * samples[n * stride];
+    }
+
+    return accumulator;
+}
+
+ROC_ATTR_SSE2 void sse2_deinterleave(sample_t* planes,
+                                     size_t plane_stride,
+                                     const sample_t* samples,
+                                     size_t n_frames,
+                                     size_t num_channels) {
+    if (num_channels == 1) {
+        memcpy(planes, samples, n_frames * sizeof(sample_t));
+        return;
+    }
+
+    size_t n = 0;
+
+    // Only stereo is vectorized, other layouts are rare.
+    if (num_channels == 2) {
+        sample_t* left = planes;
+        sample_t* right = planes + plane_stride;
+
+        for (; n + 4 <= n_frames; n += 4) {
+            const __m128 a = _mm_loadu_ps(samples + n * 2);
+            const __m128 b = _mm_loadu_ps(samples + n * 2 + 4);
+
+            _mm_storeu_ps(left + n, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(right + n, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+        }
+    }
+
+    scalar_deinterleave(planes + n, plane_stride, samples + n * num_channels,
+                        n_frames - n, num_channels);
+}
+
+ROC_ATTR_AVX2 void avx2_compute_window(sample_t* coeffs,
+                                       size_t n_coeffs,
+                                       const sample_t* sinc_table,
+                                       uint32_t pos,
+                                       uint32_t step,
+                                       size_t shift,
+                                       sample_t fract,
+                                       sample_t divisor) {
+    const __m256 v_fract = _mm256_set1_ps(fract);
+    const __m256 v_divisor = _mm256_set1_ps(divisor);
+
+    const __m128i v_shift = _mm_cvtsi32_si128((int)shift);
+    const __m256i v_one = _mm256_set1_epi32(1);
+    const __m256i v_step = _mm256_set1_epi32((int)(step * 8));
+
+    __m256i v_pos = _mm256_add_epi32(
+        _mm256_set1_epi32((int)pos),
+        _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                           _mm256_set1_epi32((int)step)));
+
+    size_t n = 0;
+
+    for (; n + 8 <= n_coeffs; n += 8) {
+        const __m256i v_index = _mm256_srl_epi32(v_pos, v_shift);
+
+        const __m256 hl = _mm256_i32gather_ps(sinc_table, v_index, 4);
+        const __m256 hh =
+            _mm256_i32gather_ps(sinc_table, _mm256_add_epi32(v_index, v_one), 4);
+
+        const __m256 h =
+            _mm256_add_ps(hl, _mm256_mul_ps(v_fract, _mm256_sub_ps(hh, hl)));
+        _mm256_storeu_ps(coeffs + n, _mm256_div_ps(h, v_divisor));
+
+        v_pos = _mm256_add_epi32(v_pos, v_step);
+    }
+
+    pos += (uint32_t)n * step;
+
+    for (; n < n_coeffs; n++) {
+        coeffs[n] = sinc_at(sinc_table, pos, shift, fract) / divisor;
+        pos += step;
+    }
+}
+
+ROC_ATTR_AVX2 sample_t avx2_convolve(const sample_t* coeffs,
+                                     const sample_t* samples,
+                                     size_t stride,
+                                     size_t n_coeffs) {
+    __m256 v_acc = _mm256_setzero_ps();
+
+    size_t n = 0;
+
+    if (stride == 1) {
+        for (; n + 8 <= n_coeffs; n += 8) {
+            v_acc = _mm256_add_ps(v_acc,
+                                  _mm256_mul_ps(_mm256_loadu_ps(coeffs + n),
+                                                _mm256_loadu_ps(samples + n)));
+        }
+    } else {
+        const __m256i v_index = _mm256_mullo_epi32(
+            _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32((int)stride));
+
+        for (; n + 8 <= n_coeffs; n += 8) {
+            const __m256 v_samples =
+                _mm256_i32gather_ps(samples + n * stride, v_index, 4);
+            v_acc = _mm256_add_ps(v_acc,
+                                  _mm256_mul_ps(_mm256_loadu_ps(coeffs + n), v_samples));
+        }
+    }
+
+    const __m128 v_half = _mm_add_ps(_mm256_castps256_ps128(v_acc),
+                                     _mm256_extractf128_ps(v_acc, 1));
+
+    sample_t accumulator = sse2_hsum(v_half);
+
+    for (; n < n_coeffs; n++) {
+        accumulator += coeffs[n] * samples[n * stride];
+    }
+
+    return accumulator;
+}
+
+ROC_ATTR_AVX2 void avx2_deinterleave(sample_t* planes,
+                                     size_t plane_stride,
+                                     const sample_t* samples,
+                                     size_t n_frames,
+                                     size_t num_channels) {
+    if (num_channels == 1) {
+        memcpy(planes, samples, n_frames * sizeof(sample_t));
+        return;
+    }
+
+    size_t n = 0;
+
+    // Only stereo is vectorized, other layouts are rare.
+    if (num_channels == 2) {
+        sample_t* left = planes;
+        sample_t* right = planes + plane_stride;
+
+        for (; n + 8 <= n_frames; n += 8) {
+            const __m256 a = _mm256_loadu_ps(samples + n * 2);
+            const __m256 b = _mm256_loadu_ps(samples + n * 2 + 8);
+
+            // shuffle works within 128-bit lanes, so pairs of samples
+            // are reordered afterwards
+            const __m256 l = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m256 r = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+
+            _mm256_storeu_ps(left + n,
+                             _mm256_castpd_ps(_mm256_permute4x64_pd(
+                                 _mm256_castps_pd(l), _MM_SHUFFLE(3, 1, 2, 0))));
+            _mm256_storeu_ps(right + n,
+                             _mm256_castpd_ps(_mm256_permute4x64_pd(
+                                 _mm256_castps_pd(r), _MM_SHUFFLE(3, 1, 2, 0))));
+        }
+    }
+
+    scalar_deinterleave(planes + n, plane_stride, samples + n * num_channels,
+                        n_frames - n, num_channels);
+}
+
+ROC_ATTR_AVX512 void avx512_compute_window(sample_t* coeffs,
+                                           size_t n_coeffs,
+                                           const sample_t* sinc_table,
+                                           uint32_t pos,
+                                           uint32_t step,
+                                           size_t shift,
+                                           sample_t fract,
+                                           sample_t divisor) {
+    const __m512 v_fract = _mm512_set1_ps(fract);
+    const __m512 v_divisor = _mm512_set1_ps(divisor);
+
+    const __m128i v_shift = _mm_cvtsi32_si128((int)shift);
+    const __m512i v_one = _mm512_set1_epi32(1);
+    const __m512i v_step = _mm512_set1_epi32((int)(step * 16));
+
+    __m512i v_pos = _mm512_add_epi32(
+        _mm512_set1_epi32((int)pos),
+        _mm512_mullo_epi32(
+            _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+            _mm512_set1_epi32((int)step)));
+
+    size_t n = 0;
+
+    for (; n + 16 <= n_coeffs; n += 16) {
+        const __m512i v_index = _mm512_srl_epi32(v_pos, v_shift);
+
+        const __m512 hl = _mm512_i32gather_ps(v_index, sinc_table, 4);
+        const __m512 hh =
+            _mm512_i32gather_ps(_mm512_add_epi32(v_index, v_one), sinc_table, 4);
+
+        const __m512 h =
+            _mm512_add_ps(hl, _mm512_mul_ps(v_fract, _mm512_sub_ps(hh, hl)));
+        _mm512_storeu_ps(coeffs + n, _mm512_div_ps(h, v_divisor));
+
+        v_pos = _mm512_add_epi32(v_pos, v_step);
+    }
+
+    pos += (uint32_t)n * step;
+
+    for (; n < n_coeffs; n++) {
+        coeffs[n] = sinc_at(sinc_table, pos, shift, fract) / divisor;
+        pos += step;
+    }
+}
+
+ROC_ATTR_AVX512 sample_t avx512_convolve(const sample_t* coeffs,
+                                         const sample_t* samples,
+                                         size_t stride,
+                                         size_t n_coeffs) {
+    __m512 v_acc = _mm512_setzero_ps();
+
+    size_t n = 0;
+
+    if (stride == 1) {
+        for (; n + 16 <= n_coeffs; n += 16) {
+            v_acc = _mm512_add_ps(v_acc,
+                                  _mm512_mul_ps(_mm512_loadu_ps(coeffs + n),
+                                                _mm512_loadu_ps(samples + n)));
+        }
+    } else {
+        const __m512i v_index = _mm512_mullo_epi32(
+            _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+            _mm512_set1_epi32((int)stride));
+
+        for (; n + 16 <= n_coeffs; n += 16) {
+            const __m512 v_samples =
+                _mm512_i32gather_ps(v_index, samples + n * stride, 4);
+            v_acc = _mm512_add_ps(v_acc,
+                                  _mm512_mul_ps(_mm512_loadu_ps(coeffs + n), v_samples));
+        }
+    }
+
+    sample_t accumulator = _mm512_reduce_add_ps(v_acc);
+
+    for (; n < n_coeffs; n++) {
+        accumulator += coeffs[n] * samples[n * stride];
+    }
+
+    return accumulator;
+}
+
+ROC_ATTR_AVX512 void avx512_deinterleave(sample_t* planes,
+                                         size_t plane_stride,
+                                         const sample_t* samples,
+                                         size_t n_frames,
+                                         size_t num_channels) {
+    if (num_channels == 1) {
+        memcpy(planes, samples, n_frames * sizeof(sample_t));
+        return;
+    }
+
+    size_t n = 0;
+
+    // Only stereo is vectorized, other layouts are rare.
+    if (num_channels == 2) {
+        sample_t* left = planes;
+        sample_t* right = planes + plane_stride;
+
+        const __m512i v_even = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18,
+                                                 20, 22, 24, 26, 28, 30);
+        const __m512i v_odd = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21,
+                                                23, 25, 27, 29, 31);
+
+        for (; n + 16 <= n_frames; n += 16) {
+            const __m512 a = _mm512_loadu_ps(samples + n * 2);
+            const __m512 b = _mm512_loadu_ps(samples + n * 2 + 16);
+
+            _mm512_storeu_ps(left + n, _mm512_permutex2var_ps(a, v_even, b));
+            _mm512_storeu_ps(right + n, _mm512_permutex2var_ps(a, v_odd, b));
+        }
+    }
+
+    scalar_deinterleave(planes + n, plane_stride, samples + n * num_channels,
+                        n_frames - n, num_channels);
+}
+
+} // namespace
+
+const ResamplerKernel SSE2ResamplerKernel = {
+    ResamplerKernel_SSE2,
+    "sse2",
+    sse2_compute_window,
+    sse2_convolve,
+    sse2_deinterleave,
+};
+
+const ResamplerKernel AVX2ResamplerKernel = {
+    ResamplerKernel_AVX2,
+    "avx2",
+    avx2_compute_window,
+    avx2_convolve,
+    avx2_deinterleave,
+};
+
+const ResamplerKernel AVX512ResamplerKernel = {
+    ResamplerKernel_AVX512,
+    "avx512",
+    avx512_compute_window,
+    avx512_convolve,
+    avx512_deinterleave,
+};
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/target_x86/roc_audio/resampler_kernel_x86.h
+//! @brief x86 SIMD resampler kernels.
+
+#ifndef ROC_AUDIO_RESAMPLER_KERNEL_X86_H_
+#define ROC_AUDIO_RESAMPLER_KERNEL_X86_H_
+
+#include "roc_audio/resampler_kernel.h"
+
+namespace roc {
+namespace audio {
+
+//! SSE2 resampler kernel.
+//! @remarks
+//!  Should be used only if the CPU supports SSE2.
+extern const ResamplerKernel SSE2ResamplerKernel;
+
+//! AVX2 resampler kernel.
+//! @remarks
+//!  Should be used only if the CPU supports AVX2.
+extern const ResamplerKernel AVX2ResamplerKernel;
+
+//! AVX-512 resampler kernel.
+//! @remarks
+//!  Should be used only if the CPU supports AVX-512F.
+extern const ResamplerKernel AVX512ResamplerKernel;
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_RESAMPLER_KERNEL_X86_H_
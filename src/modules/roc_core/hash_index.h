@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/hash_index.h
+//! @brief Open-addressing hash index.
+
+#ifndef ROC_CORE_HASH_INDEX_H_
+#define ROC_CORE_HASH_INDEX_H_
+
+#include "roc_core/iallocator.h"
+#include "roc_core/log.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/panic.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! Open-addressing hash index.
+//!
+//! Maps keys to objects owned elsewhere, e.g. by a List, so that an object
+//! can be found by its key in constant average time. The index doesn't
+//! acquire ownership of objects, and an object should be removed from the
+//! index before it's destroyed.
+//!
+//! Uses linear probing. Capacity is a power of two and is doubled when the
+//! index becomes half full. Removal shifts following objects back instead
+//! of leaving tombstones, so lookups don't degrade after many removals.
+//!
+//! @tparam T defines object type, it should provide:
+//!  - key() method, returning object key
+//!  - static key_hash(key) method, returning size_t hash of key
+//!  - static key_equal(key1, key2) method, returning true if keys are equal
+//!
+//! @tparam Key defines key type.
+template <class T, class Key> class HashIndex : public NonCopyable<> {
+public:
+    //! Initialize empty index.
+    explicit HashIndex(IAllocator& allocator)
+        : allocator_(allocator)
+        , slots_(NULL)
+        , capacity_(0)
+        , size_(0) {
+    }
+
+    ~HashIndex() {
+        if (slots_) {
+            allocator_.deallocate(slots_);
+        }
+    }
+
+    //! Get number of objects in index.
+    size_t size() const {
+        return size_;
+    }
+
+    //! Find object by key.
+    //! @returns
+    //!  object with given key or null if there is no such object.
+    T* find(const Key& key) const {
+        if (size_ == 0) {
+            return NULL;
+        }
+
+        const size_t mask = capacity_ - 1;
+
+        for (size_t n = T::key_hash(key) & mask;; n = (n + 1) & mask) {
+            T* obj = slots_[n];
+            if (!obj) {
+                return NULL;
+            }
+            if (T::key_equal(obj->key(), key)) {
+                return obj;
+            }
+        }
+    }
+
+    //! Insert object into index.
+    //! @returns
+    //!  false if allocation failed.
+    //! @pre
+    //!  Index should not contain object with same key.
+    bool insert(T& obj) {
+        if (find(obj.key())) {
+            roc_panic("hash index: attempting to insert object with existing key");
+        }
+
+        if ((size_ + 1) * 2 > capacity_) {
+            if (!rehash_(capacity_ != 0 ? capacity_ * 2 : (size_t)MinCapacity)) {
+                return false;
+            }
+        }
+
+        insert_(obj);
+        size_++;
+
+        return true;
+    }
+
+    //! Remove object from index.
+    //! @pre
+    //!  Object should be in index.
+    void remove(T& obj) {
+        const size_t mask = capacity_ - 1;
+
+        size_t hole = find_slot_(obj);
+
+        slots_[hole] = NULL;
+        size_--;
+
+        // move back objects that can't be reached anymore because of the hole,
+        // i.e. objects whose home slot is not between the hole and their slot
+        for (size_t n = (hole + 1) & mask; slots_[n]; n = (n + 1) & mask) {
+            const size_t home = T::key_hash(slots_[n]->key()) & mask;
+
+            if (((n - home) & mask) >= ((n - hole) & mask)) {
+                slots_[hole] = slots_[n];
+                slots_[n] = NULL;
+                hole = n;
+            }
+        }
+    }
+
+private:
+    enum { MinCapacity = 16 };
+
+    size_t find_slot_(const T& obj) const {
+        if (size_ != 0) {
+            const size_t mask = capacity_ - 1;
+
+            for (size_t n = T::key_hash(obj.key()) & mask; slots_[n];
+                 n = (n + 1) & mask) {
+                if (slots_[n] == &obj) {
+                    return n;
+                }
+            }
+        }
+
+        roc_panic("hash index: attempting to remove object that is not in index");
+    }
+
+    void insert_(T& obj) {
+        const size_t mask = capacity_ - 1;
+
+        size_t n = T::key_hash(obj.key()) & mask;
+        while (slots_[n]) {
+            n = (n + 1) & mask;
+        }
+
+        slots_[n] = &obj;
+    }
+
+    bool rehash_(size_t capacity) {
+        T** new_slots = (T**)allocator_.allocate(capacity * sizeof(T*));
+        if (!new_slots) {
+            roc_log(LogError, "hash index: can't allocate memory: capacity=%lu",
+                    (unsigned long)capacity);
+            return false;
+        }
+
+        for (size_t n = 0; n < capacity; n++) {
+            new_slots[n] = NULL;
+        }
+
+        T** old_slots = slots_;
+        const size_t old_capacity = capacity_;
+
+        slots_ = new_slots;
+        capacity_ = capacity;
+
+        for (size_t n = 0; n < old_capacity; n++) {
+            if (old_slots[n]) {
+                insert_(*old_slots[n]);
+            }
+        }
+
+        if (old_slots) {
+            allocator_.deallocate(old_slots);
+        }
+
+        return true;
+    }
+
+    IAllocator& allocator_;
+
+    T** slots_;
+    size_t capacity_;
+    size_t size_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_HASH_INDEX_H_
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/target_x86/roc_core/cpu_attributes.h
+//! @brief CPU-specific function attributes.
+
+#ifndef ROC_CORE_CPU_ATTRIBUTES_H_
+#define ROC_CORE_CPU_ATTRIBUTES_H_
+
+// Kernels are compiled for their instruction sets using function attributes,
+// so that the rest of the code is still built for the baseline CPU and the
+// kernel is selected at run time, see cpu_supports().
+
+//! Function is compiled for SSE2.
+#define ROC_ATTR_SSE2 __attribute__((target("sse2")))
+
+//! Function is compiled for SSSE3.
+#define ROC_ATTR_SSSE3 __attribute__((target("ssse3")))
+
+//! Function is compiled for AVX2.
+#define ROC_ATTR_AVX2 __attribute__((target("avx2")))
+
+//! Function is compiled for AVX-512 Foundation.
+#define ROC_ATTR_AVX512 __attribute__((target("avx512f")))
+
+#endif // ROC_CORE_CPU_ATTRIBUTES_H_
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/cpu_features.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace core {
+
+bool cpu_supports(CpuFeature feature) {
+    // Usually called by libgcc constructor, but it's safe to call it again,
+    // and required if we're called from another global constructor.
+    __builtin_cpu_init();
+
+    switch (feature) {
+    case CpuFeature_SSE2:
+        return __builtin_cpu_supports("sse2");
+
+    case CpuFeature_SSSE3:
+        return __builtin_cpu_supports("ssse3");
+
+    case CpuFeature_AVX2:
+        return __builtin_cpu_supports("avx2");
+
+    case CpuFeature_AVX512F:
+        return __builtin_cpu_supports("avx512f");
+    }
+
+    roc_panic("cpu features: unknown feature %d", (int)feature);
+}
+
+} // namespace core
+} // namespace roc
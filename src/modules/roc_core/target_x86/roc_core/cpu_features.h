@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/target_x86/roc_core/cpu_features.h
+//! @brief CPU features.
+
+#ifndef ROC_CORE_CPU_FEATURES_H_
+#define ROC_CORE_CPU_FEATURES_H_
+
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+//! x86 instruction set extensions.
+enum CpuFeature {
+    //! SSE2 (always available on x86_64).
+    CpuFeature_SSE2,
+
+    //! SSSE3.
+    CpuFeature_SSSE3,
+
+    //! AVX2.
+    CpuFeature_AVX2,
+
+    //! AVX-512 Foundation.
+    CpuFeature_AVX512F
+};
+
+//! Check if the CPU we're running on supports given feature.
+//! @remarks
+//!  Takes into account both CPUID and whether the OS saves the
+//!  corresponding register state.
+bool cpu_supports(CpuFeature feature);
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_CPU_FEATURES_H_
@@ -11,6 +11,10 @@
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 #include "roc_core/unique_ptr.h"
+#include "roc_fec/parity_decoder.h"
+#include "roc_fec/parity_encoder.h"
+#include "roc_fec/rs8m_decoder.h"
+#include "roc_fec/rs8m_encoder.h"
 #include "roc_packet/fec_scheme_to_str.h"
 
 #ifdef ROC_TARGET_OPENFEC
@@ -46,11 +50,35 @@ CodecMap::CodecMap()
 
         codec.scheme = packet::FEC_ReedSolomon_M8;
         add_codec_(codec);
+    }
+    {
+        Codec codec;
+        codec.encoder_ctor = ctor_func<IBlockEncoder, OFEncoder>;
+        codec.decoder_ctor = ctor_func<IBlockDecoder, OFDecoder>;
 
         codec.scheme = packet::FEC_LDPC_Staircase;
         add_codec_(codec);
     }
+#else  // !ROC_TARGET_OPENFEC
+    {
+        // native implementation is used only when OpenFEC is not available,
+        // until its compatibility with OpenFEC is verified
+        Codec codec;
+        codec.encoder_ctor = ctor_func<IBlockEncoder, RS8MEncoder>;
+        codec.decoder_ctor = ctor_func<IBlockDecoder, RS8MDecoder>;
+
+        codec.scheme = packet::FEC_ReedSolomon_M8;
+        add_codec_(codec);
+    }
 #endif // ROC_TARGET_OPENFEC
+    {
+        Codec codec;
+        codec.encoder_ctor = ctor_func<IBlockEncoder, ParityEncoder>;
+        codec.decoder_ctor = ctor_func<IBlockDecoder, ParityDecoder>;
+
+        codec.scheme = packet::FEC_Parity;
+        add_codec_(codec);
+    }
 }
 
 IBlockEncoder* CodecMap::new_encoder(const CodecConfig& config,
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/gf256.h
+//! @brief GF(2^8) arithmetic.
+
+#ifndef ROC_FEC_GF256_H_
+#define ROC_FEC_GF256_H_
+
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace fec {
+
+//! Powers of the generator of GF(2^8).
+//! @remarks
+//!  The field is defined by the primitive polynomial x^8+x^4+x^3+x^2+1
+//!  (0x11D), which is the one used by RFC 6865. The table has 510 entries,
+//!  so that it can be indexed by a sum of two logarithms.
+extern const uint8_t gf256_exp_table[510];
+
+//! Discrete logarithms in GF(2^8).
+extern const uint8_t gf256_log_table[256];
+
+//! Multiply two field elements.
+inline uint8_t gf256_mul(uint8_t a, uint8_t b) {
+    if (a == 0 || b == 0) {
+        return 0;
+    }
+    return gf256_exp_table[gf256_log_table[a] + gf256_log_table[b]];
+}
+
+//! Get multiplicative inverse of non-zero field element.
+inline uint8_t gf256_inv(uint8_t a) {
+    return gf256_exp_table[255 - gf256_log_table[a]];
+}
+
+//! Get n-th power of the generator.
+inline uint8_t gf256_exp(size_t n) {
+    return gf256_exp_table[n % 255];
+}
+
+//! Invert square matrix in place.
+//!
+//! @b Parameters
+//!  - @p matrix - row-major matrix of @p size x @p size elements
+//!  - @p scratch - temporary buffer of @p size x @p size elements
+//!  - @p size - number of rows and columns
+//!
+//! @returns
+//!  false if the matrix is singular, in which case its contents are undefined.
+bool gf256_invert_matrix(uint8_t* matrix, uint8_t* scratch, size_t size);
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_GF256_H_
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/gf256_kernel.h"
+#include "roc_core/panic.h"
+#include "roc_fec/gf256.h"
+
+#ifdef ROC_TARGET_X86
+#include "roc_core/cpu_features.h"
+#include "roc_fec/gf256_kernel_x86.h"
+#endif // ROC_TARGET_X86
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+void generic_add(uint8_t* dst, const uint8_t* src, size_t size) {
+    size_t n = 0;
+
+    // buffers may be unaligned, so words are copied instead of dereferenced
+    for (; n + sizeof(uint64_t) <= size; n += sizeof(uint64_t)) {
+        uint64_t x, y;
+        memcpy(&x, src + n, sizeof(x));
+        memcpy(&y, dst + n, sizeof(y));
+        y ^= x;
+        memcpy(dst + n, &y, sizeof(y));
+    }
+
+    for (; n < size; n++) {
+        dst[n] ^= src[n];
+    }
+}
+
+void generic_mul_add(uint8_t* dst, const uint8_t* src, uint8_t coef, size_t size) {
+    if (coef == 0) {
+        return;
+    }
+
+    if (coef == 1) {
+        generic_add(dst, src, size);
+        return;
+    }
+
+    uint8_t lo[16], hi[16];
+    gf256_nibble_tables(coef, lo, hi);
+
+    for (size_t n = 0; n < size; n++) {
+        dst[n] ^= lo[src[n] & 0xf] ^ hi[src[n] >> 4];
+    }
+}
+
+const GF256Kernel GenericGF256Kernel = {
+    GF256Kernel_Generic,
+    "generic",
+    generic_mul_add,
+    generic_add,
+};
+
+} // namespace
+
+void gf256_nibble_tables(uint8_t coef, uint8_t* lo, uint8_t* hi) {
+    for (size_t x = 0; x < 16; x++) {
+        lo[x] = gf256_mul(coef, (uint8_t)x);
+        hi[x] = gf256_mul(coef, (uint8_t)(x << 4));
+    }
+}
+
+const GF256Kernel* gf256_kernel(GF256KernelType type) {
+    switch (type) {
+    case GF256Kernel_Auto:
+#ifdef ROC_TARGET_X86
+        if (const GF256Kernel* kernel = gf256_kernel(GF256Kernel_AVX2)) {
+            return kernel;
+        }
+        if (const GF256Kernel* kernel = gf256_kernel(GF256Kernel_SSSE3)) {
+            return kernel;
+        }
+#endif // ROC_TARGET_X86
+        return &GenericGF256Kernel;
+
+    case GF256Kernel_Generic:
+        return &GenericGF256Kernel;
+
+    case GF256Kernel_SSSE3:
+#ifdef ROC_TARGET_X86
+        if (core::cpu_supports(core::CpuFeature_SSSE3)) {
+            return &SSSE3GF256Kernel;
+        }
+#endif // ROC_TARGET_X86
+        return NULL;
+
+    case GF256Kernel_AVX2:
+#ifdef ROC_TARGET_X86
+        if (core::cpu_supports(core::CpuFeature_AVX2)) {
+            return &AVX2GF256Kernel;
+        }
+#endif // ROC_TARGET_X86
+        return NULL;
+    }
+
+    roc_panic("gf256 kernel: unknown kernel type %d", (int)type);
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/gf256_kernel.h
+//! @brief GF(2^8) kernel.
+
+#ifndef ROC_FEC_GF256_KERNEL_H_
+#define ROC_FEC_GF256_KERNEL_H_
+
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace fec {
+
+//! GF(2^8) kernel type.
+enum GF256KernelType {
+    //! Select the fastest kernel supported by the CPU.
+    GF256Kernel_Auto,
+
+    //! Portable scalar implementation.
+    GF256Kernel_Generic,
+
+    //! SSSE3 implementation.
+    GF256Kernel_SSSE3,
+
+    //! AVX2 implementation.
+    GF256Kernel_AVX2
+};
+
+//! GF(2^8) kernel.
+//! @remarks
+//!  Function table implementing operations on symbols, i.e. byte vectors,
+//!  which are the inner loops of Reed-Solomon encoding and decoding.
+//!  All implementations produce identical results.
+struct GF256Kernel {
+    //! Kernel type.
+    GF256KernelType type;
+
+    //! Kernel name.
+    const char* name;
+
+    //! Multiply symbol by coefficient and add it to another symbol.
+    //! @remarks
+    //!  Computes dst[i] += coef * src[i] for every byte. Buffers don't need
+    //!  to be aligned, but should not overlap.
+    void (*mul_add)(uint8_t* dst, const uint8_t* src, uint8_t coef, size_t size);
+
+    //! Add symbol to another symbol.
+    //! @remarks
+    //!  Computes dst[i] += src[i] for every byte, which is XOR in GF(2^8).
+    //!  Same as mul_add() with coefficient 1, but cheaper. Buffers don't need
+    //!  to be aligned, but should not overlap.
+    void (*add)(uint8_t* dst, const uint8_t* src, size_t size);
+};
+
+//! Get GF(2^8) kernel.
+//! @returns
+//!  NULL if the given kernel is not supported by the build or by the CPU.
+//!  If @p type is GF256Kernel_Auto, never returns NULL.
+const GF256Kernel* gf256_kernel(GF256KernelType type);
+
+//! Build split-nibble multiplication tables for coefficient.
+//! @remarks
+//!  Fills @p lo and @p hi with 16 entries each, so that
+//!  coef * x == lo[x & 0xf] + hi[x >> 4]. These tables are used as
+//!  shuffle operands by the SIMD kernels.
+void gf256_nibble_tables(uint8_t coef, uint8_t* lo, uint8_t* hi);
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_GF256_KERNEL_H_
@@ -82,8 +82,9 @@ public:
     }
 
     //! Set encoding symbol ID.
-    void set_esi(uint16_t val) {
-        esi_ = core::hton16(val);
+    void set_esi(uint32_t val) {
+        roc_panic_if((val >> 16) != 0);
+        esi_ = core::hton16((uint16_t)val);
     }
 
     //! Get source block length.
@@ -158,8 +159,9 @@ public:
     }
 
     //! Set encoding symbol ID.
-    void set_esi(uint16_t val) {
-        esi_ = core::hton16(val);
+    void set_esi(uint32_t val) {
+        roc_panic_if((val >> 16) != 0);
+        esi_ = core::hton16((uint16_t)val);
     }
 
     //! Get source block length.
@@ -235,7 +237,7 @@ public:
     }
 
     //! Set encoding symbol ID.
-    void set_esi(uint16_t val) {
+    void set_esi(uint32_t val) {
         roc_panic_if((val >> 8) != 0);
         esi_ = (uint8_t)val;
     }
@@ -260,6 +262,316 @@ public:
     }
 };
 
+//! RLC Source FEC Payload ID (for m=8).
+//!
+//! @code
+//!    0                   1                   2                   3
+//!    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |                   Encoding Symbol ID (ESI)                    |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! @endcode
+class ROC_ATTR_PACKED RLC_Source_PayloadID {
+private:
+    //! Encoding symbol ID.
+    uint32_t esi_;
+
+public:
+    //! Get FEC scheme to which these packets belong to.
+    static packet::FECScheme fec_scheme() {
+        return packet::FEC_RLC;
+    }
+
+    //! Clear header.
+    void clear() {
+        memset(this, 0, sizeof(*this));
+    }
+
+    //! Get source block number.
+    uint16_t sbn() const {
+        return 0;
+    }
+
+    //! Set source block number.
+    void set_sbn(uint16_t) {
+    }
+
+    //! Get encoding symbol ID.
+    uint32_t esi() const {
+        return core::ntoh32(esi_);
+    }
+
+    //! Set encoding symbol ID.
+    void set_esi(uint32_t val) {
+        esi_ = core::hton32(val);
+    }
+
+    //! Get source block length.
+    uint16_t k() const {
+        return 0;
+    }
+
+    //! Set source block length.
+    void set_k(uint16_t) {
+    }
+
+    //! Get number encoding symbols.
+    uint16_t n() const {
+        return 0;
+    }
+
+    //! Set number encoding symbols.
+    void set_n(uint16_t) {
+    }
+};
+
+//! RLC Repair FEC Payload ID (for m=8).
+//!
+//! @code
+//!    0                   1                   2                   3
+//!    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |       Repair_Key              |  DT   |NSS (# src symb in ew) |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |                   FirstSrcSymbol_ESI                          |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! @endcode
+//!
+//! @remarks
+//!  Repair key is mapped to source block number, the number of source symbols
+//!  in encoding window (NSS) is mapped to source block length, and the ESI of
+//!  the first source symbol in encoding window is mapped to encoding symbol ID.
+//!  Only dense codes are supported, i.e. the density threshold (DT) is always
+//!  written as 15, and packets with other values are reported as having zero
+//!  NSS, so that they're dropped.
+class ROC_ATTR_PACKED RLC_Repair_PayloadID {
+private:
+    //! Repair key.
+    uint16_t repair_key_;
+
+    //! Density threshold (4 bits) and number of source symbols (12 bits).
+    uint16_t dt_nss_;
+
+    //! Encoding symbol ID of first source symbol.
+    uint32_t esi_;
+
+public:
+    //! Get FEC scheme to which these packets belong to.
+    static packet::FECScheme fec_scheme() {
+        return packet::FEC_RLC;
+    }
+
+    //! Clear header.
+    void clear() {
+        memset(this, 0, sizeof(*this));
+        dt_nss_ = core::hton16(uint16_t(15 << 12));
+    }
+
+    //! Get repair key.
+    uint16_t sbn() const {
+        return core::ntoh16(repair_key_);
+    }
+
+    //! Set repair key.
+    void set_sbn(uint16_t val) {
+        repair_key_ = core::hton16(val);
+    }
+
+    //! Get encoding symbol ID of first source symbol in encoding window.
+    uint32_t esi() const {
+        return core::ntoh32(esi_);
+    }
+
+    //! Set encoding symbol ID of first source symbol in encoding window.
+    void set_esi(uint32_t val) {
+        esi_ = core::hton32(val);
+    }
+
+    //! Get density threshold.
+    uint8_t dt() const {
+        return uint8_t(core::ntoh16(dt_nss_) >> 12);
+    }
+
+    //! Get number of source symbols in encoding window.
+    uint16_t k() const {
+        if (dt() != 15) {
+            return 0;
+        }
+        return core::ntoh16(dt_nss_) & 0xfff;
+    }
+
+    //! Set number of source symbols in encoding window.
+    void set_k(uint16_t val) {
+        roc_panic_if((val >> 12) != 0);
+        dt_nss_ = core::hton16(uint16_t((core::ntoh16(dt_nss_) & 0xf000) | val));
+    }
+
+    //! Get number encoding symbols.
+    uint16_t n() const {
+        return 0;
+    }
+
+    //! Set number encoding symbols.
+    void set_n(uint16_t) {
+    }
+};
+
+//! XOR parity Source FEC Payload ID.
+//!
+//! Same layout as LDPC-Staircase Source FEC Payload ID.
+//!
+//! @code
+//!    0                   1                   2                   3
+//!    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |   Source Block Number (SBN)   |   Encoding Symbol ID (ESI)    |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |    Source Block Length (k)    |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! @endcode
+class ROC_ATTR_PACKED Parity_Source_PayloadID {
+private:
+    //! Source block number.
+    uint16_t sbn_;
+
+    //! Encoding symbol ID.
+    uint16_t esi_;
+
+    //! Source block length.
+    uint16_t k_;
+
+public:
+    //! Get FEC scheme to which these packets belong to.
+    static packet::FECScheme fec_scheme() {
+        return packet::FEC_Parity;
+    }
+
+    //! Clear header.
+    void clear() {
+        memset(this, 0, sizeof(*this));
+    }
+
+    //! Get source block number.
+    uint16_t sbn() const {
+        return core::ntoh16(sbn_);
+    }
+
+    //! Set source block number.
+    void set_sbn(uint16_t val) {
+        sbn_ = core::hton16(val);
+    }
+
+    //! Get encoding symbol ID.
+    uint16_t esi() const {
+        return core::ntoh16(esi_);
+    }
+
+    //! Set encoding symbol ID.
+    void set_esi(uint32_t val) {
+        roc_panic_if((val >> 16) != 0);
+        esi_ = core::hton16((uint16_t)val);
+    }
+
+    //! Get source block length.
+    uint16_t k() const {
+        return core::ntoh16(k_);
+    }
+
+    //! Set source block length.
+    void set_k(uint16_t val) {
+        k_ = core::hton16(val);
+    }
+
+    //! Get number encoding symbols.
+    uint16_t n() const {
+        return 0;
+    }
+
+    //! Set number encoding symbols.
+    void set_n(uint16_t) {
+    }
+};
+
+//! XOR parity Repair FEC Payload ID.
+//!
+//! Same layout as LDPC-Staircase Repair FEC Payload ID.
+//!
+//! @code
+//!    0                   1                   2                   3
+//!    0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |   Source Block Number (SBN)   |   Encoding Symbol ID (ESI)    |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//!   |    Source Block Length (k)    |  Number Encoding Symbols (n)  |
+//!   +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//! @endcode
+class ROC_ATTR_PACKED Parity_Repair_PayloadID {
+private:
+    //! Source block number.
+    uint16_t sbn_;
+
+    //! Encoding symbol ID.
+    uint16_t esi_;
+
+    //! Source block length.
+    uint16_t k_;
+
+    //! Number encoding symbols.
+    uint16_t n_;
+
+public:
+    //! Get FEC scheme to which these packets belong to.
+    static packet::FECScheme fec_scheme() {
+        return packet::FEC_Parity;
+    }
+
+    //! Clear header.
+    void clear() {
+        memset(this, 0, sizeof(*this));
+    }
+
+    //! Get source block number.
+    uint16_t sbn() const {
+        return core::ntoh16(sbn_);
+    }
+
+    //! Set source block number.
+    void set_sbn(uint16_t val) {
+        sbn_ = core::hton16(val);
+    }
+
+    //! Get encoding symbol ID.
+    uint16_t esi() const {
+        return core::ntoh16(esi_);
+    }
+
+    //! Set encoding symbol ID.
+    void set_esi(uint32_t val) {
+        roc_panic_if((val >> 16) != 0);
+        esi_ = core::hton16((uint16_t)val);
+    }
+
+    //! Get source block length.
+    uint16_t k() const {
+        return core::ntoh16(k_);
+    }
+
+    //! Set source block length.
+    void set_k(uint16_t val) {
+        k_ = core::hton16(val);
+    }
+
+    //! Get number encoding symbols.
+    uint16_t n() const {
+        return core::ntoh16(n_);
+    }
+
+    //! Set number encoding symbols.
+    void set_n(uint16_t val) {
+        n_ = core::hton16(val);
+    }
+};
+
 } // namespace fec
 } // namespace roc
 
@@ -38,6 +38,12 @@ public:
 
     //! Store source or repair packet buffer for current block.
     //!
+    //! @remarks
+    //!  Buffers may be set in any order, but each index may be set only once
+    //!  per block. If repair buffers are set before source buffers, the encoder
+    //!  may process every source buffer right when it's set, so that the work
+    //!  is spread across the block instead of being done in fill().
+    //!
     //! @pre
     //!  This method may be called only between begin() and end() calls.
     virtual void set(size_t index, const core::Slice<uint8_t>& buffer) = 0;
@@ -45,7 +51,8 @@ public:
     //! Fill all repair packets in current block.
     //!
     //! @pre
-    //!  This method may be called only between begin() and end() calls.
+    //!  This method may be called only between begin() and end() calls,
+    //!  after all source buffers are set.
     virtual void fill() = 0;
 
     //! Finish block.
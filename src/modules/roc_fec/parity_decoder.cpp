@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/parity_decoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace fec {
+
+ParityDecoder::ParityDecoder(const CodecConfig& config,
+                             core::BufferPool<uint8_t>& buffer_pool,
+                             core::IAllocator& allocator)
+    : sblen_(0)
+    , rblen_(0)
+    , payload_size_(0)
+    , kernel_(gf256_kernel(GF256Kernel_Auto))
+    , buffer_pool_(buffer_pool)
+    , buff_tab_(allocator)
+    , recv_tab_(allocator)
+    , has_new_packets_(false)
+    , valid_(false) {
+    if (config.scheme != packet::FEC_Parity) {
+        roc_panic("parity decoder: unexpected fec scheme");
+    }
+
+    roc_log(LogDebug, "parity decoder: initializing: kernel=%s", kernel_->name);
+
+    valid_ = true;
+}
+
+bool ParityDecoder::valid() const {
+    return valid_;
+}
+
+size_t ParityDecoder::max_block_length() const {
+    roc_panic_if_not(valid());
+
+    return ParityLayout::MaxBlockLength;
+}
+
+bool ParityDecoder::begin(size_t sblen, size_t rblen, size_t payload_size) {
+    roc_panic_if_not(valid());
+
+    if (!layout_.build(sblen, rblen)) {
+        return false;
+    }
+
+    if (!buff_tab_.resize(sblen + rblen) || !recv_tab_.resize(sblen + rblen)) {
+        return false;
+    }
+
+    sblen_ = sblen;
+    rblen_ = rblen;
+    payload_size_ = payload_size;
+
+    return true;
+}
+
+void ParityDecoder::set(size_t index, const core::Slice<uint8_t>& buffer) {
+    roc_panic_if_not(valid());
+
+    if (index >= sblen_ + rblen_) {
+        roc_panic("parity decoder: index out of bounds: index=%lu size=%lu",
+                  (unsigned long)index, (unsigned long)(sblen_ + rblen_));
+    }
+
+    if (!buffer) {
+        roc_panic("parity decoder: null buffer");
+    }
+
+    if (buffer.size() == 0 || buffer.size() != payload_size_) {
+        roc_panic("parity decoder: invalid payload size: cur=%lu new=%lu",
+                  (unsigned long)payload_size_, (unsigned long)buffer.size());
+    }
+
+    if (buff_tab_[index]) {
+        roc_panic("parity decoder: can't overwrite buffer: index=%lu",
+                  (unsigned long)index);
+    }
+
+    buff_tab_[index] = buffer;
+    recv_tab_[index] = true;
+
+    has_new_packets_ = true;
+}
+
+core::Slice<uint8_t> ParityDecoder::repair(size_t index) {
+    roc_panic_if_not(valid());
+
+    if (index >= sblen_ + rblen_) {
+        roc_panic("parity decoder: index out of bounds: index=%lu size=%lu",
+                  (unsigned long)index, (unsigned long)(sblen_ + rblen_));
+    }
+
+    // repair packets are never repaired, like in other decoders
+    if (!buff_tab_[index] && index < sblen_ && has_new_packets_) {
+        decode_();
+        has_new_packets_ = false;
+    }
+
+    return buff_tab_[index];
+}
+
+void ParityDecoder::end() {
+    roc_panic_if_not(valid());
+
+    report_();
+
+    for (size_t i = 0; i < buff_tab_.size(); ++i) {
+        buff_tab_[i] = core::Slice<uint8_t>();
+        recv_tab_[i] = false;
+    }
+
+    has_new_packets_ = false;
+}
+
+// Repairs every symbol that is the only missing symbol of some received
+// repair symbol, and repeats while this makes progress, since every repaired
+// symbol may leave its other row or column with a single missing symbol.
+void ParityDecoder::decode_() {
+    bool progress = true;
+
+    while (progress) {
+        progress = false;
+
+        for (size_t r = 0; r < rblen_; ++r) {
+            if (buff_tab_[sblen_ + r] && repair_symbol_(r)) {
+                progress = true;
+            }
+        }
+    }
+}
+
+bool ParityDecoder::repair_symbol_(size_t repair_index) {
+    const size_t first = layout_.first(repair_index);
+    const size_t step = layout_.step(repair_index);
+    const size_t count = layout_.count(repair_index);
+
+    size_t lost_index = 0;
+    size_t n_lost = 0;
+
+    for (size_t n = 0; n < count; n++) {
+        const size_t i = first + n * step;
+
+        if (!buff_tab_[i]) {
+            lost_index = i;
+            if (++n_lost > 1) {
+                return false;
+            }
+        }
+    }
+
+    if (n_lost == 0) {
+        return false;
+    }
+
+    core::Slice<uint8_t> buffer = make_buffer_();
+    if (!buffer) {
+        return false;
+    }
+
+    memcpy(buffer.data(), buff_tab_[sblen_ + repair_index].data(), payload_size_);
+
+    for (size_t n = 0; n < count; n++) {
+        const size_t i = first + n * step;
+
+        if (i != lost_index) {
+            kernel_->add(buffer.data(), buff_tab_[i].data(), payload_size_);
+        }
+    }
+
+    buff_tab_[lost_index] = buffer;
+
+    return true;
+}
+
+core::Slice<uint8_t> ParityDecoder::make_buffer_() {
+    core::Slice<uint8_t> buffer = new (buffer_pool_) core::Buffer<uint8_t>(buffer_pool_);
+
+    if (!buffer) {
+        roc_log(LogError, "parity decoder: can't allocate buffer");
+        return core::Slice<uint8_t>();
+    }
+
+    if (buffer.capacity() < payload_size_) {
+        roc_log(LogError, "parity decoder: packet size too large: size=%lu max=%lu",
+                (unsigned long)payload_size_, (unsigned long)buffer.capacity());
+        return core::Slice<uint8_t>();
+    }
+
+    buffer.resize(payload_size_);
+
+    return buffer;
+}
+
+void ParityDecoder::report_() {
+    size_t n_lost = 0, n_repaired = 0;
+
+    for (size_t i = 0; i < sblen_; ++i) {
+        if (recv_tab_[i]) {
+            continue;
+        }
+        n_lost++;
+        if (buff_tab_[i]) {
+            n_repaired++;
+        }
+    }
+
+    if (n_lost == 0) {
+        return;
+    }
+
+    roc_log(LogDebug, "parity decoder: repaired %u/%u/%u", (unsigned)n_repaired,
+            (unsigned)n_lost, (unsigned)buff_tab_.size());
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/parity_decoder.h
+//! @brief XOR parity decoder.
+
+#ifndef ROC_FEC_PARITY_DECODER_H_
+#define ROC_FEC_PARITY_DECODER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/buffer_pool.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_fec/codec_config.h"
+#include "roc_fec/gf256_kernel.h"
+#include "roc_fec/iblock_decoder.h"
+#include "roc_fec/parity_layout.h"
+
+namespace roc {
+namespace fec {
+
+//! XOR parity decoder.
+//! @remarks
+//!  A lost source symbol is repaired when it's the only lost symbol in its
+//!  row or column. Repaired symbols are used to repair other symbols, so
+//!  with column parities, a row with several losses can be repaired if
+//!  their columns have no other losses, and vice versa.
+class ParityDecoder : public IBlockDecoder, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    explicit ParityDecoder(const CodecConfig& config,
+                           core::BufferPool<uint8_t>& buffer_pool,
+                           core::IAllocator& allocator);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Get the maximum number of encoding symbols for the scheme being used.
+    virtual size_t max_block_length() const;
+
+    //! Start block.
+    //!
+    //! @remarks
+    //!  Performs an initial setup for a block. Should be called before
+    //!  any operations for the block.
+    virtual bool begin(size_t sblen, size_t rblen, size_t payload_size);
+
+    //! Store source or repair packet buffer for current block.
+    virtual void set(size_t index, const core::Slice<uint8_t>& buffer);
+
+    //! Repair source packet buffer.
+    virtual core::Slice<uint8_t> repair(size_t index);
+
+    //! Finish block.
+    //!
+    //! @remarks
+    //!  Cleanups the resources allocated for the block. Should be called after
+    //!  all operations for the block.
+    virtual void end();
+
+private:
+    void decode_();
+    bool repair_symbol_(size_t repair_index);
+    core::Slice<uint8_t> make_buffer_();
+    void report_();
+
+    size_t sblen_;
+    size_t rblen_;
+    size_t payload_size_;
+
+    ParityLayout layout_;
+    const GF256Kernel* kernel_;
+
+    core::BufferPool<uint8_t>& buffer_pool_;
+
+    // received and repaired source and repair packets
+    core::Array<core::Slice<uint8_t> > buff_tab_;
+
+    // true if packet is received, false if it's is lost or repaired
+    core::Array<bool> recv_tab_;
+
+    bool has_new_packets_;
+
+    bool valid_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_PARITY_DECODER_H_
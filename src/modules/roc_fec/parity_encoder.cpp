@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/parity_encoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace fec {
+
+ParityEncoder::ParityEncoder(const CodecConfig& config,
+                             core::BufferPool<uint8_t>&,
+                             core::IAllocator& allocator)
+    : sblen_(0)
+    , rblen_(0)
+    , payload_size_(0)
+    , kernel_(gf256_kernel(GF256Kernel_Auto))
+    , buff_tab_(allocator)
+    , valid_(false) {
+    if (config.scheme != packet::FEC_Parity) {
+        roc_panic("parity encoder: unexpected fec scheme");
+    }
+
+    roc_log(LogDebug, "parity encoder: initializing: kernel=%s", kernel_->name);
+
+    valid_ = true;
+}
+
+bool ParityEncoder::valid() const {
+    return valid_;
+}
+
+size_t ParityEncoder::alignment() const {
+    return Alignment;
+}
+
+size_t ParityEncoder::max_block_length() const {
+    roc_panic_if_not(valid());
+
+    return ParityLayout::MaxBlockLength;
+}
+
+bool ParityEncoder::begin(size_t sblen, size_t rblen, size_t payload_size) {
+    roc_panic_if_not(valid());
+
+    if (!layout_.build(sblen, rblen)) {
+        return false;
+    }
+
+    if (!buff_tab_.resize(sblen + rblen)) {
+        return false;
+    }
+
+    sblen_ = sblen;
+    rblen_ = rblen;
+    payload_size_ = payload_size;
+
+    return true;
+}
+
+void ParityEncoder::set(size_t index, const core::Slice<uint8_t>& buffer) {
+    roc_panic_if_not(valid());
+
+    if (index >= sblen_ + rblen_) {
+        roc_panic("parity encoder: can't write more than %lu data buffers",
+                  (unsigned long)(sblen_ + rblen_));
+    }
+
+    if (!buffer) {
+        roc_panic("parity encoder: null buffer");
+    }
+
+    if (buffer.size() == 0 || buffer.size() != payload_size_) {
+        roc_panic("parity encoder: invalid payload size: cur=%lu new=%lu",
+                  (unsigned long)payload_size_, (unsigned long)buffer.size());
+    }
+
+    if (buff_tab_[index]) {
+        roc_panic("parity encoder: buffer already set: index=%lu", (unsigned long)index);
+    }
+
+    buff_tab_[index] = buffer;
+
+    if (index < sblen_) {
+        accumulate_(index, layout_.row(index));
+
+        if (layout_.n_columns() != 0) {
+            accumulate_(index, layout_.column(index));
+        }
+    } else {
+        const size_t repair_index = index - sblen_;
+
+        const size_t first = layout_.first(repair_index);
+        const size_t step = layout_.step(repair_index);
+        const size_t count = layout_.count(repair_index);
+
+        memset(buffer.data(), 0, payload_size_);
+
+        for (size_t n = 0; n < count; n++) {
+            accumulate_(first + n * step, repair_index);
+        }
+    }
+}
+
+void ParityEncoder::fill() {
+    roc_panic_if_not(valid());
+
+    for (size_t i = 0; i < sblen_; ++i) {
+        if (!buff_tab_[i]) {
+            roc_panic("parity encoder: source buffer not set: index=%lu",
+                      (unsigned long)i);
+        }
+    }
+}
+
+void ParityEncoder::end() {
+    roc_panic_if_not(valid());
+
+    for (size_t i = 0; i < buff_tab_.size(); ++i) {
+        buff_tab_[i] = core::Slice<uint8_t>();
+    }
+}
+
+void ParityEncoder::accumulate_(size_t source_index, size_t repair_index) {
+    const core::Slice<uint8_t>& src = buff_tab_[source_index];
+    const core::Slice<uint8_t>& rep = buff_tab_[sblen_ + repair_index];
+
+    if (!src || !rep) {
+        return;
+    }
+
+    kernel_->add(rep.data(), src.data(), payload_size_);
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/parity_layout.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace fec {
+
+ParityLayout::ParityLayout()
+    : sblen_(0)
+    , n_rows_(0)
+    , n_columns_(0) {
+}
+
+bool ParityLayout::build(size_t sblen, size_t rblen) {
+    if (sblen == 0 || rblen == 0 || sblen + rblen > MaxBlockLength) {
+        roc_log(LogError, "parity layout: invalid block size: sblen=%lu rblen=%lu",
+                (unsigned long)sblen, (unsigned long)rblen);
+        return false;
+    }
+
+    sblen_ = sblen;
+
+    // look for D rows and L columns, so that D * L = sblen and D + L = rblen
+    for (size_t rows = 2; rows * rows <= sblen; rows++) {
+        if (sblen % rows == 0 && rows + sblen / rows == rblen) {
+            n_rows_ = rows;
+            n_columns_ = sblen / rows;
+            return true;
+        }
+    }
+
+    if (rblen > sblen) {
+        roc_log(LogError,
+                "parity layout: too many repair symbols: sblen=%lu rblen=%lu",
+                (unsigned long)sblen, (unsigned long)rblen);
+        return false;
+    }
+
+    n_rows_ = rblen;
+    n_columns_ = 0;
+
+    return true;
+}
+
+size_t ParityLayout::n_rows() const {
+    return n_rows_;
+}
+
+size_t ParityLayout::n_columns() const {
+    return n_columns_;
+}
+
+size_t ParityLayout::row(size_t source_index) const {
+    roc_panic_if(source_index >= sblen_);
+
+    if (n_columns_ != 0) {
+        return source_index / n_columns_;
+    }
+    return source_index * n_rows_ / sblen_;
+}
+
+size_t ParityLayout::column(size_t source_index) const {
+    roc_panic_if(source_index >= sblen_);
+    roc_panic_if(n_columns_ == 0);
+
+    return n_rows_ + source_index % n_columns_;
+}
+
+size_t ParityLayout::first(size_t repair_index) const {
+    roc_panic_if(repair_index >= n_rows_ + n_columns_);
+
+    if (n_columns_ != 0) {
+        if (repair_index < n_rows_) {
+            return repair_index * n_columns_;
+        }
+        return repair_index - n_rows_;
+    }
+
+    // first i such that i * n_rows / sblen == repair_index
+    return (repair_index * sblen_ + n_rows_ - 1) / n_rows_;
+}
+
+size_t ParityLayout::step(size_t repair_index) const {
+    roc_panic_if(repair_index >= n_rows_ + n_columns_);
+
+    if (repair_index < n_rows_) {
+        return 1;
+    }
+    return n_columns_;
+}
+
+size_t ParityLayout::count(size_t repair_index) const {
+    roc_panic_if(repair_index >= n_rows_ + n_columns_);
+
+    if (n_columns_ != 0) {
+        if (repair_index < n_rows_) {
+            return n_columns_;
+        }
+        return n_rows_;
+    }
+
+    if (repair_index + 1 == n_rows_) {
+        return sblen_ - first(repair_index);
+    }
+    return first(repair_index + 1) - first(repair_index);
+}
+
+} // namespace fec
+} // namespace roc
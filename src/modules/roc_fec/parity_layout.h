@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/parity_layout.h
+//! @brief XOR parity block layout.
+
+#ifndef ROC_FEC_PARITY_LAYOUT_H_
+#define ROC_FEC_PARITY_LAYOUT_H_
+
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace fec {
+
+//! XOR parity block layout.
+//!
+//! @remarks
+//!  Defines which source symbols are protected by every repair symbol. The
+//!  layout is derived from the block size alone, so that encoder and decoder
+//!  agree on it without additional signaling.
+//!
+//!  If the block has k = L * D source symbols and L + D repair symbols,
+//!  where L >= D >= 2, source symbols form a matrix of D rows and L columns
+//!  (SMPTE 2022-1 style). The first D repair symbols are row parities, and
+//!  the remaining L repair symbols are column parities. Column parities
+//!  repair bursts of up to L losses, and both together repair many patterns
+//!  that row parities alone can't.
+//!
+//!  Otherwise, source symbols are split into rblen rows of consecutive
+//!  symbols with nearly equal lengths, and every repair symbol is a row
+//!  parity. This requires rblen <= k.
+//!
+//!  Every repair symbol protects an arithmetic progression of source symbols.
+class ParityLayout {
+public:
+    //! Maximum number of symbols in block.
+    enum { MaxBlockLength = 0xffff };
+
+    //! Initialize.
+    ParityLayout();
+
+    //! Build layout for given number of source and repair symbols.
+    //! @returns
+    //!  false if there is no layout for these parameters.
+    bool build(size_t sblen, size_t rblen);
+
+    //! Get number of row parity symbols.
+    size_t n_rows() const;
+
+    //! Get number of column parity symbols.
+    size_t n_columns() const;
+
+    //! Get index of row parity symbol protecting source symbol.
+    //! @remarks
+    //!  Returned index is relative to the first repair symbol.
+    size_t row(size_t source_index) const;
+
+    //! Get index of column parity symbol protecting source symbol.
+    //! @remarks
+    //!  Returned index is relative to the first repair symbol.
+    //!  Should be called only if n_columns() is non-zero.
+    size_t column(size_t source_index) const;
+
+    //! Get first source symbol protected by repair symbol.
+    //! @remarks
+    //!  @p repair_index is relative to the first repair symbol.
+    size_t first(size_t repair_index) const;
+
+    //! Get distance between source symbols protected by repair symbol.
+    size_t step(size_t repair_index) const;
+
+    //! Get number of source symbols protected by repair symbol.
+    size_t count(size_t repair_index) const;
+
+private:
+    size_t sblen_;
+    size_t n_rows_;
+    size_t n_columns_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_PARITY_LAYOUT_H_
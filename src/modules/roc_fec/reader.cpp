@@ -27,7 +27,7 @@ Reader::Reader(const ReaderConfig& config,
     , repair_reader_(repair_reader)
     , parser_(parser)
     , packet_pool_(packet_pool)
-    , source_queue_(0)
+    , source_queue_(allocator, 0)
     , repair_queue_(0)
     , source_block_(allocator)
     , repair_block_(allocator)
@@ -37,6 +37,8 @@ Reader::Reader(const ReaderConfig& config,
     , can_repair_(false)
     , next_packet_(0)
     , cur_sbn_(0)
+    , n_source_packets_(0)
+    , n_repair_packets_(0)
     , payload_size_(0)
     , source_block_resized_(false)
     , repair_block_resized_(false)
@@ -171,6 +173,9 @@ void Reader::next_block_() {
     cur_sbn_++;
     next_packet_ = 0;
 
+    n_source_packets_ = 0;
+    n_repair_packets_ = 0;
+
     source_block_resized_ = false;
     repair_block_resized_ = false;
     payload_resized_ = false;
@@ -189,6 +194,10 @@ void Reader::try_repair_() {
         return;
     }
 
+    if (!has_losses_()) {
+        return;
+    }
+
     if (!decoder_.begin(source_block_.size(), repair_block_.size(), payload_size_)) {
         roc_log(LogDebug,
                 "fec reader: can't begin decoder block, shutting down:"
@@ -229,12 +238,38 @@ void Reader::try_repair_() {
         }
 
         source_block_[n] = pp;
+        n_source_packets_++;
     }
 
     decoder_.end();
     can_repair_ = false;
 }
 
+// Returns true if the missing packet at current position is known to be lost,
+// i.e. some packet that should follow it was already received, and there are
+// enough packets to try to repair it. Otherwise the packet may be just not
+// delivered yet, and the decoder is not invoked, so blocks received without
+// losses never reach the decoder.
+bool Reader::has_losses_() const {
+    // Reed-Solomon can't repair anything until any sblen packets are received
+    if (fec_scheme_ == packet::FEC_ReedSolomon_M8
+        && n_source_packets_ + n_repair_packets_ < source_block_.size()) {
+        return false;
+    }
+
+    if (n_repair_packets_ != 0 || source_queue_.size() != 0) {
+        return true;
+    }
+
+    for (size_t pos = next_packet_; pos < source_block_.size(); pos++) {
+        if (source_block_[pos]) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 packet::PacketPtr Reader::parse_repaired_packet_(const core::Slice<uint8_t>& buffer) {
     packet::PacketPtr pp = new (packet_pool_) packet::Packet(packet_pool_);
     if (!pp) {
@@ -337,6 +372,7 @@ void Reader::fill_source_block_() {
         if (!source_block_[p_num]) {
             can_repair_ = true;
             source_block_[p_num] = pp;
+            n_source_packets_++;
             n_added++;
         }
     }
@@ -348,7 +384,7 @@ void Reader::fill_source_block_() {
 }
 
 void Reader::fill_repair_block_() {
-    unsigned n_fetched = 0, n_added = 0, n_dropped = 0;
+    unsigned n_fetched = 0, n_added = 0, n_skipped = 0, n_dropped = 0;
 
     for (;;) {
         packet::PacketPtr pp = repair_queue_.head();
@@ -398,16 +434,23 @@ void Reader::fill_repair_block_() {
         roc_panic_if_not(fec.encoding_symbol_id
                          < source_block_.size() + repair_block_.size());
 
+        // all source packets are here, repair packet is not needed
+        if (n_source_packets_ == source_block_.size()) {
+            n_skipped++;
+            continue;
+        }
+
         const size_t p_num = fec.encoding_symbol_id - fec.source_block_length;
 
         if (!repair_block_[p_num]) {
             can_repair_ = true;
             repair_block_[p_num] = pp;
+            n_repair_packets_++;
             n_added++;
         }
     }
 
-    if (n_dropped != 0 || n_fetched != n_added) {
+    if (n_dropped != 0 || n_fetched != n_added + n_skipped) {
         roc_log(LogDebug, "fec reader: repair queue: fetched=%u added=%u dropped=%u",
                 n_fetched, n_added, n_dropped);
     }
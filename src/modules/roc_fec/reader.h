@@ -21,6 +21,7 @@
 #include "roc_packet/ireader.h"
 #include "roc_packet/packet.h"
 #include "roc_packet/packet_pool.h"
+#include "roc_packet/seqnum_queue.h"
 #include "roc_packet/sorted_queue.h"
 
 namespace roc {
@@ -79,6 +80,7 @@ private:
 
     void next_block_();
     void try_repair_();
+    bool has_losses_() const;
 
     packet::PacketPtr parse_repaired_packet_(const core::Slice<uint8_t>& buffer);
 
@@ -114,7 +116,7 @@ private:
     packet::IParser& parser_;
     packet::PacketPool& packet_pool_;
 
-    packet::SortedQueue source_queue_;
+    packet::SeqnumQueue source_queue_;
     packet::SortedQueue repair_queue_;
 
     core::Array<packet::PacketPtr> source_block_;
@@ -129,6 +131,10 @@ private:
     size_t next_packet_;
     packet::blknum_t cur_sbn_;
 
+    // number of source (received or repaired) and repair packets in current block
+    size_t n_source_packets_;
+    size_t n_repair_packets_;
+
     size_t payload_size_;
 
     bool source_block_resized_;
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rlc_coefficients.h
+//! @brief RLC coding coefficients.
+
+#ifndef ROC_FEC_RLC_COEFFICIENTS_H_
+#define ROC_FEC_RLC_COEFFICIENTS_H_
+
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace fec {
+
+//! Density threshold for which all coefficients are non-zero.
+enum { RLC_DenseThreshold = 15 };
+
+//! Generate coding coefficients of RLC repair symbol over GF(2^8).
+//!
+//! @b Parameters
+//!  - @p repair_key - repair key of the repair symbol, used as PRNG seed
+//!  - @p dt - density threshold, in range [0; 15]
+//!  - @p coefs - output array of @p n_coefs elements
+//!  - @p n_coefs - number of source symbols in encoding window
+//!
+//! @remarks
+//!  Implements generate_coding_coefficients() from RFC 8681 for m=8. Repair
+//!  symbol is the sum of source symbols of the encoding window multiplied by
+//!  the corresponding coefficients. With dt equal to RLC_DenseThreshold all
+//!  coefficients are non-zero.
+void rlc_coefficients(uint16_t repair_key, uint8_t dt, uint8_t* coefs, size_t n_coefs);
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RLC_COEFFICIENTS_H_
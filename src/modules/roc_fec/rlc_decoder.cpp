@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rlc_decoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_fec/gf256.h"
+#include "roc_fec/rlc_coefficients.h"
+
+namespace roc {
+namespace fec {
+
+RLCDecoder::RLCDecoder(size_t max_window_length,
+                       core::BufferPool<uint8_t>& buffer_pool,
+                       core::IAllocator& allocator)
+    : max_window_length_(max_window_length)
+    , window_length_(0)
+    , payload_size_(0)
+    , n_repair_(0)
+    , n_rows_(0)
+    , n_cols_(0)
+    , kernel_(gf256_kernel(GF256Kernel_Auto))
+    , buffer_pool_(buffer_pool)
+    , source_tab_(allocator)
+    , repaired_tab_(allocator)
+    , repair_tab_(allocator)
+    , first_tab_(allocator)
+    , len_tab_(allocator)
+    , key_tab_(allocator)
+    , col_tab_(allocator)
+    , index_tab_(allocator)
+    , matrix_(allocator)
+    , rhs_tab_(allocator)
+    , coef_tab_(allocator)
+    , decoded_(false)
+    , valid_(false) {
+    const size_t len = max_window_length;
+
+    if (len == 0) {
+        roc_log(LogError, "rlc decoder: window length can't be zero");
+        return;
+    }
+
+    if (!source_tab_.resize(len) || !repaired_tab_.resize(len)
+        || !repair_tab_.resize(len) || !first_tab_.resize(len) || !len_tab_.resize(len)
+        || !key_tab_.resize(len) || !col_tab_.resize(len) || !index_tab_.resize(len)
+        || !matrix_.resize(len * len) || !rhs_tab_.resize(len)
+        || !coef_tab_.resize(len)) {
+        return;
+    }
+
+    valid_ = true;
+}
+
+bool RLCDecoder::valid() const {
+    return valid_;
+}
+
+size_t RLCDecoder::max_window_length() const {
+    return max_window_length_;
+}
+
+bool RLCDecoder::begin(size_t window_length, size_t payload_size) {
+    roc_panic_if_not(valid());
+
+    if (window_length == 0 || window_length > max_window_length_) {
+        roc_log(LogDebug, "rlc decoder: invalid window length: len=%lu max=%lu",
+                (unsigned long)window_length, (unsigned long)max_window_length_);
+        return false;
+    }
+
+    window_length_ = window_length;
+    payload_size_ = payload_size;
+
+    n_repair_ = 0;
+    decoded_ = false;
+
+    return true;
+}
+
+void RLCDecoder::set(size_t index, const core::Slice<uint8_t>& buffer) {
+    roc_panic_if_not(valid());
+
+    if (index >= window_length_) {
+        roc_panic("rlc decoder: index out of window: index=%lu len=%lu",
+                  (unsigned long)index, (unsigned long)window_length_);
+    }
+
+    if (!buffer || buffer.size() != payload_size_) {
+        roc_panic("rlc decoder: invalid payload size: cur=%lu new=%lu",
+                  (unsigned long)payload_size_, (unsigned long)buffer.size());
+    }
+
+    source_tab_[index] = buffer;
+    decoded_ = false;
+}
+
+bool RLCDecoder::add_repair(size_t first_index,
+                            size_t n_symbols,
+                            uint16_t repair_key,
+                            const core::Slice<uint8_t>& buffer) {
+    roc_panic_if_not(valid());
+
+    if (n_symbols == 0 || first_index + n_symbols > window_length_) {
+        roc_panic("rlc decoder: encoding window out of decoding window:"
+                  " first=%lu nss=%lu len=%lu",
+                  (unsigned long)first_index, (unsigned long)n_symbols,
+                  (unsigned long)window_length_);
+    }
+
+    if (!buffer || buffer.size() != payload_size_) {
+        roc_panic("rlc decoder: invalid payload size: cur=%lu new=%lu",
+                  (unsigned long)payload_size_, (unsigned long)buffer.size());
+    }
+
+    if (n_repair_ == max_window_length_) {
+        return false;
+    }
+
+    repair_tab_[n_repair_] = buffer;
+    first_tab_[n_repair_] = first_index;
+    len_tab_[n_repair_] = n_symbols;
+    key_tab_[n_repair_] = repair_key;
+
+    n_repair_++;
+    decoded_ = false;
+
+    return true;
+}
+
+core::Slice<uint8_t> RLCDecoder::repair(size_t index) {
+    roc_panic_if_not(valid());
+
+    if (index >= window_length_) {
+        roc_panic("rlc decoder: index out of window: index=%lu len=%lu",
+                  (unsigned long)index, (unsigned long)window_length_);
+    }
+
+    if (!decoded_) {
+        decode_();
+        decoded_ = true;
+    }
+
+    return repaired_tab_[index];
+}
+
+void RLCDecoder::end() {
+    roc_panic_if_not(valid());
+
+    for (size_t i = 0; i < window_length_; i++) {
+        source_tab_[i] = core::Slice<uint8_t>();
+        repaired_tab_[i] = core::Slice<uint8_t>();
+    }
+
+    for (size_t i = 0; i < n_repair_; i++) {
+        repair_tab_[i] = core::Slice<uint8_t>();
+        rhs_tab_[i] = core::Slice<uint8_t>();
+    }
+
+    window_length_ = 0;
+    n_repair_ = 0;
+    decoded_ = false;
+}
+
+void RLCDecoder::decode_() {
+    if (!build_system_()) {
+        return;
+    }
+
+    eliminate_();
+    extract_solution_();
+
+    for (size_t r = 0; r < n_rows_; r++) {
+        rhs_tab_[r] = core::Slice<uint8_t>();
+    }
+}
+
+// Assigns a matrix column to every lost source symbol covered by a repair
+// symbol, and a row to every repair symbol covering a lost source symbol.
+// Received source symbols are moved to the right-hand side.
+bool RLCDecoder::build_system_() {
+    n_rows_ = 0;
+    n_cols_ = 0;
+
+    for (size_t i = 0; i < window_length_; i++) {
+        col_tab_[i] = NoColumn;
+    }
+
+    for (size_t r = 0; r < n_repair_; r++) {
+        for (size_t i = first_tab_[r]; i < first_tab_[r] + len_tab_[r]; i++) {
+            if (!source_tab_[i] && !repaired_tab_[i] && col_tab_[i] == NoColumn) {
+                index_tab_[n_cols_] = i;
+                col_tab_[i] = n_cols_++;
+            }
+        }
+    }
+
+    if (n_cols_ == 0) {
+        return false;
+    }
+
+    for (size_t r = 0; r < n_repair_; r++) {
+        const size_t first = first_tab_[r];
+        const size_t len = len_tab_[r];
+
+        bool has_lost = false;
+        for (size_t i = first; i < first + len; i++) {
+            if (col_tab_[i] != NoColumn) {
+                has_lost = true;
+                break;
+            }
+        }
+        if (!has_lost) {
+            continue;
+        }
+
+        core::Slice<uint8_t> rhs = make_buffer_();
+        if (!rhs) {
+            return false;
+        }
+        memcpy(rhs.data(), repair_tab_[r].data(), payload_size_);
+
+        uint8_t* row = &matrix_[n_rows_ * n_cols_];
+        memset(row, 0, n_cols_);
+
+        rlc_coefficients(key_tab_[r], RLC_DenseThreshold, &coef_tab_[0], len);
+
+        for (size_t i = first; i < first + len; i++) {
+            if (col_tab_[i] != NoColumn) {
+                row[col_tab_[i]] = coef_tab_[i - first];
+            } else {
+                // subtraction is the same as addition in GF(2^8)
+                const core::Slice<uint8_t>& src =
+                    source_tab_[i] ? source_tab_[i] : repaired_tab_[i];
+                kernel_->mul_add(rhs.data(), src.data(), coef_tab_[i - first],
+                                 payload_size_);
+            }
+        }
+
+        rhs_tab_[n_rows_++] = rhs;
+    }
+
+    return true;
+}
+
+// Reduces the matrix to reduced row echelon form, applying the same
+// row operations to the right-hand side.
+void RLCDecoder::eliminate_() {
+    size_t pivot_row = 0;
+
+    for (size_t col = 0; col < n_cols_ && pivot_row < n_rows_; col++) {
+        size_t r = pivot_row;
+        while (r < n_rows_ && matrix_[r * n_cols_ + col] == 0) {
+            r++;
+        }
+        if (r == n_rows_) {
+            continue;
+        }
+
+        if (r != pivot_row) {
+            uint8_t* a = &matrix_[r * n_cols_];
+            uint8_t* b = &matrix_[pivot_row * n_cols_];
+            for (size_t c = 0; c < n_cols_; c++) {
+                const uint8_t tmp = a[c];
+                a[c] = b[c];
+                b[c] = tmp;
+            }
+
+            const core::Slice<uint8_t> tmp = rhs_tab_[r];
+            rhs_tab_[r] = rhs_tab_[pivot_row];
+            rhs_tab_[pivot_row] = tmp;
+        }
+
+        const uint8_t* prow = &matrix_[pivot_row * n_cols_];
+        const uint8_t pinv = gf256_inv(prow[col]);
+
+        for (size_t rr = 0; rr < n_rows_; rr++) {
+            if (rr == pivot_row) {
+                continue;
+            }
+
+            uint8_t* row = &matrix_[rr * n_cols_];
+            if (row[col] == 0) {
+                continue;
+            }
+
+            const uint8_t factor = gf256_mul(row[col], pinv);
+
+            kernel_->mul_add(row, prow, factor, n_cols_);
+            kernel_->mul_add(rhs_tab_[rr].data(), rhs_tab_[pivot_row].data(), factor,
+                             payload_size_);
+        }
+
+        pivot_row++;
+    }
+}
+
+// After elimination, a lost symbol is determined if its pivot row has no other
+// non-zero coefficients. Then the symbol is the right-hand side of the row
+// divided by the pivot.
+void RLCDecoder::extract_solution_() {
+    for (size_t r = 0; r < n_rows_; r++) {
+        const uint8_t* row = &matrix_[r * n_cols_];
+
+        size_t col = NoColumn;
+        bool determined = true;
+
+        for (size_t c = 0; c < n_cols_; c++) {
+            if (row[c] == 0) {
+                continue;
+            }
+            if (col == NoColumn) {
+                col = c;
+            } else {
+                determined = false;
+                break;
+            }
+        }
+
+        if (col == NoColumn || !determined) {
+            continue;
+        }
+
+        core::Slice<uint8_t> buffer = make_buffer_();
+        if (!buffer) {
+            return;
+        }
+
+        memset(buffer.data(), 0, payload_size_);
+        kernel_->mul_add(buffer.data(), rhs_tab_[r].data(), gf256_inv(row[col]),
+                         payload_size_);
+
+        repaired_tab_[index_tab_[col]] = buffer;
+    }
+}
+
+core::Slice<uint8_t> RLCDecoder::make_buffer_() {
+    core::Slice<uint8_t> buffer = new (buffer_pool_) core::Buffer<uint8_t>(buffer_pool_);
+
+    if (!buffer) {
+        roc_log(LogError, "rlc decoder: can't allocate buffer");
+        return core::Slice<uint8_t>();
+    }
+
+    if (buffer.capacity() < payload_size_) {
+        roc_log(LogError, "rlc decoder: packet size too large: size=%lu max=%lu",
+                (unsigned long)payload_size_, (unsigned long)buffer.capacity());
+        return core::Slice<uint8_t>();
+    }
+
+    buffer.resize(payload_size_);
+
+    return buffer;
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rlc_decoder.h
+//! @brief RLC decoder.
+
+#ifndef ROC_FEC_RLC_DECODER_H_
+#define ROC_FEC_RLC_DECODER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/buffer_pool.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_fec/gf256_kernel.h"
+
+namespace roc {
+namespace fec {
+
+//! RLC decoder.
+//! @remarks
+//!  Solves the linear system formed by repair symbols of sliding window
+//!  Random Linear Codes over GF(2^8) (RFC 8681).
+//!
+//!  Source symbols are indexed relative to the beginning of the decoding
+//!  window. Every repair symbol covers a contiguous range of source symbols
+//!  inside the decoding window, and encoding windows of different repair
+//!  symbols may overlap. Any lost source symbol that can be determined from
+//!  the received repair symbols is repaired, no matter which repair symbols
+//!  cover it.
+class RLCDecoder : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  @p max_window_length defines both the maximum number of source symbols
+    //!  and the maximum number of repair symbols in decoding window.
+    RLCDecoder(size_t max_window_length,
+               core::BufferPool<uint8_t>& buffer_pool,
+               core::IAllocator& allocator);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Get the maximum number of source symbols in decoding window.
+    size_t max_window_length() const;
+
+    //! Start decoding.
+    //! @returns
+    //!  false if @p window_length exceeds the maximum.
+    bool begin(size_t window_length, size_t payload_size);
+
+    //! Store received source symbol.
+    void set(size_t index, const core::Slice<uint8_t>& buffer);
+
+    //! Store received repair symbol.
+    //! @remarks
+    //!  The encoding window of the symbol is [@p first_index; @p first_index +
+    //!  @p n_symbols), and coding coefficients are derived from @p repair_key.
+    //! @returns
+    //!  false if the maximum number of repair symbols is reached.
+    bool add_repair(size_t first_index,
+                    size_t n_symbols,
+                    uint16_t repair_key,
+                    const core::Slice<uint8_t>& buffer);
+
+    //! Repair source symbol.
+    //! @returns
+    //!  null slice if the symbol was received or can't be repaired.
+    core::Slice<uint8_t> repair(size_t index);
+
+    //! Finish decoding.
+    void end();
+
+private:
+    enum { NoColumn = (size_t)-1 };
+
+    void decode_();
+    bool build_system_();
+    void eliminate_();
+    void extract_solution_();
+    core::Slice<uint8_t> make_buffer_();
+
+    const size_t max_window_length_;
+
+    size_t window_length_;
+    size_t payload_size_;
+    size_t n_repair_;
+    size_t n_rows_;
+    size_t n_cols_;
+
+    const GF256Kernel* kernel_;
+
+    core::BufferPool<uint8_t>& buffer_pool_;
+
+    // received source symbols and repaired source symbols
+    core::Array<core::Slice<uint8_t> > source_tab_;
+    core::Array<core::Slice<uint8_t> > repaired_tab_;
+
+    // received repair symbols and their encoding windows
+    core::Array<core::Slice<uint8_t> > repair_tab_;
+    core::Array<size_t> first_tab_;
+    core::Array<size_t> len_tab_;
+    core::Array<uint16_t> key_tab_;
+
+    // column in decoding matrix for every lost source symbol, and vice versa
+    core::Array<size_t> col_tab_;
+    core::Array<size_t> index_tab_;
+
+    // decoding matrix, one row per useful repair symbol, and right-hand side
+    // symbols, i.e. repair symbols with received source symbols subtracted
+    core::Array<uint8_t> matrix_;
+    core::Array<core::Slice<uint8_t> > rhs_tab_;
+
+    // coding coefficients of a repair symbol
+    core::Array<uint8_t> coef_tab_;
+
+    bool decoded_;
+    bool valid_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RLC_DECODER_H_
@@ -0,0 +1,440 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rlc_reader.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_packet/fec_scheme_to_str.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+// Source window is a ring buffer indexed by ESI, so its size should be a power
+// of two to handle ESI wrapping. It holds at least window_length packets before
+// and after current position.
+size_t source_window_size(size_t window_length) {
+    size_t size = 1;
+    while (size < window_length * 2) {
+        size <<= 1;
+    }
+    return size;
+}
+
+int32_t esi_diff(uint32_t a, uint32_t b) {
+    return int32_t(a - b);
+}
+
+const core::Slice<uint8_t>& source_payload(const packet::PacketPtr& pp) {
+    // restored packets don't have fec headers, but their data is the payload
+    if (pp->fec()) {
+        return pp->fec()->payload;
+    }
+    return pp->data();
+}
+
+} // namespace
+
+RLCReader::RLCReader(const RLCReaderConfig& config,
+                     packet::IReader& source_reader,
+                     packet::IReader& repair_reader,
+                     packet::IParser& parser,
+                     packet::PacketPool& packet_pool,
+                     core::BufferPool<uint8_t>& buffer_pool,
+                     core::IAllocator& allocator)
+    : source_reader_(source_reader)
+    , repair_reader_(repair_reader)
+    , parser_(parser)
+    , packet_pool_(packet_pool)
+    , source_queue_(allocator, 0)
+    , repair_queue_(0)
+    , source_window_(allocator)
+    , repair_window_(allocator)
+    , n_repair_packets_(0)
+    , decoder_(source_window_size(config.max_window_length), buffer_pool, allocator)
+    , window_length_(config.max_window_length)
+    , history_length_(0)
+    , head_(0)
+    , valid_(false)
+    , alive_(true)
+    , started_(false)
+    , n_packets_(0) {
+    if (window_length_ == 0) {
+        roc_log(LogError, "rlc reader: window length can't be zero");
+        return;
+    }
+
+    const size_t size = source_window_size(window_length_);
+
+    history_length_ = size - window_length_;
+
+    if (!decoder_.valid()) {
+        return;
+    }
+
+    if (!source_window_.resize(size) || !repair_window_.resize(size)) {
+        return;
+    }
+
+    valid_ = true;
+}
+
+bool RLCReader::valid() const {
+    return valid_;
+}
+
+bool RLCReader::started() const {
+    return started_;
+}
+
+bool RLCReader::alive() const {
+    return alive_;
+}
+
+packet::PacketPtr RLCReader::read() {
+    roc_panic_if_not(valid());
+    if (!alive_) {
+        return NULL;
+    }
+    packet::PacketPtr pp = read_();
+    if (pp) {
+        n_packets_++;
+    }
+    // check if alive_ has changed
+    return (alive_ ? pp : NULL);
+}
+
+packet::PacketPtr RLCReader::read_() {
+    fetch_packets_();
+
+    if (!started_) {
+        packet::PacketPtr pp = source_queue_.head();
+        if (!pp) {
+            return NULL;
+        }
+
+        head_ = (uint32_t)pp->fec()->encoding_symbol_id;
+        started_ = true;
+
+        roc_log(LogDebug, "rlc reader: got first packet, start decoding: esi=%lu",
+                (unsigned long)head_);
+    }
+
+    for (;;) {
+        if (!alive_) {
+            return NULL;
+        }
+
+        fill_source_window_();
+        fill_repair_window_();
+
+        if (packet::PacketPtr pp = slot_(head_)) {
+            next_packet_();
+            return pp;
+        }
+
+        if (!has_following_packets_()) {
+            packet::PacketPtr pp = source_queue_.head();
+            if (!pp) {
+                // next packet may be just not delivered yet
+                return NULL;
+            }
+
+            // all packets in window are lost
+            jump_to_((uint32_t)pp->fec()->encoding_symbol_id);
+            continue;
+        }
+
+        try_repair_();
+
+        // skip packets that can't be repaired
+        while (!slot_(head_)) {
+            roc_log(LogTrace, "rlc reader: skipping lost packet: esi=%lu",
+                    (unsigned long)head_);
+            next_packet_();
+        }
+    }
+}
+
+void RLCReader::next_packet_() {
+    // the oldest packet of history and the newest packet of window share slot
+    slot_(uint32_t(head_ + window_length_)) = NULL;
+    head_++;
+}
+
+void RLCReader::jump_to_(uint32_t esi) {
+    roc_log(LogDebug,
+            "rlc reader: too many packets lost, jumping: cur_esi=%lu new_esi=%lu",
+            (unsigned long)head_, (unsigned long)esi);
+
+    for (size_t n = 0; n < source_window_.size(); n++) {
+        source_window_[n] = NULL;
+    }
+
+    head_ = esi;
+
+    drop_old_repair_packets_();
+}
+
+bool RLCReader::has_following_packets_() const {
+    for (size_t n = 1; n < window_length_; n++) {
+        if (slot_(uint32_t(head_ + n))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Builds decoding window from all repair packets and source packets covered by
+// them, and restores every lost packet at or after current position that can
+// be determined. Returned packets are used too, since they are a part of
+// encoding windows of following repair packets.
+void RLCReader::try_repair_() {
+    drop_old_repair_packets_();
+
+    size_t payload_size = 0;
+
+    for (size_t n = 0; n < n_repair_packets_; n++) {
+        const packet::FEC& fec = *repair_window_[n]->fec();
+
+        const int32_t first = esi_diff((uint32_t)fec.encoding_symbol_id, head_);
+        const int32_t end = first + (int32_t)fec.source_block_length;
+
+        if (first <= 0 && end > 0) {
+            payload_size = fec.payload.size();
+            break;
+        }
+    }
+
+    if (payload_size == 0) {
+        // no repair packets cover current position
+        return;
+    }
+
+    int32_t first = 0, end = 1;
+
+    for (size_t n = 0; n < n_repair_packets_; n++) {
+        const packet::FEC& fec = *repair_window_[n]->fec();
+
+        if (fec.payload.size() != payload_size) {
+            continue;
+        }
+
+        const int32_t pkt_first = esi_diff((uint32_t)fec.encoding_symbol_id, head_);
+        const int32_t pkt_end = pkt_first + (int32_t)fec.source_block_length;
+
+        first = std::min(first, pkt_first);
+        end = std::max(end, pkt_end);
+    }
+
+    const uint32_t base = uint32_t(head_ + (uint32_t)first);
+    const size_t len = size_t(end - first);
+
+    if (!decoder_.begin(len, payload_size)) {
+        return;
+    }
+
+    for (size_t n = 0; n < len; n++) {
+        const packet::PacketPtr& pp = slot_(uint32_t(base + n));
+        if (pp && source_payload(pp).size() == payload_size) {
+            decoder_.set(n, source_payload(pp));
+        }
+    }
+
+    for (size_t n = 0; n < n_repair_packets_; n++) {
+        const packet::FEC& fec = *repair_window_[n]->fec();
+
+        if (fec.payload.size() != payload_size) {
+            continue;
+        }
+
+        decoder_.add_repair(
+            (size_t)esi_diff((uint32_t)fec.encoding_symbol_id, base),
+            fec.source_block_length, (uint16_t)fec.source_block_number, fec.payload);
+    }
+
+    unsigned n_lost = 0, n_repaired = 0;
+
+    for (size_t n = size_t(-first); n < len; n++) {
+        packet::PacketPtr& slot = slot_(uint32_t(base + n));
+        if (slot) {
+            continue;
+        }
+
+        n_lost++;
+
+        core::Slice<uint8_t> buffer = decoder_.repair(n);
+        if (!buffer) {
+            continue;
+        }
+
+        packet::PacketPtr pp = parse_repaired_packet_(buffer);
+        if (!pp) {
+            continue;
+        }
+
+        slot = pp;
+        n_repaired++;
+    }
+
+    decoder_.end();
+
+    roc_log(LogDebug, "rlc reader: repair: esi=%lu n_repair=%lu n_lost=%u n_repaired=%u",
+            (unsigned long)head_, (unsigned long)n_repair_packets_, n_lost, n_repaired);
+}
+
+packet::PacketPtr RLCReader::parse_repaired_packet_(const core::Slice<uint8_t>& buffer) {
+    packet::PacketPtr pp = new (packet_pool_) packet::Packet(packet_pool_);
+    if (!pp) {
+        roc_log(LogError, "rlc reader: can't allocate packet");
+        return NULL;
+    }
+
+    if (!parser_.parse(*pp, buffer)) {
+        roc_log(LogDebug, "rlc reader: can't parse repaired packet");
+        return NULL;
+    }
+
+    pp->set_data(buffer);
+    pp->add_flags(packet::Packet::FlagRestored);
+
+    return pp;
+}
+
+void RLCReader::fetch_packets_() {
+    while (packet::PacketPtr pp = source_reader_.read()) {
+        if (!validate_fec_packet_(pp)) {
+            return;
+        }
+        source_queue_.write(pp);
+    }
+
+    while (packet::PacketPtr pp = repair_reader_.read()) {
+        if (!validate_fec_packet_(pp)) {
+            return;
+        }
+        repair_queue_.write(pp);
+    }
+}
+
+void RLCReader::fill_source_window_() {
+    while (packet::PacketPtr pp = source_queue_.head()) {
+        const packet::FEC& fec = *pp->fec();
+
+        const int32_t pos = esi_diff((uint32_t)fec.encoding_symbol_id, head_);
+
+        if (pos >= (int32_t)window_length_) {
+            break;
+        }
+
+        (void)source_queue_.read();
+
+        if (pos < -(int32_t)history_length_ || fec.payload.size() == 0) {
+            roc_log(LogTrace, "rlc reader: dropping source packet: esi=%lu head=%lu",
+                    (unsigned long)fec.encoding_symbol_id, (unsigned long)head_);
+            continue;
+        }
+
+        // packets before current position were late, but they still may be
+        // used to repair following packets
+        packet::PacketPtr& slot = slot_((uint32_t)fec.encoding_symbol_id);
+        if (!slot) {
+            slot = pp;
+        }
+    }
+}
+
+void RLCReader::fill_repair_window_() {
+    drop_old_repair_packets_();
+
+    while (packet::PacketPtr pp = repair_queue_.head()) {
+        const packet::FEC& fec = *pp->fec();
+
+        const int32_t first = esi_diff((uint32_t)fec.encoding_symbol_id, head_);
+        const int32_t end = first + (int32_t)fec.source_block_length;
+
+        if (end > (int32_t)window_length_) {
+            break;
+        }
+
+        (void)repair_queue_.read();
+
+        if (fec.source_block_length == 0 || fec.source_block_length > window_length_
+            || fec.payload.size() == 0 || first < -(int32_t)history_length_
+            || end <= 0) {
+            roc_log(LogTrace,
+                    "rlc reader: dropping repair packet: esi=%lu nss=%lu head=%lu",
+                    (unsigned long)fec.encoding_symbol_id,
+                    (unsigned long)fec.source_block_length, (unsigned long)head_);
+            continue;
+        }
+
+        if (n_repair_packets_ == repair_window_.size()) {
+            for (size_t n = 1; n < n_repair_packets_; n++) {
+                repair_window_[n - 1] = repair_window_[n];
+            }
+            n_repair_packets_--;
+        }
+
+        repair_window_[n_repair_packets_++] = pp;
+    }
+}
+
+// Drops repair packets which encoding windows don't contain current or
+// following packets anymore, or contain packets not kept in history.
+void RLCReader::drop_old_repair_packets_() {
+    size_t n_kept = 0;
+
+    for (size_t n = 0; n < n_repair_packets_; n++) {
+        const packet::FEC& fec = *repair_window_[n]->fec();
+
+        const int32_t first = esi_diff((uint32_t)fec.encoding_symbol_id, head_);
+        const int32_t end = first + (int32_t)fec.source_block_length;
+
+        if (end > 0 && first >= -(int32_t)history_length_) {
+            repair_window_[n_kept++] = repair_window_[n];
+        }
+    }
+
+    for (size_t n = n_kept; n < n_repair_packets_; n++) {
+        repair_window_[n] = NULL;
+    }
+
+    n_repair_packets_ = n_kept;
+}
+
+packet::PacketPtr& RLCReader::slot_(uint32_t esi) {
+    return source_window_[esi & (source_window_.size() - 1)];
+}
+
+const packet::PacketPtr& RLCReader::slot_(uint32_t esi) const {
+    return source_window_[esi & (source_window_.size() - 1)];
+}
+
+bool RLCReader::validate_fec_packet_(const packet::PacketPtr& pp) {
+    const packet::FEC* fec = pp->fec();
+
+    if (!fec) {
+        roc_panic("rlc reader: unexpected non-fec packet");
+    }
+
+    if (fec->fec_scheme != packet::FEC_RLC) {
+        roc_log(LogDebug,
+                "rlc reader: unexpected packet fec scheme, shutting down:"
+                " packet_scheme=%s session_scheme=%s",
+                packet::fec_scheme_to_str(fec->fec_scheme),
+                packet::fec_scheme_to_str(packet::FEC_RLC));
+        return (alive_ = false);
+    }
+
+    return true;
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rlc_reader.h
+//! @brief RLC FEC reader.
+
+#ifndef ROC_FEC_RLC_READER_H_
+#define ROC_FEC_RLC_READER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/buffer_pool.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_fec/rlc_decoder.h"
+#include "roc_packet/iparser.h"
+#include "roc_packet/ireader.h"
+#include "roc_packet/packet.h"
+#include "roc_packet/packet_pool.h"
+#include "roc_packet/seqnum_queue.h"
+#include "roc_packet/sorted_queue.h"
+
+namespace roc {
+namespace fec {
+
+//! RLC FEC reader parameters.
+struct RLCReaderConfig {
+    //! Maximum number of source packets in encoding window.
+    //! @remarks
+    //!  Repair packets with larger windows are dropped. Also defines how many
+    //!  packets the reader keeps after returning them, since they may be
+    //!  needed to repair following packets.
+    size_t max_window_length;
+
+    RLCReaderConfig()
+        : max_window_length(64) {
+    }
+};
+
+//! RLC FEC reader.
+//! @remarks
+//!  Reads source and repair packets of sliding window Random Linear Codes
+//!  (RFC 8681). When a source packet is known to be lost, i.e. a following
+//!  packet was already received, tries to repair it using all repair packets
+//!  whose encoding windows are not yet passed. Unlike block codes, there is
+//!  no need to wait for the end of a block, so losses are repaired as soon as
+//!  enough repair packets following the loss are received.
+class RLCReader : public packet::IReader, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - @p config contains FEC scheme parameters
+    //!  - @p source_reader specifies input queue with data packets
+    //!  - @p repair_reader specifies input queue with FEC packets
+    //!  - @p parser specifies packet parser for restored packets
+    //!  - @p packet_pool is used to allocate restored packets
+    //!  - @p buffer_pool is used to allocate buffers for restored packets
+    //!  - @p allocator is used to initialize packet arrays
+    RLCReader(const RLCReaderConfig& config,
+              packet::IReader& source_reader,
+              packet::IReader& repair_reader,
+              packet::IParser& parser,
+              packet::PacketPool& packet_pool,
+              core::BufferPool<uint8_t>& buffer_pool,
+              core::IAllocator& allocator);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Did reader receive first source packet?
+    bool started() const;
+
+    //! Is reader alive?
+    bool alive() const;
+
+    //! Read packet.
+    //! @remarks
+    //!  When a packet loss is detected, try to restore it from repair packets.
+    virtual packet::PacketPtr read();
+
+private:
+    packet::PacketPtr read_();
+
+    void next_packet_();
+    void jump_to_(uint32_t esi);
+    bool has_following_packets_() const;
+
+    void try_repair_();
+    packet::PacketPtr parse_repaired_packet_(const core::Slice<uint8_t>& buffer);
+
+    void fetch_packets_();
+    void fill_source_window_();
+    void fill_repair_window_();
+    void drop_old_repair_packets_();
+
+    packet::PacketPtr& slot_(uint32_t esi);
+    const packet::PacketPtr& slot_(uint32_t esi) const;
+
+    bool validate_fec_packet_(const packet::PacketPtr&);
+
+    packet::IReader& source_reader_;
+    packet::IReader& repair_reader_;
+    packet::IParser& parser_;
+    packet::PacketPool& packet_pool_;
+
+    packet::SeqnumQueue source_queue_;
+    packet::SortedQueue repair_queue_;
+
+    // source packets with ESI in range [head - history; head + window),
+    // including returned and restored packets
+    core::Array<packet::PacketPtr> source_window_;
+
+    // repair packets with encoding windows overlapping this range
+    core::Array<packet::PacketPtr> repair_window_;
+    size_t n_repair_packets_;
+
+    RLCDecoder decoder_;
+
+    // maximum encoding window length, and number of returned packets kept
+    size_t window_length_;
+    size_t history_length_;
+
+    uint32_t head_;
+
+    bool valid_;
+    bool alive_;
+    bool started_;
+
+    unsigned n_packets_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RLC_READER_H_
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rlc_writer.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_core/random.h"
+#include "roc_fec/rlc_coefficients.h"
+#include "roc_packet/fec_scheme_to_str.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+// maximum value of NSS field in repair header
+enum { MaxWindowLength = 0xfff };
+
+} // namespace
+
+RLCWriter::RLCWriter(const RLCWriterConfig& config,
+                     packet::IWriter& writer,
+                     packet::IComposer& source_composer,
+                     packet::IComposer& repair_composer,
+                     packet::PacketPool& packet_pool,
+                     core::BufferPool<uint8_t>& buffer_pool,
+                     core::IAllocator& allocator)
+    : window_length_(config.window_length)
+    , n_source_packets_(config.n_source_packets)
+    , n_repair_packets_(config.n_repair_packets)
+    , writer_(writer)
+    , source_composer_(source_composer)
+    , repair_composer_(repair_composer)
+    , packet_pool_(packet_pool)
+    , buffer_pool_(buffer_pool)
+    , kernel_(gf256_kernel(GF256Kernel_Auto))
+    , window_(allocator)
+    , window_head_(0)
+    , window_size_(0)
+    , coef_tab_(allocator)
+    , payload_size_(0)
+    , cur_esi_((uint32_t)core::random(uint32_t(-1)))
+    , cur_repair_key_((uint16_t)core::random(uint16_t(-1)))
+    , n_packets_since_repair_(0)
+    , valid_(false)
+    , alive_(true) {
+    if (window_length_ == 0 || window_length_ > MaxWindowLength) {
+        roc_log(LogError, "rlc writer: invalid window length: len=%lu max=%lu",
+                (unsigned long)window_length_, (unsigned long)MaxWindowLength);
+        return;
+    }
+
+    if (n_source_packets_ == 0) {
+        roc_log(LogError, "rlc writer: number of source packets can't be zero");
+        return;
+    }
+
+    if (!window_.resize(window_length_) || !coef_tab_.resize(window_length_)) {
+        return;
+    }
+
+    roc_log(LogDebug,
+            "rlc writer: initializing: window_len=%lu n_source=%lu n_repair=%lu"
+            " kernel=%s",
+            (unsigned long)window_length_, (unsigned long)n_source_packets_,
+            (unsigned long)n_repair_packets_, kernel_->name);
+
+    valid_ = true;
+}
+
+bool RLCWriter::valid() const {
+    return valid_;
+}
+
+bool RLCWriter::alive() const {
+    return alive_;
+}
+
+void RLCWriter::write(const packet::PacketPtr& pp) {
+    roc_panic_if_not(valid());
+    roc_panic_if_not(pp);
+
+    if (!alive_) {
+        return;
+    }
+
+    validate_fec_packet_(pp);
+
+    const size_t payload_size = pp->fec()->payload.size();
+
+    if (payload_size == 0) {
+        roc_log(LogError, "rlc writer: payload size can't be zero, shutting down");
+        alive_ = false;
+        return;
+    }
+
+    if (payload_size != payload_size_) {
+        reset_window_(payload_size);
+    }
+
+    write_source_packet_(pp);
+
+    if (++n_packets_since_repair_ == n_source_packets_) {
+        write_repair_packets_();
+        n_packets_since_repair_ = 0;
+    }
+}
+
+void RLCWriter::write_source_packet_(const packet::PacketPtr& pp) {
+    packet::FEC& fec = *pp->fec();
+
+    fec.encoding_symbol_id = cur_esi_;
+    fec.source_block_number = 0;
+    fec.source_block_length = 0;
+    fec.block_length = 0;
+
+    pp->add_flags(packet::Packet::FlagComposed);
+
+    if (!source_composer_.compose(*pp)) {
+        roc_panic("rlc writer: can't compose source packet");
+    }
+
+    if (window_size_ == window_length_) {
+        window_[window_head_] = NULL;
+        window_head_ = (window_head_ + 1) % window_length_;
+        window_size_--;
+    }
+
+    window_[(window_head_ + window_size_) % window_length_] = pp;
+    window_size_++;
+
+    cur_esi_++;
+
+    writer_.write(pp);
+}
+
+void RLCWriter::write_repair_packets_() {
+    for (size_t n = 0; n < n_repair_packets_; n++) {
+        packet::PacketPtr rp = make_repair_packet_();
+        if (!rp) {
+            continue;
+        }
+
+        encode_repair_packet_(rp);
+
+        rp->add_flags(packet::Packet::FlagComposed);
+
+        if (!repair_composer_.compose(*rp)) {
+            roc_panic("rlc writer: can't compose repair packet");
+        }
+
+        writer_.write(rp);
+    }
+}
+
+packet::PacketPtr RLCWriter::make_repair_packet_() {
+    packet::PacketPtr packet = new (packet_pool_) packet::Packet(packet_pool_);
+    if (!packet) {
+        roc_log(LogError, "rlc writer: can't allocate packet");
+        return NULL;
+    }
+
+    core::Slice<uint8_t> data = new (buffer_pool_) core::Buffer<uint8_t>(buffer_pool_);
+    if (!data) {
+        roc_log(LogError, "rlc writer: can't allocate buffer");
+        return NULL;
+    }
+
+    if (!repair_composer_.align(data, 0, Alignment)) {
+        roc_log(LogError, "rlc writer: can't align packet buffer");
+        return NULL;
+    }
+
+    if (!repair_composer_.prepare(*packet, data, payload_size_)) {
+        roc_log(LogError, "rlc writer: can't prepare packet");
+        return NULL;
+    }
+
+    if (!packet->fec()) {
+        roc_log(LogError, "rlc writer: unexpected non-fec packet");
+        return NULL;
+    }
+
+    packet->set_data(data);
+
+    validate_fec_packet_(packet);
+
+    return packet;
+}
+
+void RLCWriter::encode_repair_packet_(const packet::PacketPtr& rp) {
+    packet::FEC& fec = *rp->fec();
+
+    fec.encoding_symbol_id = uint32_t(cur_esi_ - window_size_);
+    fec.source_block_number = cur_repair_key_;
+    fec.source_block_length = window_size_;
+    fec.block_length = 0;
+
+    rlc_coefficients(cur_repair_key_, RLC_DenseThreshold, &coef_tab_[0], window_size_);
+
+    uint8_t* repair = fec.payload.data();
+    memset(repair, 0, payload_size_);
+
+    for (size_t n = 0; n < window_size_; n++) {
+        const packet::PacketPtr& sp = window_[(window_head_ + n) % window_length_];
+        kernel_->mul_add(repair, sp->fec()->payload.data(), coef_tab_[n],
+                         payload_size_);
+    }
+
+    cur_repair_key_++;
+}
+
+// Source symbols in encoding window must have equal size, so when payload
+// size changes, the window starts from scratch.
+void RLCWriter::reset_window_(size_t payload_size) {
+    if (payload_size_ != 0) {
+        roc_log(LogDebug,
+                "rlc writer: payload size changed, resetting window:"
+                " old_size=%lu new_size=%lu",
+                (unsigned long)payload_size_, (unsigned long)payload_size);
+    }
+
+    for (size_t n = 0; n < window_length_; n++) {
+        window_[n] = NULL;
+    }
+
+    window_head_ = 0;
+    window_size_ = 0;
+
+    payload_size_ = payload_size;
+}
+
+void RLCWriter::validate_fec_packet_(const packet::PacketPtr& pp) {
+    const packet::FEC* fec = pp->fec();
+
+    if (!fec) {
+        roc_panic("rlc writer: unexpected non-fec packet");
+    }
+
+    if (fec->fec_scheme != packet::FEC_RLC) {
+        roc_panic("rlc writer: unexpected packet fec scheme:"
+                  " packet_scheme=%s session_scheme=%s",
+                  packet::fec_scheme_to_str(fec->fec_scheme),
+                  packet::fec_scheme_to_str(packet::FEC_RLC));
+    }
+}
+
+} // namespace fec
+} // namespace roc
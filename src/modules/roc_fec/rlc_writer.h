@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rlc_writer.h
+//! @brief RLC FEC writer.
+
+#ifndef ROC_FEC_RLC_WRITER_H_
+#define ROC_FEC_RLC_WRITER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/buffer_pool.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_fec/gf256_kernel.h"
+#include "roc_packet/icomposer.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet.h"
+#include "roc_packet/packet_pool.h"
+
+namespace roc {
+namespace fec {
+
+//! RLC FEC writer parameters.
+struct RLCWriterConfig {
+    //! Maximum number of source packets in encoding window.
+    size_t window_length;
+
+    //! Number of source packets between two groups of repair packets.
+    size_t n_source_packets;
+
+    //! Number of repair packets in group.
+    size_t n_repair_packets;
+
+    RLCWriterConfig()
+        : window_length(10)
+        , n_source_packets(2)
+        , n_repair_packets(1) {
+    }
+};
+
+//! RLC FEC writer.
+//! @remarks
+//!  Implements sliding window Random Linear Codes over GF(2^8) (RFC 8681).
+//!  There are no blocks: after every n_source_packets source packets, the
+//!  writer produces n_repair_packets repair packets, each being a random
+//!  linear combination of the last window_length source packets. Since
+//!  windows overlap, a loss can be repaired as soon as a few following
+//!  packets are received, instead of waiting for the whole block.
+class RLCWriter : public packet::IWriter, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //!
+    //! @b Parameters
+    //!  - @p config contains FEC scheme parameters
+    //!  - @p writer is used to write source and repair packets
+    //!  - @p source_composer is used to format source packets
+    //!  - @p repair_composer is used to format repair packets
+    //!  - @p packet_pool is used to allocate repair packets
+    //!  - @p buffer_pool is used to allocate buffers for repair packets
+    //!  - @p allocator is used to initialize a packet array
+    RLCWriter(const RLCWriterConfig& config,
+              packet::IWriter& writer,
+              packet::IComposer& source_composer,
+              packet::IComposer& repair_composer,
+              packet::PacketPool& packet_pool,
+              core::BufferPool<uint8_t>& buffer_pool,
+              core::IAllocator& allocator);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Check if writer is still working.
+    bool alive() const;
+
+    //! Write packet.
+    //! @remarks
+    //!  - writes the given source packet to the output writer
+    //!  - adds it to encoding window
+    //!  - periodically generates repair packets and also writes them to
+    //!    the output writer
+    virtual void write(const packet::PacketPtr&);
+
+private:
+    // kernels don't require alignment, but packet buffers are aligned anyway
+    enum { Alignment = 8 };
+
+    void write_source_packet_(const packet::PacketPtr&);
+    void write_repair_packets_();
+    packet::PacketPtr make_repair_packet_();
+    void encode_repair_packet_(const packet::PacketPtr&);
+
+    void reset_window_(size_t payload_size);
+    void validate_fec_packet_(const packet::PacketPtr&);
+
+    const size_t window_length_;
+    const size_t n_source_packets_;
+    const size_t n_repair_packets_;
+
+    packet::IWriter& writer_;
+
+    packet::IComposer& source_composer_;
+    packet::IComposer& repair_composer_;
+
+    packet::PacketPool& packet_pool_;
+    core::BufferPool<uint8_t>& buffer_pool_;
+
+    const GF256Kernel* kernel_;
+
+    // last source packets, window_head_ is the oldest one
+    core::Array<packet::PacketPtr> window_;
+    size_t window_head_;
+    size_t window_size_;
+
+    core::Array<uint8_t> coef_tab_;
+
+    size_t payload_size_;
+
+    uint32_t cur_esi_;
+    uint16_t cur_repair_key_;
+
+    size_t n_packets_since_repair_;
+
+    bool valid_;
+    bool alive_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RLC_WRITER_H_
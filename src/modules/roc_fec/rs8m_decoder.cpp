@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rs8m_decoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_fec/gf256.h"
+
+namespace roc {
+namespace fec {
+
+RS8MDecoder::RS8MDecoder(const CodecConfig& config,
+                         core::BufferPool<uint8_t>& buffer_pool,
+                         core::IAllocator& allocator)
+    : sblen_(0)
+    , rblen_(0)
+    , payload_size_(0)
+    , matrix_(allocator)
+    , kernel_(gf256_kernel(GF256Kernel_Auto))
+    , buffer_pool_(buffer_pool)
+    , buff_tab_(allocator)
+    , recv_tab_(allocator)
+    , lost_tab_(allocator)
+    , used_tab_(allocator)
+    , dec_matrix_(allocator)
+    , dec_scratch_(allocator)
+    , coef_tab_(allocator)
+    , has_new_packets_(false)
+    , valid_(false) {
+    if (config.scheme != packet::FEC_ReedSolomon_M8) {
+        roc_panic("rs8m decoder: unexpected fec scheme");
+    }
+
+    if (config.rs_m != 8) {
+        roc_log(LogError, "rs8m decoder: unsupported m: m=%u", (unsigned)config.rs_m);
+        return;
+    }
+
+    roc_log(LogDebug, "rs8m decoder: initializing: kernel=%s", kernel_->name);
+
+    valid_ = true;
+}
+
+bool RS8MDecoder::valid() const {
+    return valid_;
+}
+
+size_t RS8MDecoder::max_block_length() const {
+    roc_panic_if_not(valid());
+
+    return RS8MMatrix::MaxBlockLength;
+}
+
+bool RS8MDecoder::begin(size_t sblen, size_t rblen, size_t payload_size) {
+    roc_panic_if_not(valid());
+
+    if (!matrix_.build(sblen, sblen + rblen)) {
+        return false;
+    }
+
+    // at most min(sblen, rblen) packets can be repaired
+    const size_t max_lost = std::min(sblen, rblen);
+
+    if (!buff_tab_.resize(sblen + rblen) || !recv_tab_.resize(sblen + rblen)
+        || !lost_tab_.resize(max_lost) || !used_tab_.resize(max_lost)
+        || !dec_matrix_.resize(max_lost * max_lost)
+        || !dec_scratch_.resize(max_lost * max_lost) || !coef_tab_.resize(sblen)) {
+        return false;
+    }
+
+    sblen_ = sblen;
+    rblen_ = rblen;
+    payload_size_ = payload_size;
+
+    return true;
+}
+
+void RS8MDecoder::set(size_t index, const core::Slice<uint8_t>& buffer) {
+    roc_panic_if_not(valid());
+
+    if (index >= sblen_ + rblen_) {
+        roc_panic("rs8m decoder: index out of bounds: index=%lu size=%lu",
+                  (unsigned long)index, (unsigned long)(sblen_ + rblen_));
+    }
+
+    if (!buffer) {
+        roc_panic("rs8m decoder: null buffer");
+    }
+
+    if (buffer.size() == 0 || buffer.size() != payload_size_) {
+        roc_panic("rs8m decoder: invalid payload size: cur=%lu new=%lu",
+                  (unsigned long)payload_size_, (unsigned long)buffer.size());
+    }
+
+    if (buff_tab_[index]) {
+        roc_panic("rs8m decoder: can't overwrite buffer: index=%lu",
+                  (unsigned long)index);
+    }
+
+    buff_tab_[index] = buffer;
+    recv_tab_[index] = true;
+
+    has_new_packets_ = true;
+}
+
+core::Slice<uint8_t> RS8MDecoder::repair(size_t index) {
+    roc_panic_if_not(valid());
+
+    if (index >= sblen_ + rblen_) {
+        roc_panic("rs8m decoder: index out of bounds: index=%lu size=%lu",
+                  (unsigned long)index, (unsigned long)(sblen_ + rblen_));
+    }
+
+    // repair packets are never repaired, like in OpenFEC
+    if (!buff_tab_[index] && index < sblen_ && has_new_packets_) {
+        decode_();
+        has_new_packets_ = false;
+    }
+
+    return buff_tab_[index];
+}
+
+void RS8MDecoder::end() {
+    roc_panic_if_not(valid());
+
+    report_();
+
+    for (size_t i = 0; i < buff_tab_.size(); ++i) {
+        buff_tab_[i] = core::Slice<uint8_t>();
+        recv_tab_[i] = false;
+    }
+
+    has_new_packets_ = false;
+}
+
+// Every received repair packet is a known linear combination of source packets.
+// Subtracting received source packets leaves a system of n_lost equations with
+// n_lost unknowns, which is solved by inverting its matrix. Instead of
+// subtracting in place, the coefficients are folded together, so that every
+// lost packet is computed as a single linear combination of received packets.
+void RS8MDecoder::decode_() {
+    size_t n_lost = 0;
+    for (size_t i = 0; i < sblen_; ++i) {
+        if (!buff_tab_[i]) {
+            if (n_lost == lost_tab_.size()) {
+                return;
+            }
+            lost_tab_[n_lost++] = i;
+        }
+    }
+
+    if (n_lost == 0) {
+        return;
+    }
+
+    size_t n_used = 0;
+    for (size_t i = sblen_; i < sblen_ + rblen_ && n_used < n_lost; ++i) {
+        if (buff_tab_[i]) {
+            used_tab_[n_used++] = i;
+        }
+    }
+
+    if (n_used < n_lost) {
+        roc_log(LogTrace, "rs8m decoder: not enough packets: lost=%lu repair=%lu",
+                (unsigned long)n_lost, (unsigned long)n_used);
+        return;
+    }
+
+    uint8_t* dec = &dec_matrix_[0];
+
+    for (size_t r = 0; r < n_lost; ++r) {
+        const uint8_t* row = matrix_.row(used_tab_[r]);
+        for (size_t c = 0; c < n_lost; ++c) {
+            dec[r * n_lost + c] = row[lost_tab_[c]];
+        }
+    }
+
+    if (!gf256_invert_matrix(dec, &dec_scratch_[0], n_lost)) {
+        roc_log(LogError, "rs8m decoder: decoding matrix is singular");
+        return;
+    }
+
+    for (size_t l = 0; l < n_lost; ++l) {
+        core::Slice<uint8_t> buffer = make_buffer_();
+        if (!buffer) {
+            return;
+        }
+
+        const uint8_t* dec_row = &dec[l * n_lost];
+        uint8_t* data = buffer.data();
+
+        memset(data, 0, payload_size_);
+
+        for (size_t r = 0; r < n_lost; ++r) {
+            kernel_->mul_add(data, buff_tab_[used_tab_[r]].data(), dec_row[r],
+                             payload_size_);
+        }
+
+        uint8_t* coefs = &coef_tab_[0];
+        memset(coefs, 0, sblen_);
+
+        for (size_t r = 0; r < n_lost; ++r) {
+            kernel_->mul_add(coefs, matrix_.row(used_tab_[r]), dec_row[r], sblen_);
+        }
+
+        for (size_t i = 0; i < sblen_; ++i) {
+            if (recv_tab_[i]) {
+                kernel_->mul_add(data, buff_tab_[i].data(), coefs[i], payload_size_);
+            }
+        }
+
+        buff_tab_[lost_tab_[l]] = buffer;
+    }
+}
+
+core::Slice<uint8_t> RS8MDecoder::make_buffer_() {
+    core::Slice<uint8_t> buffer = new (buffer_pool_) core::Buffer<uint8_t>(buffer_pool_);
+
+    if (!buffer) {
+        roc_log(LogError, "rs8m decoder: can't allocate buffer");
+        return core::Slice<uint8_t>();
+    }
+
+    if (buffer.capacity() < payload_size_) {
+        roc_log(LogError, "rs8m decoder: packet size too large: size=%lu max=%lu",
+                (unsigned long)payload_size_, (unsigned long)buffer.capacity());
+        return core::Slice<uint8_t>();
+    }
+
+    buffer.resize(payload_size_);
+
+    return buffer;
+}
+
+void RS8MDecoder::report_() {
+    size_t n_lost = 0, n_repaired = 0;
+
+    for (size_t i = 0; i < sblen_; ++i) {
+        if (recv_tab_[i]) {
+            continue;
+        }
+        n_lost++;
+        if (buff_tab_[i]) {
+            n_repaired++;
+        }
+    }
+
+    if (n_lost == 0) {
+        return;
+    }
+
+    roc_log(LogDebug, "rs8m decoder: repaired %u/%u/%u", (unsigned)n_repaired,
+            (unsigned)n_lost, (unsigned)buff_tab_.size());
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rs8m_decoder.h
+//! @brief Reed-Solomon decoder.
+
+#ifndef ROC_FEC_RS8M_DECODER_H_
+#define ROC_FEC_RS8M_DECODER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/buffer_pool.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_fec/codec_config.h"
+#include "roc_fec/gf256_kernel.h"
+#include "roc_fec/iblock_decoder.h"
+#include "roc_fec/rs8m_matrix.h"
+
+namespace roc {
+namespace fec {
+
+//! Reed-Solomon decoder.
+//! @remarks
+//!  Native implementation of Reed-Solomon m=8 scheme (RFC 6865), used when
+//!  OpenFEC is not available. Any sblen symbols of the block are enough to
+//!  repair all source symbols. Uses SIMD kernels when available.
+class RS8MDecoder : public IBlockDecoder, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    explicit RS8MDecoder(const CodecConfig& config,
+                         core::BufferPool<uint8_t>& buffer_pool,
+                         core::IAllocator& allocator);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Get the maximum number of encoding symbols for the scheme being used.
+    virtual size_t max_block_length() const;
+
+    //! Start block.
+    //!
+    //! @remarks
+    //!  Performs an initial setup for a block. Should be called before
+    //!  any operations for the block.
+    virtual bool begin(size_t sblen, size_t rblen, size_t payload_size);
+
+    //! Store source or repair packet buffer for current block.
+    virtual void set(size_t index, const core::Slice<uint8_t>& buffer);
+
+    //! Repair source packet buffer.
+    virtual core::Slice<uint8_t> repair(size_t index);
+
+    //! Finish block.
+    //!
+    //! @remarks
+    //!  Cleanups the resources allocated for the block. Should be called after
+    //!  all operations for the block.
+    virtual void end();
+
+private:
+    void decode_();
+    core::Slice<uint8_t> make_buffer_();
+    void report_();
+
+    size_t sblen_;
+    size_t rblen_;
+    size_t payload_size_;
+
+    RS8MMatrix matrix_;
+    const GF256Kernel* kernel_;
+
+    core::BufferPool<uint8_t>& buffer_pool_;
+
+    // received and repaired source and repair packets
+    core::Array<core::Slice<uint8_t> > buff_tab_;
+
+    // true if packet is received, false if it's is lost or repaired
+    core::Array<bool> recv_tab_;
+
+    // indices of lost source packets and of repair packets used to repair them
+    core::Array<size_t> lost_tab_;
+    core::Array<size_t> used_tab_;
+
+    // decoding matrix and scratch space for its inversion
+    core::Array<uint8_t> dec_matrix_;
+    core::Array<uint8_t> dec_scratch_;
+
+    // coefficients of received source packets for packet being repaired
+    core::Array<uint8_t> coef_tab_;
+
+    bool has_new_packets_;
+
+    bool valid_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RS8M_DECODER_H_
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rs8m_encoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace fec {
+
+RS8MEncoder::RS8MEncoder(const CodecConfig& config,
+                         core::BufferPool<uint8_t>&,
+                         core::IAllocator& allocator)
+    : sblen_(0)
+    , rblen_(0)
+    , payload_size_(0)
+    , matrix_(allocator)
+    , kernel_(gf256_kernel(GF256Kernel_Auto))
+    , buff_tab_(allocator)
+    , valid_(false) {
+    if (config.scheme != packet::FEC_ReedSolomon_M8) {
+        roc_panic("rs8m encoder: unexpected fec scheme");
+    }
+
+    if (config.rs_m != 8) {
+        roc_log(LogError, "rs8m encoder: unsupported m: m=%u", (unsigned)config.rs_m);
+        return;
+    }
+
+    roc_log(LogDebug, "rs8m encoder: initializing: kernel=%s", kernel_->name);
+
+    valid_ = true;
+}
+
+bool RS8MEncoder::valid() const {
+    return valid_;
+}
+
+size_t RS8MEncoder::alignment() const {
+    return Alignment;
+}
+
+size_t RS8MEncoder::max_block_length() const {
+    roc_panic_if_not(valid());
+
+    return RS8MMatrix::MaxBlockLength;
+}
+
+bool RS8MEncoder::begin(size_t sblen, size_t rblen, size_t payload_size) {
+    roc_panic_if_not(valid());
+
+    if (!matrix_.build(sblen, sblen + rblen)) {
+        return false;
+    }
+
+    if (!buff_tab_.resize(sblen + rblen)) {
+        return false;
+    }
+
+    sblen_ = sblen;
+    rblen_ = rblen;
+    payload_size_ = payload_size;
+
+    return true;
+}
+
+void RS8MEncoder::set(size_t index, const core::Slice<uint8_t>& buffer) {
+    roc_panic_if_not(valid());
+
+    if (index >= sblen_ + rblen_) {
+        roc_panic("rs8m encoder: can't write more than %lu data buffers",
+                  (unsigned long)(sblen_ + rblen_));
+    }
+
+    if (!buffer) {
+        roc_panic("rs8m encoder: null buffer");
+    }
+
+    if (buffer.size() == 0 || buffer.size() != payload_size_) {
+        roc_panic("rs8m encoder: invalid payload size: cur=%lu new=%lu",
+                  (unsigned long)payload_size_, (unsigned long)buffer.size());
+    }
+
+    if (buff_tab_[index]) {
+        roc_panic("rs8m encoder: buffer already set: index=%lu", (unsigned long)index);
+    }
+
+    buff_tab_[index] = buffer;
+
+    if (index < sblen_) {
+        for (size_t i = sblen_; i < sblen_ + rblen_; ++i) {
+            if (buff_tab_[i]) {
+                accumulate_(index, i);
+            }
+        }
+    } else {
+        memset(buffer.data(), 0, payload_size_);
+
+        for (size_t i = 0; i < sblen_; ++i) {
+            if (buff_tab_[i]) {
+                accumulate_(i, index);
+            }
+        }
+    }
+}
+
+void RS8MEncoder::fill() {
+    roc_panic_if_not(valid());
+
+    for (size_t i = 0; i < sblen_; ++i) {
+        if (!buff_tab_[i]) {
+            roc_panic("rs8m encoder: source buffer not set: index=%lu",
+                      (unsigned long)i);
+        }
+    }
+}
+
+void RS8MEncoder::accumulate_(size_t source_index, size_t repair_index) {
+    kernel_->mul_add(buff_tab_[repair_index].data(), buff_tab_[source_index].data(),
+                     matrix_.row(repair_index)[source_index], payload_size_);
+}
+
+void RS8MEncoder::end() {
+    roc_panic_if_not(valid());
+
+    for (size_t i = 0; i < buff_tab_.size(); ++i) {
+        buff_tab_[i] = core::Slice<uint8_t>();
+    }
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rs8m_encoder.h
+//! @brief Reed-Solomon encoder.
+
+#ifndef ROC_FEC_RS8M_ENCODER_H_
+#define ROC_FEC_RS8M_ENCODER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/buffer_pool.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_fec/codec_config.h"
+#include "roc_fec/gf256_kernel.h"
+#include "roc_fec/iblock_encoder.h"
+#include "roc_fec/rs8m_matrix.h"
+
+namespace roc {
+namespace fec {
+
+//! Reed-Solomon encoder.
+//! @remarks
+//!  Native implementation of Reed-Solomon m=8 scheme (RFC 6865), used when
+//!  OpenFEC is not available. Uses SIMD kernels when available.
+//!
+//!  Repair symbols are accumulated incrementally: every source buffer is
+//!  multiplied and added to every repair buffer that is already set, and
+//!  every repair buffer is initialized from source buffers that are already
+//!  set. When repair buffers are set first, fill() has nothing left to do.
+class RS8MEncoder : public IBlockEncoder, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    explicit RS8MEncoder(const CodecConfig& config,
+                         core::BufferPool<uint8_t>& buffer_pool,
+                         core::IAllocator& allocator);
+
+    //! Check if object is successfully constructed.
+    bool valid() const;
+
+    //! Get buffer alignment requirement.
+    virtual size_t alignment() const;
+
+    //! Get the maximum number of encoding symbols for the scheme being used.
+    virtual size_t max_block_length() const;
+
+    //! Start block.
+    //!
+    //! @remarks
+    //!  Performs an initial setup for a block. Should be called before
+    //!  any operations for the block.
+    virtual bool begin(size_t sblen, size_t rblen, size_t payload_size);
+
+    //! Store packet data for current block.
+    //! @remarks
+    //!  Accumulates source buffer into repair buffers that are already set.
+    virtual void set(size_t index, const core::Slice<uint8_t>& buffer);
+
+    //! Fill repair packets.
+    //! @remarks
+    //!  Only checks that all source buffers were set, since repair buffers
+    //!  are already filled by set().
+    virtual void fill();
+
+    //! Finish block.
+    //!
+    //! @remarks
+    //!  Cleanups the resources allocated for the block. Should be called after
+    //!  all operations for the block.
+    virtual void end();
+
+private:
+    void accumulate_(size_t source_index, size_t repair_index);
+
+    // kernels don't require alignment, but packet buffers are aligned anyway
+    enum { Alignment = 8 };
+
+    size_t sblen_;
+    size_t rblen_;
+    size_t payload_size_;
+
+    RS8MMatrix matrix_;
+    const GF256Kernel* kernel_;
+
+    core::Array<core::Slice<uint8_t> > buff_tab_;
+
+    bool valid_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RS8M_ENCODER_H_
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rs8m_matrix.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_fec/gf256.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+// Element of Vandermonde matrix for symbol with given index.
+uint8_t vandermonde(size_t index, size_t col) {
+    if (index == 0) {
+        return col == 0 ? 1 : 0;
+    }
+    return gf256_exp((index - 1) * col);
+}
+
+} // namespace
+
+RS8MMatrix::RS8MMatrix(core::IAllocator& allocator)
+    : sblen_(0)
+    , blen_(0)
+    , rows_(allocator)
+    , scratch_(allocator) {
+}
+
+bool RS8MMatrix::build(size_t sblen, size_t blen) {
+    if (sblen == sblen_ && blen <= blen_) {
+        return true;
+    }
+
+    if (sblen == 0 || sblen > blen || blen > MaxBlockLength) {
+        roc_log(LogError, "rs8m matrix: invalid block size: sblen=%lu blen=%lu max=%lu",
+                (unsigned long)sblen, (unsigned long)blen,
+                (unsigned long)MaxBlockLength);
+        return false;
+    }
+
+    const size_t rblen = blen - sblen;
+
+    if (!rows_.resize(rblen * sblen) || !scratch_.resize(sblen * sblen * 2)) {
+        roc_log(LogError, "rs8m matrix: can't allocate matrix");
+        sblen_ = blen_ = 0;
+        return false;
+    }
+
+    uint8_t* top = &scratch_[0];
+    uint8_t* tmp = &scratch_[sblen * sblen];
+
+    for (size_t r = 0; r < sblen; r++) {
+        for (size_t c = 0; c < sblen; c++) {
+            top[r * sblen + c] = vandermonde(r, c);
+        }
+    }
+
+    // Vandermonde matrix with distinct elements is never singular
+    if (!gf256_invert_matrix(top, tmp, sblen)) {
+        roc_panic("rs8m matrix: singular matrix: sblen=%lu", (unsigned long)sblen);
+    }
+
+    for (size_t r = 0; r < rblen; r++) {
+        uint8_t* row = &rows_[r * sblen];
+
+        for (size_t c = 0; c < sblen; c++) {
+            uint8_t sum = 0;
+            for (size_t i = 0; i < sblen; i++) {
+                sum ^= gf256_mul(vandermonde(sblen + r, i), top[i * sblen + c]);
+            }
+            row[c] = sum;
+        }
+    }
+
+    sblen_ = sblen;
+    blen_ = blen;
+
+    return true;
+}
+
+const uint8_t* RS8MMatrix::row(size_t index) const {
+    if (index < sblen_ || index >= blen_) {
+        roc_panic("rs8m matrix: index out of bounds: index=%lu sblen=%lu blen=%lu",
+                  (unsigned long)index, (unsigned long)sblen_, (unsigned long)blen_);
+    }
+    return &rows_[(index - sblen_) * sblen_];
+}
+
+} // namespace fec
+} // namespace roc
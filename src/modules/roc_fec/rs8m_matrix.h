@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rs8m_matrix.h
+//! @brief Reed-Solomon encoding matrix.
+
+#ifndef ROC_FEC_RS8M_MATRIX_H_
+#define ROC_FEC_RS8M_MATRIX_H_
+
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace fec {
+
+//! Reed-Solomon encoding matrix over GF(2^8).
+//!
+//! @remarks
+//!  Systematic generator matrix, as defined by RFC 6865.
+//!  An n x k Vandermonde matrix is built, with the first row being
+//!  [1, 0, ..., 0] and row r + 1 being alpha^(r * col), and then multiplied
+//!  by the inverse of its top k x k part. The top part of the result is the
+//!  identity matrix, so only the rows for repair symbols are stored.
+//!
+//!  Repair symbol with index i is the sum of source symbols multiplied by the
+//!  corresponding elements of row i.
+//!
+//!  The matrix is rebuilt only when the block size changes.
+class RS8MMatrix : public core::NonCopyable<> {
+public:
+    //! Maximum number of symbols in block.
+    enum { MaxBlockLength = 255 };
+
+    //! Initialize.
+    explicit RS8MMatrix(core::IAllocator& allocator);
+
+    //! Build matrix for given number of source symbols and total symbols.
+    //! @returns
+    //!  false if parameters are invalid or allocation failed.
+    bool build(size_t sblen, size_t blen);
+
+    //! Get row for repair symbol.
+    //! @remarks
+    //!  Returns array of sblen coefficients. @p index should be in range
+    //!  [sblen; blen).
+    const uint8_t* row(size_t index) const;
+
+private:
+    size_t sblen_;
+    size_t blen_;
+
+    core::Array<uint8_t> rows_;
+    core::Array<uint8_t> scratch_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RS8M_MATRIX_H_
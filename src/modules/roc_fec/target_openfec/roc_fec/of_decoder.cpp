@@ -95,7 +95,6 @@ bool OFDecoder::begin(size_t sblen, size_t rblen, size_t payload_size) {
     max_index_ = 0;
 
     update_session_params_(sblen, rblen, payload_size);
-    reset_session_();
 
     return true;
 }
@@ -127,13 +126,10 @@ void OFDecoder::set(size_t index, const core::Slice<uint8_t>& buffer) {
     data_tab_[index] = buffer.data();
     recv_tab_[index] = true;
 
-    // register new packet and try to repair more packets
-    roc_log(LogTrace, "of decoder: of_decode_with_new_symbol(): index=%lu",
-            (unsigned long)index);
-
-    if (of_decode_with_new_symbol(of_sess_, data_tab_[index], (unsigned int)index)
-        != OF_STATUS_OK) {
-        roc_panic("of decoder: can't add packet to OF session");
+    // until a packet is lost, packets are only stored and are passed to the
+    // session when it's created, see repair()
+    if (of_sess_ != NULL) {
+        add_symbol_(index);
     }
 
     if (max_index_ < index) {
@@ -145,7 +141,12 @@ core::Slice<uint8_t> OFDecoder::repair(size_t index) {
     roc_panic_if_not(valid());
 
     if (!buff_tab_[index]) {
-        update_();
+        if (!data_tab_[index]) {
+            if (of_sess_ == NULL) {
+                start_session_();
+            }
+            update_();
+        }
         fix_buffer_(index);
     }
 
@@ -153,8 +154,9 @@ core::Slice<uint8_t> OFDecoder::repair(size_t index) {
 }
 
 void OFDecoder::end() {
+    report_();
+
     if (of_sess_ != NULL) {
-        report_();
         destroy_session_();
     }
 
@@ -222,7 +224,7 @@ void OFDecoder::decode_() {
 
     if (decoding_finished_) {
         // it's not allowed to decode twice, so we recreate the session
-        reset_session_();
+        recreate_session_();
 
         roc_log(LogTrace, "of decoder: of_set_available_symbols()");
 
@@ -242,6 +244,17 @@ void OFDecoder::decode_() {
     decoding_finished_ = true;
 }
 
+void OFDecoder::add_symbol_(size_t index) {
+    // register new packet and try to repair more packets
+    roc_log(LogTrace, "of decoder: of_decode_with_new_symbol(): index=%lu",
+            (unsigned long)index);
+
+    if (of_decode_with_new_symbol(of_sess_, data_tab_[index], (unsigned int)index)
+        != OF_STATUS_OK) {
+        roc_panic("of decoder: can't add packet to OF session");
+    }
+}
+
 // note: we have to calculate this every time because OpenFEC
 // doesn't always report to us when it repairs a packet
 bool OFDecoder::has_n_packets_(size_t n_packets) const {
@@ -266,11 +279,8 @@ bool OFDecoder::is_optimal_() const {
     return codec_id_ == OF_CODEC_REED_SOLOMON_GF_2_M_STABLE;
 }
 
-void OFDecoder::reset_session_() {
-    if (of_sess_ != NULL) {
-        of_release_codec_instance(of_sess_);
-        of_sess_ = NULL;
-    }
+void OFDecoder::create_session_() {
+    roc_panic_if(of_sess_ != NULL);
 
     roc_log(LogTrace, "of decoder: of_create_codec_instance()");
 
@@ -303,6 +313,47 @@ void OFDecoder::reset_session_() {
     }
 }
 
+// session is created when first lost packet is requested, so blocks without
+// losses never touch OpenFEC; packets received before are registered in the
+// same way as if the session was created in begin()
+void OFDecoder::start_session_() {
+    create_session_();
+
+    for (size_t i = 0; i < recv_tab_.size(); i++) {
+        if (recv_tab_[i]) {
+            add_symbol_(i);
+        }
+    }
+}
+
+void OFDecoder::recreate_session_() {
+    roc_log(LogTrace, "of decoder: of_release_codec_instance()");
+
+    of_release_codec_instance(of_sess_);
+    of_sess_ = NULL;
+
+    // OpenFEC may allocate memory without calling source_cb_(), and such
+    // memory is not freed with the session; we move repaired packets to our
+    // own buffers and free() it, like destroy_session_() does
+    for (size_t i = 0; i < sblen_; i++) {
+        if (data_tab_[i] == NULL) {
+            continue;
+        }
+        if (buff_tab_[i] && buff_tab_[i].data() == data_tab_[i]) {
+            continue;
+        }
+
+        fix_buffer_(i);
+
+        roc_log(LogTrace, "of decoder: of_free(): index=%lu", (unsigned long)i);
+        of_free(data_tab_[i]);
+
+        data_tab_[i] = buff_tab_[i] ? buff_tab_[i].data() : NULL;
+    }
+
+    create_session_();
+}
+
 void OFDecoder::destroy_session_() {
     roc_log(LogTrace, "of decoder: of_release_codec_instance()");
 
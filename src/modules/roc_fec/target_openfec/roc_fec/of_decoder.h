@@ -80,11 +80,14 @@ private:
 
     void update_();
     void decode_();
+    void add_symbol_(size_t index);
 
     bool has_n_packets_(size_t n_packets) const;
     bool is_optimal_() const;
 
-    void reset_session_();
+    void start_session_();
+    void create_session_();
+    void recreate_session_();
     void destroy_session_();
 
     void report_();
@@ -106,7 +109,7 @@ private:
         of_ldpc_parameters ldpc_params_;
     } codec_params_;
 
-    // session is recreated for every new block
+    // session is created only when block needs repair, see start_session_()
     of_session_t* of_sess_;
     of_parameters_t* of_sess_params_;
 
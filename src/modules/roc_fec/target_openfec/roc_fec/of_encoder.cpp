@@ -76,6 +76,8 @@ size_t OFEncoder::max_block_length() const {
 bool OFEncoder::begin(size_t sblen, size_t rblen, size_t payload_size) {
     roc_panic_if_not(valid());
 
+    // unlike decoder session, encoder session holds no per-block state, so it
+    // and its precomputed matrices are reused while block parameters are same
     if (sblen_ == sblen && rblen_ == rblen && payload_size_ == payload_size) {
         return true;
     }
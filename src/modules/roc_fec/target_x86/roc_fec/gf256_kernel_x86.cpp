@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <immintrin.h>
+
+#include "roc_fec/gf256_kernel_x86.h"
+#include "roc_core/cpu_attributes.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+// Multiplication by a constant is linear over XOR, so the product of a byte
+// is the sum of products of its low and high nibbles. Each of them has only
+// 16 possible values, which fit into a register and are looked up using
+// byte shuffle, 16 or 32 bytes at a time.
+
+void scalar_mul_add(uint8_t* dst,
+                    const uint8_t* src,
+                    const uint8_t* lo,
+                    const uint8_t* hi,
+                    size_t size) {
+    for (size_t n = 0; n < size; n++) {
+        dst[n] ^= lo[src[n] & 0xf] ^ hi[src[n] >> 4];
+    }
+}
+
+void scalar_add(uint8_t* dst, const uint8_t* src, size_t size) {
+    for (size_t n = 0; n < size; n++) {
+        dst[n] ^= src[n];
+    }
+}
+
+ROC_ATTR_SSSE3 void ssse3_add(uint8_t* dst, const uint8_t* src, size_t size) {
+    size_t n = 0;
+
+    for (; n + 16 <= size; n += 16) {
+        const __m128i x = _mm_loadu_si128((const __m128i*)(src + n));
+        const __m128i y = _mm_loadu_si128((const __m128i*)(dst + n));
+
+        _mm_storeu_si128((__m128i*)(dst + n), _mm_xor_si128(y, x));
+    }
+
+    scalar_add(dst + n, src + n, size - n);
+}
+
+ROC_ATTR_SSSE3 inline __m128i
+ssse3_mul(__m128i x, __m128i v_lo, __m128i v_hi, __m128i v_mask) {
+    const __m128i x_lo = _mm_and_si128(x, v_mask);
+    const __m128i x_hi = _mm_and_si128(_mm_srli_epi64(x, 4), v_mask);
+
+    return _mm_xor_si128(_mm_shuffle_epi8(v_lo, x_lo), _mm_shuffle_epi8(v_hi, x_hi));
+}
+
+ROC_ATTR_SSSE3 void
+ssse3_mul_add(uint8_t* dst, const uint8_t* src, uint8_t coef, size_t size) {
+    if (coef == 0) {
+        return;
+    }
+
+    if (coef == 1) {
+        ssse3_add(dst, src, size);
+        return;
+    }
+
+    uint8_t lo[16], hi[16];
+    gf256_nibble_tables(coef, lo, hi);
+
+    const __m128i v_lo = _mm_loadu_si128((const __m128i*)lo);
+    const __m128i v_hi = _mm_loadu_si128((const __m128i*)hi);
+    const __m128i v_mask = _mm_set1_epi8(0x0f);
+
+    size_t n = 0;
+
+    for (; n + 16 <= size; n += 16) {
+        const __m128i x = _mm_loadu_si128((const __m128i*)(src + n));
+        const __m128i y = _mm_loadu_si128((const __m128i*)(dst + n));
+
+        _mm_storeu_si128((__m128i*)(dst + n),
+                         _mm_xor_si128(y, ssse3_mul(x, v_lo, v_hi, v_mask)));
+    }
+
+    scalar_mul_add(dst + n, src + n, lo, hi, size - n);
+}
+
+ROC_ATTR_AVX2 void avx2_add(uint8_t* dst, const uint8_t* src, size_t size) {
+    size_t n = 0;
+
+    for (; n + 64 <= size; n += 64) {
+        const __m256i x0 = _mm256_loadu_si256((const __m256i*)(src + n));
+        const __m256i x1 = _mm256_loadu_si256((const __m256i*)(src + n + 32));
+        const __m256i y0 = _mm256_loadu_si256((const __m256i*)(dst + n));
+        const __m256i y1 = _mm256_loadu_si256((const __m256i*)(dst + n + 32));
+
+        _mm256_storeu_si256((__m256i*)(dst + n), _mm256_xor_si256(y0, x0));
+        _mm256_storeu_si256((__m256i*)(dst + n + 32), _mm256_xor_si256(y1, x1));
+    }
+
+    for (; n + 32 <= size; n += 32) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(src + n));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(dst + n));
+
+        _mm256_storeu_si256((__m256i*)(dst + n), _mm256_xor_si256(y, x));
+    }
+
+    ssse3_add(dst + n, src + n, size - n);
+}
+
+ROC_ATTR_AVX2 inline __m256i
+avx2_mul(__m256i x, __m256i v_lo, __m256i v_hi, __m256i v_mask) {
+    const __m256i x_lo = _mm256_and_si256(x, v_mask);
+    const __m256i x_hi = _mm256_and_si256(_mm256_srli_epi64(x, 4), v_mask);
+
+    return _mm256_xor_si256(_mm256_shuffle_epi8(v_lo, x_lo),
+                            _mm256_shuffle_epi8(v_hi, x_hi));
+}
+
+ROC_ATTR_AVX2 void
+avx2_mul_add(uint8_t* dst, const uint8_t* src, uint8_t coef, size_t size) {
+    if (coef == 0) {
+        return;
+    }
+
+    if (coef == 1) {
+        avx2_add(dst, src, size);
+        return;
+    }
+
+    uint8_t lo[16], hi[16];
+    gf256_nibble_tables(coef, lo, hi);
+
+    // shuffle works within 128-bit lanes, so tables are duplicated in both
+    const __m256i v_lo =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)lo));
+    const __m256i v_hi =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)hi));
+    const __m256i v_mask = _mm256_set1_epi8(0x0f);
+
+    size_t n = 0;
+
+    for (; n + 64 <= size; n += 64) {
+        const __m256i x0 = _mm256_loadu_si256((const __m256i*)(src + n));
+        const __m256i x1 = _mm256_loadu_si256((const __m256i*)(src + n + 32));
+        const __m256i y0 = _mm256_loadu_si256((const __m256i*)(dst + n));
+        const __m256i y1 = _mm256_loadu_si256((const __m256i*)(dst + n + 32));
+
+        _mm256_storeu_si256((__m256i*)(dst + n),
+                            _mm256_xor_si256(y0, avx2_mul(x0, v_lo, v_hi, v_mask)));
+        _mm256_storeu_si256((__m256i*)(dst + n + 32),
+                            _mm256_xor_si256(y1, avx2_mul(x1, v_lo, v_hi, v_mask)));
+    }
+
+    for (; n + 32 <= size; n += 32) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(src + n));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(dst + n));
+
+        _mm256_storeu_si256((__m256i*)(dst + n),
+                            _mm256_xor_si256(y, avx2_mul(x, v_lo, v_hi, v_mask)));
+    }
+
+    if (n + 16 <= size) {
+        const __m128i x = _mm_loadu_si128((const __m128i*)(src + n));
+        const __m128i y = _mm_loadu_si128((const __m128i*)(dst + n));
+
+        _mm_storeu_si128((__m128i*)(dst + n),
+                         _mm_xor_si128(y,
+                                       ssse3_mul(x, _mm256_castsi256_si128(v_lo),
+                                                 _mm256_castsi256_si128(v_hi),
+                                                 _mm256_castsi256_si128(v_mask))));
+        n += 16;
+    }
+
+    scalar_mul_add(dst + n, src + n, lo, hi, size - n);
+}
+
+} // namespace
+
+const GF256Kernel SSSE3GF256Kernel = {
+    GF256Kernel_SSSE3,
+    "ssse3",
+    ssse3_mul_add,
+    ssse3_add,
+};
+
+const GF256Kernel AVX2GF256Kernel = {
+    GF256Kernel_AVX2,
+    "avx2",
+    avx2_mul_add,
+    avx2_add,
+};
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/target_x86/roc_fec/gf256_kernel_x86.h
+//! @brief x86 SIMD GF(2^8) kernels.
+
+#ifndef ROC_FEC_GF256_KERNEL_X86_H_
+#define ROC_FEC_GF256_KERNEL_X86_H_
+
+#include "roc_fec/gf256_kernel.h"
+
+namespace roc {
+namespace fec {
+
+//! SSSE3 GF(2^8) kernel.
+//! @remarks
+//!  Should be used only if the CPU supports SSSE3.
+extern const GF256Kernel SSSE3GF256Kernel;
+
+//! AVX2 GF(2^8) kernel.
+//! @remarks
+//!  Should be used only if the CPU supports AVX2.
+extern const GF256Kernel AVX2GF256Kernel;
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_GF256_KERNEL_X86_H_
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/tinymt32.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+const uint32_t Mat1 = 0x8f7011ee;
+const uint32_t Mat2 = 0xfc78ff1f;
+const uint32_t TMat = 0x3793fdff;
+
+const uint32_t Mask = 0x7fffffff;
+
+enum { MinLoop = 8, PreLoop = 8 };
+
+} // namespace
+
+TinyMT32::TinyMT32(uint32_t seed) {
+    status_[0] = seed;
+    status_[1] = Mat1;
+    status_[2] = Mat2;
+    status_[3] = TMat;
+
+    for (uint32_t i = 1; i < MinLoop; i++) {
+        status_[i & 3] ^= i
+            + uint32_t(1812433253)
+                * (status_[(i - 1) & 3] ^ (status_[(i - 1) & 3] >> 30));
+    }
+
+    // period certification
+    if ((status_[0] & Mask) == 0 && status_[1] == 0 && status_[2] == 0
+        && status_[3] == 0) {
+        status_[0] = 'T';
+        status_[1] = 'I';
+        status_[2] = 'N';
+        status_[3] = 'Y';
+    }
+
+    for (size_t i = 0; i < PreLoop; i++) {
+        next_state_();
+    }
+}
+
+uint32_t TinyMT32::next() {
+    next_state_();
+    return temper_();
+}
+
+void TinyMT32::next_state_() {
+    uint32_t y = status_[3];
+    uint32_t x = (status_[0] & Mask) ^ status_[1] ^ status_[2];
+
+    x ^= (x << 1);
+    y ^= (y >> 1) ^ x;
+
+    status_[0] = status_[1];
+    status_[1] = status_[2];
+    status_[2] = x ^ (y << 10);
+    status_[3] = y;
+
+    if (y & 1) {
+        status_[1] ^= Mat1;
+        status_[2] ^= Mat2;
+    }
+}
+
+uint32_t TinyMT32::temper_() const {
+    uint32_t t0 = status_[3];
+    const uint32_t t1 = status_[0] + (status_[2] >> 8);
+
+    t0 ^= t1;
+
+    if (t1 & 1) {
+        t0 ^= TMat;
+    }
+
+    return t0;
+}
+
+} // namespace fec
+} // namespace roc
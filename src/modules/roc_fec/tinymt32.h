@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/tinymt32.h
+//! @brief TinyMT32 pseudo-random number generator.
+
+#ifndef ROC_FEC_TINYMT32_H_
+#define ROC_FEC_TINYMT32_H_
+
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace fec {
+
+//! TinyMT32 pseudo-random number generator.
+//! @remarks
+//!  Implements RFC 8682, with the parameter set mandated by it. Used to derive
+//!  coding coefficients of RLC repair symbols from the repair key, so the
+//!  output must be bit-exact on all platforms.
+class TinyMT32 {
+public:
+    //! Initialize generator with given seed.
+    explicit TinyMT32(uint32_t seed);
+
+    //! Generate next 32-bit number.
+    uint32_t next();
+
+private:
+    void next_state_();
+    uint32_t temper_() const;
+
+    uint32_t status_[4];
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_TINYMT32_H_
@@ -143,12 +143,15 @@ bool Writer::begin_block_(const packet::PacketPtr& pp) {
         return (alive_ = false);
     }
 
+    make_repair_packets_();
+    encode_repair_packets_();
+
     return true;
 }
 
 void Writer::end_block_() {
-    make_repair_packets_();
-    encode_repair_packets_();
+    encoder_.fill();
+
     compose_repair_packets_();
     write_repair_packets_();
 
@@ -185,8 +188,6 @@ bool Writer::apply_sizes_(size_t sblen, size_t rblen, size_t payload_size) {
 }
 
 void Writer::write_source_packet_(const packet::PacketPtr& pp) {
-    encoder_.set(cur_packet_, pp->fec()->payload);
-
     pp->add_flags(packet::Packet::FlagComposed);
     fill_packet_fec_fields_(pp, (packet::seqnum_t)cur_packet_);
 
@@ -194,6 +195,10 @@ void Writer::write_source_packet_(const packet::PacketPtr& pp) {
         roc_panic("fec writer: can't compose source packet");
     }
 
+    // payload includes headers of the inner protocol, which are written
+    // by the composer, so encoder should see the packet after composing
+    encoder_.set(cur_packet_, pp->fec()->payload);
+
     writer_.write(pp);
 }
 
@@ -244,13 +249,14 @@ packet::PacketPtr Writer::make_repair_packet_(packet::seqnum_t pack_n) {
 }
 
 void Writer::encode_repair_packets_() {
+    // repair buffers are set before source buffers, so that encoder can
+    // accumulate repair symbols as source packets are written
     for (size_t i = 0; i < cur_rblen_; i++) {
         packet::PacketPtr rp = repair_block_[i];
         if (rp) {
             encoder_.set(cur_sblen_ + i, rp->fec()->payload);
         }
     }
-    encoder_.fill();
 }
 
 void Writer::compose_repair_packets_() {
@@ -76,7 +76,9 @@ public:
     //! Write packet.
     //! @remarks
     //!  - writes the given source packet to the output writer
-    //!  - generates repair packets and also writes them to the output writer
+    //!  - passes the packet to the encoder, which may update repair packets
+    //!    of the current block right away
+    //!  - when the block is complete, writes repair packets to the output writer
     virtual void write(const packet::PacketPtr&);
 
 private:
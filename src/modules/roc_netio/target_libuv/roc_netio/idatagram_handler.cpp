@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_netio/idatagram_handler.h"
+
+namespace roc {
+namespace netio {
+
+IDatagramHandler::~IDatagramHandler() {
+}
+
+} // namespace netio
+} // namespace roc
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_netio/target_libuv/roc_netio/idatagram_handler.h
+//! @brief Datagram handler.
+
+#ifndef ROC_NETIO_IDATAGRAM_HANDLER_H_
+#define ROC_NETIO_IDATAGRAM_HANDLER_H_
+
+#include "roc_core/buffer.h"
+#include "roc_core/stddefs.h"
+#include "roc_packet/address.h"
+
+namespace roc {
+namespace netio {
+
+//! Datagram handler interface.
+class IDatagramHandler {
+public:
+    virtual ~IDatagramHandler();
+
+    //! Handle received datagram.
+    //!
+    //! @remarks
+    //!  - Datagram is @p size bytes of @p buffer starting from @p offset.
+    //!  - Should be called from the event loop thread.
+    virtual void handle_datagram(core::Buffer<uint8_t>& buffer,
+                                 size_t offset,
+                                 size_t size,
+                                 const packet::Address& src_addr) = 0;
+};
+
+} // namespace netio
+} // namespace roc
+
+#endif // ROC_NETIO_IDATAGRAM_HANDLER_H_
@@ -15,6 +15,13 @@
 namespace roc {
 namespace netio {
 
+namespace {
+
+// Maximum number of datagrams sent or received per system call.
+const size_t UDPBatchSize = 32;
+
+} // namespace
+
 Transceiver::Transceiver(packet::PacketPool& packet_pool,
                          core::BufferPool<uint8_t>& buffer_pool,
                          core::IAllocator& allocator)
@@ -259,7 +266,8 @@ void Transceiver::process_tasks_() {
 bool Transceiver::add_udp_receiver_(Task& task) {
     core::SharedPtr<BasicPort> rp =
         new (allocator_) UDPReceiverPort(*this, *task.address, loop_, *task.writer,
-                                         packet_pool_, buffer_pool_, allocator_);
+                                         packet_pool_, buffer_pool_, allocator_,
+                                         UDPBatchSize);
 
     if (!rp) {
         roc_log(LogError, "transceiver: can't add port %s: can't allocate receiver",
@@ -288,7 +296,8 @@ bool Transceiver::add_udp_receiver_(Task& task) {
 
 bool Transceiver::add_udp_sender_(Task& task) {
     core::SharedPtr<UDPSenderPort> sp =
-        new (allocator_) UDPSenderPort(*this, *task.address, loop_, allocator_);
+        new (allocator_)
+            UDPSenderPort(*this, *task.address, loop_, allocator_, UDPBatchSize);
     if (!sp) {
         roc_log(LogError, "transceiver: can't add port %s: can't allocate sender",
                 packet::address_to_str(*task.address).c_str());
@@ -21,13 +21,15 @@ UDPReceiverPort::UDPReceiverPort(ICloseHandler& close_handler,
                                  packet::IWriter& writer,
                                  packet::PacketPool& packet_pool,
                                  core::BufferPool<uint8_t>& buffer_pool,
-                                 core::IAllocator& allocator)
+                                 core::IAllocator& allocator,
+                                 size_t batch_size)
     : BasicPort(allocator)
     , close_handler_(close_handler)
     , loop_(event_loop)
     , handle_initialized_(false)
     , recv_started_(false)
     , closed_(false)
+    , batch_receiver_(*this, buffer_pool, allocator, batch_size)
     , address_(address)
     , writer_(writer)
     , packet_pool_(packet_pool)
@@ -36,7 +38,7 @@ UDPReceiverPort::UDPReceiverPort(ICloseHandler& close_handler,
 }
 
 UDPReceiverPort::~UDPReceiverPort() {
-    if (handle_initialized_) {
+    if (handle_initialized_ || batch_receiver_.initialized()) {
         roc_panic(
             "udp receiver: receiver was not fully closed before calling destructor");
     }
@@ -89,16 +91,19 @@ bool UDPReceiverPort::open() {
         return false;
     }
 
-    if (int err = uv_udp_recv_start(&handle_, alloc_cb_, recv_cb_)) {
-        roc_log(LogError, "udp receiver: uv_udp_recv_start(): [%s] %s", uv_err_name(err),
-                uv_strerror(err));
-        return false;
-    }
+    if (!batch_receiver_.start(loop_, handle_, address_)) {
+        if (int err = uv_udp_recv_start(&handle_, alloc_cb_, recv_cb_)) {
+            roc_log(LogError, "udp receiver: uv_udp_recv_start(): [%s] %s",
+                    uv_err_name(err), uv_strerror(err));
+            return false;
+        }
 
-    roc_log(LogInfo, "udp receiver: opened port %s",
-            packet::address_to_str(address_).c_str());
+        recv_started_ = true;
+    }
 
-    recv_started_ = true;
+    roc_log(LogInfo, "udp receiver: opened port %s batch_size=%lu gro=%d",
+            packet::address_to_str(address_).c_str(),
+            (unsigned long)batch_receiver_.batch_size(), (int)batch_receiver_.gro());
 
     return true;
 }
@@ -127,6 +132,9 @@ void UDPReceiverPort::async_close() {
         recv_started_ = false;
     }
 
+    // batch receiver should be closed before the socket is closed by udp handle
+    batch_receiver_.async_close(batch_close_cb_, this);
+
     if (!uv_is_closing((uv_handle_t*)&handle_)) {
         uv_close((uv_handle_t*)&handle_, close_cb_);
     }
@@ -138,12 +146,27 @@ void UDPReceiverPort::close_cb_(uv_handle_t* handle) {
     UDPReceiverPort& self = *(UDPReceiverPort*)handle->data;
 
     self.handle_initialized_ = false;
+    self.finish_close_();
+}
+
+void UDPReceiverPort::batch_close_cb_(void* arg) {
+    roc_panic_if_not(arg);
+
+    UDPReceiverPort& self = *(UDPReceiverPort*)arg;
+
+    self.finish_close_();
+}
+
+void UDPReceiverPort::finish_close_() {
+    if (handle_initialized_ || batch_receiver_.initialized()) {
+        return;
+    }
 
     roc_log(LogInfo, "udp receiver: closed port %s",
-            packet::address_to_str(self.address_).c_str());
+            packet::address_to_str(address_).c_str());
 
-    self.closed_ = true;
-    self.close_handler_.handle_closed(self);
+    closed_ = true;
+    close_handler_.handle_closed(*this);
 }
 
 void UDPReceiverPort::alloc_cb_(uv_handle_t* handle, size_t size, uv_buf_t* buf) {
@@ -236,18 +259,25 @@ void UDPReceiverPort::recv_cb_(uv_udp_t* handle,
         return;
     }
 
-    self.packet_counter_++;
+    self.handle_datagram(*bp, 0, (size_t)nread, src_addr);
+}
+
+void UDPReceiverPort::handle_datagram(core::Buffer<uint8_t>& buffer,
+                                      size_t offset,
+                                      size_t size,
+                                      const packet::Address& src_addr) {
+    packet_counter_++;
 
     roc_log(LogTrace, "udp receiver: received packet: num=%u src=%s dst=%s nread=%ld",
-            self.packet_counter_, packet::address_to_str(src_addr).c_str(),
-            packet::address_to_str(self.address_).c_str(), (long)nread);
+            packet_counter_, packet::address_to_str(src_addr).c_str(),
+            packet::address_to_str(address_).c_str(), (long)size);
 
-    if ((size_t)nread > bp->size()) {
-        roc_panic("udp receiver: unexpected buffer size: got %ld, max %ld", (long)nread,
-                  (long)bp->size());
+    if (offset + size > buffer.size()) {
+        roc_panic("udp receiver: unexpected buffer size: got %ld, max %ld",
+                  (long)(offset + size), (long)buffer.size());
     }
 
-    packet::PacketPtr pp = new (self.packet_pool_) packet::Packet(self.packet_pool_);
+    packet::PacketPtr pp = new (packet_pool_) packet::Packet(packet_pool_);
     if (!pp) {
         roc_log(LogError, "udp receiver: can't allocate packet");
         return;
@@ -256,11 +286,11 @@ void UDPReceiverPort::recv_cb_(uv_udp_t* handle,
     pp->add_flags(packet::Packet::FlagUDP);
 
     pp->udp()->src_addr = src_addr;
-    pp->udp()->dst_addr = self.address_;
+    pp->udp()->dst_addr = address_;
 
-    pp->set_data(core::Slice<uint8_t>(*bp, 0, (size_t)nread));
+    pp->set_data(core::Slice<uint8_t>(buffer, offset, offset + size));
 
-    self.writer_.write(pp);
+    writer_.write(pp);
 }
 
 } // namespace netio
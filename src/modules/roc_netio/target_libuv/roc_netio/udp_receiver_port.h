@@ -19,8 +19,11 @@
 #include "roc_core/list.h"
 #include "roc_core/list_node.h"
 #include "roc_core/refcnt.h"
+#include "roc_core/shared_ptr.h"
 #include "roc_netio/basic_port.h"
 #include "roc_netio/iclose_handler.h"
+#include "roc_netio/idatagram_handler.h"
+#include "roc_netio/udp_batch_receiver.h"
 #include "roc_packet/address.h"
 #include "roc_packet/iwriter.h"
 #include "roc_packet/packet_pool.h"
@@ -29,16 +32,21 @@ namespace roc {
 namespace netio {
 
 //! UDP receiver.
-class UDPReceiverPort : public BasicPort {
+class UDPReceiverPort : public BasicPort, private IDatagramHandler {
 public:
     //! Initialize.
+    //! @remarks
+    //!  @p batch_size defines maximum number of datagrams received per system
+    //!  call. If it's 1, or if batching isn't supported on this platform,
+    //!  datagrams are received one by one using libuv.
     UDPReceiverPort(ICloseHandler& close_handler,
                     const packet::Address&,
                     uv_loop_t& event_loop,
                     packet::IWriter& writer,
                     packet::PacketPool& packet_pool,
                     core::BufferPool<uint8_t>& buffer_pool,
-                    core::IAllocator& allocator);
+                    core::IAllocator& allocator,
+                    size_t batch_size);
 
     //! Destroy.
     ~UDPReceiverPort();
@@ -54,6 +62,7 @@ public:
 
 private:
     static void close_cb_(uv_handle_t* handle);
+    static void batch_close_cb_(void* arg);
     static void alloc_cb_(uv_handle_t* handle, size_t size, uv_buf_t* buf);
     static void recv_cb_(uv_udp_t* handle,
                          ssize_t nread,
@@ -61,6 +70,13 @@ private:
                          const sockaddr* addr,
                          unsigned flags);
 
+    virtual void handle_datagram(core::Buffer<uint8_t>& buffer,
+                                 size_t offset,
+                                 size_t size,
+                                 const packet::Address& src_addr);
+
+    void finish_close_();
+
     ICloseHandler& close_handler_;
 
     uv_loop_t& loop_;
@@ -71,6 +87,8 @@ private:
     bool recv_started_;
     bool closed_;
 
+    UDPBatchReceiver batch_receiver_;
+
     packet::Address address_;
     packet::IWriter& writer_;
 
@@ -18,12 +18,14 @@ namespace netio {
 UDPSenderPort::UDPSenderPort(ICloseHandler& close_handler,
                              const packet::Address& address,
                              uv_loop_t& event_loop,
-                             core::IAllocator& allocator)
+                             core::IAllocator& allocator,
+                             size_t batch_size)
     : BasicPort(allocator)
     , close_handler_(close_handler)
     , loop_(event_loop)
     , write_sem_initialized_(false)
     , handle_initialized_(false)
+    , batch_sender_(batch_size)
     , address_(address)
     , pending_(0)
     , stopped_(true)
@@ -92,8 +94,11 @@ bool UDPSenderPort::open() {
         return false;
     }
 
-    roc_log(LogInfo, "udp sender: opened port %s",
-            packet::address_to_str(address_).c_str());
+    batch_sender_.open(handle_, address_);
+
+    roc_log(LogInfo, "udp sender: opened port %s batch_size=%lu gso=%d",
+            packet::address_to_str(address_).c_str(),
+            (unsigned long)batch_sender_.batch_size(), (int)batch_sender_.gso());
 
     stopped_ = false;
 
@@ -167,30 +172,18 @@ void UDPSenderPort::write_sem_cb_(uv_async_t* handle) {
 
     UDPSenderPort& self = *(UDPSenderPort*)handle->data;
 
-    while (packet::PacketPtr pp = self.read_()) {
-        packet::UDP& udp = *pp->udp();
+    while (self.send_batch_()) {
+    }
 
+    while (packet::PacketPtr pp = self.read_()) {
         self.packet_counter_++;
 
         roc_log(LogTrace, "udp sender: sending packet: num=%u src=%s dst=%s sz=%ld",
                 self.packet_counter_, packet::address_to_str(self.address_).c_str(),
-                packet::address_to_str(udp.dst_addr).c_str(), (long)pp->data().size());
-
-        uv_buf_t buf;
-        buf.base = (char*)pp->data().data();
-        buf.len = pp->data().size();
-
-        udp.request.data = &self;
-
-        if (int err = uv_udp_send(&udp.request, &self.handle_, &buf, 1,
-                                  udp.dst_addr.saddr(), send_cb_)) {
-            roc_log(LogError, "udp sender: uv_udp_send(): [%s] %s", uv_err_name(err),
-                    uv_strerror(err));
-            continue;
-        }
+                packet::address_to_str(pp->udp()->dst_addr).c_str(),
+                (long)pp->data().size());
 
-        // will be decremented in send_cb_()
-        pp->incref();
+        self.send_(pp);
     }
 }
 
@@ -218,13 +211,7 @@ void UDPSenderPort::send_cb_(uv_udp_send_t* req, int status) {
                 (long)pp->data().size(), uv_err_name(status), uv_strerror(status));
     }
 
-    core::Mutex::Lock lock(self.mutex_);
-
-    --self.pending_;
-
-    if (self.stopped_ && self.pending_ == 0) {
-        self.close_();
-    }
+    self.complete_(1);
 }
 
 packet::PacketPtr UDPSenderPort::read_() {
@@ -238,6 +225,89 @@ packet::PacketPtr UDPSenderPort::read_() {
     return pp;
 }
 
+void UDPSenderPort::send_(const packet::PacketPtr& pp) {
+    packet::UDP& udp = *pp->udp();
+
+    uv_buf_t buf;
+    buf.base = (char*)pp->data().data();
+    buf.len = pp->data().size();
+
+    udp.request.data = this;
+
+    if (int err = uv_udp_send(&udp.request, &handle_, &buf, 1, udp.dst_addr.saddr(),
+                              send_cb_)) {
+        roc_log(LogError, "udp sender: uv_udp_send(): [%s] %s", uv_err_name(err),
+                uv_strerror(err));
+        return;
+    }
+
+    // will be decremented in send_cb_()
+    pp->incref();
+}
+
+void UDPSenderPort::complete_(size_t n_packets) {
+    core::Mutex::Lock lock(mutex_);
+
+    roc_panic_if(pending_ < n_packets);
+    pending_ -= n_packets;
+
+    if (stopped_ && pending_ == 0) {
+        close_();
+    }
+}
+
+bool UDPSenderPort::send_batch_() {
+    const size_t batch_size = batch_sender_.batch_size();
+
+    if (batch_size <= 1) {
+        return false;
+    }
+
+    // packets already queued in libuv should go first to preserve ordering
+    if (handle_.send_queue_count != 0) {
+        return false;
+    }
+
+    size_t n_packets = 0;
+
+    while (n_packets < batch_size) {
+        packet::PacketPtr pp = read_();
+        if (!pp) {
+            break;
+        }
+
+        packet_counter_++;
+
+        roc_log(LogTrace, "udp sender: sending packet: num=%u src=%s dst=%s sz=%ld",
+                packet_counter_, packet::address_to_str(address_).c_str(),
+                packet::address_to_str(pp->udp()->dst_addr).c_str(),
+                (long)pp->data().size());
+
+        batch_packets_[n_packets++] = pp;
+    }
+
+    if (n_packets == 0) {
+        return false;
+    }
+
+    const size_t n_sent = batch_sender_.send(batch_packets_, n_packets);
+
+    // socket buffer is full or gso failed, libuv will send the rest one by one
+    for (size_t n = n_sent; n < n_packets; n++) {
+        send_(batch_packets_[n]);
+    }
+
+    for (size_t n = 0; n < n_packets; n++) {
+        batch_packets_[n].reset();
+    }
+
+    if (n_sent != 0) {
+        complete_(n_sent);
+    }
+
+    return n_sent == n_packets && n_packets == batch_size;
+}
+
 void UDPSenderPort::close_() {
     if (closed_) {
         return; // handle_closed() was already called
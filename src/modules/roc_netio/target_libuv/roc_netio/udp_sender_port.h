@@ -19,6 +19,7 @@
 #include "roc_core/refcnt.h"
 #include "roc_netio/basic_port.h"
 #include "roc_netio/iclose_handler.h"
+#include "roc_netio/udp_batch_sender.h"
 #include "roc_packet/address.h"
 #include "roc_packet/iwriter.h"
 
@@ -29,10 +30,15 @@ namespace netio {
 class UDPSenderPort : public BasicPort, public packet::IWriter {
 public:
     //! Initialize.
+    //! @remarks
+    //!  @p batch_size defines maximum number of datagrams sent per system call.
+    //!  If it's 1, or if batching isn't supported on this platform, datagrams
+    //!  are sent one by one using libuv.
     UDPSenderPort(ICloseHandler& close_handler,
                   const packet::Address&,
                   uv_loop_t& event_loop,
-                  core::IAllocator& allocator);
+                  core::IAllocator& allocator,
+                  size_t batch_size);
 
     //! Destroy.
     ~UDPSenderPort();
@@ -57,6 +63,9 @@ private:
     static void send_cb_(uv_udp_send_t* req, int status);
 
     packet::PacketPtr read_();
+    void send_(const packet::PacketPtr& pp);
+    void complete_(size_t n_packets);
+    bool send_batch_();
     void close_();
 
     ICloseHandler& close_handler_;
@@ -69,6 +78,9 @@ private:
     uv_udp_t handle_;
     bool handle_initialized_;
 
+    UDPBatchSender batch_sender_;
+    packet::PacketPtr batch_packets_[UDPBatchSender::MaxSize];
+
     packet::Address address_;
 
     core::List<packet::Packet> list_;
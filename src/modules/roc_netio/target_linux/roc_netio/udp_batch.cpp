@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+
+#include "roc_core/panic.h"
+#include "roc_netio/udp_batch.h"
+
+// Older libc headers may lack these, while the kernel still supports them.
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
+namespace roc {
+namespace netio {
+
+UDPBatch::UDPBatch()
+    : n_datagrams_(0)
+    , n_msgs_(0)
+    , n_sent_msgs_(0)
+    , gso_(false) {
+    memset(msgs_, 0, sizeof(msgs_));
+}
+
+bool UDPBatch::gso_supported(int fd) {
+    int value = 0;
+    socklen_t len = sizeof(value);
+
+    return getsockopt(fd, IPPROTO_UDP, UDP_SEGMENT, &value, &len) == 0;
+}
+
+bool UDPBatch::enable_gro(int fd) {
+    int value = 1;
+
+    return setsockopt(fd, IPPROTO_UDP, UDP_GRO, &value, sizeof(value)) == 0;
+}
+
+void UDPBatch::set_gso(bool enabled) {
+    gso_ = enabled;
+}
+
+bool UDPBatch::gso() const {
+    return gso_;
+}
+
+size_t UDPBatch::size() const {
+    return n_datagrams_;
+}
+
+size_t UDPBatch::num_messages() const {
+    return n_msgs_;
+}
+
+void UDPBatch::clear() {
+    n_datagrams_ = 0;
+    n_msgs_ = 0;
+    n_sent_msgs_ = 0;
+}
+
+void UDPBatch::add(void* data, size_t size, const packet::Address* address) {
+    if (n_datagrams_ == MaxSize) {
+        roc_panic("udp batch: batch is full: max_size=%d", (int)MaxSize);
+    }
+
+    iovec& iov = iovs_[n_datagrams_++];
+
+    iov.iov_base = data;
+    iov.iov_len = size;
+
+    if (address && append_(size, *address)) {
+        const size_t last = n_msgs_ - 1;
+
+        msgs_[last].msg_hdr.msg_iovlen++;
+
+        msg_sizes_[last]++;
+        msg_bytes_[last] += size;
+
+        if (msg_sizes_[last] == 2) {
+            set_segment_size_(last, size);
+        }
+
+        return;
+    }
+
+    msghdr& hdr = msgs_[n_msgs_].msg_hdr;
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.msg_iov = &iov;
+    hdr.msg_iovlen = 1;
+    hdr.msg_name = &addrs_[n_msgs_];
+
+    if (address) {
+        memcpy(&addrs_[n_msgs_], address->saddr(), address->slen());
+        hdr.msg_namelen = address->slen();
+    } else {
+        hdr.msg_namelen = sizeof(addrs_[n_msgs_]);
+        hdr.msg_control = controls_[n_msgs_].buf;
+        hdr.msg_controllen = sizeof(controls_[n_msgs_].buf);
+    }
+
+    msgs_[n_msgs_].msg_len = 0;
+
+    msg_sizes_[n_msgs_] = 1;
+    msg_bytes_[n_msgs_] = size;
+
+    n_msgs_++;
+}
+
+ssize_t UDPBatch::send(int fd) {
+    roc_panic_if(n_sent_msgs_ >= n_msgs_);
+
+    int ret;
+    do {
+        ret = sendmmsg(fd, msgs_ + n_sent_msgs_, (unsigned)(n_msgs_ - n_sent_msgs_),
+                       MSG_DONTWAIT);
+    } while (ret < 0 && errno == EINTR);
+
+    if (ret < 0) {
+        return ret;
+    }
+
+    size_t n_datagrams = 0;
+    for (int n = 0; n < ret; n++) {
+        n_datagrams += msg_sizes_[n_sent_msgs_++];
+    }
+
+    return (ssize_t)n_datagrams;
+}
+
+size_t UDPBatch::skip() {
+    roc_panic_if(n_sent_msgs_ >= n_msgs_);
+
+    return msg_sizes_[n_sent_msgs_++];
+}
+
+ssize_t UDPBatch::recv(int fd) {
+    roc_panic_if(n_msgs_ == 0);
+
+    // kernel overwrites control length with the actual one
+    for (size_t n = 0; n < n_msgs_; n++) {
+        msgs_[n].msg_hdr.msg_controllen = sizeof(controls_[n].buf);
+    }
+
+    int ret;
+    do {
+        ret = recvmmsg(fd, msgs_, (unsigned)n_msgs_, MSG_DONTWAIT, NULL);
+    } while (ret < 0 && errno == EINTR);
+
+    return ret;
+}
+
+size_t UDPBatch::received_size(size_t index) const {
+    roc_panic_if(index >= n_msgs_);
+
+    return msgs_[index].msg_len;
+}
+
+size_t UDPBatch::segment_size(size_t index) const {
+    roc_panic_if(index >= n_msgs_);
+
+    // CMSG_NXTHDR() doesn't accept const header
+    msghdr hdr = msgs_[index].msg_hdr;
+
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr); cmsg; cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
+        if (cmsg->cmsg_level == IPPROTO_UDP && cmsg->cmsg_type == UDP_GRO) {
+            int size = 0;
+            memcpy(&size, CMSG_DATA(cmsg), sizeof(size));
+
+            if (size > 0) {
+                return (size_t)size;
+            }
+        }
+    }
+
+    return msgs_[index].msg_len;
+}
+
+bool UDPBatch::truncated(size_t index) const {
+    roc_panic_if(index >= n_msgs_);
+
+    return (msgs_[index].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+}
+
+bool UDPBatch::source_address(size_t index, packet::Address& address) const {
+    roc_panic_if(index >= n_msgs_);
+
+    return address.set_saddr((const sockaddr*)msgs_[index].msg_hdr.msg_name);
+}
+
+bool UDPBatch::append_(size_t size, const packet::Address& address) const {
+    if (!gso_ || n_msgs_ == 0 || size == 0) {
+        return false;
+    }
+
+    const size_t last = n_msgs_ - 1;
+    const msghdr& hdr = msgs_[last].msg_hdr;
+
+    // all datagrams in message should have the same size
+    if (iovs_[n_datagrams_ - 2].iov_len != size) {
+        return false;
+    }
+
+    if (msg_bytes_[last] + size > MaxMessageSize) {
+        return false;
+    }
+
+    if (hdr.msg_namelen != address.slen()
+        || memcmp(hdr.msg_name, address.saddr(), address.slen()) != 0) {
+        return false;
+    }
+
+    return true;
+}
+
+void UDPBatch::set_segment_size_(size_t index, size_t size) {
+    msghdr& hdr = msgs_[index].msg_hdr;
+
+    hdr.msg_control = controls_[index].buf;
+    hdr.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr);
+    cmsg->cmsg_level = IPPROTO_UDP;
+    cmsg->cmsg_type = UDP_SEGMENT;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+
+    const uint16_t segment_size = (uint16_t)size;
+    memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+}
+
+} // namespace netio
+} // namespace roc
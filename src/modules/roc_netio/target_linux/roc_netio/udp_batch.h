@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_netio/target_linux/roc_netio/udp_batch.h
+//! @brief Batch of UDP datagrams.
+
+#ifndef ROC_NETIO_UDP_BATCH_H_
+#define ROC_NETIO_UDP_BATCH_H_
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_packet/address.h"
+
+namespace roc {
+namespace netio {
+
+//! Batch of UDP datagrams.
+//! @remarks
+//!  Sends or receives multiple datagrams using a single sendmmsg() or
+//!  recvmmsg() system call.
+//!
+//!  When sending with GSO enabled, consecutive datagrams with the same
+//!  destination and size are coalesced into one message, which is split
+//!  into datagrams by the kernel or the network device.
+//!
+//!  When receiving from a socket with GRO enabled, one message may contain
+//!  several datagrams of segment_size() bytes, except the last one, which
+//!  may be shorter.
+class UDPBatch : public core::NonCopyable<> {
+public:
+    //! Maximum number of datagrams in batch.
+    enum { MaxSize = 64 };
+
+    //! Maximum size of coalesced message.
+    enum { MaxMessageSize = 65507 };
+
+    //! Initialize empty batch.
+    UDPBatch();
+
+    //! Check if GSO is supported for socket.
+    static bool gso_supported(int fd);
+
+    //! Enable GRO for socket.
+    //! @returns
+    //!  false if GRO is not supported.
+    static bool enable_gro(int fd);
+
+    //! Enable or disable GSO for datagrams added after this call.
+    void set_gso(bool enabled);
+
+    //! Check if GSO is enabled.
+    bool gso() const;
+
+    //! Get number of datagrams in batch.
+    size_t size() const;
+
+    //! Get number of messages in batch.
+    size_t num_messages() const;
+
+    //! Remove all datagrams from batch.
+    void clear();
+
+    //! Add datagram buffer to batch.
+    //! @remarks
+    //!  When sending, @p size bytes from @p data are sent to @p address.
+    //!  When receiving, up to @p size bytes are received into @p data,
+    //!  and @p address should be NULL.
+    void add(void* data, size_t size, const packet::Address* address);
+
+    //! Send datagrams.
+    //! @remarks
+    //!  Sends messages that were not sent yet, without blocking.
+    //! @returns
+    //!  number of sent datagrams, or -1 and errno is set. If the socket
+    //!  buffer is full, errno is EAGAIN.
+    ssize_t send(int fd);
+
+    //! Skip first message that was not sent yet.
+    //! @returns
+    //!  number of skipped datagrams.
+    size_t skip();
+
+    //! Receive datagrams.
+    //! @remarks
+    //!  Receives messages into buffers without blocking.
+    //! @returns
+    //!  number of received messages, or -1 and errno is set. If there are no
+    //!  messages, errno is EAGAIN.
+    ssize_t recv(int fd);
+
+    //! Get size of received message.
+    size_t received_size(size_t index) const;
+
+    //! Get size of datagrams in received message.
+    //! @remarks
+    //!  Returns received_size() if the message was not coalesced by GRO.
+    size_t segment_size(size_t index) const;
+
+    //! Check if received message was truncated.
+    bool truncated(size_t index) const;
+
+    //! Get source address of received message.
+    bool source_address(size_t index, packet::Address& address) const;
+
+private:
+    union Control {
+        char buf[CMSG_SPACE(sizeof(int))];
+        cmsghdr align;
+    };
+
+    bool append_(size_t size, const packet::Address& address) const;
+    void set_segment_size_(size_t index, size_t size);
+
+    mmsghdr msgs_[MaxSize];
+    iovec iovs_[MaxSize];
+    sockaddr_storage addrs_[MaxSize];
+    Control controls_[MaxSize];
+
+    // number of datagrams in every message
+    size_t msg_sizes_[MaxSize];
+    // number of payload bytes in every message
+    size_t msg_bytes_[MaxSize];
+
+    size_t n_datagrams_;
+    size_t n_msgs_;
+    size_t n_sent_msgs_;
+
+    bool gso_;
+};
+
+} // namespace netio
+} // namespace roc
+
+#endif // ROC_NETIO_UDP_BATCH_H_
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <errno.h>
+
+#include "roc_core/errno_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_netio/udp_batch_receiver.h"
+#include "roc_packet/address_to_str.h"
+
+namespace roc {
+namespace netio {
+
+namespace {
+
+// Maximum number of batches received per poll callback. The socket is polled
+// in level-triggered mode, so the rest is received on next loop iteration,
+// after other handles had a chance to run.
+const size_t MaxBatchesPerPoll = 16;
+
+// Size of buffers for messages coalesced by GRO, enough for any UDP payload.
+const size_t GROBufferSize = 65536;
+
+// Maximum number of messages per batch when GRO is enabled. Every message
+// needs a large buffer, but may contain up to 64 datagrams.
+const size_t MaxGROBatchSize = 8;
+
+} // namespace
+
+UDPBatchReceiver::UDPBatchReceiver(IDatagramHandler& handler,
+                                   core::BufferPool<uint8_t>& buffer_pool,
+                                   core::IAllocator& allocator,
+                                   size_t batch_size)
+    : handler_(handler)
+    , poll_initialized_(false)
+    , poll_started_(false)
+    , close_cb_fn_(NULL)
+    , close_arg_(NULL)
+    , fd_(-1)
+    , gro_(false)
+    , batch_size_(batch_size)
+    , buffer_pool_(buffer_pool)
+    , gro_buffer_pool_(allocator, GROBufferSize, false) {
+    if (batch_size_ > UDPBatch::MaxSize) {
+        batch_size_ = UDPBatch::MaxSize;
+    }
+}
+
+UDPBatchReceiver::~UDPBatchReceiver() {
+    if (poll_initialized_) {
+        roc_panic("udp batch receiver: receiver was not closed before calling "
+                  "destructor");
+    }
+}
+
+bool UDPBatchReceiver::start(uv_loop_t& loop,
+                             uv_udp_t& handle,
+                             const packet::Address& address) {
+    roc_panic_if(poll_initialized_);
+
+    if (batch_size_ <= 1) {
+        return false;
+    }
+
+    address_ = address;
+
+    uv_os_fd_t fd = -1;
+    if (int err = uv_fileno((uv_handle_t*)&handle, &fd)) {
+        roc_log(LogDebug, "udp batch receiver: uv_fileno(): [%s] %s", uv_err_name(err),
+                uv_strerror(err));
+        return false;
+    }
+
+    if (int err = uv_poll_init_socket(&loop, &poll_handle_, fd)) {
+        roc_log(LogDebug, "udp batch receiver: uv_poll_init_socket(): [%s] %s",
+                uv_err_name(err), uv_strerror(err));
+        return false;
+    }
+
+    poll_handle_.data = this;
+    poll_initialized_ = true;
+
+    if (int err = uv_poll_start(&poll_handle_, UV_READABLE, poll_cb_)) {
+        roc_log(LogDebug, "udp batch receiver: uv_poll_start(): [%s] %s",
+                uv_err_name(err), uv_strerror(err));
+        return false;
+    }
+
+    poll_started_ = true;
+    fd_ = fd;
+
+    gro_ = UDPBatch::enable_gro(fd);
+
+    return true;
+}
+
+bool UDPBatchReceiver::initialized() const {
+    return poll_initialized_;
+}
+
+void UDPBatchReceiver::async_close(void (*close_cb)(void*), void* close_arg) {
+    if (poll_started_) {
+        if (int err = uv_poll_stop(&poll_handle_)) {
+            roc_log(LogError, "udp batch receiver: uv_poll_stop(): [%s] %s",
+                    uv_err_name(err), uv_strerror(err));
+        }
+
+        poll_started_ = false;
+    }
+
+    if (!poll_initialized_ || uv_is_closing((uv_handle_t*)&poll_handle_)) {
+        return;
+    }
+
+    close_cb_fn_ = close_cb;
+    close_arg_ = close_arg;
+
+    uv_close((uv_handle_t*)&poll_handle_, close_cb_);
+}
+
+size_t UDPBatchReceiver::batch_size() const {
+    return poll_started_ ? batch_size_ : 1;
+}
+
+bool UDPBatchReceiver::gro() const {
+    return gro_;
+}
+
+void UDPBatchReceiver::close_cb_(uv_handle_t* handle) {
+    roc_panic_if_not(handle);
+
+    UDPBatchReceiver& self = *(UDPBatchReceiver*)handle->data;
+
+    self.poll_initialized_ = false;
+    self.fd_ = -1;
+
+    for (size_t n = 0; n < UDPBatch::MaxSize; n++) {
+        self.batch_buffers_[n].reset();
+    }
+
+    self.close_cb_fn_(self.close_arg_);
+}
+
+void UDPBatchReceiver::poll_cb_(uv_poll_t* handle, int status, int events) {
+    roc_panic_if_not(handle);
+
+    UDPBatchReceiver& self = *(UDPBatchReceiver*)handle->data;
+
+    if (status < 0) {
+        roc_log(LogError, "udp batch receiver: network error: dst=%s: [%s] %s",
+                packet::address_to_str(self.address_).c_str(), uv_err_name(status),
+                uv_strerror(status));
+        return;
+    }
+
+    if (!(events & UV_READABLE)) {
+        return;
+    }
+
+    for (size_t n = 0; n < MaxBatchesPerPoll; n++) {
+        if (!self.recv_batch_()) {
+            break;
+        }
+    }
+}
+
+bool UDPBatchReceiver::recv_batch_() {
+    batch_.clear();
+
+    core::BufferPool<uint8_t>& pool = gro_ ? gro_buffer_pool_ : buffer_pool_;
+
+    const size_t n_buffers =
+        gro_ && batch_size_ > MaxGROBatchSize ? MaxGROBatchSize : batch_size_;
+
+    // buffers that didn't receive a datagram last time are kept and reused
+    for (size_t n = 0; n < n_buffers; n++) {
+        if (!batch_buffers_[n]) {
+            batch_buffers_[n] = new (pool) core::Buffer<uint8_t>(pool);
+
+            if (!batch_buffers_[n]) {
+                roc_log(LogError, "udp batch receiver: can't allocate buffer");
+                break;
+            }
+        }
+
+        batch_.add(batch_buffers_[n]->data(), batch_buffers_[n]->size(), NULL);
+    }
+
+    if (batch_.size() == 0) {
+        return false;
+    }
+
+    const ssize_t nrecv = batch_.recv(fd_);
+
+    if (nrecv < 0) {
+        if (errno != EAGAIN) {
+            roc_log(LogError, "udp batch receiver: recvmmsg(): dst=%s: %s",
+                    packet::address_to_str(address_).c_str(),
+                    core::errno_to_str(errno).c_str());
+        }
+        return false;
+    }
+
+    for (size_t n = 0; n < (size_t)nrecv; n++) {
+        packet::Address src_addr;
+        if (!batch_.source_address(n, src_addr)) {
+            roc_log(LogError,
+                    "udp batch receiver: can't determine source address: dst=%s",
+                    packet::address_to_str(address_).c_str());
+            continue;
+        }
+
+        if (batch_.received_size(n) == 0) {
+            roc_log(LogTrace, "udp batch receiver: empty packet: src=%s dst=%s",
+                    packet::address_to_str(src_addr).c_str(),
+                    packet::address_to_str(address_).c_str());
+            continue;
+        }
+
+        if (batch_.truncated(n)) {
+            roc_log(LogDebug,
+                    "udp batch receiver: ignoring partial read: src=%s dst=%s nread=%ld",
+                    packet::address_to_str(src_addr).c_str(),
+                    packet::address_to_str(address_).c_str(),
+                    (long)batch_.received_size(n));
+            continue;
+        }
+
+        if (gro_) {
+            split_message_(n, src_addr);
+            continue;
+        }
+
+        core::SharedPtr<core::Buffer<uint8_t> > bp = batch_buffers_[n];
+        batch_buffers_[n].reset();
+
+        handler_.handle_datagram(*bp, 0, batch_.received_size(n), src_addr);
+    }
+
+    return (size_t)nrecv == batch_.size();
+}
+
+void UDPBatchReceiver::split_message_(size_t index, const packet::Address& src_addr) {
+    const size_t size = batch_.received_size(index);
+    const size_t segment_size = batch_.segment_size(index);
+
+    // datagrams larger than regular buffers are dropped, like without gro
+    if (segment_size > buffer_pool_.buffer_size()) {
+        roc_log(LogDebug,
+                "udp batch receiver: ignoring partial read: src=%s dst=%s nread=%ld",
+                packet::address_to_str(src_addr).c_str(),
+                packet::address_to_str(address_).c_str(), (long)segment_size);
+        return;
+    }
+
+    if (segment_size >= size) {
+        // single datagram is copied to regular buffer, so that every packet
+        // doesn't hold a large buffer, which is reused instead
+        core::SharedPtr<core::Buffer<uint8_t> > bp =
+            new (buffer_pool_) core::Buffer<uint8_t>(buffer_pool_);
+
+        if (!bp) {
+            roc_log(LogError, "udp batch receiver: can't allocate buffer");
+            return;
+        }
+
+        memcpy(bp->data(), batch_buffers_[index]->data(), size);
+
+        handler_.handle_datagram(*bp, 0, size, src_addr);
+        return;
+    }
+
+    // datagrams coalesced by gro share one buffer
+    core::SharedPtr<core::Buffer<uint8_t> > bp = batch_buffers_[index];
+    batch_buffers_[index].reset();
+
+    for (size_t offset = 0; offset < size; offset += segment_size) {
+        handler_.handle_datagram(*bp, offset, std::min(segment_size, size - offset),
+                                 src_addr);
+    }
+}
+
+} // namespace netio
+} // namespace roc
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_netio/target_linux/roc_netio/udp_batch_receiver.h
+//! @brief Batched UDP receiver.
+
+#ifndef ROC_NETIO_UDP_BATCH_RECEIVER_H_
+#define ROC_NETIO_UDP_BATCH_RECEIVER_H_
+
+#include <uv.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/shared_ptr.h"
+#include "roc_netio/idatagram_handler.h"
+#include "roc_netio/udp_batch.h"
+#include "roc_packet/address.h"
+
+namespace roc {
+namespace netio {
+
+//! Batched UDP receiver.
+//! @remarks
+//!  Polls socket of libuv UDP handle and receives datagrams using recvmmsg(),
+//!  and GRO where supported, instead of libuv.
+class UDPBatchReceiver : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  @p batch_size defines maximum number of datagrams received per system
+    //!  call. Received datagrams are passed to @p handler.
+    UDPBatchReceiver(IDatagramHandler& handler,
+                     core::BufferPool<uint8_t>& buffer_pool,
+                     core::IAllocator& allocator,
+                     size_t batch_size);
+
+    //! Destroy.
+    ~UDPBatchReceiver();
+
+    //! Start receiving datagrams from socket of @p handle.
+    //! @returns
+    //!  false if batching is disabled or can't be used; in this case datagrams
+    //!  should be received using libuv.
+    bool start(uv_loop_t& loop, uv_udp_t& handle, const packet::Address& address);
+
+    //! Check if receiver has resources that should be closed.
+    bool initialized() const;
+
+    //! Stop receiving and asynchronously close.
+    //! @remarks
+    //!  Should be called before @p handle passed to start() is closed. When
+    //!  closing is finished, @p close_cb is called with @p close_arg. Does
+    //!  nothing if initialized() is false.
+    void async_close(void (*close_cb)(void*), void* close_arg);
+
+    //! Get number of datagrams received per system call.
+    size_t batch_size() const;
+
+    //! Check if GRO is enabled.
+    bool gro() const;
+
+private:
+    static void poll_cb_(uv_poll_t* handle, int status, int events);
+    static void close_cb_(uv_handle_t* handle);
+
+    bool recv_batch_();
+    void split_message_(size_t index, const packet::Address& src_addr);
+
+    IDatagramHandler& handler_;
+
+    uv_poll_t poll_handle_;
+    bool poll_initialized_;
+    bool poll_started_;
+
+    void (*close_cb_fn_)(void*);
+    void* close_arg_;
+
+    int fd_;
+    bool gro_;
+
+    size_t batch_size_;
+
+    packet::Address address_;
+
+    core::BufferPool<uint8_t>& buffer_pool_;
+    core::BufferPool<uint8_t> gro_buffer_pool_;
+
+    UDPBatch batch_;
+    core::SharedPtr<core::Buffer<uint8_t> > batch_buffers_[UDPBatch::MaxSize];
+};
+
+} // namespace netio
+} // namespace roc
+
+#endif // ROC_NETIO_UDP_BATCH_RECEIVER_H_
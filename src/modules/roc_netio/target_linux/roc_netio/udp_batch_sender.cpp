@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <errno.h>
+
+#include "roc_core/errno_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_netio/udp_batch_sender.h"
+#include "roc_packet/address_to_str.h"
+
+namespace roc {
+namespace netio {
+
+UDPBatchSender::UDPBatchSender(size_t batch_size)
+    : fd_(-1)
+    , batch_size_(batch_size) {
+    if (batch_size_ > MaxSize) {
+        batch_size_ = MaxSize;
+    }
+}
+
+UDPBatchSender::~UDPBatchSender() {
+}
+
+bool UDPBatchSender::open(uv_udp_t& handle, const packet::Address& address) {
+    if (batch_size_ <= 1) {
+        return false;
+    }
+
+    address_ = address;
+
+    uv_os_fd_t fd = -1;
+    if (int err = uv_fileno((uv_handle_t*)&handle, &fd)) {
+        roc_log(LogDebug, "udp batch sender: uv_fileno(): [%s] %s", uv_err_name(err),
+                uv_strerror(err));
+        return false;
+    }
+
+    fd_ = fd;
+    batch_.set_gso(UDPBatch::gso_supported(fd));
+
+    return true;
+}
+
+size_t UDPBatchSender::batch_size() const {
+    return fd_ >= 0 ? batch_size_ : 1;
+}
+
+bool UDPBatchSender::gso() const {
+    return batch_.gso();
+}
+
+size_t UDPBatchSender::send(const packet::PacketPtr* packets, size_t n_packets) {
+    roc_panic_if(fd_ < 0);
+    roc_panic_if(n_packets > batch_size_);
+
+    if (n_packets == 0) {
+        return 0;
+    }
+
+    batch_.clear();
+
+    for (size_t n = 0; n < n_packets; n++) {
+        const packet::PacketPtr& pp = packets[n];
+
+        batch_.add(pp->data().data(), pp->data().size(), &pp->udp()->dst_addr);
+    }
+
+    size_t n_sent = 0;
+
+    while (n_sent < n_packets) {
+        const ssize_t ret = send_messages_(batch_);
+
+        if (ret < 0) {
+            if (errno == EAGAIN) {
+                break;
+            }
+
+            // network device can't segment datagrams, so we fall back to plain
+            // datagrams for this and future batches
+            if (errno == EIO && batch_.gso()) {
+                roc_log(LogInfo, "udp batch sender: gso not supported, disabling: src=%s",
+                        packet::address_to_str(address_).c_str());
+
+                batch_.set_gso(false);
+                break;
+            }
+
+            // sendmmsg() fails only if the first message can't be sent,
+            // so we drop it and send the rest
+            roc_log(LogError,
+                    "udp batch sender: can't send packet: src=%s dst=%s sz=%ld: %s",
+                    packet::address_to_str(address_).c_str(),
+                    packet::address_to_str(packets[n_sent]->udp()->dst_addr).c_str(),
+                    (long)packets[n_sent]->data().size(),
+                    core::errno_to_str(errno).c_str());
+
+            n_sent += batch_.skip();
+            continue;
+        }
+
+        n_sent += (size_t)ret;
+    }
+
+    return n_sent;
+}
+
+ssize_t UDPBatchSender::send_messages_(UDPBatch& batch) {
+    return batch.send(fd_);
+}
+
+} // namespace netio
+} // namespace roc
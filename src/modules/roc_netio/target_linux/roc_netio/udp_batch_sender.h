@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_netio/target_linux/roc_netio/udp_batch_sender.h
+//! @brief Batched UDP sender.
+
+#ifndef ROC_NETIO_UDP_BATCH_SENDER_H_
+#define ROC_NETIO_UDP_BATCH_SENDER_H_
+
+#include <uv.h>
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_netio/udp_batch.h"
+#include "roc_packet/address.h"
+#include "roc_packet/packet.h"
+
+namespace roc {
+namespace netio {
+
+//! Batched UDP sender.
+//! @remarks
+//!  Sends datagrams to socket of libuv UDP handle using sendmmsg(), and GSO
+//!  where supported, instead of libuv.
+class UDPBatchSender : public core::NonCopyable<> {
+public:
+    //! Maximum number of datagrams sent per system call.
+    enum { MaxSize = UDPBatch::MaxSize };
+
+    //! Initialize.
+    //! @remarks
+    //!  @p batch_size defines maximum number of datagrams sent per system call.
+    explicit UDPBatchSender(size_t batch_size);
+
+    virtual ~UDPBatchSender();
+
+    //! Start sending datagrams to socket of @p handle.
+    //! @returns
+    //!  false if batching is disabled or can't be used; in this case datagrams
+    //!  should be sent using libuv.
+    bool open(uv_udp_t& handle, const packet::Address& address);
+
+    //! Get number of datagrams sent per system call.
+    size_t batch_size() const;
+
+    //! Check if GSO is enabled.
+    bool gso() const;
+
+    //! Send packets without blocking.
+    //! @remarks
+    //!  Packets are sent in order, up to batch_size() at once. Packets that
+    //!  can't be sent because of an error are dropped.
+    //! @returns
+    //!  number of packets from the beginning of @p packets that were sent or
+    //!  dropped. The rest should be sent using libuv, e.g. when the socket
+    //!  buffer is full.
+    size_t send(const packet::PacketPtr* packets, size_t n_packets);
+
+protected:
+    //! Send messages from batch that were not sent yet.
+    //! @remarks
+    //!  Has the same semantics as UDPBatch::send().
+    virtual ssize_t send_messages_(UDPBatch& batch);
+
+private:
+    int fd_;
+
+    size_t batch_size_;
+
+    packet::Address address_;
+
+    UDPBatch batch_;
+};
+
+} // namespace netio
+} // namespace roc
+
+#endif // ROC_NETIO_UDP_BATCH_SENDER_H_
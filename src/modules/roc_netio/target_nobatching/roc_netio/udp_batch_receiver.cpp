@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_netio/udp_batch_receiver.h"
+
+namespace roc {
+namespace netio {
+
+UDPBatchReceiver::UDPBatchReceiver(IDatagramHandler&,
+                                   core::BufferPool<uint8_t>&,
+                                   core::IAllocator&,
+                                   size_t) {
+}
+
+bool UDPBatchReceiver::start(uv_loop_t&, uv_udp_t&, const packet::Address&) {
+    return false;
+}
+
+bool UDPBatchReceiver::initialized() const {
+    return false;
+}
+
+void UDPBatchReceiver::async_close(void (*)(void*), void*) {
+}
+
+size_t UDPBatchReceiver::batch_size() const {
+    return 1;
+}
+
+bool UDPBatchReceiver::gro() const {
+    return false;
+}
+
+} // namespace netio
+} // namespace roc
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_netio/target_nobatching/roc_netio/udp_batch_receiver.h
+//! @brief Batched UDP receiver.
+
+#ifndef ROC_NETIO_UDP_BATCH_RECEIVER_H_
+#define ROC_NETIO_UDP_BATCH_RECEIVER_H_
+
+#include <uv.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_netio/idatagram_handler.h"
+#include "roc_packet/address.h"
+
+namespace roc {
+namespace netio {
+
+//! Batched UDP receiver.
+//! @remarks
+//!  Batching is not supported on this platform, datagrams are always
+//!  received using libuv.
+class UDPBatchReceiver : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    UDPBatchReceiver(IDatagramHandler& handler,
+                     core::BufferPool<uint8_t>& buffer_pool,
+                     core::IAllocator& allocator,
+                     size_t batch_size);
+
+    //! Start receiving datagrams from socket of @p handle.
+    //! @returns
+    //!  always false.
+    bool start(uv_loop_t& loop, uv_udp_t& handle, const packet::Address& address);
+
+    //! Check if receiver has resources that should be closed.
+    //! @returns
+    //!  always false.
+    bool initialized() const;
+
+    //! Stop receiving and asynchronously close.
+    //! @remarks
+    //!  Does nothing.
+    void async_close(void (*close_cb)(void*), void* close_arg);
+
+    //! Get number of datagrams received per system call.
+    size_t batch_size() const;
+
+    //! Check if GRO is enabled.
+    bool gro() const;
+};
+
+} // namespace netio
+} // namespace roc
+
+#endif // ROC_NETIO_UDP_BATCH_RECEIVER_H_
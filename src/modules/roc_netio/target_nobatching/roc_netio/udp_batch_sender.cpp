@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_netio/udp_batch_sender.h"
+
+namespace roc {
+namespace netio {
+
+UDPBatchSender::UDPBatchSender(size_t) {
+}
+
+bool UDPBatchSender::open(uv_udp_t&, const packet::Address&) {
+    return false;
+}
+
+size_t UDPBatchSender::batch_size() const {
+    return 1;
+}
+
+bool UDPBatchSender::gso() const {
+    return false;
+}
+
+size_t UDPBatchSender::send(const packet::PacketPtr*, size_t) {
+    return 0;
+}
+
+} // namespace netio
+} // namespace roc
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_netio/target_nobatching/roc_netio/udp_batch_sender.h
+//! @brief Batched UDP sender.
+
+#ifndef ROC_NETIO_UDP_BATCH_SENDER_H_
+#define ROC_NETIO_UDP_BATCH_SENDER_H_
+
+#include <uv.h>
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_packet/address.h"
+#include "roc_packet/packet.h"
+
+namespace roc {
+namespace netio {
+
+//! Batched UDP sender.
+//! @remarks
+//!  Batching is not supported on this platform, datagrams are always sent
+//!  using libuv.
+class UDPBatchSender : public core::NonCopyable<> {
+public:
+    //! Maximum number of datagrams sent per system call.
+    enum { MaxSize = 1 };
+
+    //! Initialize.
+    explicit UDPBatchSender(size_t batch_size);
+
+    //! Start sending datagrams to socket of @p handle.
+    //! @returns
+    //!  always false.
+    bool open(uv_udp_t& handle, const packet::Address& address);
+
+    //! Get number of datagrams sent per system call.
+    size_t batch_size() const;
+
+    //! Check if GSO is enabled.
+    bool gso() const;
+
+    //! Send packets without blocking.
+    //! @returns
+    //!  always zero.
+    size_t send(const packet::PacketPtr* packets, size_t n_packets);
+};
+
+} // namespace netio
+} // namespace roc
+
+#endif // ROC_NETIO_UDP_BATCH_SENDER_H_
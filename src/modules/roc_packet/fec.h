@@ -28,7 +28,13 @@ enum FECScheme {
     FEC_ReedSolomon_M8,
 
     //! LDPC-Staircase.
-    FEC_LDPC_Staircase
+    FEC_LDPC_Staircase,
+
+    //! Sliding window Random Linear Codes over GF(2^8).
+    FEC_RLC,
+
+    //! XOR row and column parity.
+    FEC_Parity
 };
 
 //! FECFRAME packet.
@@ -46,6 +52,12 @@ struct FEC {
     //!  Repair packets are numbered in range [k; k + n), where
     //!  k is a number of source packets per block (source_block_length)
     //!  n is a number of repair packets per block.
+    //!
+    //!  For sliding window schemes, there are no blocks. Source packets are
+    //!  numbered sequentially, and this number can wrap. For repair packets,
+    //!  this is the number of the first source packet in encoding window,
+    //!  source_block_length is the number of source packets in the window,
+    //!  and source_block_number is the repair key.
     size_t encoding_symbol_id;
 
     //! Number of a source block in a packet stream.
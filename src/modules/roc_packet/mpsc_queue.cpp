@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_packet/mpsc_queue.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace packet {
+
+namespace {
+
+// Difference between two positions, which may overflow.
+long pos_diff(long a, long b) {
+    return (long)((unsigned long)a - (unsigned long)b);
+}
+
+} // namespace
+
+MpscQueue::MpscQueue(core::IAllocator& allocator,
+                     size_t max_size,
+                     OverflowPolicy policy)
+    : allocator_(allocator)
+    , slots_(NULL)
+    , mask_(0)
+    , policy_(policy) {
+    size_t capacity = 1;
+    while (capacity < max_size) {
+        capacity *= 2;
+    }
+
+    slots_ = (Slot*)allocator_.allocate(capacity * sizeof(Slot));
+    if (!slots_) {
+        roc_log(LogError, "mpsc queue: can't allocate slots: capacity=%lu",
+                (unsigned long)capacity);
+        return;
+    }
+
+    for (size_t n = 0; n < capacity; n++) {
+        new (&slots_[n]) Slot();
+        slots_[n].seq += (long)n;
+        slots_[n].packet = NULL;
+    }
+
+    mask_ = capacity - 1;
+}
+
+MpscQueue::~MpscQueue() {
+    if (!slots_) {
+        return;
+    }
+
+    Packet* packet = NULL;
+    while (pop_(packet)) {
+        packet->decref();
+    }
+
+    for (size_t n = 0; n <= mask_; n++) {
+        slots_[n].~Slot();
+    }
+
+    allocator_.deallocate(slots_);
+}
+
+bool MpscQueue::valid() const {
+    return slots_;
+}
+
+size_t MpscQueue::max_size() const {
+    return mask_ + 1;
+}
+
+size_t MpscQueue::size() const {
+    const long dist = pos_diff(write_pos_, read_pos_);
+
+    if (dist < 0) {
+        return 0;
+    }
+    if ((size_t)dist > mask_ + 1) {
+        return mask_ + 1;
+    }
+    return (size_t)dist;
+}
+
+size_t MpscQueue::num_dropped() const {
+    return (size_t)(long)num_dropped_;
+}
+
+void MpscQueue::write(const PacketPtr& packet) {
+    roc_panic_if_not(valid());
+
+    if (!packet) {
+        roc_panic("mpsc queue: attempting to add null packet");
+    }
+
+    // reference is owned by the queue until the packet is read or dropped
+    packet->incref();
+
+    while (!push_(packet.get())) {
+        ++num_dropped_;
+
+        if (policy_ == Overflow_DropNewest) {
+            roc_log(LogDebug, "mpsc queue: queue is full, dropping newest packet");
+            packet->decref();
+            return;
+        }
+
+        Packet* oldest = NULL;
+        if (pop_(oldest)) {
+            roc_log(LogDebug, "mpsc queue: queue is full, dropping oldest packet");
+            oldest->decref();
+        }
+    }
+}
+
+PacketPtr MpscQueue::read() {
+    roc_panic_if_not(valid());
+
+    Packet* packet = NULL;
+    if (!pop_(packet)) {
+        return NULL;
+    }
+
+    PacketPtr pp = packet;
+    packet->decref();
+
+    return pp;
+}
+
+bool MpscQueue::push_(Packet* packet) {
+    long pos = write_pos_;
+
+    for (;;) {
+        Slot& slot = slots_[(size_t)pos & mask_];
+
+        // slot is ready to be written during this lap when seq == pos
+        const long dist = pos_diff(slot.seq, pos);
+
+        if (dist == 0) {
+            if (write_pos_.compare_exchange(pos, pos + 1)) {
+                slot.packet = packet;
+                // publish packet to reader: seq = pos + 1
+                ++slot.seq;
+                return true;
+            }
+        } else if (dist < 0) {
+            // slot still holds packet from the previous lap
+            return false;
+        }
+
+        pos = write_pos_;
+    }
+}
+
+bool MpscQueue::pop_(Packet*& packet) {
+    long pos = read_pos_;
+
+    for (;;) {
+        Slot& slot = slots_[(size_t)pos & mask_];
+
+        // slot is ready to be read during this lap when seq == pos + 1
+        const long dist = pos_diff(slot.seq, pos + 1);
+
+        if (dist == 0) {
+            // writers may pop too when dropping oldest packets, hence CAS
+            if (read_pos_.compare_exchange(pos, pos + 1)) {
+                packet = slot.packet;
+                slot.packet = NULL;
+                // release slot for the next lap: seq = pos + capacity
+                slot.seq += (long)mask_;
+                return true;
+            }
+        } else if (dist < 0) {
+            // slot wasn't written yet
+            return false;
+        }
+
+        pos = read_pos_;
+    }
+}
+
+} // namespace packet
+} // namespace roc
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_packet/mpsc_queue.h
+//! @brief Lock-free bounded packet queue.
+
+#ifndef ROC_PACKET_MPSC_QUEUE_H_
+#define ROC_PACKET_MPSC_QUEUE_H_
+
+#include "roc_core/atomic.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_packet/ireader.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet.h"
+
+namespace roc {
+namespace packet {
+
+//! What to do when a bounded queue is full.
+enum OverflowPolicy {
+    //! Drop packet being added.
+    Overflow_DropNewest,
+
+    //! Drop the oldest packet in the queue to make room for the new one.
+    Overflow_DropOldest
+};
+
+//! Lock-free bounded multiple-producer single-consumer packet queue.
+//! @remarks
+//!  Packets are stored in a preallocated ring buffer. Both write() and read()
+//!  are lock-free and never block, so that the queue can be used to pass
+//!  packets from network threads to a realtime thread without priority
+//!  inversion.
+//!
+//!  Each ring slot has a sequence counter, telling whether the slot is ready
+//!  to be written or read during the current lap around the ring. Writers
+//!  and the reader claim slots by advancing positions with compare-and-swap,
+//!  and then publish them by updating slot counter.
+//!
+//!  write() may be called concurrently from any number of threads. read()
+//!  should be called from a single thread at a time.
+class MpscQueue : public IWriter, public IReader, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  @p max_size defines maximum number of packets in queue. It's rounded
+    //!  up to a power of two. @p policy defines what happens when it's reached.
+    MpscQueue(core::IAllocator& allocator, size_t max_size, OverflowPolicy policy);
+
+    ~MpscQueue();
+
+    //! Check if the queue was successfully constructed.
+    bool valid() const;
+
+    //! Add packet to the queue.
+    //! @remarks
+    //!  Lock-free. If the queue is full, drops either this or the oldest packet,
+    //!  depending on overflow policy.
+    virtual void write(const PacketPtr& packet);
+
+    //! Read next packet.
+    //! @returns
+    //!  the first packet in the queue or null if there are no packets
+    //! @remarks
+    //!  Lock-free. Removes returned packet from the queue.
+    virtual PacketPtr read();
+
+    //! Get number of packets in queue.
+    //! @remarks
+    //!  If the queue is concurrently modified, the returned value may be outdated.
+    size_t size() const;
+
+    //! Get maximum number of packets in queue.
+    size_t max_size() const;
+
+    //! Get number of packets dropped because of overflow.
+    size_t num_dropped() const;
+
+private:
+    struct Slot {
+        core::Atomic seq;
+        Packet* packet;
+    };
+
+    bool push_(Packet* packet);
+    bool pop_(Packet*& packet);
+
+    core::IAllocator& allocator_;
+
+    Slot* slots_;
+    size_t mask_;
+
+    core::Atomic write_pos_;
+    core::Atomic read_pos_;
+
+    core::Atomic num_dropped_;
+
+    const OverflowPolicy policy_;
+};
+
+} // namespace packet
+} // namespace roc
+
+#endif // ROC_PACKET_MPSC_QUEUE_H_
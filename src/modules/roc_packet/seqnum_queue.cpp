@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_packet/seqnum_queue.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace packet {
+
+SeqnumQueue::SeqnumQueue(core::IAllocator& allocator, size_t max_size)
+    : slots_(allocator)
+    , head_sn_(0)
+    , span_(0)
+    , size_(0)
+    , max_size_(max_size) {
+}
+
+PacketPtr SeqnumQueue::read() {
+    if (size_ == 0) {
+        return NULL;
+    }
+
+    PacketPtr& slot = slots_[slot_(head_sn_)];
+
+    PacketPtr packet = slot;
+    slot = NULL;
+
+    if (--size_ == 0) {
+        span_ = 0;
+        return packet;
+    }
+
+    // skip seqnums of missing packets; every seqnum is skipped at most once,
+    // so this takes amortized constant time per packet
+    do {
+        head_sn_++;
+        span_--;
+    } while (!slots_[slot_(head_sn_)]);
+
+    return packet;
+}
+
+void SeqnumQueue::write(const PacketPtr& packet) {
+    if (!packet) {
+        roc_panic("seqnum queue: attempting to add null packet");
+    }
+
+    if (!packet->rtp()) {
+        roc_panic("seqnum queue: attempting to add packet without rtp header");
+    }
+
+    if (max_size_ > 0 && size_ == max_size_) {
+        roc_log(LogDebug,
+                "seqnum queue: queue is full, dropping packet:"
+                " max_size=%u",
+                (unsigned)max_size_);
+        return;
+    }
+
+    const seqnum_t sn = packet->rtp()->seqnum;
+
+    seqnum_t head_sn = head_sn_;
+    size_t span = span_;
+
+    if (size_ == 0) {
+        head_sn = sn;
+        span = 1;
+    } else {
+        const seqnum_diff_t dist = seqnum_diff(sn, head_sn_);
+
+        if (dist < 0) {
+            head_sn = sn;
+            span = span_ + (size_t)-(long)dist;
+        } else if ((size_t)dist >= span_) {
+            span = (size_t)dist + 1;
+        }
+    }
+
+    if (span > MaxSpan) {
+        roc_log(LogDebug,
+                "seqnum queue: packet is too far from queued packets, dropping packet:"
+                " sn=%lu head=%lu size=%lu",
+                (unsigned long)sn, (unsigned long)head_sn_, (unsigned long)size_);
+        return;
+    }
+
+    if (span > slots_.size() && !grow_(span)) {
+        roc_log(LogError, "seqnum queue: can't grow queue, dropping packet: span=%lu",
+                (unsigned long)span);
+        return;
+    }
+
+    PacketPtr& slot = slots_[slot_(sn)];
+
+    if (slot) {
+        roc_log(LogDebug, "seqnum queue: dropping duplicate packet");
+        return;
+    }
+
+    slot = packet;
+
+    if (!latest_ || seqnum_le(latest_->rtp()->seqnum, sn)) {
+        latest_ = packet;
+    }
+
+    head_sn_ = head_sn;
+    span_ = span;
+    size_++;
+}
+
+size_t SeqnumQueue::size() const {
+    return size_;
+}
+
+PacketPtr SeqnumQueue::head() const {
+    if (size_ == 0) {
+        return NULL;
+    }
+    return slots_[slot_(head_sn_)];
+}
+
+PacketPtr SeqnumQueue::tail() const {
+    if (size_ == 0) {
+        return NULL;
+    }
+    return slots_[slot_(seqnum_t(head_sn_ + span_ - 1))];
+}
+
+PacketPtr SeqnumQueue::latest() const {
+    return latest_;
+}
+
+size_t SeqnumQueue::slot_(seqnum_t sn) const {
+    return sn & (slots_.size() - 1);
+}
+
+bool SeqnumQueue::grow_(size_t span) {
+    const size_t old_capacity = slots_.size();
+
+    size_t new_capacity = old_capacity != 0 ? old_capacity : (size_t)MinCapacity;
+    while (new_capacity < span) {
+        new_capacity *= 2;
+    }
+
+    roc_log(LogDebug, "seqnum queue: growing queue: old_capacity=%lu new_capacity=%lu",
+            (unsigned long)old_capacity, (unsigned long)new_capacity);
+
+    if (!slots_.resize(new_capacity)) {
+        return false;
+    }
+
+    // since capacity is a power of two, the new slot of a packet is either its
+    // old slot, or is beyond old capacity and thus is still empty
+    for (size_t n = 0; n < old_capacity; n++) {
+        if (!slots_[n]) {
+            continue;
+        }
+
+        const size_t new_slot = slot_(slots_[n]->rtp()->seqnum);
+
+        if (new_slot != n) {
+            slots_[new_slot] = slots_[n];
+            slots_[n] = NULL;
+        }
+    }
+
+    return true;
+}
+
+} // namespace packet
+} // namespace roc
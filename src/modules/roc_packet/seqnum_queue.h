@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_packet/seqnum_queue.h
+//! @brief Seqnum-indexed packet queue.
+
+#ifndef ROC_PACKET_SEQNUM_QUEUE_H_
+#define ROC_PACKET_SEQNUM_QUEUE_H_
+
+#include "roc_core/array.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/noncopyable.h"
+#include "roc_packet/ireader.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet.h"
+
+namespace roc {
+namespace packet {
+
+//! Seqnum-indexed packet queue.
+//! @remarks
+//!  Same as SortedQueue, but works only with RTP packets. Packets are ordered
+//!  by RTP seqnum and stored in a ring buffer indexed by seqnum modulo its
+//!  capacity, so that insertion, duplicate detection, and removal take constant
+//!  time regardless of the queue size and packet reordering.
+//!
+//!  The ring buffer covers a range of seqnums from the first to the last packet
+//!  in the queue. It grows when a packet doesn't fit into this range. Packets
+//!  that would make the range longer than half of seqnum space are dropped,
+//!  since their order can't be determined.
+class SeqnumQueue : public IWriter, public IReader, public core::NonCopyable<> {
+public:
+    //! Construct empty queue.
+    //! @remarks
+    //!  If @p max_size is non-zero, it specifies maximum number of packets in queue.
+    SeqnumQueue(core::IAllocator& allocator, size_t max_size);
+
+    //! Add packet to the queue.
+    //! @remarks
+    //!  - if the maximum queue size is reached, packet is dropped
+    //!  - if packet is too far from other packets in the queue, it is dropped
+    //!  - if packet has same seqnum as another packet in the queue, it is dropped
+    //!  - otherwise, packet is inserted into the queue, keeping the queue sorted
+    //! @note
+    //!  Packet should have RTP header.
+    virtual void write(const PacketPtr& packet);
+
+    //! Read next packet.
+    //! @returns
+    //!  the first packet in the queue or null if there are no packets
+    //! @remarks
+    //!  Removes returned packet from the queue.
+    virtual PacketPtr read();
+
+    //! Get number of packets in queue.
+    size_t size() const;
+
+    //! Get first packet in the queue.
+    //! @returns
+    //!  the first packet in the queue or null if there are no packets
+    //! @remarks
+    //!  Returned packet is not removed from the queue.
+    PacketPtr head() const;
+
+    //! Get last packet in the queue.
+    //! @returns
+    //!  the last packet in the queue or null if there are no packets
+    //! @remarks
+    //!  Returned packet is not removed from the queue.
+    PacketPtr tail() const;
+
+    //! Get the latest packet that were ever added to the queue.
+    //! @remarks
+    //!  Returns null if the queue never has any packets. Otherwise, returns
+    //!  the latest ever added packet, even if that packet is not currently
+    //!  in the queue. Returned packet is not removed from the queue.
+    PacketPtr latest() const;
+
+private:
+    enum { MinCapacity = 16, MaxSpan = 0x8000 };
+
+    size_t slot_(seqnum_t sn) const;
+    bool grow_(size_t span);
+
+    core::Array<PacketPtr> slots_;
+
+    seqnum_t head_sn_;
+    size_t span_;
+    size_t size_;
+
+    PacketPtr latest_;
+    const size_t max_size_;
+};
+
+} // namespace packet
+} // namespace roc
+
+#endif // ROC_PACKET_SEQNUM_QUEUE_H_
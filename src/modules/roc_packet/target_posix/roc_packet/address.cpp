@@ -13,6 +13,21 @@
 namespace roc {
 namespace packet {
 
+namespace {
+
+// FNV-1a.
+size_t hash_bytes(size_t hash, const void* data, size_t size) {
+    const uint8_t* bytes = (const uint8_t*)data;
+
+    for (size_t n = 0; n < size; n++) {
+        hash = (hash ^ bytes[n]) * 16777619u;
+    }
+
+    return hash;
+}
+
+} // namespace
+
 Address::Address() {
     memset(&sa_, 0, sizeof(sa_));
 }
@@ -161,6 +176,32 @@ bool Address::operator!=(const Address& other) const {
     return !(*this == other);
 }
 
+size_t Address::hash() const {
+    // hash same fields as operator==() compares
+    const sa_family_t family = family_();
+
+    size_t hash = hash_bytes(2166136261u, &family, sizeof(family));
+
+    switch (family) {
+    case AF_INET:
+        hash = hash_bytes(hash, &sa_.addr4.sin_addr.s_addr,
+                          sizeof(sa_.addr4.sin_addr.s_addr));
+        hash = hash_bytes(hash, &sa_.addr4.sin_port, sizeof(sa_.addr4.sin_port));
+        break;
+
+    case AF_INET6:
+        hash = hash_bytes(hash, sa_.addr6.sin6_addr.s6_addr,
+                          sizeof(sa_.addr6.sin6_addr.s6_addr));
+        hash = hash_bytes(hash, &sa_.addr6.sin6_port, sizeof(sa_.addr6.sin6_port));
+        break;
+
+    default:
+        break;
+    }
+
+    return hash;
+}
+
 socklen_t Address::sizeof_(sa_family_t family) {
     switch (family) {
     case AF_INET:
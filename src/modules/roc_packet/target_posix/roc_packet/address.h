@@ -65,6 +65,11 @@ public:
     //! Compare addresses.
     bool operator!=(const Address& other) const;
 
+    //! Compute hash of address.
+    //! @remarks
+    //!  Equal addresses have equal hashes.
+    size_t hash() const;
+
 private:
     static socklen_t sizeof_(sa_family_t family);
 
@@ -19,6 +19,10 @@ const char* fec_scheme_to_str(FECScheme scheme) {
         return "rs8m";
     case FEC_LDPC_Staircase:
         return "ldpc";
+    case FEC_RLC:
+        return "rlc";
+    case FEC_Parity:
+        return "parity";
     }
     return "?";
 }
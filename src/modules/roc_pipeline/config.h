@@ -19,7 +19,10 @@
 #include "roc_core/time.h"
 #include "roc_fec/codec_config.h"
 #include "roc_fec/reader.h"
+#include "roc_fec/rlc_reader.h"
+#include "roc_fec/rlc_writer.h"
 #include "roc_fec/writer.h"
+#include "roc_packet/mpsc_queue.h"
 #include "roc_packet/units.h"
 #include "roc_pipeline/port.h"
 #include "roc_rtp/headers.h"
@@ -49,6 +52,9 @@ const int DefaultMinLatencyFactor = -1;
 //! Default maximum latency relative to target latency.
 const int DefaultMaxLatencyFactor = 2;
 
+//! Default maximum number of incoming packets queued by receiver.
+const size_t DefaultPacketQueueSize = 1024;
+
 //! Port parameters.
 //! @remarks
 //!  On receiver, defines a listened port parameters. On sender,
@@ -76,6 +82,11 @@ struct SenderConfig {
     //! FEC encoder parameters.
     fec::CodecConfig fec_encoder;
 
+    //! Sliding window FEC writer parameters.
+    //! @remarks
+    //!  Used instead of fec_writer when FEC scheme is FEC_RLC.
+    fec::RLCWriterConfig rlc_writer;
+
     //! Number of samples per second per channel.
     size_t input_sample_rate;
 
@@ -135,6 +146,11 @@ struct ReceiverSessionConfig {
     //! FEC decoder parameters.
     fec::CodecConfig fec_decoder;
 
+    //! Sliding window FEC reader parameters.
+    //! @remarks
+    //!  Used instead of fec_reader when FEC scheme is FEC_RLC.
+    fec::RLCReaderConfig rlc_reader;
+
     //! RTP validator parameters.
     rtp::ValidatorConfig rtp_validator;
 
@@ -181,6 +197,21 @@ struct ReceiverCommonConfig {
     //! Insert weird beeps instead of silence on packet loss.
     bool beeping;
 
+    //! Number of worker threads for rendering sessions in parallel.
+    //! @remarks
+    //!  If zero, sessions are rendered in the thread that reads frames from
+    //!  receiver. Otherwise, frames of sessions are prefetched in parallel by
+    //!  this number of workers and the reading thread, and then mixed.
+    size_t num_workers;
+
+    //! Maximum number of incoming packets queued until the next frame is read.
+    //! @remarks
+    //!  Rounded up to a power of two.
+    size_t packet_queue_size;
+
+    //! What to do with incoming packets when the queue is full.
+    packet::OverflowPolicy packet_queue_policy;
+
     ReceiverCommonConfig()
         : output_sample_rate(DefaultSampleRate)
         , output_channels(DefaultChannelMask)
@@ -188,7 +219,10 @@ struct ReceiverCommonConfig {
         , resampling(false)
         , timing(false)
         , poisoning(false)
-        , beeping(false) {
+        , beeping(false)
+        , num_workers(0)
+        , packet_queue_size(DefaultPacketQueueSize)
+        , packet_queue_policy(packet::Overflow_DropOldest) {
     }
 };
 
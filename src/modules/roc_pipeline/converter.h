@@ -16,6 +16,7 @@
 #include "roc_audio/poison_writer.h"
 #include "roc_audio/profiling_writer.h"
 #include "roc_audio/resampler_profile.h"
+#include "roc_audio/iresampler.h"
 #include "roc_audio/resampler_writer.h"
 #include "roc_core/buffer_pool.h"
 #include "roc_core/unique_ptr.h"
@@ -50,7 +51,8 @@ private:
     audio::NullWriter null_writer_;
 
     core::UniquePtr<audio::PoisonWriter> resampler_poisoner_;
-    core::UniquePtr<audio::ResamplerWriter> resampler_;
+    core::UniquePtr<audio::IResampler> resampler_;
+    core::UniquePtr<audio::ResamplerWriter> resampler_writer_;
 
     core::UniquePtr<audio::ProfilingWriter> profiler_;
 
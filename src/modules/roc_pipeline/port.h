@@ -42,7 +42,19 @@ enum PortProtocol {
     Proto_RTP_LDPC_Source,
 
     //! FEC repair packet + FECFRAME LDPC header.
-    Proto_LDPC_Repair
+    Proto_LDPC_Repair,
+
+    //! RTP source packet + FECFRAME sliding window RLC footer.
+    Proto_RTP_RLC_Source,
+
+    //! FEC repair packet + FECFRAME sliding window RLC header.
+    Proto_RLC_Repair,
+
+    //! RTP source packet + FECFRAME XOR parity footer.
+    Proto_RTP_Parity_Source,
+
+    //! FEC repair packet + FECFRAME XOR parity header.
+    Proto_Parity_Repair
 };
 
 } // namespace pipeline
@@ -33,6 +33,18 @@ packet::FECScheme port_fec_scheme(PortProtocol proto) {
 
     case Proto_LDPC_Repair:
         return packet::FEC_LDPC_Staircase;
+
+    case Proto_RTP_RLC_Source:
+        return packet::FEC_RLC;
+
+    case Proto_RLC_Repair:
+        return packet::FEC_RLC;
+
+    case Proto_RTP_Parity_Source:
+        return packet::FEC_Parity;
+
+    case Proto_Parity_Repair:
+        return packet::FEC_Parity;
     }
 
     return packet::FEC_None;
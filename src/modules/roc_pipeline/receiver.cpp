@@ -7,6 +7,7 @@
  */
 
 #include "roc_pipeline/receiver.h"
+#include "roc_audio/frame_flags_merger.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 #include "roc_core/shared_ptr.h"
@@ -29,14 +30,26 @@ Receiver::Receiver(const ReceiverConfig& config,
     , byte_buffer_pool_(byte_buffer_pool)
     , sample_buffer_pool_(sample_buffer_pool)
     , allocator_(allocator)
+    , session_index_(allocator)
+    , packets_(allocator,
+               config.common.packet_queue_size,
+               config.common.packet_queue_policy)
     , ticker_(config.common.output_sample_rate)
+    , render_sessions_(allocator)
     , audio_reader_(NULL)
     , config_(config)
     , timestamp_(0)
     , num_channels_(packet::num_channels(config.common.output_channels))
     , active_cond_(control_mutex_) {
-    mixer_.reset(new (allocator_)
-                     audio::Mixer(sample_buffer_pool, config.common.internal_frame_size),
+    if (!packets_.valid()) {
+        return;
+    }
+
+    // Blank frames contain beeps instead of zeros when beeping is enabled,
+    // so they can't be skipped.
+    mixer_.reset(new (allocator_) audio::Mixer(sample_buffer_pool,
+                                               config.common.internal_frame_size,
+                                               !config.common.beeping),
                  allocator_);
     if (!mixer_ || !mixer_->valid()) {
         return;
@@ -51,6 +64,15 @@ Receiver::Receiver(const ReceiverConfig& config,
         areader = poisoner_.get();
     }
 
+    if (config.common.num_workers != 0) {
+        renderer_.reset(new (allocator_)
+                            SessionRenderer(config.common.num_workers, allocator_),
+                        allocator_);
+        if (!renderer_ || !renderer_->valid()) {
+            return;
+        }
+    }
+
     audio_reader_ = areader;
 }
 
@@ -86,9 +108,7 @@ void Receiver::iterate_ports(void (*fn)(void*, const PortConfig&), void* arg) co
 }
 
 size_t Receiver::num_sessions() const {
-    core::Mutex::Lock lock(control_mutex_);
-
-    return sessions_.size();
+    return (size_t)(long)num_sessions_;
 }
 
 size_t Receiver::sample_rate() const {
@@ -100,27 +120,30 @@ bool Receiver::has_clock() const {
 }
 
 sndio::ISource::State Receiver::state() const {
-    core::Mutex::Lock lock(control_mutex_);
-
     return state_();
 }
 
 void Receiver::wait_active() const {
     core::Mutex::Lock lock(control_mutex_);
 
+    ++num_waiters_;
+
     while (state_() != Active) {
         active_cond_.wait();
     }
+
+    --num_waiters_;
 }
 
 void Receiver::write(const packet::PacketPtr& packet) {
-    core::Mutex::Lock lock(control_mutex_);
-
-    const State old_state = state_();
-
-    packets_.push_back(*packet);
-
-    if (old_state != Active) {
+    packets_.write(packet);
+
+    // Mutex is locked only if someone is waiting in wait_active(). Waiter
+    // increments counter before checking queue size, and we check counter
+    // after adding packet to queue, so either the waiter sees the packet, or
+    // we see the waiter. Atomic operations are full barriers.
+    if (num_waiters_ != 0) {
+        core::Mutex::Lock lock(control_mutex_);
         active_cond_.broadcast();
     }
 }
@@ -132,15 +155,48 @@ bool Receiver::read(audio::Frame& frame) {
         ticker_.wait(timestamp_);
     }
 
-    prepare_();
-
-    audio_reader_->read(frame);
+    if (prepare_()) {
+        render_(frame);
+    } else {
+        audio_reader_->read(frame);
+    }
     timestamp_ += frame.size() / num_channels_;
 
     return true;
 }
 
-void Receiver::prepare_() {
+void Receiver::render_(audio::Frame& frame) {
+    // Sessions are rendered by chunks of internal frame size, because it's the
+    // maximum size of prefetch buffer.
+    const size_t max_size = config_.common.internal_frame_size;
+
+    audio::sample_t* samples = frame.data();
+    size_t n_samples = frame.size();
+
+    audio::FrameFlagsMerger flags;
+
+    while (n_samples != 0) {
+        size_t n_read = n_samples;
+        if (n_read > max_size) {
+            n_read = max_size;
+        }
+
+        renderer_->render(render_sessions_.size() ? &render_sessions_[0] : NULL,
+                          render_sessions_.size(), n_read);
+
+        audio::Frame chunk(samples, n_read);
+        audio_reader_->read(chunk);
+
+        flags.add(chunk.flags());
+
+        samples += n_read;
+        n_samples -= n_read;
+    }
+
+    frame.set_flags(flags.flags());
+}
+
+bool Receiver::prepare_() {
     core::Mutex::Lock lock(control_mutex_);
 
     const State old_state = state_();
@@ -151,10 +207,33 @@ void Receiver::prepare_() {
     if (old_state != Active && state_() == Active) {
         active_cond_.broadcast();
     }
+
+    if (!renderer_) {
+        return false;
+    }
+
+    return collect_sessions_();
+}
+
+bool Receiver::collect_sessions_() {
+    if (!render_sessions_.resize(sessions_.size())) {
+        roc_log(LogError,
+                "receiver: can't allocate sessions array, rendering sessions serially");
+        return false;
+    }
+
+    size_t n_sess = 0;
+
+    core::SharedPtr<ReceiverSession> sess;
+    for (sess = sessions_.front(); sess; sess = sessions_.nextof(*sess)) {
+        render_sessions_[n_sess++] = sess.get();
+    }
+
+    return true;
 }
 
 sndio::ISource::State Receiver::state_() const {
-    if (sessions_.size() != 0) {
+    if (num_sessions_ != 0) {
         return Active;
     }
 
@@ -167,13 +246,11 @@ sndio::ISource::State Receiver::state_() const {
 
 void Receiver::fetch_packets_() {
     for (;;) {
-        packet::PacketPtr packet = packets_.front();
+        packet::PacketPtr packet = packets_.read();
         if (!packet) {
             break;
         }
 
-        packets_.remove(*packet);
-
         if (!parse_packet_(packet)) {
             continue;
         }
@@ -199,11 +276,9 @@ bool Receiver::parse_packet_(const packet::PacketPtr& packet) {
 }
 
 bool Receiver::route_packet_(const packet::PacketPtr& packet) {
-    core::SharedPtr<ReceiverSession> sess;
-
-    for (sess = sessions_.front(); sess; sess = sessions_.nextof(*sess)) {
-        if (sess->handle(packet)) {
-            return true;
+    if (const packet::UDP* udp = packet->udp()) {
+        if (ReceiverSession* sess = session_index_.find(udp->src_addr)) {
+            return sess->handle(packet);
         }
     }
 
@@ -257,8 +332,14 @@ bool Receiver::create_session_(const packet::PacketPtr& packet) {
         return false;
     }
 
+    if (!session_index_.insert(*sess)) {
+        roc_log(LogError, "receiver: can't create session, can't add it to index");
+        return false;
+    }
+
     mixer_->add(sess->reader());
     sessions_.push_back(*sess);
+    ++num_sessions_;
 
     return true;
 }
@@ -267,7 +348,9 @@ void Receiver::remove_session_(ReceiverSession& sess) {
     roc_log(LogInfo, "receiver: removing session");
 
     mixer_->remove(sess.reader());
+    session_index_.remove(sess);
     sessions_.remove(sess);
+    --num_sessions_;
 }
 
 void Receiver::update_sessions_() {
@@ -15,8 +15,11 @@
 #include "roc_audio/ireader.h"
 #include "roc_audio/mixer.h"
 #include "roc_audio/poison_reader.h"
+#include "roc_core/array.h"
+#include "roc_core/atomic.h"
 #include "roc_core/buffer_pool.h"
 #include "roc_core/cond.h"
+#include "roc_core/hash_index.h"
 #include "roc_core/iallocator.h"
 #include "roc_core/list.h"
 #include "roc_core/mutex.h"
@@ -25,10 +28,12 @@
 #include "roc_fec/codec_map.h"
 #include "roc_packet/ireader.h"
 #include "roc_packet/iwriter.h"
+#include "roc_packet/mpsc_queue.h"
 #include "roc_packet/packet_pool.h"
 #include "roc_pipeline/config.h"
 #include "roc_pipeline/receiver_port.h"
 #include "roc_pipeline/receiver_session.h"
+#include "roc_pipeline/session_renderer.h"
 #include "roc_rtp/format_map.h"
 #include "roc_sndio/isource.h"
 
@@ -59,9 +64,13 @@ public:
     void iterate_ports(void (*fn)(void*, const PortConfig&), void* arg) const;
 
     //! Get number of alive sessions.
+    //! @remarks
+    //!  Lock-free.
     size_t num_sessions() const;
 
     //! Get current receiver state.
+    //! @remarks
+    //!  Lock-free.
     virtual State state() const;
 
     //! Wait until the receiver status becomes active.
@@ -74,6 +83,9 @@ public:
     virtual bool has_clock() const;
 
     //! Write packet.
+    //! @remarks
+    //!  Lock-free, may be called from any thread. Packet is added to a bounded
+    //!  queue and is processed during the next read().
     virtual void write(const packet::PacketPtr&);
 
     //! Read frame.
@@ -82,7 +94,10 @@ public:
 private:
     State state_() const;
 
-    void prepare_();
+    bool prepare_();
+
+    bool collect_sessions_();
+    void render_(audio::Frame& frame);
 
     void fetch_packets_();
 
@@ -108,14 +123,18 @@ private:
 
     core::List<ReceiverPort> ports_;
     core::List<ReceiverSession> sessions_;
+    core::HashIndex<ReceiverSession, packet::Address> session_index_;
 
-    core::List<packet::Packet> packets_;
+    packet::MpscQueue packets_;
 
     core::Ticker ticker_;
 
     core::UniquePtr<audio::Mixer> mixer_;
     core::UniquePtr<audio::PoisonReader> poisoner_;
 
+    core::UniquePtr<SessionRenderer> renderer_;
+    core::Array<ReceiverSession*> render_sessions_;
+
     audio::IReader* audio_reader_;
 
     ReceiverConfig config_;
@@ -123,6 +142,9 @@ private:
     packet::timestamp_t timestamp_;
     size_t num_channels_;
 
+    core::Atomic num_sessions_;
+    mutable core::Atomic num_waiters_;
+
     core::Mutex control_mutex_;
     core::Mutex pipeline_mutex_;
     core::Cond active_cond_;
@@ -28,6 +28,8 @@ ReceiverPort::ReceiverPort(const PortConfig& config,
     case Proto_RTP:
     case Proto_RTP_LDPC_Source:
     case Proto_RTP_RSm8_Source:
+    case Proto_RTP_RLC_Source:
+    case Proto_RTP_Parity_Source:
         rtp_parser_.reset(new (allocator) rtp::Parser(format_map, NULL), allocator);
         if (!rtp_parser_) {
             return;
@@ -77,6 +79,48 @@ ReceiverPort::ReceiverPort(const PortConfig& config,
         }
         parser = fec_parser_.get();
         break;
+    case Proto_RTP_RLC_Source:
+        fec_parser_.reset(
+            new (allocator)
+                fec::Parser<fec::RLC_Source_PayloadID, fec::Source, fec::Footer>(parser),
+            allocator);
+        if (!fec_parser_) {
+            return;
+        }
+        parser = fec_parser_.get();
+        break;
+    case Proto_RLC_Repair:
+        fec_parser_.reset(
+            new (allocator)
+                fec::Parser<fec::RLC_Repair_PayloadID, fec::Repair, fec::Header>(parser),
+            allocator);
+        if (!fec_parser_) {
+            return;
+        }
+        parser = fec_parser_.get();
+        break;
+    case Proto_RTP_Parity_Source:
+        fec_parser_.reset(
+            new (allocator)
+                fec::Parser<fec::Parity_Source_PayloadID, fec::Source, fec::Footer>(
+                    parser),
+            allocator);
+        if (!fec_parser_) {
+            return;
+        }
+        parser = fec_parser_.get();
+        break;
+    case Proto_Parity_Repair:
+        fec_parser_.reset(
+            new (allocator)
+                fec::Parser<fec::Parity_Repair_PayloadID, fec::Repair, fec::Header>(
+                    parser),
+            allocator);
+        if (!fec_parser_) {
+            return;
+        }
+        parser = fec_parser_.get();
+        break;
     }
 
     parser_ = parser;
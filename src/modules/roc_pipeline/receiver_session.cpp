@@ -7,6 +7,8 @@
  */
 
 #include "roc_pipeline/receiver_session.h"
+#include "roc_audio/polynomial_resampler.h"
+#include "roc_audio/resampler.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 
@@ -35,7 +37,7 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
         return;
     }
 
-    source_queue_.reset(new (allocator_) packet::SortedQueue(0), allocator_);
+    source_queue_.reset(new (allocator_) packet::SeqnumQueue(allocator_, 0), allocator_);
     if (!source_queue_) {
         return;
     }
@@ -74,27 +76,40 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
             return;
         }
 
-        fec_decoder_.reset(codec_map.new_decoder(session_config.fec_decoder,
-                                                 byte_buffer_pool, allocator_),
-                           allocator_);
-        if (!fec_decoder_) {
-            return;
-        }
-
         fec_parser_.reset(new (allocator_) rtp::Parser(format_map, NULL), allocator_);
         if (!fec_parser_) {
             return;
         }
 
-        fec_reader_.reset(new (allocator_) fec::Reader(
-                              session_config.fec_reader,
-                              session_config.fec_decoder.scheme, *fec_decoder_, *preader,
-                              *repair_queue_, *fec_parser_, packet_pool, allocator_),
-                          allocator_);
-        if (!fec_reader_ || !fec_reader_->valid()) {
-            return;
+        if (session_config.fec_decoder.scheme == packet::FEC_RLC) {
+            rlc_reader_.reset(new (allocator_) fec::RLCReader(
+                                  session_config.rlc_reader, *preader, *repair_queue_,
+                                  *fec_parser_, packet_pool, byte_buffer_pool,
+                                  allocator_),
+                              allocator_);
+            if (!rlc_reader_ || !rlc_reader_->valid()) {
+                return;
+            }
+            preader = rlc_reader_.get();
+        } else {
+            fec_decoder_.reset(codec_map.new_decoder(session_config.fec_decoder,
+                                                     byte_buffer_pool, allocator_),
+                               allocator_);
+            if (!fec_decoder_) {
+                return;
+            }
+
+            fec_reader_.reset(new (allocator_) fec::Reader(
+                                  session_config.fec_reader,
+                                  session_config.fec_decoder.scheme, *fec_decoder_,
+                                  *preader, *repair_queue_, *fec_parser_, packet_pool,
+                                  allocator_),
+                              allocator_);
+            if (!fec_reader_ || !fec_reader_->valid()) {
+                return;
+            }
+            preader = fec_reader_.get();
         }
-        preader = fec_reader_.get();
 
         fec_validator_.reset(new (allocator_)
                                  rtp::Validator(*preader, session_config.rtp_validator,
@@ -144,15 +159,35 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
             }
             areader = resampler_poisoner_.get();
         }
-        resampler_.reset(new (allocator_) audio::ResamplerReader(
-                             *areader, sample_buffer_pool, allocator,
-                             session_config.resampler, session_config.channels,
-                             common_config.internal_frame_size),
-                         allocator_);
-        if (!resampler_ || !resampler_->valid()) {
+        if (session_config.resampler.method != audio::ResamplerMethod_Sinc) {
+            core::UniquePtr<audio::PolynomialResampler> resampler(
+                new (allocator_) audio::PolynomialResampler(
+                    allocator, session_config.resampler, session_config.channels,
+                    common_config.internal_frame_size),
+                allocator_);
+            if (!resampler || !resampler->valid()) {
+                return;
+            }
+            resampler_.reset(resampler.release(), allocator_);
+        } else {
+            core::UniquePtr<audio::Resampler> resampler(
+                new (allocator_) audio::Resampler(allocator, session_config.resampler,
+                                                  session_config.channels,
+                                                  common_config.internal_frame_size),
+                allocator_);
+            if (!resampler || !resampler->valid()) {
+                return;
+            }
+            resampler_.reset(resampler.release(), allocator_);
+        }
+        resampler_reader_.reset(new (allocator_) audio::ResamplerReader(
+                                    *areader, *resampler_, sample_buffer_pool,
+                                    common_config.internal_frame_size),
+                                allocator_);
+        if (!resampler_reader_ || !resampler_reader_->valid()) {
             return;
         }
-        areader = resampler_.get();
+        areader = resampler_reader_.get();
     }
 
     if (common_config.poisoning) {
@@ -164,8 +199,19 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
         areader = session_poisoner_.get();
     }
 
+    if (common_config.num_workers != 0) {
+        prefetch_reader_.reset(new (allocator_) audio::PrefetchReader(
+                                   *areader, sample_buffer_pool,
+                                   common_config.internal_frame_size),
+                               allocator_);
+        if (!prefetch_reader_ || !prefetch_reader_->valid()) {
+            return;
+        }
+        areader = prefetch_reader_.get();
+    }
+
     latency_monitor_.reset(new (allocator_) audio::LatencyMonitor(
-                               *source_queue_, *depacketizer_, resampler_.get(),
+                               *source_queue_, *depacketizer_, resampler_reader_.get(),
                                session_config.latency_monitor,
                                session_config.target_latency, format->sample_rate,
                                common_config.output_sample_rate),
@@ -219,11 +265,34 @@ bool ReceiverSession::update(packet::timestamp_t time) {
     return true;
 }
 
+void ReceiverSession::prefetch(size_t size) {
+    roc_panic_if(!valid());
+
+    if (!prefetch_reader_) {
+        roc_panic("receiver session: prefetching is disabled");
+    }
+
+    prefetch_reader_->prefetch(size);
+}
+
 audio::IReader& ReceiverSession::reader() {
     roc_panic_if(!valid());
 
     return *audio_reader_;
 }
 
+const packet::Address& ReceiverSession::key() const {
+    return src_address_;
+}
+
+size_t ReceiverSession::key_hash(const packet::Address& address) {
+    return address.hash();
+}
+
+bool ReceiverSession::key_equal(const packet::Address& address1,
+                                const packet::Address& address2) {
+    return address1 == address2;
+}
+
 } // namespace pipeline
 } // namespace roc
@@ -15,8 +15,10 @@
 #include "roc_audio/depacketizer.h"
 #include "roc_audio/iframe_decoder.h"
 #include "roc_audio/ireader.h"
+#include "roc_audio/iresampler.h"
 #include "roc_audio/latency_monitor.h"
 #include "roc_audio/poison_reader.h"
+#include "roc_audio/prefetch_reader.h"
 #include "roc_audio/resampler_reader.h"
 #include "roc_audio/watchdog.h"
 #include "roc_core/buffer_pool.h"
@@ -27,6 +29,7 @@
 #include "roc_fec/codec_map.h"
 #include "roc_fec/iblock_decoder.h"
 #include "roc_fec/reader.h"
+#include "roc_fec/rlc_reader.h"
 #include "roc_packet/address.h"
 #include "roc_packet/delayed_reader.h"
 #include "roc_packet/iparser.h"
@@ -34,6 +37,7 @@
 #include "roc_packet/packet.h"
 #include "roc_packet/packet_pool.h"
 #include "roc_packet/router.h"
+#include "roc_packet/seqnum_queue.h"
 #include "roc_packet/sorted_queue.h"
 #include "roc_pipeline/config.h"
 #include "roc_rtp/format_map.h"
@@ -72,9 +76,29 @@ public:
     //!  false if the session is terminated
     bool update(packet::timestamp_t time);
 
+    //! Read next frame of session in advance.
+    //! @remarks
+    //!  May be called from any thread, but not concurrently with other methods.
+    //!  Next read from reader() should request the same number of samples.
+    //!  Should be used only if ReceiverCommonConfig::num_workers is non-zero.
+    void prefetch(size_t size);
+
     //! Get audio reader.
     audio::IReader& reader();
 
+    //! Get session key.
+    //! @remarks
+    //!  Session handles all packets from its source address. Used by
+    //!  core::HashIndex.
+    const packet::Address& key() const;
+
+    //! Compute hash of session key.
+    static size_t key_hash(const packet::Address& address);
+
+    //! Compare session keys.
+    static bool key_equal(const packet::Address& address1,
+                          const packet::Address& address2);
+
 private:
     friend class core::RefCnt<ReceiverSession>;
 
@@ -88,7 +112,7 @@ private:
 
     core::UniquePtr<packet::Router> queue_router_;
 
-    core::UniquePtr<packet::SortedQueue> source_queue_;
+    core::UniquePtr<packet::SeqnumQueue> source_queue_;
     core::UniquePtr<packet::SortedQueue> repair_queue_;
 
     core::UniquePtr<packet::DelayedReader> delayed_reader_;
@@ -98,16 +122,20 @@ private:
     core::UniquePtr<rtp::Parser> fec_parser_;
     core::UniquePtr<fec::IBlockDecoder> fec_decoder_;
     core::UniquePtr<fec::Reader> fec_reader_;
+    core::UniquePtr<fec::RLCReader> rlc_reader_;
     core::UniquePtr<rtp::Validator> fec_validator_;
 
     core::UniquePtr<audio::IFrameDecoder> payload_decoder_;
     core::UniquePtr<audio::Depacketizer> depacketizer_;
 
     core::UniquePtr<audio::PoisonReader> resampler_poisoner_;
-    core::UniquePtr<audio::ResamplerReader> resampler_;
+    core::UniquePtr<audio::IResampler> resampler_;
+    core::UniquePtr<audio::ResamplerReader> resampler_reader_;
 
     core::UniquePtr<audio::PoisonReader> session_poisoner_;
 
+    core::UniquePtr<audio::PrefetchReader> prefetch_reader_;
+
     core::UniquePtr<audio::LatencyMonitor> latency_monitor_;
 };
 
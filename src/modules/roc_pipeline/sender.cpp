@@ -7,6 +7,7 @@
  */
 
 #include "roc_pipeline/sender.h"
+#include "roc_audio/resampler_factory.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 #include "roc_pipeline/port_to_str.h"
@@ -81,11 +82,15 @@ Sender::Sender(const SenderConfig& config,
             return;
         }
 
+        const bool sliding_window = config.fec_encoder.scheme == packet::FEC_RLC;
+
         if (config.interleaving) {
-            interleaver_.reset(new (allocator) packet::Interleaver(
-                                   *pwriter, allocator,
-                                   config.fec_writer.n_source_packets
-                                       + config.fec_writer.n_repair_packets),
+            const size_t interleaver_block = sliding_window
+                ? config.rlc_writer.n_source_packets + config.rlc_writer.n_repair_packets
+                : config.fec_writer.n_source_packets + config.fec_writer.n_repair_packets;
+
+            interleaver_.reset(new (allocator) packet::Interleaver(*pwriter, allocator,
+                                                                   interleaver_block),
                                allocator);
             if (!interleaver_ || !interleaver_->valid()) {
                 return;
@@ -93,23 +98,35 @@ Sender::Sender(const SenderConfig& config,
             pwriter = interleaver_.get();
         }
 
-        fec_encoder_.reset(
-            codec_map.new_encoder(config.fec_encoder, byte_buffer_pool, allocator),
-            allocator);
-        if (!fec_encoder_) {
-            return;
-        }
+        if (sliding_window) {
+            rlc_writer_.reset(new (allocator) fec::RLCWriter(
+                                  config.rlc_writer, *pwriter, source_port_->composer(),
+                                  repair_port_->composer(), packet_pool,
+                                  byte_buffer_pool, allocator),
+                              allocator);
+            if (!rlc_writer_ || !rlc_writer_->valid()) {
+                return;
+            }
+            pwriter = rlc_writer_.get();
+        } else {
+            fec_encoder_.reset(
+                codec_map.new_encoder(config.fec_encoder, byte_buffer_pool, allocator),
+                allocator);
+            if (!fec_encoder_) {
+                return;
+            }
 
-        fec_writer_.reset(
-            new (allocator)
-                fec::Writer(config.fec_writer, config.fec_encoder.scheme, *fec_encoder_,
-                            *pwriter, source_port_->composer(), repair_port_->composer(),
-                            packet_pool, byte_buffer_pool, allocator),
-            allocator);
-        if (!fec_writer_ || !fec_writer_->valid()) {
-            return;
+            fec_writer_.reset(new (allocator) fec::Writer(
+                                  config.fec_writer, config.fec_encoder.scheme,
+                                  *fec_encoder_, *pwriter, source_port_->composer(),
+                                  repair_port_->composer(), packet_pool,
+                                  byte_buffer_pool, allocator),
+                              allocator);
+            if (!fec_writer_ || !fec_writer_->valid()) {
+                return;
+            }
+            pwriter = fec_writer_.get();
         }
-        pwriter = fec_writer_.get();
     }
 
     payload_encoder_.reset(format->new_encoder(allocator), allocator);
@@ -137,18 +154,24 @@ Sender::Sender(const SenderConfig& config,
             }
             awriter = resampler_poisoner_.get();
         }
-        resampler_.reset(new (allocator) audio::ResamplerWriter(
-                             *awriter, sample_buffer_pool, allocator, config.resampler,
-                             config.input_channels, config.internal_frame_size),
+        const float scaling = float(config.input_sample_rate) / format->sample_rate;
+
+        resampler_.reset(audio::new_constant_rate_resampler(
+                             allocator, config.resampler, config.input_channels,
+                             config.internal_frame_size, scaling),
                          allocator);
-        if (!resampler_ || !resampler_->valid()) {
+        if (!resampler_) {
             return;
         }
-        if (!resampler_->set_scaling(float(config.input_sample_rate)
-                                     / format->sample_rate)) {
+
+        resampler_writer_.reset(new (allocator) audio::ResamplerWriter(
+                                    *awriter, *resampler_, sample_buffer_pool,
+                                    config.internal_frame_size),
+                                allocator);
+        if (!resampler_writer_ || !resampler_writer_->valid()) {
             return;
         }
-        awriter = resampler_.get();
+        awriter = resampler_writer_.get();
     }
 
     if (config.poisoning) {
@@ -15,6 +15,7 @@
 #include "roc_audio/iframe_encoder.h"
 #include "roc_audio/packetizer.h"
 #include "roc_audio/poison_writer.h"
+#include "roc_audio/iresampler.h"
 #include "roc_audio/resampler_writer.h"
 #include "roc_core/buffer_pool.h"
 #include "roc_core/iallocator.h"
@@ -23,6 +24,7 @@
 #include "roc_core/unique_ptr.h"
 #include "roc_fec/codec_map.h"
 #include "roc_fec/iblock_encoder.h"
+#include "roc_fec/rlc_writer.h"
 #include "roc_fec/writer.h"
 #include "roc_packet/interleaver.h"
 #include "roc_packet/packet_pool.h"
@@ -73,12 +75,14 @@ private:
 
     core::UniquePtr<fec::IBlockEncoder> fec_encoder_;
     core::UniquePtr<fec::Writer> fec_writer_;
+    core::UniquePtr<fec::RLCWriter> rlc_writer_;
 
     core::UniquePtr<audio::IFrameEncoder> payload_encoder_;
     core::UniquePtr<audio::Packetizer> packetizer_;
 
     core::UniquePtr<audio::PoisonWriter> resampler_poisoner_;
-    core::UniquePtr<audio::ResamplerWriter> resampler_;
+    core::UniquePtr<audio::IResampler> resampler_;
+    core::UniquePtr<audio::ResamplerWriter> resampler_writer_;
 
     core::UniquePtr<audio::PoisonWriter> pipeline_poisoner_;
 
@@ -27,6 +27,8 @@ SenderPort::SenderPort(const PortConfig& config,
     case Proto_RTP:
     case Proto_RTP_LDPC_Source:
     case Proto_RTP_RSm8_Source:
+    case Proto_RTP_RLC_Source:
+    case Proto_RTP_Parity_Source:
         rtp_composer_.reset(new (allocator) rtp::Composer(NULL), allocator);
         if (!rtp_composer_) {
             return;
@@ -78,6 +80,50 @@ SenderPort::SenderPort(const PortConfig& config,
         }
         composer = fec_composer_.get();
         break;
+    case Proto_RTP_RLC_Source:
+        fec_composer_.reset(
+            new (allocator)
+                fec::Composer<fec::RLC_Source_PayloadID, fec::Source, fec::Footer>(
+                    composer),
+            allocator);
+        if (!fec_composer_) {
+            return;
+        }
+        composer = fec_composer_.get();
+        break;
+    case Proto_RLC_Repair:
+        fec_composer_.reset(
+            new (allocator)
+                fec::Composer<fec::RLC_Repair_PayloadID, fec::Repair, fec::Header>(
+                    composer),
+            allocator);
+        if (!fec_composer_) {
+            return;
+        }
+        composer = fec_composer_.get();
+        break;
+    case Proto_RTP_Parity_Source:
+        fec_composer_.reset(
+            new (allocator)
+                fec::Composer<fec::Parity_Source_PayloadID, fec::Source, fec::Footer>(
+                    composer),
+            allocator);
+        if (!fec_composer_) {
+            return;
+        }
+        composer = fec_composer_.get();
+        break;
+    case Proto_Parity_Repair:
+        fec_composer_.reset(
+            new (allocator)
+                fec::Composer<fec::Parity_Repair_PayloadID, fec::Repair, fec::Header>(
+                    composer),
+            allocator);
+        if (!fec_composer_) {
+            return;
+        }
+        composer = fec_composer_.get();
+        break;
     }
 
     composer_ = composer;
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/session_renderer.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace pipeline {
+
+SessionRenderer::Worker::Worker(SessionRenderer& renderer)
+    : renderer_(renderer) {
+}
+
+void SessionRenderer::Worker::run() {
+    renderer_.run_worker_();
+}
+
+SessionRenderer::SessionRenderer(size_t num_workers, core::IAllocator& allocator)
+    : allocator_(allocator)
+    , workers_(allocator)
+    , cond_(mutex_)
+    , sessions_(NULL)
+    , n_sessions_(0)
+    , size_(0)
+    , next_session_(0)
+    , n_pending_(0)
+    , generation_(0)
+    , stop_(false)
+    , valid_(false) {
+    roc_log(LogDebug, "session renderer: initializing: num_workers=%lu",
+            (unsigned long)num_workers);
+
+    if (!workers_.grow(num_workers)) {
+        roc_log(LogError, "session renderer: can't allocate workers array");
+        return;
+    }
+
+    for (size_t n = 0; n < num_workers; n++) {
+        Worker* worker = new (allocator_) Worker(*this);
+        if (!worker) {
+            roc_log(LogError, "session renderer: can't allocate worker");
+            return;
+        }
+
+        workers_.resize(n + 1);
+        workers_[n] = worker;
+
+        if (!worker->start()) {
+            roc_log(LogError, "session renderer: can't start worker");
+            return;
+        }
+    }
+
+    valid_ = true;
+}
+
+SessionRenderer::~SessionRenderer() {
+    {
+        core::Mutex::Lock lock(mutex_);
+
+        stop_ = true;
+        cond_.broadcast();
+    }
+
+    for (size_t n = 0; n < workers_.size(); n++) {
+        workers_[n]->join();
+        allocator_.destroy(*workers_[n]);
+    }
+}
+
+bool SessionRenderer::valid() const {
+    return valid_;
+}
+
+void SessionRenderer::render(ReceiverSession** sessions, size_t n_sessions, size_t size) {
+    roc_panic_if_not(valid_);
+
+    core::Mutex::Lock lock(mutex_);
+
+    sessions_ = sessions;
+    n_sessions_ = n_sessions;
+    size_ = size;
+
+    next_session_ = 0;
+    n_pending_ = n_sessions;
+
+    generation_++;
+    cond_.broadcast();
+
+    // Calling thread renders sessions too, instead of just waiting.
+    render_sessions_();
+
+    while (n_pending_ != 0) {
+        cond_.wait();
+    }
+
+    sessions_ = NULL;
+    n_sessions_ = 0;
+}
+
+void SessionRenderer::run_worker_() {
+    core::Mutex::Lock lock(mutex_);
+
+    size_t generation = generation_;
+
+    for (;;) {
+        while (!stop_ && generation == generation_) {
+            cond_.wait();
+        }
+
+        if (stop_) {
+            return;
+        }
+
+        generation = generation_;
+
+        render_sessions_();
+    }
+}
+
+// Should be called with mutex locked.
+void SessionRenderer::render_sessions_() {
+    while (next_session_ < n_sessions_) {
+        ReceiverSession* sess = sessions_[next_session_++];
+        const size_t size = size_;
+
+        mutex_.unlock();
+        sess->prefetch(size);
+        mutex_.lock();
+
+        if (--n_pending_ == 0) {
+            cond_.broadcast();
+        }
+    }
+}
+
+} // namespace pipeline
+} // namespace roc
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/session_renderer.h
+//! @brief Parallel session renderer.
+
+#ifndef ROC_PIPELINE_SESSION_RENDERER_H_
+#define ROC_PIPELINE_SESSION_RENDERER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/cond.h"
+#include "roc_core/iallocator.h"
+#include "roc_core/mutex.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/thread.h"
+#include "roc_pipeline/receiver_session.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Renders frames of receiver sessions in parallel.
+//! @remarks
+//!  Owns a pool of worker threads. Every session is rendered by one of the
+//!  workers or by the calling thread into its own prefetch buffer, so the
+//!  result doesn't depend on the number of workers and scheduling.
+class SessionRenderer : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  Starts @p num_workers threads.
+    SessionRenderer(size_t num_workers, core::IAllocator& allocator);
+
+    //! Stop and join workers.
+    ~SessionRenderer();
+
+    //! Check if the object was successfully constructed.
+    bool valid() const;
+
+    //! Prefetch @p size samples for every session.
+    //! @remarks
+    //!  Blocks until all sessions are rendered.
+    void render(ReceiverSession** sessions, size_t n_sessions, size_t size);
+
+private:
+    class Worker : public core::Thread {
+    public:
+        Worker(SessionRenderer& renderer);
+
+    private:
+        virtual void run();
+
+        SessionRenderer& renderer_;
+    };
+
+    void run_worker_();
+    void render_sessions_();
+
+    core::IAllocator& allocator_;
+
+    core::Array<Worker*> workers_;
+
+    core::Mutex mutex_;
+    core::Cond cond_;
+
+    ReceiverSession** sessions_;
+    size_t n_sessions_;
+    size_t size_;
+
+    size_t next_session_;
+    size_t n_pending_;
+
+    size_t generation_;
+    bool stop_;
+
+    bool valid_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_SESSION_RENDERER_H_
@@ -23,6 +23,10 @@ bool match_proto(PortType type, const char* str, PortProtocol& proto) {
             proto = Proto_RTP_RSm8_Source;
         } else if (strcmp(str, "rtp+ldpc") == 0) {
             proto = Proto_RTP_LDPC_Source;
+        } else if (strcmp(str, "rtp+rlc") == 0) {
+            proto = Proto_RTP_RLC_Source;
+        } else if (strcmp(str, "rtp+parity") == 0) {
+            proto = Proto_RTP_Parity_Source;
         } else {
             roc_log(LogError, "parse port: '%s' is not a valid source port protocol",
                     str);
@@ -35,6 +39,10 @@ bool match_proto(PortType type, const char* str, PortProtocol& proto) {
             proto = Proto_RSm8_Repair;
         } else if (strcmp(str, "ldpc") == 0) {
             proto = Proto_LDPC_Repair;
+        } else if (strcmp(str, "rlc") == 0) {
+            proto = Proto_RLC_Repair;
+        } else if (strcmp(str, "parity") == 0) {
+            proto = Proto_Parity_Repair;
         } else {
             roc_log(LogError, "parse port: '%s' is not a valid repair port protocol",
                     str);
@@ -38,6 +38,14 @@ const char* port_proto_to_str(PortProtocol proto) {
         return "rtp+ldpc";
     case Proto_LDPC_Repair:
         return "ldpc";
+    case Proto_RTP_RLC_Source:
+        return "rtp+rlc";
+    case Proto_RLC_Repair:
+        return "rlc";
+    case Proto_RTP_Parity_Source:
+        return "rtp+parity";
+    case Proto_Parity_Repair:
+        return "parity";
     }
     return "?";
 }
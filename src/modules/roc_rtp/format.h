@@ -23,11 +23,23 @@
 namespace roc {
 namespace rtp {
 
+//! RTP payload encoding.
+enum PayloadEncoding {
+    PayloadEncoding_L16,     //!< PCM 16-bit integers.
+    PayloadEncoding_L24,     //!< PCM 24-bit integers.
+    PayloadEncoding_Float32, //!< PCM 32-bit floats.
+    PayloadEncoding_ADPCM,   //!< IMA ADPCM, 4 bits per sample.
+    PayloadEncoding_Lossless //!< Lossless compression of 16-bit samples.
+};
+
 //! RTP payload format.
 struct Format {
     //! Payload type.
     PayloadType payload_type;
 
+    //! Payload encoding.
+    PayloadEncoding encoding;
+
     //! Packet flags.
     unsigned flags;
 
@@ -37,8 +49,11 @@ struct Format {
     //! Channel mask.
     packet::channel_mask_t channel_mask;
 
-    //! Get number of samples for given payload size.
-    size_t (*get_num_samples)(size_t payload_size);
+    //! Get number of samples in given payload.
+    //! @remarks
+    //!  Payloads of fixed-rate encodings aren't inspected, the number of
+    //!  samples is derived from the payload size.
+    size_t (*get_num_samples)(const void* payload, size_t payload_size);
 
     //! Create encoder.
     audio::IFrameEncoder* (*new_encoder)(core::IAllocator& allocator);
@@ -7,6 +7,11 @@
  */
 
 #include "roc_rtp/format_map.h"
+#include "roc_audio/adpcm_decoder.h"
+#include "roc_audio/adpcm_encoder.h"
+#include "roc_audio/ima_adpcm.h"
+#include "roc_audio/lossless_decoder.h"
+#include "roc_audio/lossless_encoder.h"
 #include "roc_audio/pcm_decoder.h"
 #include "roc_audio/pcm_encoder.h"
 #include "roc_audio/pcm_funcs.h"
@@ -17,44 +22,159 @@ namespace rtp {
 
 namespace {
 
-template <class I, class T> I* new_codec_pcm_int16_1ch(core::IAllocator& allocator) {
-    return new (allocator) T(audio::PCM_int16_1ch);
+template <class I, class T, const audio::PCMFuncs& Funcs>
+I* new_codec_pcm(core::IAllocator& allocator) {
+    return new (allocator) T(Funcs);
 }
 
-template <class I, class T> I* new_codec_pcm_int16_2ch(core::IAllocator& allocator) {
-    return new (allocator) T(audio::PCM_int16_2ch);
+template <class I, class T, packet::channel_mask_t ChMask>
+I* new_codec_adpcm(core::IAllocator& allocator) {
+    return new (allocator) T(ChMask);
 }
 
-} // namespace
+template <class I, class T, packet::channel_mask_t ChMask>
+I* new_codec_lossless(core::IAllocator& allocator) {
+    return new (allocator) T(allocator, ChMask);
+}
 
-FormatMap::FormatMap()
-    : n_formats_(0) {
-    {
-        Format fmt;
-        fmt.payload_type = PayloadType_L16_Mono;
-        fmt.flags = packet::Packet::FlagAudio;
-        fmt.sample_rate = 44100;
-        fmt.channel_mask = 0x1;
-        fmt.get_num_samples = audio::PCM_int16_1ch.samples_from_payload_size;
+template <const audio::PCMFuncs& Funcs>
+size_t pcm_num_samples(const void*, size_t payload_size) {
+    return Funcs.samples_from_payload_size(payload_size);
+}
+
+template <size_t NumCh>
+size_t adpcm_num_samples(const void* payload, size_t payload_size) {
+    if (payload_size < NumCh * audio::IMAADPCM_HeaderSize) {
+        return 0;
+    }
+
+    size_t num_samples = audio::ima_adpcm_num_samples(payload_size, NumCh);
+
+    // last nibble is padding, see flags in header of first channel
+    const uint8_t flags = ((const uint8_t*)payload)[audio::IMAADPCM_HeaderSize - 1];
+
+    if (num_samples != 0 && (flags & audio::IMAADPCM_FlagOddPadding)) {
+        num_samples--;
+    }
+
+    return num_samples;
+}
+
+Format base_format(PayloadType pt,
+                   PayloadEncoding encoding,
+                   size_t sample_rate,
+                   packet::channel_mask_t ch_mask) {
+    Format fmt;
+    fmt.payload_type = pt;
+    fmt.encoding = encoding;
+    fmt.flags = packet::Packet::FlagAudio;
+    fmt.sample_rate = sample_rate;
+    fmt.channel_mask = ch_mask;
+    return fmt;
+}
+
+template <PayloadEncoding Enc, const audio::PCMFuncs& Mono, const audio::PCMFuncs& Stereo>
+Format pcm_format(PayloadType pt, size_t sample_rate, packet::channel_mask_t ch_mask) {
+    Format fmt = base_format(pt, Enc, sample_rate, ch_mask);
+    if (ch_mask == 0x1) {
+        fmt.get_num_samples = pcm_num_samples<Mono>;
+        fmt.new_encoder = new_codec_pcm<audio::IFrameEncoder, audio::PCMEncoder, Mono>;
+        fmt.new_decoder = new_codec_pcm<audio::IFrameDecoder, audio::PCMDecoder, Mono>;
+    } else {
+        fmt.get_num_samples = pcm_num_samples<Stereo>;
+        fmt.new_encoder = new_codec_pcm<audio::IFrameEncoder, audio::PCMEncoder, Stereo>;
+        fmt.new_decoder = new_codec_pcm<audio::IFrameDecoder, audio::PCMDecoder, Stereo>;
+    }
+    return fmt;
+}
+
+Format l16_format(PayloadType pt, size_t sample_rate, packet::channel_mask_t ch_mask) {
+    return pcm_format<PayloadEncoding_L16, audio::PCM_int16_1ch, audio::PCM_int16_2ch>(
+        pt, sample_rate, ch_mask);
+}
+
+Format l24_format(PayloadType pt, size_t sample_rate, packet::channel_mask_t ch_mask) {
+    return pcm_format<PayloadEncoding_L24, audio::PCM_int24_1ch, audio::PCM_int24_2ch>(
+        pt, sample_rate, ch_mask);
+}
+
+Format f32_format(PayloadType pt, size_t sample_rate, packet::channel_mask_t ch_mask) {
+    return pcm_format<PayloadEncoding_Float32, audio::PCM_float32_1ch,
+                      audio::PCM_float32_2ch>(pt, sample_rate, ch_mask);
+}
+
+Format adpcm_format(PayloadType pt, size_t sample_rate, packet::channel_mask_t ch_mask) {
+    Format fmt = base_format(pt, PayloadEncoding_ADPCM, sample_rate, ch_mask);
+    if (ch_mask == 0x1) {
+        fmt.get_num_samples = adpcm_num_samples<1>;
+        fmt.new_encoder = new_codec_adpcm<audio::IFrameEncoder, audio::ADPCMEncoder, 0x1>;
+        fmt.new_decoder = new_codec_adpcm<audio::IFrameDecoder, audio::ADPCMDecoder, 0x1>;
+    } else {
+        fmt.get_num_samples = adpcm_num_samples<2>;
+        fmt.new_encoder = new_codec_adpcm<audio::IFrameEncoder, audio::ADPCMEncoder, 0x3>;
+        fmt.new_decoder = new_codec_adpcm<audio::IFrameDecoder, audio::ADPCMDecoder, 0x3>;
+    }
+    return fmt;
+}
+
+Format
+lossless_format(PayloadType pt, size_t sample_rate, packet::channel_mask_t ch_mask) {
+    Format fmt = base_format(pt, PayloadEncoding_Lossless, sample_rate, ch_mask);
+    fmt.get_num_samples = audio::lossless_num_samples;
+    if (ch_mask == 0x1) {
         fmt.new_encoder =
-            new_codec_pcm_int16_1ch<audio::IFrameEncoder, audio::PCMEncoder>;
+            new_codec_lossless<audio::IFrameEncoder, audio::LosslessEncoder, 0x1>;
         fmt.new_decoder =
-            new_codec_pcm_int16_1ch<audio::IFrameDecoder, audio::PCMDecoder>;
-        add_(fmt);
-    }
-    {
-        Format fmt;
-        fmt.payload_type = PayloadType_L16_Stereo;
-        fmt.flags = packet::Packet::FlagAudio;
-        fmt.sample_rate = 44100;
-        fmt.channel_mask = 0x3;
-        fmt.get_num_samples = audio::PCM_int16_2ch.samples_from_payload_size;
+            new_codec_lossless<audio::IFrameDecoder, audio::LosslessDecoder, 0x1>;
+    } else {
         fmt.new_encoder =
-            new_codec_pcm_int16_2ch<audio::IFrameEncoder, audio::PCMEncoder>;
+            new_codec_lossless<audio::IFrameEncoder, audio::LosslessEncoder, 0x3>;
         fmt.new_decoder =
-            new_codec_pcm_int16_2ch<audio::IFrameDecoder, audio::PCMDecoder>;
-        add_(fmt);
+            new_codec_lossless<audio::IFrameDecoder, audio::LosslessDecoder, 0x3>;
     }
+    return fmt;
+}
+
+} // namespace
+
+FormatMap::FormatMap()
+    : n_formats_(0) {
+    // static payload types go first, so that find() prefers them
+    add_(l16_format(PayloadType_L16_Mono, 44100, 0x1));
+    add_(l16_format(PayloadType_L16_Stereo, 44100, 0x3));
+
+    add_(l16_format(PayloadType_L16_Mono_48000, 48000, 0x1));
+    add_(l16_format(PayloadType_L16_Stereo_48000, 48000, 0x3));
+    add_(l16_format(PayloadType_L16_Mono_96000, 96000, 0x1));
+    add_(l16_format(PayloadType_L16_Stereo_96000, 96000, 0x3));
+
+    add_(l24_format(PayloadType_L24_Mono_44100, 44100, 0x1));
+    add_(l24_format(PayloadType_L24_Stereo_44100, 44100, 0x3));
+    add_(l24_format(PayloadType_L24_Mono_48000, 48000, 0x1));
+    add_(l24_format(PayloadType_L24_Stereo_48000, 48000, 0x3));
+    add_(l24_format(PayloadType_L24_Mono_96000, 96000, 0x1));
+    add_(l24_format(PayloadType_L24_Stereo_96000, 96000, 0x3));
+
+    add_(f32_format(PayloadType_F32_Mono_44100, 44100, 0x1));
+    add_(f32_format(PayloadType_F32_Stereo_44100, 44100, 0x3));
+    add_(f32_format(PayloadType_F32_Mono_48000, 48000, 0x1));
+    add_(f32_format(PayloadType_F32_Stereo_48000, 48000, 0x3));
+    add_(f32_format(PayloadType_F32_Mono_96000, 96000, 0x1));
+    add_(f32_format(PayloadType_F32_Stereo_96000, 96000, 0x3));
+
+    add_(adpcm_format(PayloadType_ADPCM_Mono_44100, 44100, 0x1));
+    add_(adpcm_format(PayloadType_ADPCM_Stereo_44100, 44100, 0x3));
+    add_(adpcm_format(PayloadType_ADPCM_Mono_48000, 48000, 0x1));
+    add_(adpcm_format(PayloadType_ADPCM_Stereo_48000, 48000, 0x3));
+    add_(adpcm_format(PayloadType_ADPCM_Mono_96000, 96000, 0x1));
+    add_(adpcm_format(PayloadType_ADPCM_Stereo_96000, 96000, 0x3));
+
+    add_(lossless_format(PayloadType_Lossless_Mono_44100, 44100, 0x1));
+    add_(lossless_format(PayloadType_Lossless_Stereo_44100, 44100, 0x3));
+    add_(lossless_format(PayloadType_Lossless_Mono_48000, 48000, 0x1));
+    add_(lossless_format(PayloadType_Lossless_Stereo_48000, 48000, 0x3));
+    add_(lossless_format(PayloadType_Lossless_Mono_96000, 96000, 0x1));
+    add_(lossless_format(PayloadType_Lossless_Stereo_96000, 96000, 0x3));
 }
 
 const Format* FormatMap::format(unsigned int pt) const {
@@ -67,6 +187,19 @@ const Format* FormatMap::format(unsigned int pt) const {
     return NULL;
 }
 
+const Format* FormatMap::find(PayloadEncoding encoding,
+                              size_t sample_rate,
+                              packet::channel_mask_t channel_mask) const {
+    for (size_t n = 0; n < n_formats_; n++) {
+        if (formats_[n].encoding == encoding && formats_[n].sample_rate == sample_rate
+            && formats_[n].channel_mask == channel_mask) {
+            return &formats_[n];
+        }
+    }
+
+    return NULL;
+}
+
 void FormatMap::add_(const Format& fmt) {
     roc_panic_if(n_formats_ == MaxFormats);
     formats_[n_formats_++] = fmt;
@@ -29,8 +29,16 @@ public:
     //!  registered for this payload type.
     const Format* format(unsigned int pt) const;
 
+    //! Find format by encoding parameters.
+    //! @returns
+    //!  pointer to the format structure or null if there is no format
+    //!  registered for these parameters.
+    const Format* find(PayloadEncoding encoding,
+                       size_t sample_rate,
+                       packet::channel_mask_t channel_mask) const;
+
 private:
-    enum { MaxFormats = 2 };
+    enum { MaxFormats = 32 };
 
     Format formats_[MaxFormats];
     size_t n_formats_;
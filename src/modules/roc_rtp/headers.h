@@ -28,7 +28,41 @@ enum Version {
 //! RTP payload type.
 enum PayloadType {
     PayloadType_L16_Stereo = 10, //!< Audio, 16-bit samples, 2 channels, 44100 Hz.
-    PayloadType_L16_Mono = 11    //!< Audio, 16-bit samples, 1 channel, 44100 Hz.
+    PayloadType_L16_Mono = 11,   //!< Audio, 16-bit samples, 1 channel, 44100 Hz.
+
+    //! @name Dynamic payload types.
+    //! @remarks
+    //!  Not registered by RTP A/V Profile, so both sides should agree on them.
+    // @{
+    PayloadType_L16_Stereo_48000 = 96,       //!< Audio, 16-bit, 2 channels, 48000 Hz.
+    PayloadType_L16_Mono_48000 = 97,         //!< Audio, 16-bit, 1 channel, 48000 Hz.
+    PayloadType_L16_Stereo_96000 = 98,       //!< Audio, 16-bit, 2 channels, 96000 Hz.
+    PayloadType_L16_Mono_96000 = 99,         //!< Audio, 16-bit, 1 channel, 96000 Hz.
+    PayloadType_L24_Stereo_44100 = 100,      //!< Audio, 24-bit, 2 channels, 44100 Hz.
+    PayloadType_L24_Mono_44100 = 101,        //!< Audio, 24-bit, 1 channel, 44100 Hz.
+    PayloadType_L24_Stereo_48000 = 102,      //!< Audio, 24-bit, 2 channels, 48000 Hz.
+    PayloadType_L24_Mono_48000 = 103,        //!< Audio, 24-bit, 1 channel, 48000 Hz.
+    PayloadType_L24_Stereo_96000 = 104,      //!< Audio, 24-bit, 2 channels, 96000 Hz.
+    PayloadType_L24_Mono_96000 = 105,        //!< Audio, 24-bit, 1 channel, 96000 Hz.
+    PayloadType_F32_Stereo_44100 = 106,      //!< Audio, float, 2 channels, 44100 Hz.
+    PayloadType_F32_Mono_44100 = 107,        //!< Audio, float, 1 channel, 44100 Hz.
+    PayloadType_F32_Stereo_48000 = 108,      //!< Audio, float, 2 channels, 48000 Hz.
+    PayloadType_F32_Mono_48000 = 109,        //!< Audio, float, 1 channel, 48000 Hz.
+    PayloadType_F32_Stereo_96000 = 110,      //!< Audio, float, 2 channels, 96000 Hz.
+    PayloadType_F32_Mono_96000 = 111,        //!< Audio, float, 1 channel, 96000 Hz.
+    PayloadType_ADPCM_Stereo_44100 = 112,    //!< Audio, IMA ADPCM, 2 channels, 44100 Hz.
+    PayloadType_ADPCM_Mono_44100 = 113,      //!< Audio, IMA ADPCM, 1 channel, 44100 Hz.
+    PayloadType_ADPCM_Stereo_48000 = 114,    //!< Audio, IMA ADPCM, 2 channels, 48000 Hz.
+    PayloadType_ADPCM_Mono_48000 = 115,      //!< Audio, IMA ADPCM, 1 channel, 48000 Hz.
+    PayloadType_ADPCM_Stereo_96000 = 116,    //!< Audio, IMA ADPCM, 2 channels, 96000 Hz.
+    PayloadType_ADPCM_Mono_96000 = 117,      //!< Audio, IMA ADPCM, 1 channel, 96000 Hz.
+    PayloadType_Lossless_Stereo_44100 = 118, //!< Audio, lossless, 2 channels, 44100 Hz.
+    PayloadType_Lossless_Mono_44100 = 119,   //!< Audio, lossless, 1 channel, 44100 Hz.
+    PayloadType_Lossless_Stereo_48000 = 120, //!< Audio, lossless, 2 channels, 48000 Hz.
+    PayloadType_Lossless_Mono_48000 = 121,   //!< Audio, lossless, 1 channel, 48000 Hz.
+    PayloadType_Lossless_Stereo_96000 = 122, //!< Audio, lossless, 2 channels, 96000 Hz.
+    PayloadType_Lossless_Mono_96000 = 123    //!< Audio, lossless, 1 channel, 96000 Hz.
+    // @}
 };
 
 //! RTP header.
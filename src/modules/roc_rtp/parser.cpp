@@ -106,7 +106,8 @@ bool Parser::parse(packet::Packet& packet, const core::Slice<uint8_t>& buffer) {
 
     if (const Format* format = format_map_.format(header.payload_type())) {
         packet.add_flags(format->flags);
-        rtp.duration = (packet::timestamp_t)format->get_num_samples(rtp.payload.size());
+        rtp.duration = (packet::timestamp_t)format->get_num_samples(
+            rtp.payload.data(), rtp.payload.size());
     }
 
     if (inner_parser_) {
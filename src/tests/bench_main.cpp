@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/crash.h"
+#include "roc_core/log.h"
+
+int main(int argc, char** argv) {
+    roc::core::CrashHandler crash_handler;
+
+    roc::core::Logger::instance().set_level(roc::LogNone);
+
+    benchmark::Initialize(&argc, argv);
+
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+
+    return 0;
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/adpcm_decoder.h"
+#include "roc_audio/adpcm_encoder.h"
+#include "roc_audio/pcm_decoder.h"
+#include "roc_audio/pcm_encoder.h"
+#include "roc_audio/pcm_funcs.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum { PacketSize = 320, MaxChans = 2, MaxFrameSize = PacketSize * MaxChans * 2 };
+
+enum { Codec_PCM, Codec_ADPCM };
+
+void fill_samples(sample_t* samples, size_t n_samples) {
+    for (size_t n = 0; n < n_samples; n++) {
+        samples[n] = (sample_t)(0.5 * std::sin(2 * M_PI * 440.0 / 44100.0 * (double)n));
+    }
+}
+
+IFrameEncoder* new_encoder(int codec, packet::channel_mask_t ch_mask) {
+    if (codec == Codec_ADPCM) {
+        return new ADPCMEncoder(ch_mask);
+    }
+    return new PCMEncoder(ch_mask == 0x1 ? PCM_int16_1ch : PCM_int16_2ch);
+}
+
+IFrameDecoder* new_decoder(int codec, packet::channel_mask_t ch_mask) {
+    if (codec == Codec_ADPCM) {
+        return new ADPCMDecoder(ch_mask);
+    }
+    return new PCMDecoder(ch_mask == 0x1 ? PCM_int16_1ch : PCM_int16_2ch);
+}
+
+// Arguments: codec and channel mask.
+void BM_Codec_Encode(benchmark::State& state) {
+    const packet::channel_mask_t ch_mask = (packet::channel_mask_t)state.range(1);
+    const size_t num_ch = packet::num_channels(ch_mask);
+
+    IFrameEncoder* encoder = new_encoder((int)state.range(0), ch_mask);
+
+    sample_t input[PacketSize * MaxChans];
+    fill_samples(input, PacketSize * num_ch);
+
+    uint8_t frame[MaxFrameSize];
+    const size_t frame_size = encoder->encoded_size(PacketSize);
+
+    while (state.KeepRunning()) {
+        encoder->begin(frame, frame_size);
+        encoder->write(input, PacketSize, ch_mask);
+        encoder->end();
+
+        benchmark::DoNotOptimize(frame);
+    }
+
+    delete encoder;
+
+    // samples per channel
+    state.SetItemsProcessed(state.iterations() * PacketSize * (int64_t)num_ch);
+    state.counters["bytes_per_packet"] = (double)frame_size;
+}
+
+// Arguments: codec and channel mask.
+void BM_Codec_Decode(benchmark::State& state) {
+    const packet::channel_mask_t ch_mask = (packet::channel_mask_t)state.range(1);
+    const size_t num_ch = packet::num_channels(ch_mask);
+
+    IFrameEncoder* encoder = new_encoder((int)state.range(0), ch_mask);
+    IFrameDecoder* decoder = new_decoder((int)state.range(0), ch_mask);
+
+    sample_t input[PacketSize * MaxChans];
+    fill_samples(input, PacketSize * num_ch);
+
+    uint8_t frame[MaxFrameSize];
+    const size_t frame_size = encoder->encoded_size(PacketSize);
+
+    encoder->begin(frame, frame_size);
+    encoder->write(input, PacketSize, ch_mask);
+    encoder->end();
+
+    sample_t output[PacketSize * MaxChans];
+
+    while (state.KeepRunning()) {
+        decoder->begin(0, frame, frame_size);
+        decoder->read(output, PacketSize, ch_mask);
+        decoder->end();
+
+        benchmark::DoNotOptimize(output);
+    }
+
+    delete encoder;
+    delete decoder;
+
+    // samples per channel
+    state.SetItemsProcessed(state.iterations() * PacketSize * (int64_t)num_ch);
+}
+
+BENCHMARK(BM_Codec_Encode)
+    ->Args({ Codec_PCM, 0x1 })
+    ->Args({ Codec_PCM, 0x3 })
+    ->Args({ Codec_ADPCM, 0x1 })
+    ->Args({ Codec_ADPCM, 0x3 });
+
+BENCHMARK(BM_Codec_Decode)
+    ->Args({ Codec_PCM, 0x1 })
+    ->Args({ Codec_PCM, 0x3 })
+    ->Args({ Codec_ADPCM, 0x1 })
+    ->Args({ Codec_ADPCM, 0x3 });
+
+} // namespace
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/lossless_decoder.h"
+#include "roc_audio/lossless_encoder.h"
+#include "roc_audio/pcm_funcs.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/random.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum {
+    SampleRate = 44100,
+    PacketSize = 320,
+    NumPackets = SampleRate / PacketSize,
+    NumCh = 2,
+    ChMask = 0x3,
+    MaxFrameSize = PacketSize * NumCh * 2 + 16
+};
+
+// Synthetic corpus, one second of stereo audio per signal.
+enum { Signal_Tones, Signal_Music, Signal_Speech, Signal_Noise, Signal_Silence };
+
+const char* signal_names[] = { "tones", "music", "speech", "noise", "silence" };
+
+core::HeapAllocator allocator;
+
+double noise(double amplitude) {
+    return amplitude * ((double)core::random(0, 20000) / 10000.0 - 1.0);
+}
+
+void make_signal(sample_t* samples, int signal) {
+    for (size_t n = 0; n < (size_t)NumPackets * PacketSize; n++) {
+        const double t = (double)n / SampleRate;
+
+        for (size_t ch = 0; ch < NumCh; ch++) {
+            double s = 0;
+
+            switch (signal) {
+            case Signal_Tones:
+                s = 0.5 * std::sin(2 * M_PI * (ch == 0 ? 440.0 : 1000.0) * t);
+                break;
+
+            case Signal_Music:
+                // chord with harmonics, slow envelope, and -60 dB noise floor
+                for (size_t h = 1; h <= 6; h++) {
+                    s += 0.1 / (double)h
+                        * (std::sin(2 * M_PI * 220.0 * (double)h * t)
+                           + std::sin(2 * M_PI * 277.2 * (double)h * t + (double)ch)
+                           + std::sin(2 * M_PI * 329.6 * (double)h * t));
+                }
+                s *= 0.6 + 0.4 * std::sin(2 * M_PI * 0.5 * t);
+                s += noise(0.001);
+                break;
+
+            case Signal_Speech:
+                // formant-like tones modulated by syllable-rate envelope
+                s = (0.3 * std::sin(2 * M_PI * 150.0 * t)
+                     + 0.15 * std::sin(2 * M_PI * 700.0 * t)
+                     + 0.08 * std::sin(2 * M_PI * 2400.0 * t))
+                    * std::max(0.0, std::sin(2 * M_PI * 4.0 * t));
+                s += noise(0.0005);
+                break;
+
+            case Signal_Noise:
+                s = noise(0.1);
+                break;
+
+            case Signal_Silence:
+                // 1 LSB dither
+                s = noise(1.0 / 32768);
+                break;
+            }
+
+            samples[n * NumCh + ch] = (sample_t)s;
+        }
+    }
+}
+
+struct Corpus {
+    sample_t samples[NumPackets * PacketSize * NumCh];
+    uint8_t frames[NumPackets][MaxFrameSize];
+    size_t frame_sizes[NumPackets];
+    size_t total_size;
+};
+
+Corpus corpus;
+
+void encode_corpus(LosslessEncoder& encoder) {
+    corpus.total_size = 0;
+
+    for (size_t p = 0; p < NumPackets; p++) {
+        encoder.begin(corpus.frames[p], encoder.encoded_size(PacketSize));
+        encoder.write(corpus.samples + p * PacketSize * NumCh, PacketSize, ChMask);
+        corpus.frame_sizes[p] = encoder.end();
+        corpus.total_size += corpus.frame_sizes[p];
+    }
+}
+
+void set_counters(benchmark::State& state) {
+    const double pcm_size =
+        (double)PCM_int16_2ch.payload_size_from_samples(PacketSize) * NumPackets;
+
+    state.counters["ratio"] = pcm_size / (double)corpus.total_size;
+    state.counters["bytes_per_packet"] = (double)corpus.total_size / NumPackets;
+
+    state.SetLabel(signal_names[state.range(0)]);
+}
+
+// Arguments: signal.
+void BM_Lossless_Encode(benchmark::State& state) {
+    make_signal(corpus.samples, (int)state.range(0));
+
+    LosslessEncoder encoder(allocator, ChMask);
+
+    while (state.KeepRunning()) {
+        encode_corpus(encoder);
+        benchmark::DoNotOptimize(corpus.frames);
+    }
+
+    // samples per channel
+    state.SetItemsProcessed(state.iterations() * NumPackets * PacketSize * NumCh);
+    set_counters(state);
+}
+
+// Arguments: signal.
+void BM_Lossless_Decode(benchmark::State& state) {
+    make_signal(corpus.samples, (int)state.range(0));
+
+    LosslessEncoder encoder(allocator, ChMask);
+    LosslessDecoder decoder(allocator, ChMask);
+
+    encode_corpus(encoder);
+
+    sample_t output[PacketSize * NumCh];
+
+    while (state.KeepRunning()) {
+        for (size_t p = 0; p < NumPackets; p++) {
+            decoder.begin(0, corpus.frames[p], corpus.frame_sizes[p]);
+            decoder.read(output, PacketSize, ChMask);
+            decoder.end();
+
+            benchmark::DoNotOptimize(output);
+        }
+    }
+
+    // samples per channel
+    state.SetItemsProcessed(state.iterations() * NumPackets * PacketSize * NumCh);
+    set_counters(state);
+}
+
+BENCHMARK(BM_Lossless_Encode)->DenseRange(Signal_Tones, Signal_Silence);
+BENCHMARK(BM_Lossless_Decode)->DenseRange(Signal_Tones, Signal_Silence);
+
+} // namespace
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/mixer.h"
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum { FrameSize = 512, MaxReaders = 256 };
+
+core::HeapAllocator allocator;
+core::BufferPool<sample_t> buffer_pool(allocator, FrameSize, true);
+
+// Reader that returns either blank frame or frame with data, like depacketizer
+// does when session has or has no packets.
+class BenchReader : public IReader {
+public:
+    BenchReader()
+        : active_(false) {
+    }
+
+    void set_active(bool active) {
+        active_ = active;
+    }
+
+    virtual void read(Frame& frame) {
+        if (active_) {
+            for (size_t n = 0; n < frame.size(); n++) {
+                frame.data()[n] = (sample_t)(n % 100) / 1000.0f;
+            }
+        } else {
+            memset(frame.data(), 0, frame.size() * sizeof(sample_t));
+            frame.set_flags(Frame::FlagBlank);
+        }
+    }
+
+private:
+    bool active_;
+};
+
+// Arguments: number of readers and number of active readers.
+void BM_Mixer(benchmark::State& state) {
+    const size_t n_readers = (size_t)state.range(0);
+    const size_t n_active = (size_t)state.range(1);
+
+    static BenchReader readers[MaxReaders];
+
+    Mixer mixer(buffer_pool, FrameSize, true);
+    if (!mixer.valid()) {
+        state.SkipWithError("can't create mixer");
+        return;
+    }
+
+    for (size_t n = 0; n < n_readers; n++) {
+        readers[n].set_active(n < n_active);
+        mixer.add(readers[n]);
+    }
+
+    sample_t output[FrameSize];
+
+    while (state.KeepRunning()) {
+        Frame frame(output, FrameSize);
+        mixer.read(frame);
+
+        benchmark::DoNotOptimize(output);
+    }
+
+    for (size_t n = 0; n < n_readers; n++) {
+        mixer.remove(readers[n]);
+    }
+
+    state.SetItemsProcessed(state.iterations() * FrameSize);
+}
+
+BENCHMARK(BM_Mixer)
+    ->Args({ 2, 2 })
+    ->Args({ 8, 8 })
+    ->Args({ 128, 128 })
+    ->Args({ 128, 4 })
+    ->Args({ 128, 0 });
+
+} // namespace
+
+} // namespace audio
+} // namespace roc
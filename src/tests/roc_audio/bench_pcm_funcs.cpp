@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/pcm_funcs.h"
+#include "roc_audio/pcm_kernel.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum { NumCh = 2, ChMask = 0x3, SubsetChMask = 0x1, PacketSize = 320 };
+
+void fill_samples(sample_t* samples, size_t n_samples) {
+    for (size_t n = 0; n < n_samples; n++) {
+        samples[n] = (sample_t)(n % 100) / 50.0f - 1.0f;
+    }
+}
+
+// Argument: channel mask of the stream.
+void BM_PCM_Encode(benchmark::State& state) {
+    const packet::channel_mask_t ch_mask = (packet::channel_mask_t)state.range(0);
+
+    sample_t input[PacketSize * NumCh];
+    fill_samples(input, PacketSize * NumCh);
+
+    int16_t payload[PacketSize * NumCh];
+
+    while (state.KeepRunning()) {
+        PCM_int16_2ch.encode_samples(payload, sizeof(payload), 0, input, PacketSize,
+                                     ch_mask);
+        benchmark::DoNotOptimize(payload);
+    }
+
+    state.SetItemsProcessed(state.iterations() * PacketSize);
+}
+
+// Argument: channel mask of the stream.
+void BM_PCM_Decode(benchmark::State& state) {
+    const packet::channel_mask_t ch_mask = (packet::channel_mask_t)state.range(0);
+
+    sample_t input[PacketSize * NumCh];
+    fill_samples(input, PacketSize * NumCh);
+
+    int16_t payload[PacketSize * NumCh];
+    PCM_int16_2ch.encode_samples(payload, sizeof(payload), 0, input, PacketSize,
+                                 ChMask);
+
+    sample_t output[PacketSize * NumCh];
+
+    while (state.KeepRunning()) {
+        PCM_int16_2ch.decode_samples(payload, sizeof(payload), 0, output, PacketSize,
+                                     ch_mask);
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetItemsProcessed(state.iterations() * PacketSize);
+}
+
+// Argument: PCM kernel.
+void BM_PCMKernel_Encode(benchmark::State& state) {
+    const PCMKernel* kernel = pcm_kernel((PCMKernelType)state.range(0));
+    if (!kernel) {
+        state.SkipWithError("kernel is not supported by cpu");
+        return;
+    }
+
+    sample_t input[PacketSize * NumCh];
+    fill_samples(input, PacketSize * NumCh);
+
+    int16_t payload[PacketSize * NumCh];
+
+    while (state.KeepRunning()) {
+        kernel->encode_int16(payload, input, PacketSize * NumCh);
+        benchmark::DoNotOptimize(payload);
+    }
+
+    state.SetItemsProcessed(state.iterations() * PacketSize);
+    state.SetLabel(kernel->name);
+}
+
+// Argument: PCM kernel.
+void BM_PCMKernel_Decode(benchmark::State& state) {
+    const PCMKernel* kernel = pcm_kernel((PCMKernelType)state.range(0));
+    if (!kernel) {
+        state.SkipWithError("kernel is not supported by cpu");
+        return;
+    }
+
+    sample_t input[PacketSize * NumCh];
+    fill_samples(input, PacketSize * NumCh);
+
+    int16_t payload[PacketSize * NumCh];
+    kernel->encode_int16(payload, input, PacketSize * NumCh);
+
+    sample_t output[PacketSize * NumCh];
+
+    while (state.KeepRunning()) {
+        kernel->decode_int16(output, payload, PacketSize * NumCh);
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetItemsProcessed(state.iterations() * PacketSize);
+    state.SetLabel(kernel->name);
+}
+
+BENCHMARK(BM_PCM_Encode)->Arg(ChMask)->Arg(SubsetChMask);
+BENCHMARK(BM_PCM_Decode)->Arg(ChMask)->Arg(SubsetChMask);
+
+BENCHMARK(BM_PCMKernel_Encode)
+    ->Arg(PCMKernel_Generic)
+    ->Arg(PCMKernel_SSE2)
+    ->Arg(PCMKernel_AVX2);
+BENCHMARK(BM_PCMKernel_Decode)
+    ->Arg(PCMKernel_Generic)
+    ->Arg(PCMKernel_SSE2)
+    ->Arg(PCMKernel_AVX2);
+
+} // namespace
+
+} // namespace audio
+} // namespace roc
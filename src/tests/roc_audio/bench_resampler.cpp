@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/iresampler.h"
+#include "roc_audio/polynomial_resampler.h"
+#include "roc_audio/polyphase_resampler.h"
+#include "roc_audio/resampler.h"
+#include "roc_audio/resampler_kernel.h"
+#include "roc_audio/resampler_profile.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/helpers.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum { ChMask = 0x3, NumCh = 2, FrameSize = 512 };
+
+const float scalings[] = {
+    // 48000 Hz to 44100 Hz.
+    160.0f / 147.0f,
+    // Clock drift correction.
+    1.005f,
+};
+
+core::HeapAllocator allocator;
+
+// Solve 3x3 linear system using Cramer's rule.
+void solve3(const double m[3][3], const double v[3], double x[3]) {
+    const double det = m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
+        - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+        + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+
+    for (size_t i = 0; i < 3; i++) {
+        double mi[3][3];
+        for (size_t r = 0; r < 3; r++) {
+            for (size_t c = 0; c < 3; c++) {
+                mi[r][c] = c == i ? v[r] : m[r][c];
+            }
+        }
+        x[i] = (mi[0][0] * (mi[1][1] * mi[2][2] - mi[1][2] * mi[2][1])
+                - mi[0][1] * (mi[1][0] * mi[2][2] - mi[1][2] * mi[2][0])
+                + mi[0][2] * (mi[1][0] * mi[2][1] - mi[1][1] * mi[2][0]))
+            / det;
+    }
+}
+
+// Resamples sine wave and returns THD+N of the output in dB, i.e. ratio of
+// power of everything except the fundamental to power of the fundamental.
+// The fundamental is found by least squares fit of sine, cosine, and DC.
+double measure_thdn(IResampler& resampler, float scaling) {
+    enum { NumFrames = 64, SkipFrames = 4, FrameSizeCh = FrameSize / NumCh };
+
+    // 997 Hz at 48000 Hz, in cycles per input sample.
+    const double in_freq = 997.0 / 48000.0;
+    const double out_freq = in_freq * (double)scaling;
+
+    static double signal[(NumFrames - SkipFrames) * FrameSizeCh];
+    size_t signal_size = 0;
+
+    sample_t input[FrameSize];
+    sample_t output[FrameSize];
+    size_t in_pos = 0;
+
+    for (size_t f = 0; f < NumFrames; f++) {
+        Frame frame(output, FrameSize);
+
+        while (!resampler.resample_buff(frame)) {
+            for (size_t n = 0; n < FrameSizeCh; n++) {
+                const double s = 0.5 * std::sin(2 * M_PI * in_freq * double(in_pos + n));
+                for (size_t ch = 0; ch < NumCh; ch++) {
+                    input[n * NumCh + ch] = (sample_t)s;
+                }
+            }
+            in_pos += FrameSizeCh;
+
+            resampler.push_input(input, FrameSize);
+        }
+
+        if (f >= SkipFrames) {
+            for (size_t n = 0; n < FrameSizeCh; n++) {
+                signal[signal_size++] = output[n * NumCh];
+            }
+        }
+    }
+
+    double m[3][3] = {};
+    double v[3] = {};
+
+    for (size_t n = 0; n < signal_size; n++) {
+        const double b[3] = { std::sin(2 * M_PI * out_freq * double(n)),
+                              std::cos(2 * M_PI * out_freq * double(n)), 1 };
+        for (size_t r = 0; r < 3; r++) {
+            for (size_t c = 0; c < 3; c++) {
+                m[r][c] += b[r] * b[c];
+            }
+            v[r] += b[r] * signal[n];
+        }
+    }
+
+    double x[3];
+    solve3(m, v, x);
+
+    double fundamental_power = 0;
+    double residual_power = 0;
+
+    for (size_t n = 0; n < signal_size; n++) {
+        const double fundamental = x[0] * std::sin(2 * M_PI * out_freq * double(n))
+            + x[1] * std::cos(2 * M_PI * out_freq * double(n));
+        const double residual = signal[n] - fundamental - x[2];
+
+        fundamental_power += fundamental * fundamental;
+        residual_power += residual * residual;
+    }
+
+    return 10 * std::log10(residual_power / fundamental_power);
+}
+
+void run_resampler(benchmark::State& state, IResampler& resampler, float scaling) {
+    state.counters["thdn_db"] = measure_thdn(resampler, scaling);
+
+    sample_t input[FrameSize];
+    for (size_t n = 0; n < FrameSize; n++) {
+        input[n] = (sample_t)(n % 100) / 100.0f - 0.5f;
+    }
+
+    sample_t output[FrameSize];
+
+    while (state.KeepRunning()) {
+        Frame frame(output, FrameSize);
+
+        while (!resampler.resample_buff(frame)) {
+            resampler.push_input(input, FrameSize);
+        }
+
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetItemsProcessed(state.iterations() * (FrameSize / NumCh));
+}
+
+// Arguments: resampler profile, resampler kernel, and scaling index.
+void BM_Resampler(benchmark::State& state) {
+    ResamplerConfig config = resampler_profile((ResamplerProfile)state.range(0));
+    config.kernel = (ResamplerKernelType)state.range(1);
+
+    const float scaling = scalings[state.range(2)];
+
+    const ResamplerKernel* kernel = resampler_kernel(config.kernel);
+    if (!kernel) {
+        state.SkipWithError("kernel is not supported by cpu");
+        return;
+    }
+
+    Resampler resampler(allocator, config, ChMask, FrameSize);
+    if (!resampler.valid() || !resampler.set_scaling(scaling)) {
+        state.SkipWithError("can't create resampler");
+        return;
+    }
+
+    run_resampler(state, resampler, scaling);
+
+    state.SetLabel(kernel->name);
+}
+
+// Arguments: resampler profile, resampler kernel, and scaling index.
+void BM_PolyphaseResampler(benchmark::State& state) {
+    ResamplerConfig config = resampler_profile((ResamplerProfile)state.range(0));
+    config.kernel = (ResamplerKernelType)state.range(1);
+
+    const float scaling = scalings[state.range(2)];
+
+    const ResamplerKernel* kernel = resampler_kernel(config.kernel);
+    if (!kernel) {
+        state.SkipWithError("kernel is not supported by cpu");
+        return;
+    }
+
+    PolyphaseResampler resampler(allocator, config, ChMask, FrameSize);
+    if (!resampler.valid() || !resampler.set_scaling(scaling)) {
+        state.SkipWithError("can't create resampler");
+        return;
+    }
+
+    run_resampler(state, resampler, scaling);
+
+    state.SetLabel(kernel->name);
+}
+
+// Arguments: resampler profile and scaling index.
+void BM_PolynomialResampler(benchmark::State& state) {
+    const ResamplerConfig config =
+        resampler_profile((ResamplerProfile)state.range(0));
+
+    const float scaling = scalings[state.range(1)];
+
+    PolynomialResampler resampler(allocator, config, ChMask, FrameSize);
+    if (!resampler.valid() || !resampler.set_scaling(scaling)) {
+        state.SkipWithError("can't create resampler");
+        return;
+    }
+
+    run_resampler(state, resampler, scaling);
+
+    state.SetLabel(config.method == ResamplerMethod_Cubic ? "cubic" : "linear");
+}
+
+void sinc_resampler_args(benchmark::internal::Benchmark* b) {
+    const ResamplerProfile profiles[] = {
+        ResamplerProfile_Low,
+        ResamplerProfile_Medium,
+        ResamplerProfile_High,
+    };
+
+    const ResamplerKernelType kernels[] = {
+        ResamplerKernel_Generic,
+        ResamplerKernel_SSE2,
+        ResamplerKernel_AVX2,
+        ResamplerKernel_AVX512,
+    };
+
+    for (size_t s = 0; s < ROC_ARRAY_SIZE(scalings); s++) {
+        for (size_t p = 0; p < ROC_ARRAY_SIZE(profiles); p++) {
+            for (size_t k = 0; k < ROC_ARRAY_SIZE(kernels); k++) {
+                b->Args({ profiles[p], kernels[k], (int)s });
+            }
+        }
+    }
+}
+
+void polynomial_resampler_args(benchmark::internal::Benchmark* b) {
+    const ResamplerProfile profiles[] = {
+        ResamplerProfile_Cubic,
+        ResamplerProfile_Linear,
+    };
+
+    for (size_t s = 0; s < ROC_ARRAY_SIZE(scalings); s++) {
+        for (size_t p = 0; p < ROC_ARRAY_SIZE(profiles); p++) {
+            b->Args({ profiles[p], (int)s });
+        }
+    }
+}
+
+BENCHMARK(BM_Resampler)->Apply(sinc_resampler_args);
+BENCHMARK(BM_PolyphaseResampler)->Apply(sinc_resampler_args);
+BENCHMARK(BM_PolynomialResampler)->Apply(polynomial_resampler_args);
+
+} // namespace
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/adpcm_decoder.h"
+#include "roc_audio/adpcm_encoder.h"
+#include "roc_audio/pcm_encoder.h"
+#include "roc_audio/pcm_funcs.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum {
+    NumFrames = 20,
+    SamplesPerFrame = 177,
+    MaxChans = 2,
+    MaxFrameSize = 1024,
+    TotalSamples = NumFrames * SamplesPerFrame
+};
+
+const double MinSNR = 30;
+
+// Two channels with different tones.
+void make_signal(sample_t* samples, size_t n_samples, packet::channel_mask_t ch_mask) {
+    const size_t num_ch = packet::num_channels(ch_mask);
+
+    for (size_t n = 0; n < n_samples; n++) {
+        for (size_t ch = 0; ch < num_ch; ch++) {
+            const double freq = (ch == 0 ? 440.0 : 1000.0) / 44100.0;
+            samples[n * num_ch + ch] =
+                (sample_t)(0.5 * std::sin(2 * M_PI * freq * (double)n));
+        }
+    }
+}
+
+double snr_db(const sample_t* expected, const sample_t* actual, size_t n_samples) {
+    double signal_power = 0;
+    double noise_power = 0;
+
+    for (size_t n = 0; n < n_samples; n++) {
+        signal_power += (double)expected[n] * (double)expected[n];
+        noise_power += ((double)expected[n] - (double)actual[n])
+            * ((double)expected[n] - (double)actual[n]);
+    }
+
+    return 10 * std::log10(signal_power / noise_power);
+}
+
+} // namespace
+
+TEST_GROUP(adpcm) {
+    packet::channel_mask_t ch_mask;
+    size_t num_ch;
+
+    sample_t input[TotalSamples * MaxChans];
+
+    uint8_t frames[NumFrames][MaxFrameSize];
+    size_t frame_sizes[NumFrames];
+
+    void setup() {
+        use(0x3);
+    }
+
+    void use(packet::channel_mask_t mask) {
+        ch_mask = mask;
+        num_ch = packet::num_channels(mask);
+        make_signal(input, TotalSamples, ch_mask);
+    }
+
+    void encode_all() {
+        ADPCMEncoder encoder(ch_mask);
+
+        for (size_t f = 0; f < NumFrames; f++) {
+            frame_sizes[f] = encoder.encoded_size(SamplesPerFrame);
+            CHECK(frame_sizes[f] <= MaxFrameSize);
+
+            encoder.begin(frames[f], frame_sizes[f]);
+            UNSIGNED_LONGS_EQUAL(SamplesPerFrame,
+                                 encoder.write(input + f * SamplesPerFrame * num_ch,
+                                               SamplesPerFrame, ch_mask));
+            encoder.end();
+        }
+    }
+
+    void decode_frame(ADPCMDecoder & decoder, size_t f, sample_t * output) {
+        decoder.begin(packet::timestamp_t(f * SamplesPerFrame), frames[f],
+                      frame_sizes[f]);
+
+        UNSIGNED_LONGS_EQUAL(SamplesPerFrame, decoder.available());
+        UNSIGNED_LONGS_EQUAL(SamplesPerFrame,
+                             decoder.read(output, SamplesPerFrame, ch_mask));
+        UNSIGNED_LONGS_EQUAL(0, decoder.available());
+
+        decoder.end();
+    }
+};
+
+TEST(adpcm, encoded_size) {
+    enum { NumSamples = 320 };
+
+    ADPCMEncoder adpcm_encoder(0x3);
+    PCMEncoder pcm_encoder(PCM_int16_2ch);
+
+    const size_t header_size = 2 * IMAADPCM_HeaderSize;
+
+    UNSIGNED_LONGS_EQUAL(header_size, adpcm_encoder.encoded_size(0));
+    UNSIGNED_LONGS_EQUAL(pcm_encoder.encoded_size(NumSamples) / 4,
+                         adpcm_encoder.encoded_size(NumSamples) - header_size);
+}
+
+TEST(adpcm, encode_decode) {
+    const packet::channel_mask_t masks[] = { 0x1, 0x3 };
+
+    for (size_t m = 0; m < ROC_ARRAY_SIZE(masks); m++) {
+        use(masks[m]);
+        encode_all();
+
+        ADPCMDecoder decoder(ch_mask);
+
+        sample_t output[TotalSamples * MaxChans];
+
+        for (size_t f = 0; f < NumFrames; f++) {
+            decode_frame(decoder, f, output + f * SamplesPerFrame * num_ch);
+            UNSIGNED_LONGS_EQUAL((f + 1) * SamplesPerFrame, decoder.position());
+        }
+
+        CHECK(snr_db(input, output, TotalSamples * num_ch) > MinSNR);
+    }
+}
+
+TEST(adpcm, frames_are_independent) {
+    encode_all();
+
+    sample_t expected[TotalSamples * MaxChans];
+    {
+        ADPCMDecoder decoder(ch_mask);
+        for (size_t f = 0; f < NumFrames; f++) {
+            decode_frame(decoder, f, expected + f * SamplesPerFrame * num_ch);
+        }
+    }
+
+    // decode frames in reverse order, skipping every third frame
+    ADPCMDecoder decoder(ch_mask);
+
+    for (size_t f = NumFrames; f > 0; f--) {
+        if (f % 3 == 0) {
+            continue;
+        }
+
+        sample_t actual[SamplesPerFrame * MaxChans];
+        decode_frame(decoder, f - 1, actual);
+
+        for (size_t n = 0; n < SamplesPerFrame * num_ch; n++) {
+            DOUBLES_EQUAL(expected[(f - 1) * SamplesPerFrame * num_ch + n], actual[n],
+                          0);
+        }
+    }
+}
+
+TEST(adpcm, write_incrementally) {
+    encode_all();
+
+    ADPCMEncoder encoder(ch_mask);
+
+    for (size_t f = 0; f < NumFrames; f++) {
+        uint8_t frame[MaxFrameSize];
+        encoder.begin(frame, frame_sizes[f]);
+
+        size_t pos = 0;
+        while (pos < SamplesPerFrame) {
+            size_t n = std::min((size_t)(pos % 7 + 1), (size_t)SamplesPerFrame - pos);
+            UNSIGNED_LONGS_EQUAL(
+                n,
+                encoder.write(input + (f * SamplesPerFrame + pos) * num_ch, n, ch_mask));
+            pos += n;
+        }
+
+        encoder.end();
+
+        for (size_t n = 0; n < frame_sizes[f]; n++) {
+            UNSIGNED_LONGS_EQUAL(frames[f][n], frame[n]);
+        }
+    }
+}
+
+TEST(adpcm, shift) {
+    enum { Shift = 55 };
+
+    encode_all();
+
+    ADPCMDecoder decoder(ch_mask);
+
+    for (size_t f = 0; f < NumFrames; f++) {
+        sample_t expected[SamplesPerFrame * MaxChans];
+        decode_frame(decoder, f, expected);
+
+        decoder.begin(0, frames[f], frame_sizes[f]);
+
+        UNSIGNED_LONGS_EQUAL(Shift, decoder.shift(Shift));
+        UNSIGNED_LONGS_EQUAL(Shift, decoder.position());
+        UNSIGNED_LONGS_EQUAL(SamplesPerFrame - Shift, decoder.available());
+
+        sample_t actual[SamplesPerFrame * MaxChans];
+        UNSIGNED_LONGS_EQUAL(SamplesPerFrame - Shift,
+                             decoder.read(actual, SamplesPerFrame, ch_mask));
+
+        decoder.end();
+
+        for (size_t n = 0; n < (SamplesPerFrame - Shift) * num_ch; n++) {
+            DOUBLES_EQUAL(expected[Shift * num_ch + n], actual[n], 0);
+        }
+    }
+}
+
+TEST(adpcm, odd_samples_mono) {
+    use(0x1);
+
+    ADPCMEncoder encoder(ch_mask);
+    ADPCMDecoder decoder(ch_mask);
+
+    for (size_t n_samples = 1; n_samples < 10; n_samples++) {
+        uint8_t frame[MaxFrameSize];
+
+        const size_t frame_size = encoder.encoded_size(n_samples);
+        encoder.begin(frame, frame_size);
+        UNSIGNED_LONGS_EQUAL(n_samples, encoder.write(input, n_samples, ch_mask));
+        encoder.end();
+
+        decoder.begin(0, frame, frame_size);
+        UNSIGNED_LONGS_EQUAL(n_samples, decoder.available());
+        decoder.end();
+    }
+}
+
+TEST(adpcm, incomplete_frame) {
+    enum { ExpectedSamples = SamplesPerFrame, ActualSamples = 100 };
+
+    ADPCMEncoder encoder(ch_mask);
+    ADPCMDecoder decoder(ch_mask);
+
+    uint8_t frame[MaxFrameSize];
+
+    encoder.begin(frame, encoder.encoded_size(ExpectedSamples));
+    UNSIGNED_LONGS_EQUAL(ActualSamples, encoder.write(input, ActualSamples, ch_mask));
+    encoder.end();
+
+    decoder.begin(0, frame, encoder.encoded_size(ActualSamples));
+    UNSIGNED_LONGS_EQUAL(ActualSamples, decoder.available());
+
+    sample_t output[ExpectedSamples * MaxChans];
+    UNSIGNED_LONGS_EQUAL(ActualSamples, decoder.read(output, ExpectedSamples, ch_mask));
+
+    decoder.end();
+}
+
+TEST(adpcm, write_too_much) {
+    ADPCMEncoder encoder(ch_mask);
+
+    uint8_t frame[MaxFrameSize];
+
+    encoder.begin(frame, encoder.encoded_size(SamplesPerFrame));
+    UNSIGNED_LONGS_EQUAL(SamplesPerFrame,
+                         encoder.write(input, SamplesPerFrame + 20, ch_mask));
+    UNSIGNED_LONGS_EQUAL(0, encoder.write(input, 1, ch_mask));
+    encoder.end();
+}
+
+TEST(adpcm, frame_smaller_than_header) {
+    ADPCMEncoder encoder(ch_mask);
+    ADPCMDecoder decoder(ch_mask);
+
+    uint8_t frame[MaxFrameSize];
+
+    encoder.begin(frame, IMAADPCM_HeaderSize);
+    UNSIGNED_LONGS_EQUAL(0, encoder.write(input, SamplesPerFrame, ch_mask));
+    encoder.end();
+
+    decoder.begin(0, frame, IMAADPCM_HeaderSize);
+    UNSIGNED_LONGS_EQUAL(0, decoder.available());
+    decoder.end();
+}
+
+TEST(adpcm, channel_mask) {
+    encode_all();
+
+    ADPCMDecoder decoder(ch_mask);
+
+    sample_t expected[SamplesPerFrame * MaxChans];
+    decode_frame(decoder, 0, expected);
+
+    // read only left channel
+    sample_t left[SamplesPerFrame];
+
+    decoder.begin(0, frames[0], frame_sizes[0]);
+    UNSIGNED_LONGS_EQUAL(SamplesPerFrame, decoder.read(left, SamplesPerFrame, 0x1));
+    decoder.end();
+
+    for (size_t n = 0; n < SamplesPerFrame; n++) {
+        DOUBLES_EQUAL(expected[n * 2], left[n], 0);
+    }
+
+    // write only left channel, right channel is encoded as silence
+    ADPCMEncoder encoder(0x3);
+
+    sample_t mono[SamplesPerFrame];
+    make_signal(mono, SamplesPerFrame, 0x1);
+
+    uint8_t frame[MaxFrameSize];
+    const size_t frame_size = encoder.encoded_size(SamplesPerFrame);
+
+    encoder.begin(frame, frame_size);
+    UNSIGNED_LONGS_EQUAL(SamplesPerFrame, encoder.write(mono, SamplesPerFrame, 0x1));
+    encoder.end();
+
+    sample_t stereo[SamplesPerFrame * 2];
+
+    decoder.begin(0, frame, frame_size);
+    UNSIGNED_LONGS_EQUAL(SamplesPerFrame, decoder.read(stereo, SamplesPerFrame, 0x3));
+    decoder.end();
+
+    for (size_t n = 0; n < SamplesPerFrame; n++) {
+        DOUBLES_EQUAL(0.0, stereo[n * 2 + 1], 0);
+    }
+}
+
+} // namespace audio
+} // namespace roc
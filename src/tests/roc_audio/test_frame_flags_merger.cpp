@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/frame_flags_merger.h"
+
+namespace roc {
+namespace audio {
+
+TEST_GROUP(frame_flags_merger) {};
+
+TEST(frame_flags_merger, empty) {
+    FrameFlagsMerger merger;
+
+    UNSIGNED_LONGS_EQUAL(0, merger.flags());
+}
+
+TEST(frame_flags_merger, all_data) {
+    FrameFlagsMerger merger;
+
+    merger.add(0);
+    merger.add(Frame::FlagDrops);
+    merger.add(0);
+
+    UNSIGNED_LONGS_EQUAL(Frame::FlagDrops, merger.flags());
+}
+
+TEST(frame_flags_merger, all_blank) {
+    FrameFlagsMerger merger;
+
+    merger.add(Frame::FlagBlank);
+    merger.add(Frame::FlagBlank | Frame::FlagDrops);
+
+    UNSIGNED_LONGS_EQUAL(Frame::FlagBlank | Frame::FlagDrops, merger.flags());
+}
+
+TEST(frame_flags_merger, some_blank) {
+    FrameFlagsMerger merger;
+
+    merger.add(Frame::FlagBlank);
+    merger.add(0);
+    merger.add(Frame::FlagBlank);
+
+    UNSIGNED_LONGS_EQUAL(Frame::FlagIncomplete, merger.flags());
+}
+
+TEST(frame_flags_merger, incomplete) {
+    FrameFlagsMerger merger;
+
+    merger.add(0);
+    merger.add(Frame::FlagIncomplete);
+
+    UNSIGNED_LONGS_EQUAL(Frame::FlagIncomplete, merger.flags());
+}
+
+} // namespace audio
+} // namespace roc
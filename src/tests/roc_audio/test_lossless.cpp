@@ -0,0 +1,424 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/lossless_decoder.h"
+#include "roc_audio/lossless_encoder.h"
+#include "roc_audio/pcm_decoder.h"
+#include "roc_audio/pcm_encoder.h"
+#include "roc_audio/pcm_funcs.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/random.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum {
+    NumFrames = 20,
+    SamplesPerFrame = 177,
+    MaxChans = 2,
+    MaxFrameSize = SamplesPerFrame * MaxChans * 2 + 16,
+    TotalSamples = NumFrames * SamplesPerFrame
+};
+
+core::HeapAllocator allocator;
+
+// Two channels with different tones and some noise.
+void make_signal(sample_t* samples, size_t n_samples, size_t num_ch) {
+    for (size_t n = 0; n < n_samples; n++) {
+        for (size_t ch = 0; ch < num_ch; ch++) {
+            const double freq = (ch == 0 ? 440.0 : 1000.0) / 44100.0;
+            const double noise = (double)core::random(0, 64) / 32768.0;
+            samples[n * num_ch + ch] =
+                (sample_t)(0.5 * std::sin(2 * M_PI * freq * (double)n) + noise);
+        }
+    }
+}
+
+// Round trip through L16 encoder and decoder.
+void make_reference(sample_t* output,
+                    const sample_t* input,
+                    size_t n_samples,
+                    packet::channel_mask_t ch_mask) {
+    const PCMFuncs& funcs = ch_mask == 0x1 ? PCM_int16_1ch : PCM_int16_2ch;
+
+    PCMEncoder encoder(funcs);
+    PCMDecoder decoder(funcs);
+
+    uint8_t frame[TotalSamples * MaxChans * 2];
+
+    const size_t frame_size = encoder.encoded_size(n_samples);
+    CHECK(frame_size <= sizeof(frame));
+
+    encoder.begin(frame, frame_size);
+    UNSIGNED_LONGS_EQUAL(n_samples, encoder.write(input, n_samples, ch_mask));
+    encoder.end();
+
+    decoder.begin(0, frame, frame_size);
+    UNSIGNED_LONGS_EQUAL(n_samples, decoder.read(output, n_samples, ch_mask));
+    decoder.end();
+}
+
+} // namespace
+
+TEST_GROUP(lossless) {
+    packet::channel_mask_t ch_mask;
+    size_t num_ch;
+
+    sample_t input[TotalSamples * MaxChans];
+
+    uint8_t frames[NumFrames][MaxFrameSize];
+    size_t frame_sizes[NumFrames];
+
+    void setup() {
+        use(0x3);
+    }
+
+    void use(packet::channel_mask_t mask) {
+        ch_mask = mask;
+        num_ch = packet::num_channels(mask);
+        make_signal(input, TotalSamples, num_ch);
+    }
+
+    size_t encode_frame(LosslessEncoder & encoder, uint8_t * frame,
+                        const sample_t* samples, size_t n_samples) {
+        const size_t max_size = encoder.encoded_size(n_samples);
+        CHECK(max_size <= MaxFrameSize);
+
+        encoder.begin(frame, max_size);
+        UNSIGNED_LONGS_EQUAL(n_samples, encoder.write(samples, n_samples, ch_mask));
+        const size_t size = encoder.end();
+        CHECK(size <= max_size);
+
+        return size;
+    }
+
+    size_t encode_all() {
+        LosslessEncoder encoder(allocator, ch_mask);
+
+        size_t total_size = 0;
+
+        for (size_t f = 0; f < NumFrames; f++) {
+            frame_sizes[f] = encode_frame(encoder, frames[f],
+                                          input + f * SamplesPerFrame * num_ch,
+                                          SamplesPerFrame);
+            total_size += frame_sizes[f];
+        }
+
+        return total_size;
+    }
+
+    void decode_frame(LosslessDecoder & decoder, size_t f, sample_t * output) {
+        decoder.begin(packet::timestamp_t(f * SamplesPerFrame), frames[f],
+                      frame_sizes[f]);
+
+        UNSIGNED_LONGS_EQUAL(f * SamplesPerFrame, decoder.position());
+        UNSIGNED_LONGS_EQUAL(SamplesPerFrame, decoder.available());
+        UNSIGNED_LONGS_EQUAL(SamplesPerFrame,
+                             decoder.read(output, SamplesPerFrame, ch_mask));
+        UNSIGNED_LONGS_EQUAL(0, decoder.available());
+
+        decoder.end();
+    }
+
+    void check_bit_exact(const sample_t* output, size_t n_samples) {
+        sample_t expected[TotalSamples * MaxChans];
+        make_reference(expected, input, n_samples, ch_mask);
+
+        for (size_t n = 0; n < n_samples * num_ch; n++) {
+            DOUBLES_EQUAL((double)expected[n], (double)output[n], 0);
+        }
+    }
+};
+
+TEST(lossless, encoded_size) {
+    enum { NumSamples = 320 };
+
+    LosslessEncoder lossless_encoder(allocator, 0x3);
+    PCMEncoder pcm_encoder(PCM_int16_2ch);
+
+    UNSIGNED_LONGS_EQUAL(pcm_encoder.encoded_size(NumSamples) + Lossless_FrameHeaderSize
+                             + 2 * Lossless_SubframeHeaderSize,
+                         lossless_encoder.encoded_size(NumSamples));
+}
+
+TEST(lossless, encode_decode) {
+    const packet::channel_mask_t masks[] = { 0x1, 0x3 };
+
+    for (size_t m = 0; m < ROC_ARRAY_SIZE(masks); m++) {
+        use(masks[m]);
+
+        const size_t total_size = encode_all();
+
+        PCMEncoder pcm_encoder(num_ch == 1 ? PCM_int16_1ch : PCM_int16_2ch);
+        CHECK(total_size < pcm_encoder.encoded_size(TotalSamples));
+
+        LosslessDecoder decoder(allocator, ch_mask);
+
+        sample_t output[TotalSamples * MaxChans];
+        for (size_t f = 0; f < NumFrames; f++) {
+            decode_frame(decoder, f, output + f * SamplesPerFrame * num_ch);
+        }
+
+        check_bit_exact(output, TotalSamples);
+    }
+}
+
+TEST(lossless, independent_frames) {
+    encode_all();
+
+    LosslessDecoder decoder(allocator, ch_mask);
+
+    sample_t output[TotalSamples * MaxChans];
+
+    // decode frames in reverse order, skipping every third frame
+    for (size_t f = NumFrames; f > 0; f--) {
+        if (f % 3 == 0) {
+            for (size_t n = 0; n < SamplesPerFrame * num_ch; n++) {
+                output[(f - 1) * SamplesPerFrame * num_ch + n] = 0;
+            }
+            continue;
+        }
+        decode_frame(decoder, f - 1, output + (f - 1) * SamplesPerFrame * num_ch);
+    }
+
+    sample_t expected[TotalSamples * MaxChans];
+    make_reference(expected, input, TotalSamples, ch_mask);
+
+    for (size_t f = 0; f < NumFrames; f++) {
+        for (size_t n = 0; n < SamplesPerFrame * num_ch; n++) {
+            const size_t i = f * SamplesPerFrame * num_ch + n;
+            DOUBLES_EQUAL((f + 1) % 3 == 0 ? 0.0 : (double)expected[i],
+                          (double)output[i], 0);
+        }
+    }
+}
+
+TEST(lossless, silence) {
+    for (size_t n = 0; n < TotalSamples * num_ch; n++) {
+        input[n] = 0.25f;
+    }
+
+    encode_all();
+
+    // frame header and constant subframe for every channel
+    for (size_t f = 0; f < NumFrames; f++) {
+        UNSIGNED_LONGS_EQUAL(Lossless_FrameHeaderSize
+                                 + num_ch * (Lossless_SubframeHeaderSize + 2),
+                             frame_sizes[f]);
+    }
+
+    LosslessDecoder decoder(allocator, ch_mask);
+
+    sample_t output[TotalSamples * MaxChans];
+    for (size_t f = 0; f < NumFrames; f++) {
+        decode_frame(decoder, f, output + f * SamplesPerFrame * num_ch);
+    }
+
+    check_bit_exact(output, TotalSamples);
+}
+
+TEST(lossless, noise) {
+    for (size_t n = 0; n < TotalSamples * num_ch; n++) {
+        input[n] = (sample_t)core::random(0, 65535) / 32768.0f - 1.0f;
+    }
+
+    LosslessEncoder encoder(allocator, ch_mask);
+
+    // incompressible signal is stored verbatim
+    for (size_t f = 0; f < NumFrames; f++) {
+        frame_sizes[f] = encode_frame(encoder, frames[f],
+                                      input + f * SamplesPerFrame * num_ch,
+                                      SamplesPerFrame);
+        UNSIGNED_LONGS_EQUAL(encoder.encoded_size(SamplesPerFrame), frame_sizes[f]);
+    }
+
+    LosslessDecoder decoder(allocator, ch_mask);
+
+    sample_t output[TotalSamples * MaxChans];
+    for (size_t f = 0; f < NumFrames; f++) {
+        decode_frame(decoder, f, output + f * SamplesPerFrame * num_ch);
+    }
+
+    check_bit_exact(output, TotalSamples);
+}
+
+TEST(lossless, full_scale) {
+    // square wave clipped at full scale, with extreme residuals
+    for (size_t n = 0; n < TotalSamples; n++) {
+        for (size_t ch = 0; ch < num_ch; ch++) {
+            input[n * num_ch + ch] = (n / (ch + 3)) % 2 ? 2.0f : -2.0f;
+        }
+    }
+
+    encode_all();
+
+    LosslessDecoder decoder(allocator, ch_mask);
+
+    sample_t output[TotalSamples * MaxChans];
+    for (size_t f = 0; f < NumFrames; f++) {
+        decode_frame(decoder, f, output + f * SamplesPerFrame * num_ch);
+    }
+
+    check_bit_exact(output, TotalSamples);
+}
+
+TEST(lossless, short_frames) {
+    LosslessEncoder encoder(allocator, ch_mask);
+    LosslessDecoder decoder(allocator, ch_mask);
+
+    for (size_t n_samples = 0; n_samples <= Lossless_MaxOrder * 2; n_samples++) {
+        const size_t size = encode_frame(encoder, frames[0], input, n_samples);
+
+        decoder.begin(0, frames[0], size);
+        UNSIGNED_LONGS_EQUAL(n_samples, decoder.available());
+
+        sample_t output[Lossless_MaxOrder * 2 * MaxChans] = {};
+        UNSIGNED_LONGS_EQUAL(n_samples, decoder.read(output, n_samples, ch_mask));
+        decoder.end();
+
+        check_bit_exact(output, n_samples);
+    }
+}
+
+TEST(lossless, partial_writes) {
+    LosslessEncoder encoder(allocator, ch_mask);
+
+    encoder.begin(frames[0], encoder.encoded_size(SamplesPerFrame));
+
+    size_t pos = 0;
+    for (size_t n = 1; pos < SamplesPerFrame; n++) {
+        const size_t n_samples = std::min((size_t)n, (size_t)SamplesPerFrame - pos);
+        UNSIGNED_LONGS_EQUAL(n_samples,
+                             encoder.write(input + pos * num_ch, n_samples, ch_mask));
+        pos += n_samples;
+    }
+
+    // frame is full
+    UNSIGNED_LONGS_EQUAL(0, encoder.write(input, 1, ch_mask));
+
+    frame_sizes[0] = encoder.end();
+
+    LosslessDecoder decoder(allocator, ch_mask);
+
+    sample_t output[SamplesPerFrame * MaxChans];
+    decode_frame(decoder, 0, output);
+
+    check_bit_exact(output, SamplesPerFrame);
+}
+
+TEST(lossless, shift) {
+    enum { Shift = 50 };
+
+    encode_all();
+
+    LosslessDecoder decoder(allocator, ch_mask);
+
+    decoder.begin(0, frames[0], frame_sizes[0]);
+
+    UNSIGNED_LONGS_EQUAL(Shift, decoder.shift(Shift));
+    UNSIGNED_LONGS_EQUAL(Shift, decoder.position());
+    UNSIGNED_LONGS_EQUAL(SamplesPerFrame - Shift, decoder.available());
+
+    sample_t output[SamplesPerFrame * MaxChans];
+    UNSIGNED_LONGS_EQUAL(SamplesPerFrame - Shift,
+                         decoder.read(output, SamplesPerFrame, ch_mask));
+
+    decoder.end();
+
+    sample_t expected[SamplesPerFrame * MaxChans];
+    make_reference(expected, input, SamplesPerFrame, ch_mask);
+
+    for (size_t n = 0; n < (SamplesPerFrame - Shift) * num_ch; n++) {
+        DOUBLES_EQUAL((double)expected[Shift * num_ch + n], (double)output[n], 0);
+    }
+}
+
+TEST(lossless, channel_mapping) {
+    enum { NumSamples = 100 };
+
+    // mono input, stereo frame
+    sample_t mono_input[NumSamples];
+    make_signal(mono_input, NumSamples, 1);
+
+    LosslessEncoder encoder(allocator, 0x3);
+
+    encoder.begin(frames[0], encoder.encoded_size(NumSamples));
+    UNSIGNED_LONGS_EQUAL(NumSamples, encoder.write(mono_input, NumSamples, 0x1));
+    frame_sizes[0] = encoder.end();
+
+    // stereo frame, mono output
+    LosslessDecoder decoder(allocator, 0x3);
+
+    sample_t mono_output[NumSamples];
+    decoder.begin(0, frames[0], frame_sizes[0]);
+    UNSIGNED_LONGS_EQUAL(NumSamples, decoder.read(mono_output, NumSamples, 0x1));
+    decoder.end();
+
+    // stereo frame, stereo output, second channel is silent
+    sample_t stereo_output[NumSamples * 2];
+    decoder.begin(0, frames[0], frame_sizes[0]);
+    UNSIGNED_LONGS_EQUAL(NumSamples, decoder.read(stereo_output, NumSamples, 0x3));
+    decoder.end();
+
+    sample_t expected[NumSamples];
+    make_reference(expected, mono_input, NumSamples, 0x1);
+
+    for (size_t n = 0; n < NumSamples; n++) {
+        DOUBLES_EQUAL((double)expected[n], (double)mono_output[n], 0);
+        DOUBLES_EQUAL((double)expected[n], (double)stereo_output[n * 2], 0);
+        DOUBLES_EQUAL(0.0, (double)stereo_output[n * 2 + 1], 0);
+    }
+}
+
+TEST(lossless, small_frame) {
+    LosslessEncoder encoder(allocator, ch_mask);
+
+    // frame header only
+    encoder.begin(frames[0], Lossless_FrameHeaderSize);
+    UNSIGNED_LONGS_EQUAL(0, encoder.write(input, SamplesPerFrame, ch_mask));
+    UNSIGNED_LONGS_EQUAL(Lossless_FrameHeaderSize, encoder.end());
+
+    LosslessDecoder decoder(allocator, ch_mask);
+
+    decoder.begin(0, frames[0], Lossless_FrameHeaderSize);
+    UNSIGNED_LONGS_EQUAL(0, decoder.available());
+    decoder.end();
+}
+
+TEST(lossless, malformed) {
+    encode_all();
+
+    LosslessDecoder decoder(allocator, ch_mask);
+
+    // truncated frames
+    for (size_t size = 0; size < frame_sizes[0]; size++) {
+        decoder.begin(0, frames[0], size);
+        UNSIGNED_LONGS_EQUAL(0, decoder.available());
+        decoder.end();
+    }
+
+    // unknown subframe type
+    frames[1][Lossless_FrameHeaderSize] = 0xf0;
+    decoder.begin(0, frames[1], frame_sizes[1]);
+    UNSIGNED_LONGS_EQUAL(0, decoder.available());
+    decoder.end();
+
+    // frame is still decodable after errors
+    sample_t output[SamplesPerFrame * MaxChans];
+    decode_frame(decoder, 0, output);
+
+    check_bit_exact(output, SamplesPerFrame);
+}
+
+} // namespace audio
+} // namespace roc
@@ -36,7 +36,7 @@ TEST_GROUP(mixer) {
         return buf;
     }
 
-    void expect_output(Mixer& mixer, size_t sz, sample_t value) {
+    void expect_output(Mixer & mixer, size_t sz, sample_t value, unsigned flags = 0) {
         core::Slice<sample_t> buf = new_buffer(sz);
 
         Frame frame(buf.data(), buf.size());
@@ -45,20 +45,22 @@ TEST_GROUP(mixer) {
         for (size_t n = 0; n < sz; n++) {
             DOUBLES_EQUAL((double)value, (double)frame.data()[n], 0.0001);
         }
+
+        UNSIGNED_LONGS_EQUAL(flags, frame.flags());
     }
 };
 
 TEST(mixer, no_readers) {
-    Mixer mixer(buffer_pool, MaxSz);
+    Mixer mixer(buffer_pool, MaxSz, true);
     CHECK(mixer.valid());
 
-    expect_output(mixer, BufSz, 0);
+    expect_output(mixer, BufSz, 0, Frame::FlagBlank);
 }
 
 TEST(mixer, one_reader) {
     MockReader reader;
 
-    Mixer mixer(buffer_pool, MaxSz);
+    Mixer mixer(buffer_pool, MaxSz, true);
     CHECK(mixer.valid());
 
     mixer.add(reader);
@@ -72,7 +74,7 @@ TEST(mixer, one_reader) {
 TEST(mixer, one_reader_large) {
     MockReader reader;
 
-    Mixer mixer(buffer_pool, MaxSz);
+    Mixer mixer(buffer_pool, MaxSz, true);
     CHECK(mixer.valid());
 
     mixer.add(reader);
@@ -87,7 +89,7 @@ TEST(mixer, two_readers) {
     MockReader reader1;
     MockReader reader2;
 
-    Mixer mixer(buffer_pool, MaxSz);
+    Mixer mixer(buffer_pool, MaxSz, true);
     CHECK(mixer.valid());
 
     mixer.add(reader1);
@@ -106,7 +108,7 @@ TEST(mixer, remove_reader) {
     MockReader reader1;
     MockReader reader2;
 
-    Mixer mixer(buffer_pool, MaxSz);
+    Mixer mixer(buffer_pool, MaxSz, true);
     CHECK(mixer.valid());
 
     mixer.add(reader1);
@@ -126,7 +128,7 @@ TEST(mixer, remove_reader) {
 
     reader1.add(BufSz, 0.77f);
     reader2.add(BufSz, 0.88f);
-    expect_output(mixer, BufSz, 0.0f);
+    expect_output(mixer, BufSz, 0.0f, Frame::FlagBlank);
 
     CHECK(reader1.num_unread() == BufSz);
     CHECK(reader2.num_unread() == BufSz * 2);
@@ -136,7 +138,7 @@ TEST(mixer, clamp) {
     MockReader reader1;
     MockReader reader2;
 
-    Mixer mixer(buffer_pool, MaxSz);
+    Mixer mixer(buffer_pool, MaxSz, true);
     CHECK(mixer.valid());
 
     mixer.add(reader1);
@@ -161,5 +163,151 @@ TEST(mixer, clamp) {
     CHECK(reader2.num_unread() == 0);
 }
 
+TEST(mixer, clamp_once) {
+    MockReader reader1;
+    MockReader reader2;
+    MockReader reader3;
+
+    Mixer mixer(buffer_pool, MaxSz, true);
+    CHECK(mixer.valid());
+
+    mixer.add(reader1);
+    mixer.add(reader2);
+    mixer.add(reader3);
+
+    reader1.add(BufSz, 0.9f);
+    reader2.add(BufSz, 0.9f);
+    reader3.add(BufSz, -0.9f);
+
+    expect_output(mixer, BufSz, 0.9f);
+
+    CHECK(reader1.num_unread() == 0);
+    CHECK(reader2.num_unread() == 0);
+    CHECK(reader3.num_unread() == 0);
+}
+
+TEST(mixer, skip_blank) {
+    MockReader reader1;
+    MockReader reader2;
+    MockReader reader3;
+
+    Mixer mixer(buffer_pool, MaxSz, true);
+    CHECK(mixer.valid());
+
+    mixer.add(reader1);
+    mixer.add(reader2);
+    mixer.add(reader3);
+
+    // samples of blank frames should be ignored
+    reader1.set_flags(Frame::FlagBlank);
+    reader2.set_flags(0);
+    reader3.set_flags(Frame::FlagBlank);
+
+    reader1.add(BufSz, 0.11f);
+    reader2.add(BufSz, 0.22f);
+    reader3.add(BufSz, 0.33f);
+
+    expect_output(mixer, BufSz, 0.22f);
+
+    reader1.set_flags(0);
+    reader2.set_flags(Frame::FlagBlank);
+
+    reader1.add(BufSz, 0.11f);
+    reader2.add(BufSz, 0.22f);
+    reader3.add(BufSz, 0.33f);
+
+    expect_output(mixer, BufSz, 0.11f);
+
+    CHECK(reader1.num_unread() == 0);
+    CHECK(reader2.num_unread() == 0);
+    CHECK(reader3.num_unread() == 0);
+}
+
+TEST(mixer, all_blank) {
+    MockReader reader1;
+    MockReader reader2;
+
+    Mixer mixer(buffer_pool, MaxSz, true);
+    CHECK(mixer.valid());
+
+    mixer.add(reader1);
+    mixer.add(reader2);
+
+    reader1.set_flags(Frame::FlagBlank);
+    reader2.set_flags(Frame::FlagBlank | Frame::FlagDrops);
+
+    // skipped samples should not get to output
+    reader1.add(BufSz, 0.11f);
+    reader2.add(BufSz, 0.22f);
+
+    expect_output(mixer, BufSz, 0.0f, Frame::FlagBlank | Frame::FlagDrops);
+
+    CHECK(reader1.num_unread() == 0);
+    CHECK(reader2.num_unread() == 0);
+}
+
+TEST(mixer, mix_blank) {
+    MockReader reader1;
+    MockReader reader2;
+    MockReader reader3;
+
+    Mixer mixer(buffer_pool, MaxSz, false);
+    CHECK(mixer.valid());
+
+    mixer.add(reader1);
+    mixer.add(reader2);
+    mixer.add(reader3);
+
+    // samples of blank frames should be mixed
+    reader1.set_flags(Frame::FlagBlank);
+    reader2.set_flags(0);
+    reader3.set_flags(Frame::FlagBlank);
+
+    reader1.add(BufSz, 0.11f);
+    reader2.add(BufSz, 0.22f);
+    reader3.add(BufSz, 0.33f);
+
+    expect_output(mixer, BufSz, 0.66f);
+
+    reader2.set_flags(Frame::FlagBlank);
+
+    reader1.add(BufSz, 0.11f);
+    reader2.add(BufSz, 0.22f);
+    reader3.add(BufSz, 0.33f);
+
+    expect_output(mixer, BufSz, 0.66f, Frame::FlagBlank);
+
+    CHECK(reader1.num_unread() == 0);
+    CHECK(reader2.num_unread() == 0);
+    CHECK(reader3.num_unread() == 0);
+}
+
+TEST(mixer, merge_flags) {
+    MockReader reader1;
+    MockReader reader2;
+    MockReader reader3;
+
+    Mixer mixer(buffer_pool, MaxSz, true);
+    CHECK(mixer.valid());
+
+    mixer.add(reader1);
+    mixer.add(reader2);
+    mixer.add(reader3);
+
+    reader1.set_flags(Frame::FlagIncomplete);
+    reader2.set_flags(0);
+    reader3.set_flags(Frame::FlagBlank | Frame::FlagDrops);
+
+    reader1.add(BufSz, 0.11f);
+    reader2.add(BufSz, 0.22f);
+    reader3.add(BufSz, 0.0f);
+
+    expect_output(mixer, BufSz, 0.33f, Frame::FlagIncomplete | Frame::FlagDrops);
+
+    CHECK(reader1.num_unread() == 0);
+    CHECK(reader2.num_unread() == 0);
+    CHECK(reader3.num_unread() == 0);
+}
+
 } // namespace audio
 } // namespace roc
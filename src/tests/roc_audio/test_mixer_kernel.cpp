@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/mixer_kernel.h"
+#include "roc_core/helpers.h"
+#include "roc_core/random.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum { NumSamples = 203 };
+
+const MixerKernelType kernels[] = {
+    MixerKernel_SSE2,
+    MixerKernel_AVX2,
+};
+
+sample_t random_sample() {
+    return (sample_t)core::random(0, 4000) / 1000.0f - 2.0f;
+}
+
+} // namespace
+
+TEST_GROUP(mixer_kernel) {
+    sample_t acc[NumSamples];
+    sample_t samples[NumSamples];
+
+    void setup() {
+        for (size_t n = 0; n < NumSamples; n++) {
+            acc[n] = random_sample();
+            samples[n] = random_sample();
+        }
+    }
+};
+
+TEST(mixer_kernel, auto_is_supported) {
+    const MixerKernel* kernel = mixer_kernel(MixerKernel_Auto);
+
+    CHECK(kernel);
+    CHECK(kernel->name);
+    CHECK(kernel->type != MixerKernel_Auto);
+
+    CHECK(mixer_kernel(MixerKernel_Generic));
+}
+
+TEST(mixer_kernel, accumulate) {
+    const MixerKernel* generic = mixer_kernel(MixerKernel_Generic);
+
+    for (size_t k = 0; k < ROC_ARRAY_SIZE(kernels); k++) {
+        const MixerKernel* kernel = mixer_kernel(kernels[k]);
+        if (!kernel) {
+            continue;
+        }
+
+        for (size_t n_samples = 0; n_samples <= NumSamples; n_samples++) {
+            sample_t expected[NumSamples];
+            sample_t actual[NumSamples];
+
+            memcpy(expected, acc, sizeof(acc));
+            memcpy(actual, acc, sizeof(acc));
+
+            generic->accumulate(expected, samples, n_samples);
+            kernel->accumulate(actual, samples, n_samples);
+
+            for (size_t n = 0; n < NumSamples; n++) {
+                DOUBLES_EQUAL(expected[n], actual[n], 0);
+            }
+        }
+    }
+}
+
+TEST(mixer_kernel, clamp) {
+    const MixerKernel* generic = mixer_kernel(MixerKernel_Generic);
+
+    for (size_t k = 0; k < ROC_ARRAY_SIZE(kernels); k++) {
+        const MixerKernel* kernel = mixer_kernel(kernels[k]);
+        if (!kernel) {
+            continue;
+        }
+
+        for (size_t n_samples = 0; n_samples <= NumSamples; n_samples++) {
+            sample_t expected[NumSamples];
+            sample_t actual[NumSamples];
+
+            memcpy(expected, samples, sizeof(samples));
+            memcpy(actual, samples, sizeof(samples));
+
+            generic->clamp(expected, n_samples);
+            kernel->clamp(actual, n_samples);
+
+            for (size_t n = 0; n < NumSamples; n++) {
+                DOUBLES_EQUAL(expected[n], actual[n], 0);
+                if (n < n_samples) {
+                    CHECK(actual[n] <= SampleMax && actual[n] >= SampleMin);
+                }
+            }
+        }
+    }
+}
+
+} // namespace audio
+} // namespace roc
@@ -21,7 +21,8 @@ class MockReader : public IReader {
 public:
     MockReader()
         : pos_(0)
-        , size_(0) {
+        , size_(0)
+        , flags_(0) {
     }
 
     virtual void read(Frame& frame) {
@@ -29,6 +30,12 @@ public:
 
         memcpy(frame.data(), samples_ + pos_, frame.size() * sizeof(sample_t));
         pos_ += frame.size();
+
+        frame.set_flags(flags_);
+    }
+
+    void set_flags(unsigned flags) {
+        flags_ = flags;
     }
 
     void add(size_t size, sample_t value) {
@@ -49,6 +56,7 @@ private:
     sample_t samples_[MaxSz];
     size_t pos_;
     size_t size_;
+    unsigned flags_;
 };
 
 } // namespace audio
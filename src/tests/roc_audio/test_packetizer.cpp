@@ -10,6 +10,8 @@
 
 #include "roc_audio/iframe_decoder.h"
 #include "roc_audio/iframe_encoder.h"
+#include "roc_audio/lossless_decoder.h"
+#include "roc_audio/lossless_encoder.h"
 #include "roc_audio/packetizer.h"
 #include "roc_audio/pcm_decoder.h"
 #include "roc_audio/pcm_encoder.h"
@@ -19,6 +21,7 @@
 #include "roc_packet/packet_pool.h"
 #include "roc_packet/queue.h"
 #include "roc_rtp/composer.h"
+#include "roc_rtp/headers.h"
 
 namespace roc {
 namespace audio {
@@ -301,5 +304,45 @@ TEST(packetizer, flush) {
     }
 }
 
+TEST(packetizer, variable_payload_size) {
+    enum { NumIterations = 5, Missing = 10 };
+
+    audio::LosslessEncoder encoder(allocator, ChMask);
+    audio::LosslessDecoder decoder(allocator, ChMask);
+
+    packet::Queue packet_queue;
+    packet::Queue checked_queue;
+
+    Packetizer packetizer(packet_queue, rtp_composer, encoder, packet_pool,
+                          byte_buffer_pool, ChMask, PacketDuration, SampleRate,
+                          PayloadType);
+
+    FrameMaker frame_maker;
+    PacketChecker packet_checker(decoder);
+
+    for (size_t n = 0; n < NumIterations; n++) {
+        frame_maker.write(packetizer, SamplesPerPacket);
+        frame_maker.write(packetizer, SamplesPerPacket - Missing);
+
+        packetizer.flush();
+
+        UNSIGNED_LONGS_EQUAL(2, packet_queue.size());
+
+        while (packet::PacketPtr pp = packet_queue.read()) {
+            // packet is truncated to the actual payload size
+            CHECK(pp->rtp()->payload.size()
+                  < encoder.encoded_size(SamplesPerPacket - Missing));
+            UNSIGNED_LONGS_EQUAL(sizeof(rtp::Header) + pp->rtp()->payload.size(),
+                                 pp->data().size());
+            UNSIGNED_LONGS_EQUAL(0, pp->rtp()->padding.size());
+
+            checked_queue.write(pp);
+        }
+
+        packet_checker.read(checked_queue, SamplesPerPacket);
+        packet_checker.read(checked_queue, SamplesPerPacket - Missing);
+    }
+}
+
 } // namespace audio
 } // namespace roc
@@ -146,6 +146,150 @@ TEST(pcm_funcs, encode_decode_2ch) {
     check(samples, NumSamples, 0x3);
 }
 
+TEST(pcm_funcs, payload_size_int24) {
+    enum { NumSamples = 77 };
+
+    use(PCM_int24_1ch);
+    UNSIGNED_LONGS_EQUAL(NumSamples * 1 * 3,
+                         funcs->payload_size_from_samples(NumSamples));
+    UNSIGNED_LONGS_EQUAL(NumSamples,
+                         funcs->samples_from_payload_size(NumSamples * 1 * 3));
+
+    use(PCM_int24_2ch);
+    UNSIGNED_LONGS_EQUAL(NumSamples * 2 * 3,
+                         funcs->payload_size_from_samples(NumSamples));
+    UNSIGNED_LONGS_EQUAL(NumSamples,
+                         funcs->samples_from_payload_size(NumSamples * 2 * 3));
+}
+
+TEST(pcm_funcs, payload_size_float32) {
+    enum { NumSamples = 77 };
+
+    use(PCM_float32_1ch);
+    UNSIGNED_LONGS_EQUAL(NumSamples * 1 * 4,
+                         funcs->payload_size_from_samples(NumSamples));
+    UNSIGNED_LONGS_EQUAL(NumSamples,
+                         funcs->samples_from_payload_size(NumSamples * 1 * 4));
+
+    use(PCM_float32_2ch);
+    UNSIGNED_LONGS_EQUAL(NumSamples * 2 * 4,
+                         funcs->payload_size_from_samples(NumSamples));
+    UNSIGNED_LONGS_EQUAL(NumSamples,
+                         funcs->samples_from_payload_size(NumSamples * 2 * 4));
+}
+
+TEST(pcm_funcs, encode_decode_int24) {
+    enum { NumSamples = 5 };
+
+    use(PCM_int24_2ch);
+
+    core::Slice<uint8_t> bp = new_buffer(NumSamples);
+
+    const audio::sample_t samples[NumSamples * 2] = {
+        -0.1f, 0.1f, //
+        -0.2f, 0.2f, //
+        -0.3f, 0.3f, //
+        -0.4f, 0.4f, //
+        -0.5f, 0.5f, //
+    };
+
+    encode(bp, samples, 0, NumSamples, 0x3);
+    decode(bp, 0, NumSamples, 0x3);
+
+    for (size_t n = 0; n < NumSamples * 2; n++) {
+        DOUBLES_EQUAL((double)samples[n], (double)output[n], 1.0 / 8388608.0);
+    }
+}
+
+TEST(pcm_funcs, encode_decode_float32) {
+    enum { NumSamples = 5 };
+
+    use(PCM_float32_2ch);
+
+    core::Slice<uint8_t> bp = new_buffer(NumSamples);
+
+    const audio::sample_t samples[NumSamples * 2] = {
+        -0.1f, 0.1f, //
+        -0.2f, 0.2f, //
+        -0.3f, 0.3f, //
+        -0.4f, 0.4f, //
+        -1.5f, 1.5f, //
+    };
+
+    encode(bp, samples, 0, NumSamples, 0x3);
+    decode(bp, 0, NumSamples, 0x3);
+
+    // floats are transferred as is, without quantization and clamping
+    for (size_t n = 0; n < NumSamples * 2; n++) {
+        DOUBLES_EQUAL((double)samples[n], (double)output[n], 0);
+    }
+}
+
+TEST(pcm_funcs, encode_int24_big_endian) {
+    enum { NumSamples = 4 };
+
+    use(PCM_int24_1ch);
+
+    core::Slice<uint8_t> bp = new_buffer(NumSamples);
+
+    const audio::sample_t samples[NumSamples] = { 1.0f, -1.0f, 0.5f, -0.5f };
+
+    encode(bp, samples, 0, NumSamples, 0x1);
+
+    const uint8_t expected[NumSamples * 3] = {
+        0x7f, 0xff, 0xff, // clamped
+        0x80, 0x00, 0x00, //
+        0x40, 0x00, 0x00, //
+        0xc0, 0x00, 0x00, //
+    };
+
+    for (size_t n = 0; n < NumSamples * 3; n++) {
+        UNSIGNED_LONGS_EQUAL(expected[n], bp.data()[n]);
+    }
+}
+
+TEST(pcm_funcs, encode_float32_big_endian) {
+    enum { NumSamples = 2 };
+
+    use(PCM_float32_1ch);
+
+    core::Slice<uint8_t> bp = new_buffer(NumSamples);
+
+    const audio::sample_t samples[NumSamples] = { 1.0f, -0.5f };
+
+    encode(bp, samples, 0, NumSamples, 0x1);
+
+    const uint8_t expected[NumSamples * 4] = {
+        0x3f, 0x80, 0x00, 0x00, //
+        0xbf, 0x00, 0x00, 0x00, //
+    };
+
+    for (size_t n = 0; n < NumSamples * 4; n++) {
+        UNSIGNED_LONGS_EQUAL(expected[n], bp.data()[n]);
+    }
+}
+
+TEST(pcm_funcs, decode_int24_mask_subset) {
+    enum { NumSamples = 3 };
+
+    use(PCM_int24_2ch);
+
+    core::Slice<uint8_t> bp = new_buffer(NumSamples);
+
+    const audio::sample_t input[NumSamples * 2] = {
+        -0.1f, 0.1f, //
+        -0.2f, 0.2f, //
+        -0.3f, 0.3f, //
+    };
+
+    encode(bp, input, 0, NumSamples, 0x3);
+    decode(bp, 0, NumSamples, 0x1);
+
+    for (size_t n = 0; n < NumSamples; n++) {
+        DOUBLES_EQUAL((double)input[n * 2], (double)output[n], 1.0 / 8388608.0);
+    }
+}
+
 TEST(pcm_funcs, encode_mask_subset) {
     enum { NumSamples = 5 };
 
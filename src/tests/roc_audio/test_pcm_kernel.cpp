@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/pcm_kernel.h"
+#include "roc_core/helpers.h"
+#include "roc_core/random.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum { NumSamples = 203 };
+
+const PCMKernelType kernels[] = {
+    PCMKernel_SSE2,
+    PCMKernel_AVX2,
+};
+
+// Includes out of range values to check saturation.
+sample_t random_sample() {
+    return (sample_t)core::random(0, 4000) / 1000.0f - 2.0f;
+}
+
+} // namespace
+
+TEST_GROUP(pcm_kernel) {
+    sample_t samples[NumSamples];
+    int16_t encoded[NumSamples];
+
+    void setup() {
+        for (size_t n = 0; n < NumSamples; n++) {
+            samples[n] = random_sample();
+            encoded[n] = (int16_t)core::random(0, 0xffff);
+        }
+
+        // edge cases
+        samples[0] = 1.0f;
+        samples[1] = -1.0f;
+        samples[2] = 0.99999f;
+        samples[3] = -0.99999f;
+        encoded[0] = (int16_t)0x0080;
+        encoded[1] = (int16_t)0xff7f;
+    }
+};
+
+TEST(pcm_kernel, auto_is_supported) {
+    const PCMKernel* kernel = pcm_kernel(PCMKernel_Auto);
+
+    CHECK(kernel);
+    CHECK(kernel->name);
+    CHECK(kernel->type != PCMKernel_Auto);
+
+    CHECK(pcm_kernel(PCMKernel_Generic));
+}
+
+TEST(pcm_kernel, encode_int16) {
+    const PCMKernel* generic = pcm_kernel(PCMKernel_Generic);
+
+    for (size_t k = 0; k < ROC_ARRAY_SIZE(kernels); k++) {
+        const PCMKernel* kernel = pcm_kernel(kernels[k]);
+        if (!kernel) {
+            continue;
+        }
+
+        for (size_t n_samples = 0; n_samples <= NumSamples; n_samples++) {
+            int16_t expected[NumSamples] = {};
+            int16_t actual[NumSamples] = {};
+
+            generic->encode_int16(expected, samples, n_samples);
+            kernel->encode_int16(actual, samples, n_samples);
+
+            for (size_t n = 0; n < NumSamples; n++) {
+                LONGS_EQUAL(expected[n], actual[n]);
+            }
+        }
+    }
+}
+
+TEST(pcm_kernel, decode_int16) {
+    const PCMKernel* generic = pcm_kernel(PCMKernel_Generic);
+
+    for (size_t k = 0; k < ROC_ARRAY_SIZE(kernels); k++) {
+        const PCMKernel* kernel = pcm_kernel(kernels[k]);
+        if (!kernel) {
+            continue;
+        }
+
+        for (size_t n_samples = 0; n_samples <= NumSamples; n_samples++) {
+            sample_t expected[NumSamples] = {};
+            sample_t actual[NumSamples] = {};
+
+            generic->decode_int16(expected, encoded, n_samples);
+            kernel->decode_int16(actual, encoded, n_samples);
+
+            for (size_t n = 0; n < NumSamples; n++) {
+                DOUBLES_EQUAL(expected[n], actual[n], 0);
+            }
+        }
+    }
+}
+
+TEST(pcm_kernel, encode_decode) {
+    const PCMKernel* generic = pcm_kernel(PCMKernel_Generic);
+
+    int16_t packed[NumSamples];
+    sample_t unpacked[NumSamples];
+
+    generic->encode_int16(packed, samples, NumSamples);
+    generic->decode_int16(unpacked, packed, NumSamples);
+
+    for (size_t n = 0; n < NumSamples; n++) {
+        const sample_t s = std::min(std::max(samples[n], -1.0f), 32767.0f / 32768.0f);
+        DOUBLES_EQUAL(s, unpacked[n], 1.0 / 32768.0);
+    }
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/polynomial_resampler.h"
+#include "roc_audio/resampler_profile.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/helpers.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum {
+    ChMask = 0x3,
+    NumCh = 2,
+    FrameSize = 256,
+    InSize = FrameSize * 20,
+    OutSize = FrameSize * 16
+};
+
+const ResamplerProfile profiles[] = { ResamplerProfile_Linear, ResamplerProfile_Cubic };
+
+// Signal period, in samples.
+const double Period = 100;
+
+core::HeapAllocator allocator;
+
+double signal(double pos, size_t channel) {
+    return std::sin(2 * M_PI / Period * pos) * (channel == 0 ? 0.5 : -0.25);
+}
+
+} // namespace
+
+TEST_GROUP(polynomial_resampler) {
+    sample_t input[InSize];
+    sample_t output[OutSize];
+
+    void setup() {
+        for (size_t n = 0; n < InSize / NumCh; n++) {
+            for (size_t ch = 0; ch < NumCh; ch++) {
+                input[n * NumCh + ch] = (sample_t)signal((double)n, ch);
+            }
+        }
+    }
+
+    // Pushes input in chunks of varying size and fills output.
+    void resample(IResampler & resampler) {
+        size_t in_pos = 0;
+        size_t chunk = NumCh;
+
+        Frame frame(output, OutSize);
+
+        while (!resampler.resample_buff(frame)) {
+            CHECK(in_pos + chunk <= InSize);
+
+            in_pos += resampler.push_input(input + in_pos, chunk);
+
+            chunk += NumCh;
+            if (chunk > FrameSize) {
+                chunk = NumCh;
+            }
+        }
+    }
+};
+
+TEST(polynomial_resampler, invalid_method) {
+    ResamplerConfig config;
+    config.method = ResamplerMethod_Sinc;
+
+    PolynomialResampler resampler(allocator, config, ChMask, FrameSize);
+    CHECK(!resampler.valid());
+}
+
+TEST(polynomial_resampler, invalid_scaling) {
+    for (size_t p = 0; p < ROC_ARRAY_SIZE(profiles); p++) {
+        PolynomialResampler resampler(allocator, resampler_profile(profiles[p]), ChMask,
+                                      FrameSize);
+        CHECK(resampler.valid());
+
+        CHECK(!resampler.set_scaling(0));
+        CHECK(!resampler.set_scaling(-1));
+        CHECK(!resampler.set_scaling(FrameSize));
+
+        CHECK(resampler.set_scaling(0.5f));
+        CHECK(resampler.set_scaling(2.0f));
+    }
+}
+
+// With unity scaling, output samples are exactly the input samples.
+TEST(polynomial_resampler, no_scaling) {
+    for (size_t p = 0; p < ROC_ARRAY_SIZE(profiles); p++) {
+        PolynomialResampler resampler(allocator, resampler_profile(profiles[p]), ChMask,
+                                      FrameSize);
+        CHECK(resampler.valid());
+
+        resample(resampler);
+
+        for (size_t n = 0; n < OutSize; n++) {
+            DOUBLES_EQUAL(input[n], output[n], 0);
+        }
+    }
+}
+
+// Output sample N is the input signal at position N * scaling.
+TEST(polynomial_resampler, scaling) {
+    const float scalings[] = { 0.995f, 1.005f, 0.9f, 1.1f };
+    const double epsilons[] = { 0.001, 0.0003 };
+
+    for (size_t p = 0; p < ROC_ARRAY_SIZE(profiles); p++) {
+        for (size_t s = 0; s < ROC_ARRAY_SIZE(scalings); s++) {
+            PolynomialResampler resampler(allocator, resampler_profile(profiles[p]),
+                                          ChMask, FrameSize);
+            CHECK(resampler.valid());
+            CHECK(resampler.set_scaling(scalings[s]));
+
+            resample(resampler);
+
+            for (size_t n = 0; n < OutSize / NumCh; n++) {
+                for (size_t ch = 0; ch < NumCh; ch++) {
+                    DOUBLES_EQUAL(signal((double)n * (double)scalings[s], ch),
+                                  output[n * NumCh + ch], epsilons[p]);
+                }
+            }
+        }
+    }
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/iresampler.h"
+#include "roc_audio/polyphase_resampler.h"
+#include "roc_audio/resampler.h"
+#include "roc_audio/resampler_writer.h"
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/helpers.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum {
+    ChMask = 0x3,
+    NumCh = 2,
+    FrameSize = 512,
+    InFrames = 40,
+    InSize = FrameSize * InFrames,
+    OutSize = InSize * 2,
+    MaxSize = 4000
+};
+
+// Resampler approximates sinc table interpolation, so results are not
+// bit-exact and differ by a fraction of percent.
+const double Epsilon = 0.005;
+
+core::HeapAllocator allocator;
+core::BufferPool<sample_t> buffer_pool(allocator, MaxSize, true);
+
+class CollectingWriter : public IWriter {
+public:
+    CollectingWriter()
+        : size_(0) {
+    }
+
+    virtual void write(Frame& frame) {
+        CHECK(size_ + frame.size() <= OutSize);
+        memcpy(samples_ + size_, frame.data(), frame.size() * sizeof(sample_t));
+        size_ += frame.size();
+    }
+
+    const sample_t* samples() const {
+        return samples_;
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+private:
+    sample_t samples_[OutSize];
+    size_t size_;
+};
+
+} // namespace
+
+TEST_GROUP(polyphase_resampler) {
+    ResamplerConfig config;
+    sample_t input[InSize];
+
+    void setup() {
+        config.window_interp = 512;
+        config.window_size = 32;
+
+        // stereo signal with different tones in channels
+        for (size_t n = 0; n < InSize / NumCh; n++) {
+            input[n * NumCh] = (sample_t)std::sin(2 * M_PI / 50 * double(n)) * 0.5f;
+            input[n * NumCh + 1] = (sample_t)std::sin(2 * M_PI / 90 * double(n)) * 0.5f;
+        }
+    }
+
+    void resample(IResampler & resampler, CollectingWriter & writer) {
+        ResamplerWriter rw(writer, resampler, buffer_pool, FrameSize);
+        CHECK(rw.valid());
+
+        for (size_t n = 0; n < InFrames; n++) {
+            Frame frame(input + n * FrameSize, FrameSize);
+            rw.write(frame);
+        }
+    }
+
+    void compare(float scaling) {
+        Resampler dynamic_resampler(allocator, config, ChMask, FrameSize);
+        CHECK(dynamic_resampler.valid());
+        CHECK(dynamic_resampler.set_scaling(scaling));
+
+        PolyphaseResampler polyphase_resampler(allocator, config, ChMask, FrameSize);
+        CHECK(polyphase_resampler.valid());
+        CHECK(polyphase_resampler.set_scaling(scaling));
+
+        CollectingWriter expected;
+        resample(dynamic_resampler, expected);
+
+        CollectingWriter actual;
+        resample(polyphase_resampler, actual);
+
+        CHECK(expected.size() > 0);
+        UNSIGNED_LONGS_EQUAL(expected.size(), actual.size());
+
+        for (size_t n = 0; n < actual.size(); n++) {
+            DOUBLES_EQUAL(expected.samples()[n], actual.samples()[n], Epsilon);
+        }
+    }
+};
+
+TEST(polyphase_resampler, supported_scaling) {
+    PolyphaseResampler resampler(allocator, config, ChMask, FrameSize);
+    CHECK(resampler.valid());
+
+    CHECK(resampler.set_scaling(1.0f));
+    CHECK(resampler.set_scaling(0.5f));
+    CHECK(resampler.set_scaling(2.0f));
+    CHECK(resampler.set_scaling(48000.0f / 44100.0f));
+    CHECK(resampler.set_scaling(44100.0f / 48000.0f));
+    CHECK(resampler.set_scaling(8000.0f / 44100.0f));
+    CHECK(resampler.set_scaling(44100.0f / 96000.0f));
+}
+
+TEST(polyphase_resampler, unsupported_scaling) {
+    PolyphaseResampler resampler(allocator, config, ChMask, FrameSize);
+    CHECK(resampler.valid());
+
+    // too many phases
+    CHECK(!resampler.set_scaling(1.0001234f));
+    CHECK(!resampler.set_scaling(0.99987f));
+
+    // window doesn't fit frame
+    CHECK(!resampler.set_scaling(FrameSize));
+}
+
+TEST(polyphase_resampler, same_as_dynamic_no_scaling) {
+    compare(1.0f);
+}
+
+TEST(polyphase_resampler, same_as_dynamic_upsample) {
+    compare(44100.0f / 48000.0f);
+}
+
+TEST(polyphase_resampler, same_as_dynamic_downsample) {
+    compare(48000.0f / 44100.0f);
+}
+
+TEST(polyphase_resampler, same_as_dynamic_twice) {
+    compare(0.5f);
+    compare(2.0f);
+}
+
+} // namespace audio
+} // namespace roc
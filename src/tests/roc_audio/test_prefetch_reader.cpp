@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/prefetch_reader.h"
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/stddefs.h"
+
+#include "test_mock_reader.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum { BufSz = 100, MaxSz = 500 };
+
+core::HeapAllocator allocator;
+core::BufferPool<sample_t> buffer_pool(allocator, MaxSz, true);
+
+} // namespace
+
+TEST_GROUP(prefetch_reader) {
+    void expect_output(IReader & reader, size_t sz, sample_t value, unsigned flags) {
+        sample_t samples[MaxSz];
+
+        Frame frame(samples, sz);
+        reader.read(frame);
+
+        for (size_t n = 0; n < sz; n++) {
+            DOUBLES_EQUAL((double)value, (double)frame.data()[n], 0);
+        }
+
+        UNSIGNED_LONGS_EQUAL(flags, frame.flags());
+    }
+};
+
+TEST(prefetch_reader, invalid_frame_size) {
+    MockReader mock_reader;
+
+    PrefetchReader reader(mock_reader, buffer_pool, MaxSz + 1);
+    CHECK(!reader.valid());
+}
+
+TEST(prefetch_reader, no_prefetch) {
+    MockReader mock_reader;
+
+    PrefetchReader reader(mock_reader, buffer_pool, MaxSz);
+    CHECK(reader.valid());
+
+    mock_reader.add(BufSz, 0.11f);
+    mock_reader.add(BufSz, 0.22f);
+
+    expect_output(reader, BufSz, 0.11f, 0);
+    expect_output(reader, BufSz, 0.22f, 0);
+
+    CHECK(mock_reader.num_unread() == 0);
+}
+
+TEST(prefetch_reader, prefetch) {
+    MockReader mock_reader;
+
+    PrefetchReader reader(mock_reader, buffer_pool, MaxSz);
+    CHECK(reader.valid());
+
+    mock_reader.add(BufSz, 0.11f);
+    mock_reader.add(BufSz, 0.22f);
+    mock_reader.add(BufSz, 0.33f);
+
+    reader.prefetch(BufSz);
+    CHECK(mock_reader.num_unread() == BufSz * 2);
+
+    expect_output(reader, BufSz, 0.11f, 0);
+    CHECK(mock_reader.num_unread() == BufSz * 2);
+
+    reader.prefetch(BufSz);
+    CHECK(mock_reader.num_unread() == BufSz);
+
+    expect_output(reader, BufSz, 0.22f, 0);
+    expect_output(reader, BufSz, 0.33f, 0);
+
+    CHECK(mock_reader.num_unread() == 0);
+}
+
+TEST(prefetch_reader, flags) {
+    MockReader mock_reader;
+
+    PrefetchReader reader(mock_reader, buffer_pool, MaxSz);
+    CHECK(reader.valid());
+
+    mock_reader.add(MaxSz, 0.0f);
+    mock_reader.set_flags(Frame::FlagBlank | Frame::FlagDrops);
+
+    reader.prefetch(MaxSz);
+    mock_reader.set_flags(0);
+
+    expect_output(reader, MaxSz, 0.0f, Frame::FlagBlank | Frame::FlagDrops);
+}
+
+} // namespace audio
+} // namespace roc
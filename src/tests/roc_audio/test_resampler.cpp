@@ -12,6 +12,7 @@
 #include "roc_audio/resampler_reader.h"
 #include "roc_core/buffer_pool.h"
 #include "roc_core/heap_allocator.h"
+#include "roc_core/helpers.h"
 #include "roc_core/random.h"
 #include "roc_core/stddefs.h"
 
@@ -54,9 +55,20 @@ TEST_GROUP(resampler) {
         return buf;
     }
 
+    // Skips beginning of resampled signal, where resampler window is partially
+    // filled with initial silence.
+    void skip_transient(IReader & reader) {
+        core::Slice<sample_t> buf = new_buffer(FrameSize);
+
+        Frame frame(buf.data(), buf.size());
+        reader.read(frame);
+    }
+
     // Reads signal from the resampler and puts its spectrum into @p spectrum.
     // Spectrum must have twice bigger space than the length of the input signal.
     void get_sample_spectrum1(IReader & reader, double* spectrum, const size_t sig_len) {
+        skip_transient(reader);
+
         core::Slice<sample_t> buf = new_buffer(sig_len);
 
         Frame frame(buf.data(), buf.size());
@@ -76,6 +88,8 @@ TEST_GROUP(resampler) {
                               size_t sig_len) {
         enum { nChannels = 2 };
 
+        skip_transient(reader);
+
         core::Slice<sample_t> buf = new_buffer(sig_len);
 
         Frame frame(buf.data(), buf.size());
@@ -101,7 +115,8 @@ TEST(resampler, invalid_scaling) {
     enum { ChMask = 0x1, InvalidScaling = FrameSize };
 
     MockReader reader;
-    ResamplerReader rr(reader, buffer_pool, allocator, config, ChMask, FrameSize);
+    Resampler resampler(allocator, config, ChMask, FrameSize);
+    ResamplerReader rr(reader, resampler, buffer_pool, FrameSize);
 
     CHECK(rr.valid());
 
@@ -113,7 +128,8 @@ TEST(resampler, upscaling_twice_single) {
     enum { ChMask = 0x1 };
 
     MockReader reader;
-    ResamplerReader rr(reader, buffer_pool, allocator, config, ChMask, FrameSize);
+    Resampler resampler(allocator, config, ChMask, FrameSize);
+    ResamplerReader rr(reader, resampler, buffer_pool, FrameSize);
 
     CHECK(rr.valid());
 
@@ -144,7 +160,8 @@ TEST(resampler, upscaling_twice_awgn) {
     enum { ChMask = 0x1 };
 
     MockReader reader;
-    ResamplerReader rr(reader, buffer_pool, allocator, config, ChMask, FrameSize);
+    Resampler resampler(allocator, config, ChMask, FrameSize);
+    ResamplerReader rr(reader, resampler, buffer_pool, FrameSize);
 
     CHECK(rr.valid());
     CHECK(rr.set_scaling(0.5f));
@@ -185,7 +202,8 @@ TEST(resampler, downsample) {
     enum { ChMask = 0x1 };
 
     MockReader reader;
-    ResamplerReader rr(reader, buffer_pool, allocator, config, ChMask, FrameSize);
+    Resampler resampler(allocator, config, ChMask, FrameSize);
+    ResamplerReader rr(reader, resampler, buffer_pool, FrameSize);
 
     CHECK(rr.valid());
     CHECK(rr.set_scaling(1.5f));
@@ -215,7 +233,8 @@ TEST(resampler, two_tones_sep_channels) {
     enum { ChMask = 0x3, nChannels = 2 };
 
     MockReader reader;
-    ResamplerReader rr(reader, buffer_pool, allocator, config, ChMask, FrameSize);
+    Resampler resampler(allocator, config, ChMask, FrameSize);
+    ResamplerReader rr(reader, resampler, buffer_pool, FrameSize);
 
     CHECK(rr.valid());
     CHECK(rr.set_scaling(0.5f));
@@ -244,5 +263,108 @@ TEST(resampler, two_tones_sep_channels) {
     }
 }
 
+// Check that channels don't affect each other and are resampled the same
+// way as a single channel stream.
+TEST(resampler, multiple_channels) {
+    enum { ChMask = 0x3f, nChannels = 6, OutFrames = 8 };
+
+    MockReader mono_readers[nChannels];
+    MockReader reader;
+
+    for (size_t n = 0; n < InSamples / nChannels; n++) {
+        for (size_t ch = 0; ch < nChannels; ch++) {
+            const sample_t s = (sample_t)std::sin(M_PI / double(ch + 2) * double(n));
+            reader.add(1, s);
+            mono_readers[ch].add(1, s);
+        }
+    }
+
+    Resampler resampler(allocator, config, ChMask, FrameSize * nChannels);
+    ResamplerReader rr(reader, resampler, buffer_pool, FrameSize * nChannels);
+    CHECK(rr.valid());
+    CHECK(rr.set_scaling(0.95f));
+
+    core::Slice<sample_t> buf = new_buffer(FrameSize * nChannels);
+    core::Slice<sample_t> mono_buf = new_buffer(FrameSize);
+
+    Resampler* mono_resamplers[nChannels];
+    ResamplerReader* mono_rrs[nChannels];
+    for (size_t ch = 0; ch < nChannels; ch++) {
+        mono_resamplers[ch] =
+            new (allocator) Resampler(allocator, config, 0x1, FrameSize);
+        mono_rrs[ch] = new (allocator) ResamplerReader(
+            mono_readers[ch], *mono_resamplers[ch], buffer_pool, FrameSize);
+        CHECK(mono_rrs[ch]->valid());
+        CHECK(mono_rrs[ch]->set_scaling(0.95f));
+    }
+
+    for (size_t f = 0; f < OutFrames; f++) {
+        Frame frame(buf.data(), buf.size());
+        rr.read(frame);
+
+        for (size_t ch = 0; ch < nChannels; ch++) {
+            Frame mono_frame(mono_buf.data(), mono_buf.size());
+            mono_rrs[ch]->read(mono_frame);
+
+            for (size_t n = 0; n < FrameSize; n++) {
+                DOUBLES_EQUAL(mono_buf.data()[n], buf.data()[n * nChannels + ch], 1e-6);
+            }
+        }
+    }
+
+    for (size_t ch = 0; ch < nChannels; ch++) {
+        allocator.destroy(*mono_rrs[ch]);
+        allocator.destroy(*mono_resamplers[ch]);
+    }
+}
+
+// Check that large frames are supported and resampled the same way as
+// small frames.
+TEST(resampler, large_frame_size) {
+    enum {
+        ChMask = 0x1,
+        LargeFrameSize = 16384,
+        InSize = LargeFrameSize * 4,
+        OutSize = LargeFrameSize * 3
+    };
+
+    config.window_size = 32;
+    config.window_interp = 128;
+
+    static sample_t input[InSize];
+    for (size_t n = 0; n < InSize; n++) {
+        input[n] = (sample_t)std::sin(M_PI / 7 * double(n));
+    }
+
+    const size_t frame_sizes[] = { FrameSize, LargeFrameSize };
+
+    static sample_t outputs[ROC_ARRAY_SIZE(frame_sizes)][OutSize];
+
+    for (size_t i = 0; i < ROC_ARRAY_SIZE(frame_sizes); i++) {
+        const size_t frame_size = frame_sizes[i];
+
+        Resampler resampler(allocator, config, ChMask, frame_size);
+        CHECK(resampler.valid());
+        CHECK(resampler.set_scaling(0.95f));
+
+        size_t n_in = 0;
+        size_t n_out = 0;
+
+        while (n_out < OutSize) {
+            Frame frame(outputs[i] + n_out, frame_size);
+            if (resampler.resample_buff(frame)) {
+                n_out += frame_size;
+                continue;
+            }
+            CHECK(n_in < InSize);
+            n_in += resampler.push_input(input + n_in, frame_size);
+        }
+    }
+
+    for (size_t n = 0; n < OutSize; n++) {
+        DOUBLES_EQUAL(outputs[0][n], outputs[1][n], 1e-6);
+    }
+}
+
 } // namespace audio
 } // namespace roc
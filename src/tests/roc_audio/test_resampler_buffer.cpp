@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/resampler_buffer.h"
+#include "roc_core/heap_allocator.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum { NumCh = 2, HalfWindow = 5, ChunkSize = 16, NumSamples = 1000 };
+
+core::HeapAllocator allocator;
+
+sample_t nth_sample(size_t n, size_t channel) {
+    return (sample_t)(n + 1) * (channel == 0 ? 1.0f : -1.0f);
+}
+
+} // namespace
+
+TEST_GROUP(resampler_buffer) {
+    sample_t input[NumSamples * NumCh];
+
+    void setup() {
+        for (size_t n = 0; n < NumSamples; n++) {
+            for (size_t ch = 0; ch < NumCh; ch++) {
+                input[n * NumCh + ch] = nth_sample(n, ch);
+            }
+        }
+    }
+};
+
+TEST(resampler_buffer, initial_history) {
+    ResamplerBuffer buffer(allocator, NumCh, HalfWindow, ChunkSize);
+    CHECK(buffer.valid());
+
+    UNSIGNED_LONGS_EQUAL(0, buffer.available());
+
+    UNSIGNED_LONGS_EQUAL(3 * NumCh, buffer.write(input, 3 * NumCh));
+    UNSIGNED_LONGS_EQUAL(3, buffer.available());
+
+    const sample_t* window = buffer.window(HalfWindow);
+
+    for (size_t ch = 0; ch < NumCh; ch++) {
+        for (size_t n = 0; n < HalfWindow; n++) {
+            DOUBLES_EQUAL(0, window[n], 0);
+        }
+        for (size_t n = 0; n < 3; n++) {
+            DOUBLES_EQUAL(nth_sample(n, ch), window[HalfWindow + n], 0);
+        }
+        window += buffer.channel_stride();
+    }
+}
+
+TEST(resampler_buffer, full) {
+    ResamplerBuffer buffer(allocator, NumCh, HalfWindow, ChunkSize);
+    CHECK(buffer.valid());
+
+    const size_t capacity = HalfWindow + 1 + ChunkSize;
+
+    UNSIGNED_LONGS_EQUAL(capacity * NumCh, buffer.write(input, NumSamples * NumCh));
+    UNSIGNED_LONGS_EQUAL(capacity, buffer.available());
+
+    UNSIGNED_LONGS_EQUAL(0, buffer.write(input, NumCh));
+
+    buffer.advance(ChunkSize);
+    UNSIGNED_LONGS_EQUAL(HalfWindow + 1, buffer.available());
+
+    UNSIGNED_LONGS_EQUAL(ChunkSize * NumCh, buffer.write(input, NumSamples * NumCh));
+}
+
+// Every window is contiguous, including windows crossing the end of the ring,
+// for any input chunk sizes.
+TEST(resampler_buffer, contiguous_window) {
+    enum { WindowLen = HalfWindow * 2 + 1 };
+
+    ResamplerBuffer buffer(allocator, NumCh, HalfWindow, ChunkSize);
+    CHECK(buffer.valid());
+
+    size_t in_pos = 0;
+    size_t pos = 0;
+    size_t chunk = 1;
+
+    while (pos + WindowLen < NumSamples) {
+        in_pos += buffer.write(input + in_pos * NumCh, chunk * NumCh) / NumCh;
+        chunk = chunk % 7 + 1;
+
+        while (buffer.available() >= HalfWindow + 1) {
+            if (pos >= HalfWindow) {
+                const sample_t* window = buffer.window(HalfWindow);
+
+                for (size_t ch = 0; ch < NumCh; ch++) {
+                    for (size_t n = 0; n < WindowLen; n++) {
+                        DOUBLES_EQUAL(nth_sample(pos - HalfWindow + n, ch), window[n], 0);
+                    }
+                    window += buffer.channel_stride();
+                }
+            }
+
+            const size_t n_advance = pos % 3 + 1;
+            buffer.advance(n_advance);
+            pos += n_advance;
+        }
+    }
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/resampler_factory.h"
+#include "roc_audio/resampler_profile.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/helpers.h"
+#include "roc_core/unique_ptr.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum { ChMask = 0x3, FrameSize = 512 };
+
+const ResamplerProfile profiles[] = {
+    ResamplerProfile_Low,   ResamplerProfile_Medium, ResamplerProfile_High,
+    ResamplerProfile_Cubic, ResamplerProfile_Linear,
+};
+
+const float scalings[] = { 0.5f, 44100.0f / 48000.0f, 1.0f, 48000.0f / 44100.0f, 2.0f };
+
+core::HeapAllocator allocator;
+
+} // namespace
+
+TEST_GROUP(resampler_factory) {};
+
+TEST(resampler_factory, supported_scaling) {
+    for (size_t p = 0; p < ROC_ARRAY_SIZE(profiles); p++) {
+        for (size_t s = 0; s < ROC_ARRAY_SIZE(scalings); s++) {
+            core::UniquePtr<IResampler> resampler(
+                new_constant_rate_resampler(allocator, resampler_profile(profiles[p]),
+                                            ChMask, FrameSize, scalings[s]),
+                allocator);
+            CHECK(resampler);
+
+            sample_t input[FrameSize] = {};
+            sample_t output[FrameSize] = {};
+
+            Frame frame(output, FrameSize);
+
+            while (!resampler->resample_buff(frame)) {
+                UNSIGNED_LONGS_EQUAL(FrameSize, resampler->push_input(input, FrameSize));
+            }
+        }
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, allocator.num_allocations());
+}
+
+TEST(resampler_factory, unsupported_scaling) {
+    for (size_t p = 0; p < ROC_ARRAY_SIZE(profiles); p++) {
+        IResampler* resampler = new_constant_rate_resampler(
+            allocator, resampler_profile(profiles[p]), ChMask, FrameSize, FrameSize);
+        CHECK(!resampler);
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, allocator.num_allocations());
+}
+
+} // namespace audio
+} // namespace roc
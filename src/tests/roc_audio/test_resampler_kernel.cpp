@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/resampler.h"
+#include "roc_audio/resampler_kernel.h"
+#include "roc_audio/resampler_profile.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/helpers.h"
+#include "roc_core/random.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum { ChMask = 0x3, FrameSize = 512, NumFrames = 20 };
+
+const double Epsilon = 0.0001;
+
+const ResamplerProfile profiles[] = {
+    ResamplerProfile_Low,
+    ResamplerProfile_Medium,
+    ResamplerProfile_High,
+};
+
+const ResamplerKernelType kernels[] = {
+    ResamplerKernel_SSE2,
+    ResamplerKernel_AVX2,
+    ResamplerKernel_AVX512,
+};
+
+const float scalings[] = { 0.95f, 1.0f, 1.05f };
+
+core::HeapAllocator allocator;
+
+sample_t random_sample() {
+    return (sample_t)core::random(0, 2000) / 1000.0f - 1.0f;
+}
+
+} // namespace
+
+TEST_GROUP(resampler_kernel) {
+    sample_t input[NumFrames][FrameSize];
+
+    void setup() {
+        for (size_t f = 0; f < NumFrames; f++) {
+            for (size_t n = 0; n < FrameSize; n++) {
+                input[f][n] = random_sample();
+            }
+        }
+    }
+
+    // Runs resampler with given kernel over the input signal and stores output.
+    size_t resample(ResamplerProfile profile, ResamplerKernelType kernel, float scaling,
+                    sample_t* output, size_t output_size) {
+        ResamplerConfig config = resampler_profile(profile);
+        config.kernel = kernel;
+
+        Resampler resampler(allocator, config, ChMask, FrameSize);
+        CHECK(resampler.valid());
+        CHECK(resampler.set_scaling(scaling));
+
+        size_t n_out = 0;
+
+        for (size_t f = 0; f < NumFrames; f++) {
+            UNSIGNED_LONGS_EQUAL(FrameSize, resampler.push_input(input[f], FrameSize));
+
+            while (n_out + FrameSize <= output_size) {
+                Frame frame(output + n_out, FrameSize);
+                if (!resampler.resample_buff(frame)) {
+                    break;
+                }
+                n_out += FrameSize;
+            }
+        }
+
+        return n_out;
+    }
+};
+
+TEST(resampler_kernel, auto_is_supported) {
+    const ResamplerKernel* kernel = resampler_kernel(ResamplerKernel_Auto);
+
+    CHECK(kernel);
+    CHECK(kernel->name);
+    CHECK(kernel->type != ResamplerKernel_Auto);
+
+    CHECK(resampler_kernel(ResamplerKernel_Generic));
+}
+
+TEST(resampler_kernel, compute_window) {
+    enum { NumCoeffs = 203, TableSize = 4096, Shift = 18 };
+
+    sample_t table[TableSize];
+    for (size_t n = 0; n < TableSize; n++) {
+        table[n] = random_sample();
+    }
+
+    const ResamplerKernel* generic = resampler_kernel(ResamplerKernel_Generic);
+
+    for (size_t k = 0; k < ROC_ARRAY_SIZE(kernels); k++) {
+        const ResamplerKernel* kernel = resampler_kernel(kernels[k]);
+        if (!kernel) {
+            continue;
+        }
+
+        // increasing and decreasing runs
+        const uint32_t steps[] = { (1 << Shift) + 12345, uint32_t(0) - (1 << Shift) };
+        const uint32_t starts[] = { 0, (TableSize - 2) << Shift };
+
+        for (size_t s = 0; s < ROC_ARRAY_SIZE(steps); s++) {
+            for (size_t n_coeffs = 0; n_coeffs <= NumCoeffs; n_coeffs++) {
+                sample_t expected[NumCoeffs];
+                sample_t actual[NumCoeffs];
+
+                generic->compute_window(expected, n_coeffs, table, starts[s], steps[s],
+                                        Shift, 0.25f, 1.5f);
+                kernel->compute_window(actual, n_coeffs, table, starts[s], steps[s],
+                                       Shift, 0.25f, 1.5f);
+
+                for (size_t n = 0; n < n_coeffs; n++) {
+                    DOUBLES_EQUAL(expected[n], actual[n], 1e-7);
+                }
+            }
+        }
+    }
+}
+
+TEST(resampler_kernel, convolve) {
+    enum { NumCoeffs = 203, MaxStride = 3 };
+
+    sample_t coeffs[NumCoeffs];
+    sample_t samples[NumCoeffs * MaxStride];
+
+    for (size_t n = 0; n < NumCoeffs; n++) {
+        coeffs[n] = random_sample();
+    }
+    for (size_t n = 0; n < NumCoeffs * MaxStride; n++) {
+        samples[n] = random_sample();
+    }
+
+    const ResamplerKernel* generic = resampler_kernel(ResamplerKernel_Generic);
+
+    for (size_t k = 0; k < ROC_ARRAY_SIZE(kernels); k++) {
+        const ResamplerKernel* kernel = resampler_kernel(kernels[k]);
+        if (!kernel) {
+            continue;
+        }
+
+        for (size_t stride = 1; stride <= MaxStride; stride++) {
+            for (size_t n_coeffs = 0; n_coeffs <= NumCoeffs; n_coeffs++) {
+                const sample_t expected =
+                    generic->convolve(coeffs, samples, stride, n_coeffs);
+                const sample_t actual =
+                    kernel->convolve(coeffs, samples, stride, n_coeffs);
+
+                DOUBLES_EQUAL(expected, actual, Epsilon);
+            }
+        }
+    }
+}
+
+TEST(resampler_kernel, deinterleave) {
+    enum { NumSamples = 203, MaxChannels = 3, PlaneStride = NumSamples + 5 };
+
+    sample_t samples[NumSamples * MaxChannels];
+    for (size_t n = 0; n < NumSamples * MaxChannels; n++) {
+        samples[n] = random_sample();
+    }
+
+    const ResamplerKernelType all_kernels[] = {
+        ResamplerKernel_Generic,
+        ResamplerKernel_SSE2,
+        ResamplerKernel_AVX2,
+        ResamplerKernel_AVX512,
+    };
+
+    for (size_t k = 0; k < ROC_ARRAY_SIZE(all_kernels); k++) {
+        const ResamplerKernel* kernel = resampler_kernel(all_kernels[k]);
+        if (!kernel) {
+            continue;
+        }
+
+        for (size_t num_ch = 1; num_ch <= MaxChannels; num_ch++) {
+            for (size_t n_samples = 0; n_samples <= NumSamples; n_samples++) {
+                sample_t planes[PlaneStride * MaxChannels] = {};
+
+                kernel->deinterleave(planes, PlaneStride, samples, n_samples, num_ch);
+
+                for (size_t ch = 0; ch < num_ch; ch++) {
+                    for (size_t n = 0; n < PlaneStride; n++) {
+                        const sample_t expected =
+                            n < n_samples ? samples[n * num_ch + ch] : 0;
+                        CHECK(expected == planes[ch * PlaneStride + n]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(resampler_kernel, profiles) {
+    enum { OutSize = FrameSize * NumFrames };
+
+    for (size_t p = 0; p < ROC_ARRAY_SIZE(profiles); p++) {
+        for (size_t s = 0; s < ROC_ARRAY_SIZE(scalings); s++) {
+            sample_t expected[OutSize];
+            const size_t n_expected = resample(profiles[p], ResamplerKernel_Generic,
+                                               scalings[s], expected, OutSize);
+            CHECK(n_expected > 0);
+
+            for (size_t k = 0; k < ROC_ARRAY_SIZE(kernels); k++) {
+                if (!resampler_kernel(kernels[k])) {
+                    continue;
+                }
+
+                sample_t actual[OutSize];
+                const size_t n_actual =
+                    resample(profiles[p], kernels[k], scalings[s], actual, OutSize);
+
+                UNSIGNED_LONGS_EQUAL(n_expected, n_actual);
+
+                for (size_t n = 0; n < n_actual; n++) {
+                    DOUBLES_EQUAL(expected[n], actual[n], Epsilon);
+                }
+            }
+        }
+    }
+}
+
+} // namespace audio
+} // namespace roc
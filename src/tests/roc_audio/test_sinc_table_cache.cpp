@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/resampler.h"
+#include "roc_audio/sinc_table_cache.h"
+#include "roc_core/heap_allocator.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum { ChMask = 0x3, FrameSize = 512 };
+
+core::HeapAllocator allocator;
+
+} // namespace
+
+TEST_GROUP(sinc_table_cache) {};
+
+TEST(sinc_table_cache, same_config) {
+    SincTableCache& cache = SincTableCache::instance();
+
+    const size_t n_tables = cache.num_tables();
+
+    const sample_t* table1 = cache.acquire(32, 128);
+    CHECK(table1);
+    UNSIGNED_LONGS_EQUAL(n_tables + 1, cache.num_tables());
+
+    const sample_t* table2 = cache.acquire(32, 128);
+    POINTERS_EQUAL(table1, table2);
+    UNSIGNED_LONGS_EQUAL(n_tables + 1, cache.num_tables());
+
+    cache.release(table1);
+    UNSIGNED_LONGS_EQUAL(n_tables + 1, cache.num_tables());
+
+    cache.release(table2);
+    UNSIGNED_LONGS_EQUAL(n_tables, cache.num_tables());
+}
+
+TEST(sinc_table_cache, different_config) {
+    SincTableCache& cache = SincTableCache::instance();
+
+    const size_t n_tables = cache.num_tables();
+
+    const sample_t* table1 = cache.acquire(32, 128);
+    const sample_t* table2 = cache.acquire(32, 64);
+    const sample_t* table3 = cache.acquire(16, 128);
+
+    CHECK(table1);
+    CHECK(table2);
+    CHECK(table3);
+
+    CHECK(table1 != table2);
+    CHECK(table1 != table3);
+    CHECK(table2 != table3);
+
+    UNSIGNED_LONGS_EQUAL(n_tables + 3, cache.num_tables());
+
+    cache.release(table1);
+    cache.release(table2);
+    cache.release(table3);
+
+    UNSIGNED_LONGS_EQUAL(n_tables, cache.num_tables());
+}
+
+TEST(sinc_table_cache, table_values) {
+    enum { WindowSize = 4, WindowInterp = 8, TableSize = WindowSize * WindowInterp + 2 };
+
+    SincTableCache& cache = SincTableCache::instance();
+
+    const sample_t* table = cache.acquire(WindowSize, WindowInterp);
+    CHECK(table);
+
+    DOUBLES_EQUAL(1.0, table[0], 1e-6);
+
+    // zero crossings of sinc at integer positions
+    for (size_t n = WindowInterp; n < TableSize - 2; n += WindowInterp) {
+        DOUBLES_EQUAL(0.0, table[n], 1e-6);
+    }
+
+    // guard values used by interpolation
+    DOUBLES_EQUAL(0.0, table[TableSize - 2], 1e-6);
+    DOUBLES_EQUAL(0.0, table[TableSize - 1], 1e-6);
+
+    cache.release(table);
+}
+
+TEST(sinc_table_cache, resamplers) {
+    SincTableCache& cache = SincTableCache::instance();
+
+    const size_t n_tables = cache.num_tables();
+
+    ResamplerConfig config;
+
+    {
+        Resampler resampler1(allocator, config, ChMask, FrameSize);
+        CHECK(resampler1.valid());
+        UNSIGNED_LONGS_EQUAL(n_tables + 1, cache.num_tables());
+
+        Resampler resampler2(allocator, config, ChMask, FrameSize);
+        CHECK(resampler2.valid());
+        UNSIGNED_LONGS_EQUAL(n_tables + 1, cache.num_tables());
+
+        config.window_size /= 2;
+
+        Resampler resampler3(allocator, config, ChMask, FrameSize);
+        CHECK(resampler3.valid());
+        UNSIGNED_LONGS_EQUAL(n_tables + 2, cache.num_tables());
+    }
+
+    UNSIGNED_LONGS_EQUAL(n_tables, cache.num_tables());
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/hash_index.h"
+#include "roc_core/heap_allocator.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+enum { NumObjects = 1000 };
+
+// Hash has only a few distinct values, so that objects collide a lot.
+const size_t NumHashes = 7;
+
+struct Object {
+    size_t id;
+
+    size_t key() const {
+        return id;
+    }
+
+    static size_t key_hash(size_t key) {
+        return key % NumHashes;
+    }
+
+    static bool key_equal(size_t key1, size_t key2) {
+        return key1 == key2;
+    }
+};
+
+HeapAllocator allocator;
+
+} // namespace
+
+TEST_GROUP(hash_index) {
+    Object objects[NumObjects];
+
+    void setup() {
+        for (size_t n = 0; n < NumObjects; n++) {
+            objects[n].id = n;
+        }
+    }
+};
+
+TEST(hash_index, empty) {
+    HashIndex<Object, size_t> index(allocator);
+
+    LONGS_EQUAL(0, index.size());
+
+    POINTERS_EQUAL(NULL, index.find(0));
+}
+
+TEST(hash_index, insert_find) {
+    HashIndex<Object, size_t> index(allocator);
+
+    for (size_t n = 0; n < NumObjects; n++) {
+        CHECK(index.insert(objects[n]));
+        LONGS_EQUAL(n + 1, index.size());
+    }
+
+    for (size_t n = 0; n < NumObjects; n++) {
+        POINTERS_EQUAL(&objects[n], index.find(n));
+    }
+
+    POINTERS_EQUAL(NULL, index.find(NumObjects));
+}
+
+TEST(hash_index, remove) {
+    HashIndex<Object, size_t> index(allocator);
+
+    for (size_t n = 0; n < NumObjects; n++) {
+        CHECK(index.insert(objects[n]));
+    }
+
+    // remove every third object, so that holes appear in the middle of chains
+    for (size_t n = 0; n < NumObjects; n += 3) {
+        index.remove(objects[n]);
+    }
+
+    for (size_t n = 0; n < NumObjects; n++) {
+        if (n % 3 == 0) {
+            POINTERS_EQUAL(NULL, index.find(n));
+        } else {
+            POINTERS_EQUAL(&objects[n], index.find(n));
+        }
+    }
+
+    for (size_t n = 0; n < NumObjects; n++) {
+        if (n % 3 != 0) {
+            index.remove(objects[n]);
+        }
+    }
+
+    LONGS_EQUAL(0, index.size());
+
+    for (size_t n = 0; n < NumObjects; n++) {
+        POINTERS_EQUAL(NULL, index.find(n));
+    }
+}
+
+TEST(hash_index, reinsert) {
+    HashIndex<Object, size_t> index(allocator);
+
+    for (size_t i = 0; i < 10; i++) {
+        for (size_t n = 0; n < NumObjects; n++) {
+            CHECK(index.insert(objects[n]));
+        }
+
+        LONGS_EQUAL(NumObjects, index.size());
+
+        for (size_t n = 0; n < NumObjects; n++) {
+            POINTERS_EQUAL(&objects[n], index.find(n));
+            index.remove(objects[n]);
+        }
+
+        LONGS_EQUAL(0, index.size());
+    }
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_fec/composer.h"
+#include "roc_fec/headers.h"
+#include "roc_fec/parser.h"
+#include "roc_fec/reader.h"
+#include "roc_fec/rlc_reader.h"
+#include "roc_fec/rlc_writer.h"
+#include "roc_fec/rs8m_decoder.h"
+#include "roc_fec/rs8m_encoder.h"
+#include "roc_fec/writer.h"
+#include "roc_packet/packet_pool.h"
+#include "roc_packet/queue.h"
+#include "roc_rtp/composer.h"
+#include "roc_rtp/format_map.h"
+#include "roc_rtp/headers.h"
+#include "roc_rtp/parser.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+// Both schemes add 50% of repair traffic: Reed-Solomon uses 20+10 blocks,
+// RLC sends one repair packet per two source packets over a window of 10.
+enum {
+    RS8MSourcePackets = 20,
+    RS8MRepairPackets = 10,
+
+    RLCWindowLength = 10,
+    RLCSourcePackets = 2,
+    RLCRepairPackets = 1
+};
+
+enum { PayloadSize = 1024, MaxBuffSize = 1500 };
+
+// One of LossPeriod packets (source or repair) is lost.
+enum { LossPeriod = 20 };
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, MaxBuffSize, true);
+packet::PacketPool packet_pool(allocator, true);
+
+rtp::FormatMap format_map;
+rtp::Parser rtp_parser(format_map, NULL);
+rtp::Composer rtp_composer(NULL);
+
+fec::Parser<RSm8_PayloadID, Source, Footer> rs8m_source_parser(&rtp_parser);
+fec::Parser<RSm8_PayloadID, Repair, Header> rs8m_repair_parser(NULL);
+fec::Composer<RSm8_PayloadID, Source, Footer> rs8m_source_composer(&rtp_composer);
+fec::Composer<RSm8_PayloadID, Repair, Header> rs8m_repair_composer(NULL);
+
+fec::Parser<RLC_Source_PayloadID, Source, Footer> rlc_source_parser(&rtp_parser);
+fec::Parser<RLC_Repair_PayloadID, Repair, Header> rlc_repair_parser(NULL);
+fec::Composer<RLC_Source_PayloadID, Source, Footer> rlc_source_composer(&rtp_composer);
+fec::Composer<RLC_Repair_PayloadID, Repair, Header> rlc_repair_composer(NULL);
+
+// Delivers packets from writer to reader queues, losing some of them.
+class Network : public packet::IWriter {
+public:
+    Network(packet::IParser& source_parser, packet::IParser& repair_parser)
+        : source_parser_(source_parser)
+        , repair_parser_(repair_parser)
+        , seed_(1)
+        , n_lost_(0) {
+    }
+
+    packet::Queue& source_queue() {
+        return source_queue_;
+    }
+
+    packet::Queue& repair_queue() {
+        return repair_queue_;
+    }
+
+    size_t n_lost() const {
+        return n_lost_;
+    }
+
+    virtual void write(const packet::PacketPtr& pp) {
+        const bool is_repair = (pp->flags() & packet::Packet::FlagRepair);
+
+        seed_ = seed_ * 1103515245 + 12345;
+        if ((seed_ >> 16) % LossPeriod == 0) {
+            if (!is_repair) {
+                n_lost_++;
+            }
+            return;
+        }
+
+        packet::PacketPtr rp = new (packet_pool) packet::Packet(packet_pool);
+        if (!rp) {
+            roc_panic("bench: can't allocate packet");
+        }
+
+        if (!(is_repair ? repair_parser_ : source_parser_).parse(*rp, pp->data())) {
+            roc_panic("bench: can't parse packet");
+        }
+        rp->set_data(pp->data());
+
+        (is_repair ? repair_queue_ : source_queue_).write(rp);
+    }
+
+private:
+    packet::IParser& source_parser_;
+    packet::IParser& repair_parser_;
+
+    packet::Queue source_queue_;
+    packet::Queue repair_queue_;
+
+    uint32_t seed_;
+    size_t n_lost_;
+};
+
+packet::PacketPtr make_packet(packet::IComposer& composer, packet::seqnum_t sn) {
+    packet::PacketPtr pp = new (packet_pool) packet::Packet(packet_pool);
+    if (!pp) {
+        roc_panic("bench: can't allocate packet");
+    }
+
+    core::Slice<uint8_t> bp = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    if (!bp) {
+        roc_panic("bench: can't allocate buffer");
+    }
+
+    if (!composer.prepare(*pp, bp, PayloadSize - sizeof(rtp::Header))) {
+        roc_panic("bench: can't prepare packet");
+    }
+    pp->set_data(bp);
+
+    pp->add_flags(packet::Packet::FlagAudio);
+
+    pp->rtp()->source = 1;
+    pp->rtp()->payload_type = rtp::PayloadType_L16_Stereo;
+    pp->rtp()->seqnum = sn;
+    pp->rtp()->timestamp = packet::timestamp_t(sn) * 100;
+
+    memset(pp->rtp()->payload.data(), (int)sn, pp->rtp()->payload.size());
+
+    return pp;
+}
+
+// Writes one source packet per iteration. Receiver reads a packet only after
+// the given number of following source packets were sent, i.e. it has this
+// latency budget, in packets, for repairing losses. Reports the share of lost
+// source packets which were restored within the budget.
+void run_stream(benchmark::State& state,
+                packet::IWriter& writer,
+                packet::IReader& reader,
+                packet::IComposer& composer,
+                Network& network) {
+    const size_t latency = (size_t)state.range(0);
+
+    packet::seqnum_t write_sn = 0;
+    packet::seqnum_t read_sn = 0;
+
+    size_t n_written = 0;
+    size_t n_read = 0;
+    size_t n_restored = 0;
+
+    while (state.KeepRunning()) {
+        writer.write(make_packet(composer, write_sn));
+        write_sn++;
+        n_written++;
+
+        while (n_written - n_read > latency) {
+            packet::PacketPtr pp = reader.read();
+            if (!pp) {
+                break;
+            }
+            if (pp->flags() & packet::Packet::FlagRestored) {
+                n_restored++;
+            }
+            const packet::seqnum_t sn = pp->rtp()->seqnum;
+            n_read += (size_t)packet::seqnum_t(sn - read_sn) + 1;
+            read_sn = packet::seqnum_t(sn + 1);
+        }
+    }
+
+    state.counters["restored"] = network.n_lost() != 0
+        ? double(n_restored) / double(network.n_lost())
+        : 1.0;
+
+    state.SetBytesProcessed(state.iterations() * (int64_t)PayloadSize);
+}
+
+// Arguments: receiver latency budget, in packets.
+void BM_RS8M_Recovery(benchmark::State& state) {
+    CodecConfig codec_config;
+    codec_config.scheme = packet::FEC_ReedSolomon_M8;
+
+    WriterConfig writer_config;
+    writer_config.n_source_packets = RS8MSourcePackets;
+    writer_config.n_repair_packets = RS8MRepairPackets;
+
+    ReaderConfig reader_config;
+
+    RS8MEncoder encoder(codec_config, buffer_pool, allocator);
+    RS8MDecoder decoder(codec_config, buffer_pool, allocator);
+
+    Network network(rs8m_source_parser, rs8m_repair_parser);
+
+    Writer writer(writer_config, codec_config.scheme, encoder, network,
+                  rs8m_source_composer, rs8m_repair_composer, packet_pool, buffer_pool,
+                  allocator);
+    Reader reader(reader_config, codec_config.scheme, decoder, network.source_queue(),
+                  network.repair_queue(), rtp_parser, packet_pool, allocator);
+
+    if (!writer.valid() || !reader.valid()) {
+        state.SkipWithError("can't create writer or reader");
+        return;
+    }
+
+    run_stream(state, writer, reader, rs8m_source_composer, network);
+}
+
+// Arguments: receiver latency budget, in packets.
+void BM_RLC_Recovery(benchmark::State& state) {
+    RLCWriterConfig writer_config;
+    writer_config.window_length = RLCWindowLength;
+    writer_config.n_source_packets = RLCSourcePackets;
+    writer_config.n_repair_packets = RLCRepairPackets;
+
+    RLCReaderConfig reader_config;
+
+    Network network(rlc_source_parser, rlc_repair_parser);
+
+    RLCWriter writer(writer_config, network, rlc_source_composer, rlc_repair_composer,
+                     packet_pool, buffer_pool, allocator);
+    RLCReader reader(reader_config, network.source_queue(), network.repair_queue(),
+                     rtp_parser, packet_pool, buffer_pool, allocator);
+
+    if (!writer.valid() || !reader.valid()) {
+        state.SkipWithError("can't create writer or reader");
+        return;
+    }
+
+    run_stream(state, writer, reader, rlc_source_composer, network);
+}
+
+BENCHMARK(BM_RS8M_Recovery)->Arg(2)->Arg(5)->Arg(10)->Arg(20)->Arg(30)->Arg(40);
+
+BENCHMARK(BM_RLC_Recovery)->Arg(2)->Arg(5)->Arg(10)->Arg(20)->Arg(30)->Arg(40);
+
+} // namespace
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/random.h"
+#include "roc_fec/gf256_kernel.h"
+#include "roc_fec/rs8m_decoder.h"
+#include "roc_fec/rs8m_encoder.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+enum { PayloadSize = 1024, MaxBlockLength = 255 };
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, PayloadSize, true);
+
+CodecConfig make_config() {
+    CodecConfig config;
+    config.scheme = packet::FEC_ReedSolomon_M8;
+    return config;
+}
+
+struct Block {
+    core::Slice<uint8_t> buffers[MaxBlockLength];
+
+    Block(size_t sblen, size_t rblen) {
+        for (size_t i = 0; i < sblen + rblen; i++) {
+            buffers[i] = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+            buffers[i].resize(PayloadSize);
+            for (size_t j = 0; j < PayloadSize; j++) {
+                buffers[i].data()[j] = (uint8_t)core::random(0, 0xff);
+            }
+        }
+    }
+};
+
+void encode(RS8MEncoder& encoder, Block& block, size_t sblen, size_t rblen) {
+    encoder.begin(sblen, rblen, PayloadSize);
+    for (size_t i = 0; i < sblen + rblen; i++) {
+        encoder.set(i, block.buffers[i]);
+    }
+    encoder.fill();
+    encoder.end();
+}
+
+// Arguments: kernel type.
+void BM_GF256_MulAdd(benchmark::State& state) {
+    const GF256Kernel* kernel = gf256_kernel((GF256KernelType)state.range(0));
+    if (!kernel) {
+        state.SkipWithError("kernel not supported");
+        return;
+    }
+
+    uint8_t src[PayloadSize], dst[PayloadSize];
+    for (size_t n = 0; n < PayloadSize; n++) {
+        src[n] = (uint8_t)core::random(0, 0xff);
+        dst[n] = 0;
+    }
+
+    while (state.KeepRunning()) {
+        kernel->mul_add(dst, src, 0x8e, PayloadSize);
+        benchmark::DoNotOptimize(dst);
+    }
+
+    state.SetBytesProcessed(state.iterations() * PayloadSize);
+    state.SetLabel(kernel->name);
+}
+
+// Arguments: source block length, repair block length.
+// Bytes are counted for source packets protected by the block.
+void BM_RS8M_Encode(benchmark::State& state) {
+    const size_t sblen = (size_t)state.range(0);
+    const size_t rblen = (size_t)state.range(1);
+
+    RS8MEncoder encoder(make_config(), buffer_pool, allocator);
+    Block block(sblen, rblen);
+
+    while (state.KeepRunning()) {
+        encode(encoder, block, sblen, rblen);
+    }
+
+    state.SetBytesProcessed(state.iterations() * (int64_t)(sblen * PayloadSize));
+}
+
+// Arguments: source block length, repair block length.
+// The first min(sblen, rblen) source packets are lost in every block.
+void BM_RS8M_Decode(benchmark::State& state) {
+    const size_t sblen = (size_t)state.range(0);
+    const size_t rblen = (size_t)state.range(1);
+    const size_t n_lost = std::min(sblen, rblen);
+
+    RS8MEncoder encoder(make_config(), buffer_pool, allocator);
+    RS8MDecoder decoder(make_config(), buffer_pool, allocator);
+    Block block(sblen, rblen);
+
+    encode(encoder, block, sblen, rblen);
+
+    while (state.KeepRunning()) {
+        decoder.begin(sblen, rblen, PayloadSize);
+        for (size_t i = n_lost; i < sblen + rblen; i++) {
+            decoder.set(i, block.buffers[i]);
+        }
+        for (size_t i = 0; i < n_lost; i++) {
+            benchmark::DoNotOptimize(decoder.repair(i));
+        }
+        decoder.end();
+    }
+
+    state.SetBytesProcessed(state.iterations() * (int64_t)(sblen * PayloadSize));
+}
+
+BENCHMARK(BM_GF256_MulAdd)
+    ->Arg(GF256Kernel_Generic)
+    ->Arg(GF256Kernel_SSSE3)
+    ->Arg(GF256Kernel_AVX2);
+
+BENCHMARK(BM_RS8M_Encode)
+    ->Args({ 10, 5 })
+    ->Args({ 20, 10 })
+    ->Args({ 50, 25 })
+    ->Args({ 100, 50 })
+    ->Args({ 200, 55 });
+
+BENCHMARK(BM_RS8M_Decode)
+    ->Args({ 10, 5 })
+    ->Args({ 20, 10 })
+    ->Args({ 50, 25 })
+    ->Args({ 100, 50 })
+    ->Args({ 200, 55 });
+
+} // namespace
+
+} // namespace fec
+} // namespace roc
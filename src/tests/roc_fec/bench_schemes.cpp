@@ -0,0 +1,575 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+// Benchmarks for FEC schemes registered in CodecMap.
+//
+// Every benchmark takes the same arguments: fec scheme, source block length,
+// repair block length, payload size, and loss model. One iteration processes
+// one block, so reported time is per-block latency. Reported counters:
+//  - bytes_per_second: throughput, counting payload of source packets
+//  - loss: share of lost source packets (decoding benchmarks only)
+//  - recovered: share of lost source packets that were restored (decoding
+//    benchmarks only)
+//
+// Schemes that are not enabled in the build are skipped with an error.
+// Use --benchmark_format=json or --benchmark_out=<file> to get results
+// in machine-readable form.
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/unique_ptr.h"
+#include "roc_fec/codec_map.h"
+#include "roc_fec/composer.h"
+#include "roc_fec/headers.h"
+#include "roc_fec/parser.h"
+#include "roc_fec/reader.h"
+#include "roc_fec/writer.h"
+#include "roc_packet/fec_scheme_to_str.h"
+#include "roc_packet/packet_pool.h"
+#include "roc_packet/queue.h"
+#include "roc_rtp/composer.h"
+#include "roc_rtp/format_map.h"
+#include "roc_rtp/headers.h"
+#include "roc_rtp/parser.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+enum { MaxPayloadSize = 1024, MaxBuffSize = 1500, MaxBlockLength = 255 };
+
+// Number of precomputed loss patterns for codec benchmarks.
+enum { NumLossPatterns = 64 };
+
+enum LossModel {
+    // No losses.
+    Loss_None,
+
+    // Every packet is lost independently with 5% probability.
+    Loss_Uniform,
+
+    // Gilbert-Elliott model: a two-state Markov chain, with 1% losses in the
+    // good state and 50% losses in the bad state. Average loss rate is about
+    // 5%, like in the uniform model, but losses come in bursts.
+    Loss_Bursty
+};
+
+const double UniformLossRate = 0.05;
+
+const double GoodToBadRate = 0.02;
+const double BadToGoodRate = 0.25;
+const double GoodLossRate = 0.01;
+const double BadLossRate = 0.5;
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, MaxBuffSize, true);
+packet::PacketPool packet_pool(allocator, true);
+
+CodecMap codec_map;
+
+rtp::FormatMap format_map;
+rtp::Parser rtp_parser(format_map, NULL);
+rtp::Composer rtp_composer(NULL);
+
+fec::Parser<RSm8_PayloadID, Source, Footer> rs8m_source_parser(&rtp_parser);
+fec::Parser<RSm8_PayloadID, Repair, Header> rs8m_repair_parser(NULL);
+fec::Composer<RSm8_PayloadID, Source, Footer> rs8m_source_composer(&rtp_composer);
+fec::Composer<RSm8_PayloadID, Repair, Header> rs8m_repair_composer(NULL);
+
+fec::Parser<LDPC_Source_PayloadID, Source, Footer> ldpc_source_parser(&rtp_parser);
+fec::Parser<LDPC_Repair_PayloadID, Repair, Header> ldpc_repair_parser(NULL);
+fec::Composer<LDPC_Source_PayloadID, Source, Footer> ldpc_source_composer(&rtp_composer);
+fec::Composer<LDPC_Repair_PayloadID, Repair, Header> ldpc_repair_composer(NULL);
+
+fec::Parser<Parity_Source_PayloadID, Source, Footer> parity_source_parser(&rtp_parser);
+fec::Parser<Parity_Repair_PayloadID, Repair, Header> parity_repair_parser(NULL);
+fec::Composer<Parity_Source_PayloadID, Source, Footer>
+    parity_source_composer(&rtp_composer);
+fec::Composer<Parity_Repair_PayloadID, Repair, Header> parity_repair_composer(NULL);
+
+const char* loss_model_to_str(LossModel model) {
+    switch (model) {
+    case Loss_None:
+        return "none";
+    case Loss_Uniform:
+        return "uniform";
+    case Loss_Bursty:
+        return "bursty";
+    }
+    return "?";
+}
+
+// Deterministic packet loss generator.
+class LossGenerator {
+public:
+    explicit LossGenerator(LossModel model)
+        : model_(model)
+        , seed_(1)
+        , bad_state_(false) {
+    }
+
+    // Returns true if next packet is lost.
+    bool next() {
+        switch (model_) {
+        case Loss_None:
+            return false;
+
+        case Loss_Uniform:
+            return chance_() < UniformLossRate;
+
+        case Loss_Bursty:
+            if (chance_() < (bad_state_ ? BadToGoodRate : GoodToBadRate)) {
+                bad_state_ = !bad_state_;
+            }
+            return chance_() < (bad_state_ ? BadLossRate : GoodLossRate);
+        }
+
+        return false;
+    }
+
+private:
+    double chance_() {
+        seed_ = seed_ * 1103515245 + 12345;
+        return double((seed_ >> 8) & 0xffffff) / double(0x1000000);
+    }
+
+    const LossModel model_;
+    uint32_t seed_;
+    bool bad_state_;
+};
+
+struct Params {
+    packet::FECScheme scheme;
+    size_t sblen;
+    size_t rblen;
+    size_t payload_size;
+    LossModel loss;
+
+    explicit Params(const benchmark::State& state)
+        : scheme((packet::FECScheme)state.range(0))
+        , sblen((size_t)state.range(1))
+        , rblen((size_t)state.range(2))
+        , payload_size((size_t)state.range(3))
+        , loss((LossModel)state.range(4)) {
+    }
+
+    std::string label() const {
+        return std::string(packet::fec_scheme_to_str(scheme)) + "/"
+            + loss_model_to_str(loss);
+    }
+};
+
+packet::IComposer* source_composer(packet::FECScheme scheme) {
+    switch ((int)scheme) {
+    case packet::FEC_ReedSolomon_M8:
+        return &rs8m_source_composer;
+    case packet::FEC_LDPC_Staircase:
+        return &ldpc_source_composer;
+    case packet::FEC_Parity:
+        return &parity_source_composer;
+    }
+    return NULL;
+}
+
+packet::IComposer* repair_composer(packet::FECScheme scheme) {
+    switch ((int)scheme) {
+    case packet::FEC_ReedSolomon_M8:
+        return &rs8m_repair_composer;
+    case packet::FEC_LDPC_Staircase:
+        return &ldpc_repair_composer;
+    case packet::FEC_Parity:
+        return &parity_repair_composer;
+    }
+    return NULL;
+}
+
+packet::IParser* source_parser(packet::FECScheme scheme) {
+    switch ((int)scheme) {
+    case packet::FEC_ReedSolomon_M8:
+        return &rs8m_source_parser;
+    case packet::FEC_LDPC_Staircase:
+        return &ldpc_source_parser;
+    case packet::FEC_Parity:
+        return &parity_source_parser;
+    }
+    return NULL;
+}
+
+packet::IParser* repair_parser(packet::FECScheme scheme) {
+    switch ((int)scheme) {
+    case packet::FEC_ReedSolomon_M8:
+        return &rs8m_repair_parser;
+    case packet::FEC_LDPC_Staircase:
+        return &ldpc_repair_parser;
+    case packet::FEC_Parity:
+        return &parity_repair_parser;
+    }
+    return NULL;
+}
+
+void report_throughput(benchmark::State& state, const Params& params) {
+    state.SetBytesProcessed(state.iterations()
+                            * (int64_t)(params.sblen * params.payload_size));
+    state.SetLabel(params.label());
+}
+
+void report_recovery(benchmark::State& state,
+                     size_t n_total,
+                     size_t n_lost,
+                     size_t n_recovered) {
+    state.counters["loss"] = n_total != 0 ? double(n_lost) / double(n_total) : 0.0;
+    state.counters["recovered"] =
+        n_lost != 0 ? double(n_recovered) / double(n_lost) : 1.0;
+}
+
+struct Block {
+    core::Slice<uint8_t> buffers[MaxBlockLength];
+
+    bool encode(IBlockEncoder& encoder, const Params& params) {
+        if (!encoder.begin(params.sblen, params.rblen, params.payload_size)) {
+            return false;
+        }
+        for (size_t i = 0; i < params.sblen + params.rblen; i++) {
+            if (!buffers[i]) {
+                buffers[i] = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+                if (!buffers[i]) {
+                    return false;
+                }
+                buffers[i].resize(params.payload_size);
+                for (size_t j = 0; j < params.payload_size; j++) {
+                    buffers[i].data()[j] = (uint8_t)(i * 7 + j);
+                }
+            }
+            encoder.set(i, buffers[i]);
+        }
+        encoder.fill();
+        encoder.end();
+        return true;
+    }
+};
+
+// Measures sender cost of a block: begin, set all buffers, fill, end.
+void BM_Scheme_Encode(benchmark::State& state) {
+    const Params params(state);
+
+    CodecConfig config;
+    config.scheme = params.scheme;
+
+    core::UniquePtr<IBlockEncoder> encoder(
+        codec_map.new_encoder(config, buffer_pool, allocator), allocator);
+    if (!encoder) {
+        state.SkipWithError("scheme not supported");
+        return;
+    }
+
+    Block block;
+
+    while (state.KeepRunning()) {
+        if (!block.encode(*encoder, params)) {
+            state.SkipWithError("can't encode block");
+            return;
+        }
+    }
+
+    report_throughput(state, params);
+}
+
+// Measures receiver cost of a block: begin, set received buffers, repair lost
+// source buffers, end. Losses are applied to both source and repair packets.
+void BM_Scheme_Decode(benchmark::State& state) {
+    const Params params(state);
+    const size_t blen = params.sblen + params.rblen;
+
+    CodecConfig config;
+    config.scheme = params.scheme;
+
+    core::UniquePtr<IBlockEncoder> encoder(
+        codec_map.new_encoder(config, buffer_pool, allocator), allocator);
+    core::UniquePtr<IBlockDecoder> decoder(
+        codec_map.new_decoder(config, buffer_pool, allocator), allocator);
+    if (!encoder || !decoder) {
+        state.SkipWithError("scheme not supported");
+        return;
+    }
+
+    Block block;
+    if (!block.encode(*encoder, params)) {
+        state.SkipWithError("can't encode block");
+        return;
+    }
+
+    static bool lost[NumLossPatterns][MaxBlockLength];
+
+    LossGenerator loss(params.loss);
+    for (size_t n = 0; n < NumLossPatterns; n++) {
+        for (size_t i = 0; i < blen; i++) {
+            lost[n][i] = loss.next();
+        }
+    }
+
+    size_t n_total = 0, n_lost = 0, n_recovered = 0;
+    size_t pattern = 0;
+
+    while (state.KeepRunning()) {
+        const bool* block_lost = lost[pattern];
+        pattern = (pattern + 1) % NumLossPatterns;
+
+        if (!decoder->begin(params.sblen, params.rblen, params.payload_size)) {
+            state.SkipWithError("can't decode block");
+            return;
+        }
+
+        for (size_t i = 0; i < blen; i++) {
+            if (!block_lost[i]) {
+                decoder->set(i, block.buffers[i]);
+            }
+        }
+
+        for (size_t i = 0; i < params.sblen; i++) {
+            if (block_lost[i]) {
+                n_lost++;
+                if (decoder->repair(i)) {
+                    n_recovered++;
+                }
+            }
+        }
+
+        decoder->end();
+
+        n_total += params.sblen;
+    }
+
+    report_throughput(state, params);
+    report_recovery(state, n_total, n_lost, n_recovered);
+}
+
+// Delivers packets from writer to reader queues, losing some of them.
+class Network : public packet::IWriter {
+public:
+    Network(packet::IParser& source_parser,
+            packet::IParser& repair_parser,
+            LossModel loss)
+        : source_parser_(source_parser)
+        , repair_parser_(repair_parser)
+        , loss_(loss)
+        , n_source_(0)
+        , n_lost_(0) {
+    }
+
+    packet::Queue& source_queue() {
+        return source_queue_;
+    }
+
+    packet::Queue& repair_queue() {
+        return repair_queue_;
+    }
+
+    size_t n_source() const {
+        return n_source_;
+    }
+
+    size_t n_lost() const {
+        return n_lost_;
+    }
+
+    virtual void write(const packet::PacketPtr& pp) {
+        const bool is_repair = (pp->flags() & packet::Packet::FlagRepair);
+
+        if (!is_repair) {
+            n_source_++;
+        }
+
+        if (loss_.next()) {
+            if (!is_repair) {
+                n_lost_++;
+            }
+            return;
+        }
+
+        packet::PacketPtr rp = new (packet_pool) packet::Packet(packet_pool);
+        if (!rp) {
+            roc_panic("bench: can't allocate packet");
+        }
+
+        if (!(is_repair ? repair_parser_ : source_parser_).parse(*rp, pp->data())) {
+            roc_panic("bench: can't parse packet");
+        }
+        rp->set_data(pp->data());
+
+        (is_repair ? repair_queue_ : source_queue_).write(rp);
+    }
+
+private:
+    packet::IParser& source_parser_;
+    packet::IParser& repair_parser_;
+
+    packet::Queue source_queue_;
+    packet::Queue repair_queue_;
+
+    LossGenerator loss_;
+
+    size_t n_source_;
+    size_t n_lost_;
+};
+
+packet::PacketPtr
+make_packet(packet::IComposer& composer, size_t payload_size, packet::seqnum_t sn) {
+    packet::PacketPtr pp = new (packet_pool) packet::Packet(packet_pool);
+    if (!pp) {
+        roc_panic("bench: can't allocate packet");
+    }
+
+    core::Slice<uint8_t> bp = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    if (!bp) {
+        roc_panic("bench: can't allocate buffer");
+    }
+
+    if (!composer.prepare(*pp, bp, payload_size - sizeof(rtp::Header))) {
+        roc_panic("bench: can't prepare packet");
+    }
+    pp->set_data(bp);
+
+    pp->add_flags(packet::Packet::FlagAudio);
+
+    pp->rtp()->source = 1;
+    pp->rtp()->payload_type = rtp::PayloadType_L16_Stereo;
+    pp->rtp()->seqnum = sn;
+    pp->rtp()->timestamp = packet::timestamp_t(sn) * 100;
+
+    memset(pp->rtp()->payload.data(), (int)sn, pp->rtp()->payload.size());
+
+    return pp;
+}
+
+// Measures the full path: packets of a block are written to fec::Writer,
+// delivered with losses, and read from fec::Reader. Reader lags one block
+// behind writer, so that all packets of a block arrive before its lost
+// packets are needed.
+void BM_Scheme_WriterReader(benchmark::State& state) {
+    const Params params(state);
+
+    CodecConfig codec_config;
+    codec_config.scheme = params.scheme;
+
+    WriterConfig writer_config;
+    writer_config.n_source_packets = params.sblen;
+    writer_config.n_repair_packets = params.rblen;
+
+    ReaderConfig reader_config;
+
+    core::UniquePtr<IBlockEncoder> encoder(
+        codec_map.new_encoder(codec_config, buffer_pool, allocator), allocator);
+    core::UniquePtr<IBlockDecoder> decoder(
+        codec_map.new_decoder(codec_config, buffer_pool, allocator), allocator);
+    if (!encoder || !decoder) {
+        state.SkipWithError("scheme not supported");
+        return;
+    }
+
+    packet::IComposer& composer = *source_composer(params.scheme);
+
+    Network network(*source_parser(params.scheme), *repair_parser(params.scheme),
+                    params.loss);
+
+    Writer writer(writer_config, params.scheme, *encoder, network, composer,
+                  *repair_composer(params.scheme), packet_pool, buffer_pool, allocator);
+    Reader reader(reader_config, params.scheme, *decoder, network.source_queue(),
+                  network.repair_queue(), rtp_parser, packet_pool, allocator);
+
+    if (!writer.valid() || !reader.valid()) {
+        state.SkipWithError("can't create writer or reader");
+        return;
+    }
+
+    packet::seqnum_t write_sn = 0;
+    packet::seqnum_t read_sn = 0;
+
+    size_t n_written = 0;
+    size_t n_read = 0;
+    size_t n_recovered = 0;
+
+    while (state.KeepRunning()) {
+        for (size_t n = 0; n < params.sblen; n++) {
+            writer.write(make_packet(composer, params.payload_size, write_sn));
+            write_sn++;
+            n_written++;
+        }
+
+        while (n_written - n_read > params.sblen) {
+            packet::PacketPtr pp = reader.read();
+            if (!pp) {
+                break;
+            }
+            if (pp->flags() & packet::Packet::FlagRestored) {
+                n_recovered++;
+            }
+            const packet::seqnum_t sn = pp->rtp()->seqnum;
+            n_read += (size_t)packet::seqnum_t(sn - read_sn) + 1;
+            read_sn = packet::seqnum_t(sn + 1);
+        }
+    }
+
+    report_throughput(state, params);
+    report_recovery(state, network.n_source(), network.n_lost(), n_recovered);
+}
+
+void CodecArgs(benchmark::internal::Benchmark* b) {
+    const int schemes[] = {
+        packet::FEC_ReedSolomon_M8,
+        packet::FEC_LDPC_Staircase,
+        packet::FEC_Parity,
+    };
+    // 20+9 forms 4x5 matrix with row and column parity for parity scheme
+    const int blocks[][2] = {
+        { 10, 5 }, { 20, 10 }, { 20, 9 }, { 100, 50 }, { 200, 55 },
+    };
+    const int payload_sizes[] = { 256, 1024 };
+
+    for (size_t s = 0; s < ROC_ARRAY_SIZE(schemes); s++) {
+        for (size_t n = 0; n < ROC_ARRAY_SIZE(blocks); n++) {
+            for (size_t p = 0; p < ROC_ARRAY_SIZE(payload_sizes); p++) {
+                b->Args({ schemes[s], blocks[n][0], blocks[n][1], payload_sizes[p],
+                          Loss_None });
+            }
+        }
+    }
+}
+
+void LossArgs(benchmark::internal::Benchmark* b) {
+    const int schemes[] = {
+        packet::FEC_ReedSolomon_M8,
+        packet::FEC_LDPC_Staircase,
+        packet::FEC_Parity,
+    };
+    const int blocks[][2] = {
+        { 10, 5 }, { 20, 10 }, { 20, 9 }, { 100, 50 }, { 200, 55 },
+    };
+    const int losses[] = { Loss_None, Loss_Uniform, Loss_Bursty };
+
+    for (size_t s = 0; s < ROC_ARRAY_SIZE(schemes); s++) {
+        for (size_t n = 0; n < ROC_ARRAY_SIZE(blocks); n++) {
+            for (size_t l = 0; l < ROC_ARRAY_SIZE(losses); l++) {
+                b->Args({ schemes[s], blocks[n][0], blocks[n][1], 1024, losses[l] });
+            }
+        }
+    }
+}
+
+BENCHMARK(BM_Scheme_Encode)->Apply(CodecArgs);
+
+BENCHMARK(BM_Scheme_Decode)->Apply(LossArgs);
+
+BENCHMARK(BM_Scheme_WriterReader)->Apply(LossArgs);
+
+} // namespace
+
+} // namespace fec
+} // namespace roc
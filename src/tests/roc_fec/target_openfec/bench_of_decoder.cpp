@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/random.h"
+#include "roc_fec/of_decoder.h"
+#include "roc_fec/of_encoder.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+enum { SourceLen = 20, RepairLen = 10, PayloadSize = 256 };
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, PayloadSize, true);
+
+// Arguments: fec scheme, number of lost source packets.
+// Measures per-block cost of the receiver: begin, set all received
+// packets, repair lost ones, end.
+void BM_OFDecoder_Block(benchmark::State& state) {
+    CodecConfig config;
+    config.scheme = (packet::FECScheme)state.range(0);
+
+    const size_t n_lost = (size_t)state.range(1);
+
+    OFEncoder encoder(config, buffer_pool, allocator);
+    OFDecoder decoder(config, buffer_pool, allocator);
+
+    core::Slice<uint8_t> buffers[SourceLen + RepairLen];
+
+    encoder.begin(SourceLen, RepairLen, PayloadSize);
+    for (size_t i = 0; i < SourceLen + RepairLen; i++) {
+        buffers[i] = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+        buffers[i].resize(PayloadSize);
+        for (size_t j = 0; j < PayloadSize; j++) {
+            buffers[i].data()[j] = (uint8_t)core::random(0, 0xff);
+        }
+        encoder.set(i, buffers[i]);
+    }
+    encoder.fill();
+    encoder.end();
+
+    while (state.KeepRunning()) {
+        decoder.begin(SourceLen, RepairLen, PayloadSize);
+        for (size_t i = n_lost; i < SourceLen + RepairLen; i++) {
+            decoder.set(i, buffers[i]);
+        }
+        for (size_t i = 0; i < n_lost; i++) {
+            benchmark::DoNotOptimize(decoder.repair(i));
+        }
+        decoder.end();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_OFDecoder_Block)
+    ->Args({ packet::FEC_ReedSolomon_M8, 0 })
+    ->Args({ packet::FEC_ReedSolomon_M8, 1 })
+    ->Args({ packet::FEC_ReedSolomon_M8, 5 })
+    ->Args({ packet::FEC_LDPC_Staircase, 0 })
+    ->Args({ packet::FEC_LDPC_Staircase, 1 })
+    ->Args({ packet::FEC_LDPC_Staircase, 5 });
+
+} // namespace
+
+} // namespace fec
+} // namespace roc
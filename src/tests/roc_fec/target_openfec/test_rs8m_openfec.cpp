@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/helpers.h"
+#include "roc_core/random.h"
+#include "roc_fec/of_decoder.h"
+#include "roc_fec/of_encoder.h"
+#include "roc_fec/rs8m_decoder.h"
+#include "roc_fec/rs8m_encoder.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+enum { MaxPayloadSize = 1024, MaxBlockLength = 255 };
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, MaxPayloadSize, true);
+
+CodecConfig make_config() {
+    CodecConfig config;
+    config.scheme = packet::FEC_ReedSolomon_M8;
+    return config;
+}
+
+core::Slice<uint8_t> make_buffer(size_t size) {
+    core::Slice<uint8_t> buf = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    CHECK(buf);
+    buf.resize(size);
+    return buf;
+}
+
+struct BlockSize {
+    size_t sblen;
+    size_t rblen;
+    size_t payload_size;
+};
+
+const BlockSize block_sizes[] = {
+    { 1, 1, 8 },    { 1, 10, 100 },  { 10, 1, 100 },   { 18, 10, 251 },
+    { 20, 10, 640 }, { 64, 32, 1024 }, { 100, 155, 40 }, { 254, 1, 16 },
+};
+
+} // namespace
+
+TEST_GROUP(rs8m_openfec) {
+    core::Slice<uint8_t> of_buffers[MaxBlockLength];
+    core::Slice<uint8_t> rs_buffers[MaxBlockLength];
+
+    void encode(IBlockEncoder & encoder, core::Slice<uint8_t> * buffers,
+                const BlockSize& bs) {
+        CHECK(encoder.begin(bs.sblen, bs.rblen, bs.payload_size));
+        for (size_t i = 0; i < bs.sblen + bs.rblen; i++) {
+            encoder.set(i, buffers[i]);
+        }
+        encoder.fill();
+        encoder.end();
+    }
+
+    void encode_both(const BlockSize& bs) {
+        OFEncoder of_encoder(make_config(), buffer_pool, allocator);
+        RS8MEncoder rs_encoder(make_config(), buffer_pool, allocator);
+
+        CHECK(of_encoder.valid());
+        CHECK(rs_encoder.valid());
+
+        for (size_t i = 0; i < bs.sblen + bs.rblen; i++) {
+            of_buffers[i] = make_buffer(bs.payload_size);
+            rs_buffers[i] = make_buffer(bs.payload_size);
+
+            for (size_t j = 0; j < bs.payload_size; j++) {
+                const uint8_t b =
+                    i < bs.sblen ? (uint8_t)core::random(0, 0xff) : (uint8_t)0;
+                of_buffers[i].data()[j] = b;
+                rs_buffers[i].data()[j] = b;
+            }
+        }
+
+        encode(of_encoder, of_buffers, bs);
+        encode(rs_encoder, rs_buffers, bs);
+    }
+
+    // Drop first rblen source packets and repair them using given decoder.
+    void decode(IBlockDecoder & decoder, core::Slice<uint8_t> * buffers,
+                const BlockSize& bs) {
+        const size_t n_lost = std::min(bs.sblen, bs.rblen);
+
+        CHECK(decoder.begin(bs.sblen, bs.rblen, bs.payload_size));
+
+        for (size_t i = n_lost; i < bs.sblen + bs.rblen; i++) {
+            decoder.set(i, buffers[i]);
+        }
+
+        for (size_t i = 0; i < bs.sblen; i++) {
+            core::Slice<uint8_t> buf = decoder.repair(i);
+            CHECK(buf);
+            CHECK(memcmp(buffers[i].data(), buf.data(), bs.payload_size) == 0);
+        }
+
+        decoder.end();
+    }
+};
+
+TEST(rs8m_openfec, same_repair_symbols) {
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(block_sizes); n++) {
+        const BlockSize& bs = block_sizes[n];
+
+        encode_both(bs);
+
+        for (size_t i = bs.sblen; i < bs.sblen + bs.rblen; i++) {
+            CHECK(memcmp(of_buffers[i].data(), rs_buffers[i].data(), bs.payload_size)
+                  == 0);
+        }
+    }
+}
+
+TEST(rs8m_openfec, openfec_to_native) {
+    RS8MDecoder decoder(make_config(), buffer_pool, allocator);
+    CHECK(decoder.valid());
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(block_sizes); n++) {
+        encode_both(block_sizes[n]);
+        decode(decoder, of_buffers, block_sizes[n]);
+    }
+}
+
+TEST(rs8m_openfec, native_to_openfec) {
+    OFDecoder decoder(make_config(), buffer_pool, allocator);
+    CHECK(decoder.valid());
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(block_sizes); n++) {
+        encode_both(block_sizes[n]);
+        decode(decoder, rs_buffers, block_sizes[n]);
+    }
+}
+
+} // namespace fec
+} // namespace roc
@@ -64,6 +64,44 @@ fec::Composer<RSm8_PayloadID, Repair, Header> rs8m_repair_composer(NULL);
 fec::Composer<LDPC_Source_PayloadID, Source, Footer> ldpc_source_composer(&rtp_composer);
 fec::Composer<LDPC_Repair_PayloadID, Repair, Header> ldpc_repair_composer(NULL);
 
+// Forwards calls to another decoder and counts decoded blocks.
+class CountingDecoder : public IBlockDecoder {
+public:
+    CountingDecoder(IBlockDecoder& decoder)
+        : decoder_(decoder)
+        , n_blocks_(0) {
+    }
+
+    size_t n_blocks() const {
+        return n_blocks_;
+    }
+
+    virtual size_t max_block_length() const {
+        return decoder_.max_block_length();
+    }
+
+    virtual bool begin(size_t sblen, size_t rblen, size_t payload_size) {
+        n_blocks_++;
+        return decoder_.begin(sblen, rblen, payload_size);
+    }
+
+    virtual void set(size_t index, const core::Slice<uint8_t>& buffer) {
+        decoder_.set(index, buffer);
+    }
+
+    virtual core::Slice<uint8_t> repair(size_t index) {
+        return decoder_.repair(index);
+    }
+
+    virtual void end() {
+        decoder_.end();
+    }
+
+private:
+    IBlockDecoder& decoder_;
+    size_t n_blocks_;
+};
+
 } // namespace
 
 TEST_GROUP(writer_reader) {
@@ -254,6 +292,79 @@ TEST(writer_reader, no_losses) {
     }
 }
 
+TEST(writer_reader, no_losses_no_decoding) {
+    for (size_t n_scheme = 0; n_scheme < Test_n_fec_schemes; n_scheme++) {
+        codec_config.scheme = Test_fec_schemes[n_scheme];
+
+        core::UniquePtr<IBlockEncoder> encoder(
+            codec_map.new_encoder(codec_config, buffer_pool, allocator), allocator);
+        core::UniquePtr<IBlockDecoder> decoder(
+            codec_map.new_decoder(codec_config, buffer_pool, allocator), allocator);
+
+        CHECK(encoder);
+        CHECK(decoder);
+
+        CountingDecoder counting_decoder(*decoder);
+
+        packet::Queue writer_queue;
+        packet::Queue source_queue;
+        packet::Queue repair_queue;
+
+        Writer writer(writer_config, codec_config.scheme, *encoder, writer_queue,
+                      source_composer(), repair_composer(), packet_pool, buffer_pool,
+                      allocator);
+
+        Reader reader(reader_config, codec_config.scheme, counting_decoder,
+                      source_queue, repair_queue, rtp_parser, packet_pool, allocator);
+
+        CHECK(writer.valid());
+        CHECK(reader.valid());
+
+        enum { NumBlocks = 3 };
+
+        for (size_t block_num = 0; block_num < NumBlocks; block_num++) {
+            fill_all_packets(NumSourcePackets * block_num);
+
+            for (size_t i = 0; i < NumSourcePackets; ++i) {
+                writer.write(source_packets[i]);
+            }
+
+            // deliver first half of source packets
+            for (size_t i = 0; i < NumSourcePackets / 2; ++i) {
+                packet::PacketPtr p = writer_queue.read();
+                CHECK(p);
+                source_queue.write(p);
+            }
+
+            for (size_t i = 0; i < NumSourcePackets / 2; ++i) {
+                packet::PacketPtr p = reader.read();
+                check_audio_packet(p, NumSourcePackets * block_num + i);
+            }
+
+            // next packet is not delivered yet, but it's not a loss
+            CHECK(!reader.read());
+            CHECK(reader.alive());
+
+            // deliver the rest, including repair packets
+            while (packet::PacketPtr p = writer_queue.read()) {
+                if (p->flags() & packet::Packet::FlagRepair) {
+                    repair_queue.write(p);
+                } else {
+                    source_queue.write(p);
+                }
+            }
+
+            for (size_t i = NumSourcePackets / 2; i < NumSourcePackets; ++i) {
+                packet::PacketPtr p = reader.read();
+                check_audio_packet(p, NumSourcePackets * block_num + i);
+                check_restored(p, false);
+            }
+        }
+
+        UNSIGNED_LONGS_EQUAL(0, counting_decoder.n_blocks());
+    }
+}
+
 TEST(writer_reader, 1_loss) {
     for (size_t n_scheme = 0; n_scheme < Test_n_fec_schemes; n_scheme++) {
         codec_config.scheme = Test_fec_schemes[n_scheme];
@@ -33,6 +33,10 @@ const size_t Test_fec_sbn = 0x2233;
 const size_t Test_fec_sbl = 0x4455;
 const size_t Test_fec_nes = 0x6677;
 
+const size_t Test_rlc_esi = 0x8899aabb;
+const size_t Test_rlc_key = 0x2233;
+const size_t Test_rlc_nss = 0x455;
+
 const uint8_t Ref_rtp_ldpc_source[] = {
     /* RTP header */
     0x80, 0x0B, 0x55, 0x66,
@@ -81,11 +85,37 @@ const uint8_t Ref_rsm8_repair[] = {
     0x09, 0x0a
 };
 
+const uint8_t Ref_rtp_rlc_source[] = {
+    /* RTP header */
+    0x80, 0x0B, 0x55, 0x66,
+    0x77, 0x88, 0x99, 0xaa,
+    0x11, 0x22, 0x33, 0x44,
+    /* Payload */
+    0x01, 0x02, 0x03, 0x04,
+    0x05, 0x06, 0x07, 0x08,
+    0x09, 0x0a,
+    /* RLC footer */
+    0x88, 0x99, 0xaa, 0xbb
+};
+
+const uint8_t Ref_rlc_repair[] = {
+    /* RLC header */
+    0x22, 0x33, 0xf4, 0x55,
+    0x88, 0x99, 0xaa, 0xbb,
+    /* Payload */
+    0x01, 0x02, 0x03, 0x04,
+    0x05, 0x06, 0x07, 0x08,
+    0x09, 0x0a
+};
+
 struct PacketTest {
     packet::IComposer* composer;
     packet::IParser* parser;
 
     packet::FECScheme scheme;
+    size_t encoding_symbol_id;
+    size_t source_block_number;
+    size_t source_block_length;
     size_t block_length;
 
     bool is_rtp;
@@ -98,7 +128,9 @@ core::HeapAllocator allocator;
 core::BufferPool<uint8_t> buffer_pool(allocator, 1000, true);
 packet::PacketPool packet_pool(allocator, true);
 
-void fill_packet(packet::Packet& packet, bool is_rtp) {
+void fill_packet(packet::Packet& packet, const PacketTest& test) {
+    const bool is_rtp = test.is_rtp;
+
     if (is_rtp) {
         CHECK(packet.rtp());
 
@@ -110,9 +142,9 @@ void fill_packet(packet::Packet& packet, bool is_rtp) {
 
     CHECK(packet.fec());
 
-    packet.fec()->encoding_symbol_id = Test_fec_esi;
-    packet.fec()->source_block_number = Test_fec_sbn;
-    packet.fec()->source_block_length = Test_fec_sbl;
+    packet.fec()->encoding_symbol_id = test.encoding_symbol_id;
+    packet.fec()->source_block_number = (packet::blknum_t)test.source_block_number;
+    packet.fec()->source_block_length = test.source_block_length;
     packet.fec()->block_length = Test_fec_nes;
 
     core::Slice<uint8_t> packet_payload;
@@ -128,10 +160,9 @@ void fill_packet(packet::Packet& packet, bool is_rtp) {
     }
 }
 
-void check_packet(packet::Packet& packet,
-                  packet::FECScheme scheme,
-                  size_t block_length,
-                  bool is_rtp) {
+void check_packet(packet::Packet& packet, const PacketTest& test) {
+    const bool is_rtp = test.is_rtp;
+
     if (is_rtp) {
         CHECK(packet.rtp());
 
@@ -143,11 +174,11 @@ void check_packet(packet::Packet& packet,
 
     CHECK(packet.fec());
 
-    UNSIGNED_LONGS_EQUAL(scheme, packet.fec()->fec_scheme);
-    UNSIGNED_LONGS_EQUAL(Test_fec_esi, packet.fec()->encoding_symbol_id);
-    UNSIGNED_LONGS_EQUAL(Test_fec_sbn, packet.fec()->source_block_number);
-    UNSIGNED_LONGS_EQUAL(Test_fec_sbl, packet.fec()->source_block_length);
-    UNSIGNED_LONGS_EQUAL(block_length, packet.fec()->block_length);
+    UNSIGNED_LONGS_EQUAL(test.scheme, packet.fec()->fec_scheme);
+    UNSIGNED_LONGS_EQUAL(test.encoding_symbol_id, packet.fec()->encoding_symbol_id);
+    UNSIGNED_LONGS_EQUAL(test.source_block_number, packet.fec()->source_block_number);
+    UNSIGNED_LONGS_EQUAL(test.source_block_length, packet.fec()->source_block_length);
+    UNSIGNED_LONGS_EQUAL(test.block_length, packet.fec()->block_length);
 
     core::Slice<uint8_t> packet_payload;
     if (is_rtp) {
@@ -173,7 +204,7 @@ void test_compose(const PacketTest& test) {
 
     packet->set_data(buffer);
 
-    fill_packet(*packet, test.is_rtp);
+    fill_packet(*packet, test);
 
     CHECK(test.composer->compose(*packet));
 
@@ -199,7 +230,7 @@ void test_parse(const PacketTest& test) {
 
     CHECK(test.parser->parse(*packet, packet->data()));
 
-    check_packet(*packet, test.scheme, test.block_length, test.is_rtp);
+    check_packet(*packet, test);
 }
 
 void test_compose_parse(const PacketTest& test) {
@@ -213,7 +244,7 @@ void test_compose_parse(const PacketTest& test) {
 
     packet1->set_data(buffer);
 
-    fill_packet(*packet1, test.is_rtp);
+    fill_packet(*packet1, test);
 
     CHECK(test.composer->compose(*packet1));
 
@@ -222,7 +253,7 @@ void test_compose_parse(const PacketTest& test) {
 
     CHECK(test.parser->parse(*packet2, packet1->data()));
 
-    check_packet(*packet2, test.scheme, test.block_length, test.is_rtp);
+    check_packet(*packet2, test);
 }
 
 void test_all(const PacketTest& test) {
@@ -248,6 +279,9 @@ TEST(composer_parser, rtp_ldpc_source) {
     test.parser = &ldpc_parser;
     test.scheme = packet::FEC_LDPC_Staircase;
     test.is_rtp = true;
+    test.encoding_symbol_id = Test_fec_esi;
+    test.source_block_number = Test_fec_sbn;
+    test.source_block_length = Test_fec_sbl;
     test.block_length = 0;
     test.reference = Ref_rtp_ldpc_source;
     test.reference_size = sizeof(Ref_rtp_ldpc_source);
@@ -264,6 +298,9 @@ TEST(composer_parser, ldpc_repair) {
     test.parser = &ldpc_parser;
     test.scheme = packet::FEC_LDPC_Staircase;
     test.is_rtp = false;
+    test.encoding_symbol_id = Test_fec_esi;
+    test.source_block_number = Test_fec_sbn;
+    test.source_block_length = Test_fec_sbl;
     test.block_length = Test_fec_nes;
     test.reference = Ref_ldpc_repair;
     test.reference_size = sizeof(Ref_ldpc_repair);
@@ -284,6 +321,9 @@ TEST(composer_parser, rtp_rsm8_source) {
     test.parser = &rsm8_parser;
     test.scheme = packet::FEC_ReedSolomon_M8;
     test.is_rtp = true;
+    test.encoding_symbol_id = Test_fec_esi;
+    test.source_block_number = Test_fec_sbn;
+    test.source_block_length = Test_fec_sbl;
     test.block_length = 255;
     test.reference = Ref_rtp_rsm8_source;
     test.reference_size = sizeof(Ref_rtp_rsm8_source);
@@ -300,6 +340,9 @@ TEST(composer_parser, rsm8_repair) {
     test.parser = &rsm8_parser;
     test.scheme = packet::FEC_ReedSolomon_M8;
     test.is_rtp = false;
+    test.encoding_symbol_id = Test_fec_esi;
+    test.source_block_number = Test_fec_sbn;
+    test.source_block_length = Test_fec_sbl;
     test.block_length = 255;
     test.reference = Ref_rsm8_repair;
     test.reference_size = sizeof(Ref_rsm8_repair);
@@ -307,5 +350,71 @@ TEST(composer_parser, rsm8_repair) {
     test_all(test);
 }
 
+TEST(composer_parser, rtp_rlc_source) {
+    rtp::Composer rtp_composer(NULL);
+    Composer<RLC_Source_PayloadID, Source, Footer> rlc_composer(&rtp_composer);
+
+    rtp::FormatMap rtp_format_map;
+    rtp::Parser rtp_parser(rtp_format_map, NULL);
+    Parser<RLC_Source_PayloadID, Source, Footer> rlc_parser(&rtp_parser);
+
+    PacketTest test;
+    test.composer = &rlc_composer;
+    test.parser = &rlc_parser;
+    test.scheme = packet::FEC_RLC;
+    test.is_rtp = true;
+    test.encoding_symbol_id = Test_rlc_esi;
+    test.source_block_number = 0;
+    test.source_block_length = 0;
+    test.block_length = 0;
+    test.reference = Ref_rtp_rlc_source;
+    test.reference_size = sizeof(Ref_rtp_rlc_source);
+
+    test_all(test);
+}
+
+TEST(composer_parser, rlc_repair) {
+    Composer<RLC_Repair_PayloadID, Repair, Header> rlc_composer(NULL);
+    Parser<RLC_Repair_PayloadID, Repair, Header> rlc_parser(NULL);
+
+    PacketTest test;
+    test.composer = &rlc_composer;
+    test.parser = &rlc_parser;
+    test.scheme = packet::FEC_RLC;
+    test.is_rtp = false;
+    test.encoding_symbol_id = Test_rlc_esi;
+    test.source_block_number = Test_rlc_key;
+    test.source_block_length = Test_rlc_nss;
+    test.block_length = 0;
+    test.reference = Ref_rlc_repair;
+    test.reference_size = sizeof(Ref_rlc_repair);
+
+    test_all(test);
+}
+
+TEST(composer_parser, rlc_repair_sparse) {
+    Parser<RLC_Repair_PayloadID, Repair, Header> rlc_parser(NULL);
+
+    uint8_t data[sizeof(Ref_rlc_repair)];
+    memcpy(data, Ref_rlc_repair, sizeof(data));
+
+    // DT = 7
+    data[2] = 0x74;
+
+    core::Slice<uint8_t> buffer = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    CHECK(buffer);
+
+    buffer.resize(sizeof(data));
+    memcpy(buffer.data(), data, sizeof(data));
+
+    packet::PacketPtr packet = new (packet_pool) packet::Packet(packet_pool);
+    CHECK(packet);
+
+    CHECK(rlc_parser.parse(*packet, buffer));
+
+    // sparse codes are not supported, and reported as empty encoding window
+    UNSIGNED_LONGS_EQUAL(0, packet->fec()->source_block_length);
+}
+
 } // namespace fec
 } // namespace roc
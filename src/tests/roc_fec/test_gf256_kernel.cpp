@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/helpers.h"
+#include "roc_core/random.h"
+#include "roc_core/stddefs.h"
+#include "roc_fec/gf256.h"
+#include "roc_fec/gf256_kernel.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+enum { NumBytes = 203 };
+
+const GF256KernelType kernels[] = {
+    GF256Kernel_Generic,
+    GF256Kernel_SSSE3,
+    GF256Kernel_AVX2,
+};
+
+// Multiplication by shift and add, independent from tables.
+uint8_t slow_mul(uint8_t a, uint8_t b) {
+    unsigned p = 0, x = a;
+    for (; b != 0; b >>= 1) {
+        if (b & 1) {
+            p ^= x;
+        }
+        x <<= 1;
+        if (x & 0x100) {
+            x ^= 0x11d;
+        }
+    }
+    return (uint8_t)p;
+}
+
+} // namespace
+
+TEST_GROUP(gf256_kernel) {
+    uint8_t src[NumBytes];
+    uint8_t dst[NumBytes];
+
+    void setup() {
+        for (size_t n = 0; n < NumBytes; n++) {
+            src[n] = (uint8_t)core::random(0, 0xff);
+            dst[n] = (uint8_t)core::random(0, 0xff);
+        }
+    }
+};
+
+TEST(gf256_kernel, auto_is_supported) {
+    const GF256Kernel* kernel = gf256_kernel(GF256Kernel_Auto);
+
+    CHECK(kernel);
+    CHECK(kernel->name);
+    CHECK(kernel->type != GF256Kernel_Auto);
+
+    CHECK(gf256_kernel(GF256Kernel_Generic));
+}
+
+TEST(gf256_kernel, field) {
+    for (unsigned a = 0; a < 256; a++) {
+        for (unsigned b = 0; b < 256; b++) {
+            LONGS_EQUAL(slow_mul((uint8_t)a, (uint8_t)b),
+                        gf256_mul((uint8_t)a, (uint8_t)b));
+        }
+        if (a != 0) {
+            LONGS_EQUAL(1, gf256_mul((uint8_t)a, gf256_inv((uint8_t)a)));
+        }
+    }
+
+    // alpha is 2 and has order 255
+    LONGS_EQUAL(1, gf256_exp(0));
+    LONGS_EQUAL(2, gf256_exp(1));
+    LONGS_EQUAL(0x1d, gf256_exp(8));
+    LONGS_EQUAL(1, gf256_exp(255));
+}
+
+TEST(gf256_kernel, invert_matrix) {
+    enum { Size = 5 };
+
+    uint8_t matrix[Size * Size];
+    uint8_t inverse[Size * Size];
+    uint8_t scratch[Size * Size];
+
+    // Cauchy matrix is never singular
+    for (size_t r = 0; r < Size; r++) {
+        for (size_t c = 0; c < Size; c++) {
+            matrix[r * Size + c] = gf256_inv((uint8_t)(r ^ (c + Size)));
+        }
+    }
+
+    memcpy(inverse, matrix, sizeof(matrix));
+    CHECK(gf256_invert_matrix(inverse, scratch, Size));
+
+    for (size_t r = 0; r < Size; r++) {
+        for (size_t c = 0; c < Size; c++) {
+            uint8_t sum = 0;
+            for (size_t i = 0; i < Size; i++) {
+                sum ^= gf256_mul(matrix[r * Size + i], inverse[i * Size + c]);
+            }
+            LONGS_EQUAL(r == c ? 1 : 0, sum);
+        }
+    }
+
+    // two equal rows
+    memcpy(matrix + Size, matrix, Size);
+    CHECK(!gf256_invert_matrix(matrix, scratch, Size));
+}
+
+TEST(gf256_kernel, mul_add) {
+    const uint8_t coefs[] = { 0, 1, 2, 0x1d, 0x80, 0xff };
+
+    for (size_t k = 0; k < ROC_ARRAY_SIZE(kernels); k++) {
+        const GF256Kernel* kernel = gf256_kernel(kernels[k]);
+        if (!kernel) {
+            continue;
+        }
+
+        for (size_t c = 0; c < ROC_ARRAY_SIZE(coefs); c++) {
+            for (size_t size = 0; size <= NumBytes; size++) {
+                uint8_t actual[NumBytes];
+                memcpy(actual, dst, NumBytes);
+
+                kernel->mul_add(actual, src, coefs[c], size);
+
+                for (size_t n = 0; n < NumBytes; n++) {
+                    const uint8_t expected =
+                        n < size ? (uint8_t)(dst[n] ^ slow_mul(coefs[c], src[n]))
+                                 : dst[n];
+                    LONGS_EQUAL(expected, actual[n]);
+                }
+            }
+        }
+    }
+}
+
+TEST(gf256_kernel, add) {
+    for (size_t k = 0; k < ROC_ARRAY_SIZE(kernels); k++) {
+        const GF256Kernel* kernel = gf256_kernel(kernels[k]);
+        if (!kernel) {
+            continue;
+        }
+
+        for (size_t offset = 0; offset < 3; offset++) {
+            for (size_t size = 0; size + offset <= NumBytes; size++) {
+                uint8_t actual[NumBytes];
+                memcpy(actual, dst, NumBytes);
+
+                kernel->add(actual + offset, src + offset, size);
+
+                for (size_t n = 0; n < NumBytes; n++) {
+                    const uint8_t expected = n >= offset && n < offset + size
+                        ? (uint8_t)(dst[n] ^ src[n])
+                        : dst[n];
+                    LONGS_EQUAL(expected, actual[n]);
+                }
+            }
+        }
+    }
+}
+
+TEST(gf256_kernel, mul_add_all_values) {
+    uint8_t all[256];
+    for (size_t n = 0; n < 256; n++) {
+        all[n] = (uint8_t)n;
+    }
+
+    for (size_t k = 0; k < ROC_ARRAY_SIZE(kernels); k++) {
+        const GF256Kernel* kernel = gf256_kernel(kernels[k]);
+        if (!kernel) {
+            continue;
+        }
+
+        for (unsigned coef = 0; coef < 256; coef++) {
+            uint8_t actual[256] = {};
+            kernel->mul_add(actual, all, (uint8_t)coef, 256);
+
+            for (size_t n = 0; n < 256; n++) {
+                LONGS_EQUAL(slow_mul((uint8_t)coef, (uint8_t)n), actual[n]);
+            }
+        }
+    }
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,361 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/random.h"
+#include "roc_core/unique_ptr.h"
+#include "roc_fec/codec_map.h"
+#include "roc_fec/parity_decoder.h"
+#include "roc_fec/parity_encoder.h"
+#include "roc_fec/parity_layout.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+enum { MaxPayloadSize = 1024, MaxBlockLength = 300 };
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, MaxPayloadSize, true);
+
+CodecConfig make_config() {
+    CodecConfig config;
+    config.scheme = packet::FEC_Parity;
+    return config;
+}
+
+core::Slice<uint8_t> make_buffer(size_t size) {
+    core::Slice<uint8_t> buf = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    CHECK(buf);
+    buf.resize(size);
+    return buf;
+}
+
+core::Slice<uint8_t> make_random_buffer(size_t size) {
+    core::Slice<uint8_t> buf = make_buffer(size);
+    for (size_t n = 0; n < size; n++) {
+        buf.data()[n] = (uint8_t)core::random(0, 0xff);
+    }
+    return buf;
+}
+
+} // namespace
+
+TEST_GROUP(parity) {
+    core::Slice<uint8_t> buffers[MaxBlockLength];
+
+    void encode(ParityEncoder & encoder, size_t sblen, size_t rblen,
+                size_t payload_size) {
+        CHECK(encoder.begin(sblen, rblen, payload_size));
+
+        for (size_t i = 0; i < sblen + rblen; i++) {
+            if (i < sblen) {
+                buffers[i] = make_random_buffer(payload_size);
+            } else {
+                buffers[i] = make_buffer(payload_size);
+            }
+            encoder.set(i, buffers[i]);
+        }
+
+        encoder.fill();
+        encoder.end();
+    }
+
+    // Returns number of repaired source packets.
+    size_t decode(ParityDecoder & decoder, size_t sblen, size_t rblen,
+                  size_t payload_size, const bool* lost) {
+        CHECK(decoder.begin(sblen, rblen, payload_size));
+
+        for (size_t i = 0; i < sblen + rblen; i++) {
+            if (!lost[i]) {
+                decoder.set(i, buffers[i]);
+            }
+        }
+
+        size_t n_repaired = 0;
+
+        for (size_t i = 0; i < sblen; i++) {
+            core::Slice<uint8_t> buf = decoder.repair(i);
+            if (!buf) {
+                continue;
+            }
+
+            UNSIGNED_LONGS_EQUAL(payload_size, buf.size());
+            CHECK(memcmp(buffers[i].data(), buf.data(), payload_size) == 0);
+
+            if (lost[i]) {
+                n_repaired++;
+            }
+        }
+
+        decoder.end();
+
+        return n_repaired;
+    }
+};
+
+TEST(parity, codec_map) {
+    CodecMap codec_map;
+    CodecConfig config = make_config();
+
+    core::UniquePtr<IBlockEncoder> encoder(
+        codec_map.new_encoder(config, buffer_pool, allocator), allocator);
+    core::UniquePtr<IBlockDecoder> decoder(
+        codec_map.new_decoder(config, buffer_pool, allocator), allocator);
+
+    CHECK(encoder);
+    CHECK(decoder);
+
+    UNSIGNED_LONGS_EQUAL(ParityLayout::MaxBlockLength, encoder->max_block_length());
+    UNSIGNED_LONGS_EQUAL(ParityLayout::MaxBlockLength, decoder->max_block_length());
+}
+
+TEST(parity, layout_rows) {
+    ParityLayout layout;
+
+    // 20 source packets, 10 rows of 2 packets
+    CHECK(layout.build(20, 10));
+
+    UNSIGNED_LONGS_EQUAL(10, layout.n_rows());
+    UNSIGNED_LONGS_EQUAL(0, layout.n_columns());
+
+    for (size_t r = 0; r < 10; r++) {
+        UNSIGNED_LONGS_EQUAL(r * 2, layout.first(r));
+        UNSIGNED_LONGS_EQUAL(1, layout.step(r));
+        UNSIGNED_LONGS_EQUAL(2, layout.count(r));
+    }
+
+    // rows of unequal length cover every source packet exactly once
+    CHECK(layout.build(10, 3));
+
+    size_t total = 0;
+    for (size_t r = 0; r < 3; r++) {
+        UNSIGNED_LONGS_EQUAL(total, layout.first(r));
+        for (size_t n = 0; n < layout.count(r); n++) {
+            UNSIGNED_LONGS_EQUAL(r, layout.row(layout.first(r) + n));
+        }
+        total += layout.count(r);
+    }
+    UNSIGNED_LONGS_EQUAL(10, total);
+}
+
+TEST(parity, layout_matrix) {
+    ParityLayout layout;
+
+    // 20 source packets, 4 rows and 5 columns
+    CHECK(layout.build(20, 9));
+
+    UNSIGNED_LONGS_EQUAL(4, layout.n_rows());
+    UNSIGNED_LONGS_EQUAL(5, layout.n_columns());
+
+    for (size_t i = 0; i < 20; i++) {
+        const size_t row = layout.row(i);
+        const size_t col = layout.column(i);
+
+        UNSIGNED_LONGS_EQUAL(i / 5, row);
+        UNSIGNED_LONGS_EQUAL(4 + i % 5, col);
+
+        UNSIGNED_LONGS_EQUAL(row * 5, layout.first(row));
+        UNSIGNED_LONGS_EQUAL(1, layout.step(row));
+        UNSIGNED_LONGS_EQUAL(5, layout.count(row));
+
+        UNSIGNED_LONGS_EQUAL(i % 5, layout.first(col));
+        UNSIGNED_LONGS_EQUAL(5, layout.step(col));
+        UNSIGNED_LONGS_EQUAL(4, layout.count(col));
+    }
+}
+
+TEST(parity, invalid_block) {
+    ParityEncoder encoder(make_config(), buffer_pool, allocator);
+    ParityDecoder decoder(make_config(), buffer_pool, allocator);
+
+    CHECK(encoder.valid());
+    CHECK(decoder.valid());
+
+    CHECK(!encoder.begin(0, 10, 100));
+    CHECK(!encoder.begin(10, 0, 100));
+    CHECK(!encoder.begin(10, 11, 100));
+    CHECK(!decoder.begin(0, 10, 100));
+    CHECK(!decoder.begin(10, 0, 100));
+    CHECK(!decoder.begin(10, 11, 100));
+
+    CHECK(encoder.begin(10, 10, 100));
+    CHECK(decoder.begin(10, 10, 100));
+}
+
+TEST(parity, known_symbols) {
+    enum { SourcePackets = 4, RepairPackets = 2, PayloadSize = 8 };
+
+    ParityEncoder encoder(make_config(), buffer_pool, allocator);
+    CHECK(encoder.valid());
+
+    encode(encoder, SourcePackets, RepairPackets, PayloadSize);
+
+    for (size_t r = 0; r < RepairPackets; r++) {
+        for (size_t n = 0; n < PayloadSize; n++) {
+            const uint8_t expected = uint8_t(buffers[r * 2].data()[n]
+                                             ^ buffers[r * 2 + 1].data()[n]);
+            UNSIGNED_LONGS_EQUAL(expected, buffers[SourcePackets + r].data()[n]);
+        }
+    }
+}
+
+TEST(parity, repair_buffers_set_first) {
+    enum { SourcePackets = 20, RepairPackets = 9, PayloadSize = 251 };
+
+    ParityEncoder encoder(make_config(), buffer_pool, allocator);
+    CHECK(encoder.valid());
+
+    encode(encoder, SourcePackets, RepairPackets, PayloadSize);
+
+    core::Slice<uint8_t> repair[RepairPackets];
+
+    CHECK(encoder.begin(SourcePackets, RepairPackets, PayloadSize));
+
+    for (size_t i = 0; i < RepairPackets; i++) {
+        repair[i] = make_buffer(PayloadSize);
+        encoder.set(SourcePackets + i, repair[i]);
+    }
+    for (size_t i = 0; i < SourcePackets; i++) {
+        encoder.set(i, buffers[i]);
+    }
+
+    encoder.fill();
+    encoder.end();
+
+    for (size_t i = 0; i < RepairPackets; i++) {
+        CHECK(memcmp(buffers[SourcePackets + i].data(), repair[i].data(), PayloadSize)
+              == 0);
+    }
+}
+
+TEST(parity, single_loss_in_every_row) {
+    enum { SourcePackets = 20, RepairPackets = 10, PayloadSize = 100 };
+
+    ParityEncoder encoder(make_config(), buffer_pool, allocator);
+    ParityDecoder decoder(make_config(), buffer_pool, allocator);
+
+    encode(encoder, SourcePackets, RepairPackets, PayloadSize);
+
+    bool lost[SourcePackets + RepairPackets] = {};
+    for (size_t i = 0; i < SourcePackets; i += 2) {
+        lost[i + (i / 2) % 2] = true;
+    }
+
+    UNSIGNED_LONGS_EQUAL(
+        10, decode(decoder, SourcePackets, RepairPackets, PayloadSize, lost));
+}
+
+TEST(parity, two_losses_in_row) {
+    enum { SourcePackets = 20, RepairPackets = 10, PayloadSize = 100 };
+
+    ParityEncoder encoder(make_config(), buffer_pool, allocator);
+    ParityDecoder decoder(make_config(), buffer_pool, allocator);
+
+    encode(encoder, SourcePackets, RepairPackets, PayloadSize);
+
+    bool lost[SourcePackets + RepairPackets] = {};
+    lost[4] = true;
+    lost[5] = true;
+    lost[8] = true;
+
+    // row of packets 4 and 5 can't be repaired
+    UNSIGNED_LONGS_EQUAL(
+        1, decode(decoder, SourcePackets, RepairPackets, PayloadSize, lost));
+}
+
+TEST(parity, lost_repair_packet) {
+    enum { SourcePackets = 20, RepairPackets = 10, PayloadSize = 100 };
+
+    ParityEncoder encoder(make_config(), buffer_pool, allocator);
+    ParityDecoder decoder(make_config(), buffer_pool, allocator);
+
+    encode(encoder, SourcePackets, RepairPackets, PayloadSize);
+
+    bool lost[SourcePackets + RepairPackets] = {};
+    lost[2] = true;
+    lost[SourcePackets + 1] = true;
+    lost[7] = true;
+
+    UNSIGNED_LONGS_EQUAL(
+        1, decode(decoder, SourcePackets, RepairPackets, PayloadSize, lost));
+}
+
+TEST(parity, burst_loss_columns) {
+    enum { SourcePackets = 20, RepairPackets = 9, PayloadSize = 100 };
+
+    ParityEncoder encoder(make_config(), buffer_pool, allocator);
+    ParityDecoder decoder(make_config(), buffer_pool, allocator);
+
+    encode(encoder, SourcePackets, RepairPackets, PayloadSize);
+
+    // burst of L=5 packets is repaired by column parities
+    for (size_t first = 0; first + 5 <= SourcePackets; first++) {
+        bool lost[SourcePackets + RepairPackets] = {};
+        for (size_t i = first; i < first + 5; i++) {
+            lost[i] = true;
+        }
+
+        UNSIGNED_LONGS_EQUAL(
+            5, decode(decoder, SourcePackets, RepairPackets, PayloadSize, lost));
+    }
+}
+
+TEST(parity, iterative_decoding) {
+    enum { SourcePackets = 16, RepairPackets = 8, PayloadSize = 100 };
+
+    ParityEncoder encoder(make_config(), buffer_pool, allocator);
+    ParityDecoder decoder(make_config(), buffer_pool, allocator);
+
+    encode(encoder, SourcePackets, RepairPackets, PayloadSize);
+
+    // 4x4 matrix:
+    //  - packets 0 and 1 share row 0, packet 0 is alone in column 0
+    //  - packet 1 shares column 1 with packet 5, which is alone in row 1
+    //  - column 1 repair packet is lost
+    bool lost[SourcePackets + RepairPackets] = {};
+    lost[0] = true;
+    lost[1] = true;
+    lost[5] = true;
+    lost[SourcePackets + 4 + 1] = true;
+
+    UNSIGNED_LONGS_EQUAL(
+        3, decode(decoder, SourcePackets, RepairPackets, PayloadSize, lost));
+}
+
+TEST(parity, repair_after_more_packets) {
+    enum { SourcePackets = 10, RepairPackets = 5, PayloadSize = 100 };
+
+    ParityEncoder encoder(make_config(), buffer_pool, allocator);
+    ParityDecoder decoder(make_config(), buffer_pool, allocator);
+
+    encode(encoder, SourcePackets, RepairPackets, PayloadSize);
+
+    CHECK(decoder.begin(SourcePackets, RepairPackets, PayloadSize));
+
+    for (size_t i = 1; i < SourcePackets; i++) {
+        decoder.set(i, buffers[i]);
+    }
+
+    CHECK(!decoder.repair(0));
+
+    decoder.set(SourcePackets, buffers[SourcePackets]);
+
+    core::Slice<uint8_t> buf = decoder.repair(0);
+    CHECK(buf);
+    CHECK(memcmp(buffers[0].data(), buf.data(), PayloadSize) == 0);
+
+    decoder.end();
+}
+
+} // namespace fec
+} // namespace roc
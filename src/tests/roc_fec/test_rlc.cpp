@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/random.h"
+#include "roc_fec/gf256_kernel.h"
+#include "roc_fec/rlc_coefficients.h"
+#include "roc_fec/rlc_decoder.h"
+#include "roc_fec/tinymt32.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+enum { MaxPayloadSize = 256, MaxWindowLength = 64 };
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, MaxPayloadSize, true);
+
+core::Slice<uint8_t> make_buffer(size_t size) {
+    core::Slice<uint8_t> buf = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    CHECK(buf);
+    buf.resize(size);
+    return buf;
+}
+
+core::Slice<uint8_t> make_random_buffer(size_t size) {
+    core::Slice<uint8_t> buf = make_buffer(size);
+    for (size_t n = 0; n < size; n++) {
+        buf.data()[n] = (uint8_t)core::random(0, 0xff);
+    }
+    return buf;
+}
+
+} // namespace
+
+TEST_GROUP(rlc) {
+    core::Slice<uint8_t> source[MaxWindowLength];
+    core::Slice<uint8_t> repair[MaxWindowLength];
+
+    size_t repair_first[MaxWindowLength];
+    size_t repair_len[MaxWindowLength];
+
+    void make_source(size_t n_source, size_t payload_size) {
+        for (size_t i = 0; i < n_source; i++) {
+            source[i] = make_random_buffer(payload_size);
+        }
+    }
+
+    void make_repair(size_t index, size_t first, size_t len, size_t payload_size) {
+        uint8_t coefs[MaxWindowLength];
+        rlc_coefficients((uint16_t)index, RLC_DenseThreshold, coefs, len);
+
+        repair[index] = make_buffer(payload_size);
+        memset(repair[index].data(), 0, payload_size);
+
+        for (size_t i = 0; i < len; i++) {
+            gf256_kernel(GF256Kernel_Generic)
+                ->mul_add(repair[index].data(), source[first + i].data(), coefs[i],
+                          payload_size);
+        }
+
+        repair_first[index] = first;
+        repair_len[index] = len;
+    }
+
+    void add_repair(RLCDecoder & decoder, size_t index) {
+        CHECK(decoder.add_repair(repair_first[index], repair_len[index],
+                                 (uint16_t)index, repair[index]));
+    }
+
+    void check_repaired(RLCDecoder & decoder, size_t index, size_t payload_size) {
+        core::Slice<uint8_t> buf = decoder.repair(index);
+        CHECK(buf);
+        UNSIGNED_LONGS_EQUAL(payload_size, buf.size());
+        CHECK(memcmp(source[index].data(), buf.data(), payload_size) == 0);
+    }
+};
+
+TEST(rlc, tinymt32_reference) {
+    // RFC 8682, Section 2.2
+    const uint32_t expected[] = {
+        2545341989u, 981918433u,  3715302833u, 2387538352u, 3591001365u,
+        3820442102u, 2114400566u, 2196103051u, 2783359912u, 764534509u,
+    };
+
+    TinyMT32 prng(1);
+
+    for (size_t n = 0; n < sizeof(expected) / sizeof(expected[0]); n++) {
+        UNSIGNED_LONGS_EQUAL(expected[n], prng.next());
+    }
+}
+
+TEST(rlc, coefficients) {
+    uint8_t a[MaxWindowLength], b[MaxWindowLength];
+
+    for (unsigned key = 0; key < 100; key++) {
+        rlc_coefficients((uint16_t)key, RLC_DenseThreshold, a, MaxWindowLength);
+        rlc_coefficients((uint16_t)key, RLC_DenseThreshold, b, MaxWindowLength);
+
+        CHECK(memcmp(a, b, MaxWindowLength) == 0);
+
+        for (size_t n = 0; n < MaxWindowLength; n++) {
+            CHECK(a[n] != 0);
+        }
+    }
+
+    // shorter window has the same leading coefficients
+    rlc_coefficients(123, RLC_DenseThreshold, a, MaxWindowLength);
+    rlc_coefficients(123, RLC_DenseThreshold, b, 10);
+    CHECK(memcmp(a, b, 10) == 0);
+
+    // sparse coefficients have zeros
+    size_t n_zeros = 0;
+    rlc_coefficients(123, 0, a, MaxWindowLength);
+    for (size_t n = 0; n < MaxWindowLength; n++) {
+        n_zeros += (a[n] == 0);
+    }
+    CHECK(n_zeros > MaxWindowLength / 2);
+}
+
+TEST(rlc, decoder_no_losses) {
+    enum { NumSource = 10, PayloadSize = 100 };
+
+    make_source(NumSource, PayloadSize);
+    make_repair(0, 0, NumSource, PayloadSize);
+
+    RLCDecoder decoder(MaxWindowLength, buffer_pool, allocator);
+    CHECK(decoder.valid());
+
+    CHECK(decoder.begin(NumSource, PayloadSize));
+
+    for (size_t i = 0; i < NumSource; i++) {
+        decoder.set(i, source[i]);
+    }
+    add_repair(decoder, 0);
+
+    for (size_t i = 0; i < NumSource; i++) {
+        CHECK(!decoder.repair(i));
+    }
+
+    decoder.end();
+}
+
+TEST(rlc, decoder_overlapping_windows) {
+    enum { NumSource = 20, WindowLength = 8, PayloadSize = 77 };
+
+    make_source(NumSource, PayloadSize);
+
+    // one repair symbol after every two source symbols, over last 8 symbols
+    size_t n_repair = 0;
+    for (size_t end = 2; end <= NumSource; end += 2) {
+        const size_t first = end > WindowLength ? end - WindowLength : 0;
+        make_repair(n_repair++, first, end - first, PayloadSize);
+    }
+
+    // lose burst of 4 symbols
+    const size_t lost_first = 6, lost_last = 9;
+
+    RLCDecoder decoder(MaxWindowLength, buffer_pool, allocator);
+    CHECK(decoder.valid());
+
+    CHECK(decoder.begin(NumSource, PayloadSize));
+
+    for (size_t i = 0; i < NumSource; i++) {
+        if (i < lost_first || i > lost_last) {
+            decoder.set(i, source[i]);
+        }
+    }
+    for (size_t r = 0; r < n_repair; r++) {
+        add_repair(decoder, r);
+    }
+
+    for (size_t i = 0; i < NumSource; i++) {
+        if (i < lost_first || i > lost_last) {
+            CHECK(!decoder.repair(i));
+        } else {
+            check_repaired(decoder, i, PayloadSize);
+        }
+    }
+
+    decoder.end();
+}
+
+TEST(rlc, decoder_not_enough_repair) {
+    enum { NumSource = 10, PayloadSize = 50 };
+
+    make_source(NumSource, PayloadSize);
+    make_repair(0, 0, NumSource, PayloadSize);
+    make_repair(1, 5, 5, PayloadSize);
+
+    RLCDecoder decoder(MaxWindowLength, buffer_pool, allocator);
+    CHECK(decoder.valid());
+
+    CHECK(decoder.begin(NumSource, PayloadSize));
+
+    // symbols 1 and 2 are covered only by first repair symbol,
+    // symbol 7 is covered by both
+    for (size_t i = 0; i < NumSource; i++) {
+        if (i != 1 && i != 2 && i != 7) {
+            decoder.set(i, source[i]);
+        }
+    }
+    add_repair(decoder, 0);
+    add_repair(decoder, 1);
+
+    CHECK(!decoder.repair(1));
+    CHECK(!decoder.repair(2));
+
+    // symbol 7 is determined by second repair symbol alone
+    check_repaired(decoder, 7, PayloadSize);
+
+    decoder.end();
+}
+
+TEST(rlc, decoder_incremental) {
+    enum { NumSource = 12, PayloadSize = 64 };
+
+    make_source(NumSource, PayloadSize);
+    make_repair(0, 0, 6, PayloadSize);
+    make_repair(1, 0, 12, PayloadSize);
+
+    RLCDecoder decoder(MaxWindowLength, buffer_pool, allocator);
+    CHECK(decoder.valid());
+
+    CHECK(decoder.begin(NumSource, PayloadSize));
+
+    for (size_t i = 0; i < NumSource; i++) {
+        if (i != 3 && i != 8) {
+            decoder.set(i, source[i]);
+        }
+    }
+
+    add_repair(decoder, 0);
+
+    check_repaired(decoder, 3, PayloadSize);
+    CHECK(!decoder.repair(8));
+
+    // repaired symbol is used when more repair symbols arrive
+    add_repair(decoder, 1);
+
+    check_repaired(decoder, 3, PayloadSize);
+    check_repaired(decoder, 8, PayloadSize);
+
+    decoder.end();
+}
+
+TEST(rlc, decoder_limits) {
+    enum { PayloadSize = 10 };
+
+    RLCDecoder decoder(4, buffer_pool, allocator);
+    CHECK(decoder.valid());
+
+    UNSIGNED_LONGS_EQUAL(4, decoder.max_window_length());
+
+    CHECK(!decoder.begin(0, PayloadSize));
+    CHECK(!decoder.begin(5, PayloadSize));
+    CHECK(decoder.begin(4, PayloadSize));
+
+    make_source(4, PayloadSize);
+    for (size_t r = 0; r < 5; r++) {
+        make_repair(r, 0, 4, PayloadSize);
+    }
+
+    for (size_t r = 0; r < 4; r++) {
+        add_repair(decoder, r);
+    }
+    CHECK(!decoder.add_repair(0, 4, 4, repair[4]));
+
+    // all four source symbols are lost and repaired from four repair symbols
+    for (size_t i = 0; i < 4; i++) {
+        check_repaired(decoder, i, PayloadSize);
+    }
+
+    decoder.end();
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,457 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_fec/composer.h"
+#include "roc_fec/headers.h"
+#include "roc_fec/parser.h"
+#include "roc_fec/rlc_reader.h"
+#include "roc_fec/rlc_writer.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet_pool.h"
+#include "roc_packet/queue.h"
+#include "roc_rtp/composer.h"
+#include "roc_rtp/format_map.h"
+#include "roc_rtp/headers.h"
+#include "roc_rtp/parser.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+const size_t NumPackets = 200;
+
+const unsigned SourceID = 555;
+const unsigned PayloadType = rtp::PayloadType_L16_Stereo;
+
+const size_t FECPayloadSize = 193;
+
+const size_t MaxBuffSize = 500;
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, MaxBuffSize, true);
+packet::PacketPool packet_pool(allocator, true);
+
+rtp::FormatMap format_map;
+rtp::Parser rtp_parser(format_map, NULL);
+
+fec::Parser<RLC_Source_PayloadID, Source, Footer> source_parser(&rtp_parser);
+fec::Parser<RLC_Repair_PayloadID, Repair, Header> repair_parser(NULL);
+
+rtp::Composer rtp_composer(NULL);
+fec::Composer<RLC_Source_PayloadID, Source, Footer> source_composer(&rtp_composer);
+fec::Composer<RLC_Repair_PayloadID, Repair, Header> repair_composer(NULL);
+
+// Re-parses packets produced by writer and routes them to source and
+// repair queues, dropping packets with given indices.
+class Network : public packet::IWriter {
+public:
+    Network()
+        : n_source_(0)
+        , n_repair_(0) {
+        memset(lost_source_, 0, sizeof(lost_source_));
+        memset(lost_repair_, 0, sizeof(lost_repair_));
+    }
+
+    packet::Queue& source_queue() {
+        return source_queue_;
+    }
+
+    packet::Queue& repair_queue() {
+        return repair_queue_;
+    }
+
+    size_t n_source() const {
+        return n_source_;
+    }
+
+    size_t n_repair() const {
+        return n_repair_;
+    }
+
+    void lose_source(size_t index) {
+        CHECK(index < NumPackets);
+        lost_source_[index] = true;
+    }
+
+    void lose_repair(size_t index) {
+        CHECK(index < NumPackets);
+        lost_repair_[index] = true;
+    }
+
+    virtual void write(const packet::PacketPtr& p) {
+        CHECK(p);
+
+        if (p->flags() & packet::Packet::FlagRepair) {
+            CHECK(n_repair_ < NumPackets);
+            if (!lost_repair_[n_repair_]) {
+                repair_queue_.write(reparse_(repair_parser, p));
+            }
+            n_repair_++;
+        } else {
+            CHECK(n_source_ < NumPackets);
+            if (!lost_source_[n_source_]) {
+                source_queue_.write(reparse_(source_parser, p));
+            }
+            n_source_++;
+        }
+    }
+
+private:
+    packet::PacketPtr reparse_(packet::IParser& parser, const packet::PacketPtr& old_pp) {
+        packet::PacketPtr pp = new (packet_pool) packet::Packet(packet_pool);
+        CHECK(pp);
+
+        CHECK(parser.parse(*pp, old_pp->data()));
+        pp->set_data(old_pp->data());
+
+        return pp;
+    }
+
+    packet::Queue source_queue_;
+    packet::Queue repair_queue_;
+
+    bool lost_source_[NumPackets];
+    bool lost_repair_[NumPackets];
+
+    size_t n_source_;
+    size_t n_repair_;
+};
+
+} // namespace
+
+TEST_GROUP(rlc_writer_reader) {
+    RLCWriterConfig writer_config;
+    RLCReaderConfig reader_config;
+
+    packet::PacketPtr make_packet(size_t sn, size_t fec_payload_size = FECPayloadSize) {
+        CHECK(fec_payload_size > sizeof(rtp::Header));
+        const size_t rtp_payload_size = fec_payload_size - sizeof(rtp::Header);
+
+        packet::PacketPtr pp = new (packet_pool) packet::Packet(packet_pool);
+        CHECK(pp);
+
+        core::Slice<uint8_t> bp = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+        CHECK(bp);
+
+        CHECK(source_composer.prepare(*pp, bp, rtp_payload_size));
+        pp->set_data(bp);
+
+        UNSIGNED_LONGS_EQUAL(fec_payload_size, pp->fec()->payload.size());
+
+        pp->add_flags(packet::Packet::FlagAudio);
+
+        pp->rtp()->source = SourceID;
+        pp->rtp()->payload_type = PayloadType;
+        pp->rtp()->seqnum = packet::seqnum_t(sn);
+        pp->rtp()->timestamp = packet::timestamp_t(sn * 10);
+
+        for (size_t i = 0; i < rtp_payload_size; i++) {
+            pp->rtp()->payload.data()[i] = uint8_t(sn + i);
+        }
+
+        return pp;
+    }
+
+    void check_packet(const packet::PacketPtr& pp, size_t sn, bool restored,
+                      size_t fec_payload_size = FECPayloadSize) {
+        const size_t rtp_payload_size = fec_payload_size - sizeof(rtp::Header);
+
+        CHECK(pp);
+
+        CHECK(pp->flags() & packet::Packet::FlagRTP);
+        CHECK(pp->flags() & packet::Packet::FlagAudio);
+
+        if (restored) {
+            CHECK(pp->flags() & packet::Packet::FlagRestored);
+            CHECK(!pp->fec());
+        } else {
+            CHECK(!(pp->flags() & packet::Packet::FlagRestored));
+            CHECK(pp->fec());
+        }
+
+        UNSIGNED_LONGS_EQUAL(SourceID, pp->rtp()->source);
+        UNSIGNED_LONGS_EQUAL(PayloadType, pp->rtp()->payload_type);
+        UNSIGNED_LONGS_EQUAL(packet::seqnum_t(sn), pp->rtp()->seqnum);
+        UNSIGNED_LONGS_EQUAL(packet::timestamp_t(sn * 10), pp->rtp()->timestamp);
+
+        UNSIGNED_LONGS_EQUAL(rtp_payload_size, pp->rtp()->payload.size());
+
+        for (size_t i = 0; i < rtp_payload_size; i++) {
+            UNSIGNED_LONGS_EQUAL(uint8_t(sn + i), pp->rtp()->payload.data()[i]);
+        }
+    }
+};
+
+TEST(rlc_writer_reader, no_losses) {
+    Network network;
+
+    RLCWriter writer(writer_config, network, source_composer, repair_composer,
+                     packet_pool, buffer_pool, allocator);
+    RLCReader reader(reader_config, network.source_queue(), network.repair_queue(),
+                     rtp_parser, packet_pool, buffer_pool, allocator);
+
+    CHECK(writer.valid());
+    CHECK(reader.valid());
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        writer.write(make_packet(n));
+    }
+
+    UNSIGNED_LONGS_EQUAL(NumPackets, network.n_source());
+    UNSIGNED_LONGS_EQUAL(NumPackets / writer_config.n_source_packets
+                             * writer_config.n_repair_packets,
+                         network.n_repair());
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        check_packet(reader.read(), n, false);
+    }
+
+    CHECK(!reader.read());
+
+    CHECK(writer.alive());
+    CHECK(reader.alive());
+}
+
+TEST(rlc_writer_reader, repair_fields) {
+    Network network;
+
+    RLCWriter writer(writer_config, network, source_composer, repair_composer,
+                     packet_pool, buffer_pool, allocator);
+    CHECK(writer.valid());
+
+    for (size_t n = 0; n < writer_config.window_length * 2; n++) {
+        writer.write(make_packet(n));
+    }
+
+    packet::PacketPtr first_source = network.source_queue().read();
+    CHECK(first_source);
+    CHECK(first_source->fec());
+
+    const uint32_t first_esi = (uint32_t)first_source->fec()->encoding_symbol_id;
+
+    for (size_t n = 0; n < writer_config.window_length; n++) {
+        packet::PacketPtr rp = network.repair_queue().read();
+        CHECK(rp);
+        CHECK(rp->fec());
+
+        // repair packet protects all source packets written so far,
+        // but no more than window length
+        const size_t end = (n + 1) * writer_config.n_source_packets;
+        const size_t len = std::min(end, writer_config.window_length);
+
+        UNSIGNED_LONGS_EQUAL(packet::FEC_RLC, rp->fec()->fec_scheme);
+        UNSIGNED_LONGS_EQUAL(len, rp->fec()->source_block_length);
+        UNSIGNED_LONGS_EQUAL(uint32_t(first_esi + (end - len)),
+                             rp->fec()->encoding_symbol_id);
+        UNSIGNED_LONGS_EQUAL(FECPayloadSize, rp->fec()->payload.size());
+    }
+}
+
+TEST(rlc_writer_reader, single_losses) {
+    Network network;
+
+    RLCWriter writer(writer_config, network, source_composer, repair_composer,
+                     packet_pool, buffer_pool, allocator);
+    RLCReader reader(reader_config, network.source_queue(), network.repair_queue(),
+                     rtp_parser, packet_pool, buffer_pool, allocator);
+
+    CHECK(writer.valid());
+    CHECK(reader.valid());
+
+    for (size_t n = 3; n < NumPackets; n += 5) {
+        network.lose_source(n);
+    }
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        writer.write(make_packet(n));
+    }
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        check_packet(reader.read(), n, n % 5 == 3);
+    }
+
+    CHECK(!reader.read());
+}
+
+TEST(rlc_writer_reader, burst_loss) {
+    Network network;
+
+    RLCWriter writer(writer_config, network, source_composer, repair_composer,
+                     packet_pool, buffer_pool, allocator);
+    RLCReader reader(reader_config, network.source_queue(), network.repair_queue(),
+                     rtp_parser, packet_pool, buffer_pool, allocator);
+
+    CHECK(writer.valid());
+    CHECK(reader.valid());
+
+    // burst shorter than half of the window is repaired by following
+    // repair packets, which overlap it
+    for (size_t n = 50; n < 54; n++) {
+        network.lose_source(n);
+    }
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        writer.write(make_packet(n));
+    }
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        check_packet(reader.read(), n, n >= 50 && n < 54);
+    }
+
+    CHECK(!reader.read());
+}
+
+TEST(rlc_writer_reader, source_and_repair_losses) {
+    Network network;
+
+    RLCWriter writer(writer_config, network, source_composer, repair_composer,
+                     packet_pool, buffer_pool, allocator);
+    RLCReader reader(reader_config, network.source_queue(), network.repair_queue(),
+                     rtp_parser, packet_pool, buffer_pool, allocator);
+
+    CHECK(writer.valid());
+    CHECK(reader.valid());
+
+    network.lose_source(20);
+    network.lose_source(21);
+    network.lose_repair(10);
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        writer.write(make_packet(n));
+    }
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        check_packet(reader.read(), n, n == 20 || n == 21);
+    }
+
+    CHECK(!reader.read());
+}
+
+TEST(rlc_writer_reader, unrepairable_loss) {
+    Network network;
+
+    RLCWriter writer(writer_config, network, source_composer, repair_composer,
+                     packet_pool, buffer_pool, allocator);
+    RLCReader reader(reader_config, network.source_queue(), network.repair_queue(),
+                     rtp_parser, packet_pool, buffer_pool, allocator);
+
+    CHECK(writer.valid());
+    CHECK(reader.valid());
+
+    // burst longer than window can't be repaired
+    const size_t lost_first = 60, lost_last = 60 + writer_config.window_length + 5;
+
+    for (size_t n = lost_first; n <= lost_last; n++) {
+        network.lose_source(n);
+    }
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        writer.write(make_packet(n));
+    }
+
+    // packets before and after the burst are still delivered in order,
+    // some packets at the edges of the burst may be repaired
+    size_t n_read = 0;
+    size_t last_sn = 0;
+
+    while (packet::PacketPtr pp = reader.read()) {
+        const size_t sn = pp->rtp()->seqnum;
+
+        if (n_read != 0) {
+            CHECK(sn > last_sn);
+        }
+        if (sn < lost_first || sn > lost_last) {
+            check_packet(pp, sn, false);
+        } else {
+            check_packet(pp, sn, true);
+        }
+
+        last_sn = sn;
+        n_read++;
+    }
+
+    UNSIGNED_LONGS_EQUAL(NumPackets - 1, last_sn);
+    CHECK(n_read >= NumPackets - (lost_last - lost_first + 1));
+    CHECK(n_read < NumPackets);
+
+    CHECK(reader.alive());
+}
+
+TEST(rlc_writer_reader, repair_latency) {
+    Network network;
+
+    RLCWriter writer(writer_config, network, source_composer, repair_composer,
+                     packet_pool, buffer_pool, allocator);
+    RLCReader reader(reader_config, network.source_queue(), network.repair_queue(),
+                     rtp_parser, packet_pool, buffer_pool, allocator);
+
+    CHECK(writer.valid());
+    CHECK(reader.valid());
+
+    const size_t lost_sn = 31;
+    network.lose_source(lost_sn);
+
+    for (size_t n = 0; n < lost_sn; n++) {
+        writer.write(make_packet(n));
+        while (packet::PacketPtr pp = reader.read()) {
+            check_packet(pp, pp->rtp()->seqnum, false);
+        }
+    }
+
+    // lost packet is repaired as soon as the next repair packet arrives,
+    // which is sent after the current group of source packets is complete
+    size_t n = lost_sn;
+    for (; n < lost_sn + writer_config.n_source_packets; n++) {
+        writer.write(make_packet(n));
+    }
+
+    check_packet(reader.read(), lost_sn, true);
+
+    for (size_t sn = lost_sn + 1; sn < n; sn++) {
+        check_packet(reader.read(), sn, false);
+    }
+
+    CHECK(!reader.read());
+}
+
+TEST(rlc_writer_reader, payload_size_change) {
+    Network network;
+
+    RLCWriter writer(writer_config, network, source_composer, repair_composer,
+                     packet_pool, buffer_pool, allocator);
+    RLCReader reader(reader_config, network.source_queue(), network.repair_queue(),
+                     rtp_parser, packet_pool, buffer_pool, allocator);
+
+    CHECK(writer.valid());
+    CHECK(reader.valid());
+
+    const size_t switch_sn = 100;
+
+    network.lose_source(switch_sn - 4);
+    network.lose_source(switch_sn + 3);
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        writer.write(
+            make_packet(n, n < switch_sn ? FECPayloadSize : FECPayloadSize + 40));
+    }
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        check_packet(reader.read(), n, n == switch_sn - 4 || n == switch_sn + 3,
+                     n < switch_sn ? FECPayloadSize : FECPayloadSize + 40);
+    }
+
+    CHECK(!reader.read());
+}
+
+} // namespace fec
+} // namespace roc
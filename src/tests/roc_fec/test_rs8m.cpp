@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/random.h"
+#include "roc_core/unique_ptr.h"
+#include "roc_fec/codec_map.h"
+#include "roc_fec/rs8m_decoder.h"
+#include "roc_fec/rs8m_encoder.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+enum { MaxPayloadSize = 1024, MaxBlockLength = 255 };
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, MaxPayloadSize, true);
+
+CodecConfig make_config() {
+    CodecConfig config;
+    config.scheme = packet::FEC_ReedSolomon_M8;
+    return config;
+}
+
+core::Slice<uint8_t> make_buffer(size_t size) {
+    core::Slice<uint8_t> buf = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    CHECK(buf);
+    buf.resize(size);
+    return buf;
+}
+
+core::Slice<uint8_t> make_random_buffer(size_t size) {
+    core::Slice<uint8_t> buf = make_buffer(size);
+    for (size_t n = 0; n < size; n++) {
+        buf.data()[n] = (uint8_t)core::random(0, 0xff);
+    }
+    return buf;
+}
+
+} // namespace
+
+TEST_GROUP(rs8m) {
+    core::Slice<uint8_t> buffers[MaxBlockLength];
+
+    void encode(RS8MEncoder & encoder, size_t sblen, size_t rblen, size_t payload_size) {
+        CHECK(encoder.begin(sblen, rblen, payload_size));
+
+        for (size_t i = 0; i < sblen + rblen; i++) {
+            if (i < sblen) {
+                buffers[i] = make_random_buffer(payload_size);
+            } else {
+                buffers[i] = make_buffer(payload_size);
+            }
+            encoder.set(i, buffers[i]);
+        }
+
+        encoder.fill();
+        encoder.end();
+    }
+
+    // Returns number of repaired source packets.
+    size_t decode(RS8MDecoder & decoder, size_t sblen, size_t rblen,
+                  size_t payload_size, const bool* lost) {
+        CHECK(decoder.begin(sblen, rblen, payload_size));
+
+        for (size_t i = 0; i < sblen + rblen; i++) {
+            if (!lost[i]) {
+                decoder.set(i, buffers[i]);
+            }
+        }
+
+        size_t n_repaired = 0;
+
+        for (size_t i = 0; i < sblen; i++) {
+            core::Slice<uint8_t> buf = decoder.repair(i);
+            if (!buf) {
+                continue;
+            }
+
+            UNSIGNED_LONGS_EQUAL(payload_size, buf.size());
+            CHECK(memcmp(buffers[i].data(), buf.data(), payload_size) == 0);
+
+            if (lost[i]) {
+                n_repaired++;
+            }
+        }
+
+        decoder.end();
+
+        return n_repaired;
+    }
+};
+
+TEST(rs8m, codec_map) {
+    CodecMap codec_map;
+    CodecConfig config = make_config();
+
+    core::UniquePtr<IBlockEncoder> encoder(
+        codec_map.new_encoder(config, buffer_pool, allocator), allocator);
+    core::UniquePtr<IBlockDecoder> decoder(
+        codec_map.new_decoder(config, buffer_pool, allocator), allocator);
+
+    CHECK(encoder);
+    CHECK(decoder);
+
+    UNSIGNED_LONGS_EQUAL(MaxBlockLength, encoder->max_block_length());
+    UNSIGNED_LONGS_EQUAL(MaxBlockLength, decoder->max_block_length());
+}
+
+TEST(rs8m, invalid_m) {
+    CodecConfig config = make_config();
+    config.rs_m = 16;
+
+    RS8MEncoder encoder(config, buffer_pool, allocator);
+    RS8MDecoder decoder(config, buffer_pool, allocator);
+
+    CHECK(!encoder.valid());
+    CHECK(!decoder.valid());
+}
+
+TEST(rs8m, invalid_block) {
+    RS8MEncoder encoder(make_config(), buffer_pool, allocator);
+    RS8MDecoder decoder(make_config(), buffer_pool, allocator);
+
+    CHECK(!encoder.begin(0, 10, 100));
+    CHECK(!encoder.begin(200, 56, 100));
+    CHECK(!decoder.begin(0, 10, 100));
+    CHECK(!decoder.begin(200, 56, 100));
+
+    CHECK(encoder.begin(200, 55, 100));
+    CHECK(decoder.begin(200, 55, 100));
+}
+
+// Regression symbols produced by this implementation. They don't prove
+// compatibility with OpenFEC, which is checked by test_rs8m_openfec.
+TEST(rs8m, known_symbols) {
+    enum { SourceLen = 4, RepairLen = 3, PayloadSize = 8 };
+
+    const uint8_t expected[RepairLen][PayloadSize] = {
+        { 0xab, 0xeb, 0x7a, 0xcd, 0x57, 0xa1, 0x2c, 0xae },
+        { 0xfe, 0xf6, 0x29, 0xd6, 0x45, 0xd7, 0xb5, 0x8f },
+        { 0x2c, 0x29, 0x3d, 0xd9, 0x83, 0x4c, 0xb8, 0x06 },
+    };
+
+    RS8MEncoder encoder(make_config(), buffer_pool, allocator);
+    CHECK(encoder.valid());
+
+    CHECK(encoder.begin(SourceLen, RepairLen, PayloadSize));
+
+    for (size_t i = 0; i < SourceLen + RepairLen; i++) {
+        buffers[i] = make_buffer(PayloadSize);
+        for (size_t j = 0; j < PayloadSize; j++) {
+            buffers[i].data()[j] = i < SourceLen ? (uint8_t)(i * 37 + j * 11 + 1) : 0;
+        }
+        encoder.set(i, buffers[i]);
+    }
+
+    encoder.fill();
+    encoder.end();
+
+    for (size_t i = 0; i < RepairLen; i++) {
+        CHECK(memcmp(expected[i], buffers[SourceLen + i].data(), PayloadSize) == 0);
+    }
+}
+
+TEST(rs8m, repair_buffers_set_first) {
+    enum { SourceLen = 20, RepairLen = 10, PayloadSize = 300 };
+
+    RS8MEncoder encoder(make_config(), buffer_pool, allocator);
+    CHECK(encoder.valid());
+
+    // source buffers first, repair buffers are filled at once
+    encode(encoder, SourceLen, RepairLen, PayloadSize);
+
+    core::Slice<uint8_t> repair_buffers[RepairLen];
+
+    CHECK(encoder.begin(SourceLen, RepairLen, PayloadSize));
+
+    // repair buffers first, with garbage, then source buffers one by one,
+    // so that repair buffers are accumulated incrementally
+    for (size_t i = 0; i < RepairLen; i++) {
+        repair_buffers[i] = make_random_buffer(PayloadSize);
+        encoder.set(SourceLen + i, repair_buffers[i]);
+    }
+
+    for (size_t i = 0; i < SourceLen; i++) {
+        encoder.set(i, buffers[i]);
+    }
+
+    encoder.fill();
+    encoder.end();
+
+    for (size_t i = 0; i < RepairLen; i++) {
+        CHECK(memcmp(buffers[SourceLen + i].data(), repair_buffers[i].data(),
+                     PayloadSize)
+              == 0);
+    }
+}
+
+TEST(rs8m, single_source_packet) {
+    enum { SourceLen = 1, RepairLen = 3, PayloadSize = 100 };
+
+    RS8MEncoder encoder(make_config(), buffer_pool, allocator);
+    encode(encoder, SourceLen, RepairLen, PayloadSize);
+
+    // with one source packet, every repair packet is its copy
+    for (size_t i = SourceLen; i < SourceLen + RepairLen; i++) {
+        CHECK(memcmp(buffers[0].data(), buffers[i].data(), PayloadSize) == 0);
+    }
+}
+
+TEST(rs8m, all_loss_patterns) {
+    enum { SourceLen = 6, RepairLen = 4, BlockLen = SourceLen + RepairLen };
+    enum { PayloadSize = 77 };
+
+    RS8MEncoder encoder(make_config(), buffer_pool, allocator);
+    RS8MDecoder decoder(make_config(), buffer_pool, allocator);
+
+    CHECK(encoder.valid());
+    CHECK(decoder.valid());
+
+    encode(encoder, SourceLen, RepairLen, PayloadSize);
+
+    for (unsigned mask = 0; mask < (1u << BlockLen); mask++) {
+        bool lost[BlockLen];
+        size_t n_lost = 0, n_lost_source = 0;
+
+        for (size_t i = 0; i < BlockLen; i++) {
+            lost[i] = (mask & (1u << i)) != 0;
+            if (lost[i]) {
+                n_lost++;
+                if (i < SourceLen) {
+                    n_lost_source++;
+                }
+            }
+        }
+
+        const size_t n_repaired =
+            decode(decoder, SourceLen, RepairLen, PayloadSize, lost);
+
+        // any SourceLen packets are enough to repair the block
+        if (n_lost <= RepairLen) {
+            UNSIGNED_LONGS_EQUAL(n_lost_source, n_repaired);
+        } else {
+            UNSIGNED_LONGS_EQUAL(0, n_repaired);
+        }
+    }
+}
+
+TEST(rs8m, varying_block_size) {
+    enum { NumIterations = 30, PayloadSize = 251 };
+
+    RS8MEncoder encoder(make_config(), buffer_pool, allocator);
+    RS8MDecoder decoder(make_config(), buffer_pool, allocator);
+
+    for (size_t iter = 0; iter < NumIterations; iter++) {
+        const size_t sblen = core::random(1, 200);
+        const size_t rblen = core::random(1, MaxBlockLength - sblen);
+
+        encode(encoder, sblen, rblen, PayloadSize);
+
+        bool lost[MaxBlockLength] = {};
+
+        // lose up to rblen random packets
+        size_t n_lost_source = 0;
+        for (size_t n = 0; n < rblen; n++) {
+            const size_t i = core::random(0, sblen + rblen - 1);
+            if (!lost[i] && i < sblen) {
+                n_lost_source++;
+            }
+            lost[i] = true;
+        }
+
+        UNSIGNED_LONGS_EQUAL(n_lost_source,
+                             decode(decoder, sblen, rblen, PayloadSize, lost));
+    }
+}
+
+TEST(rs8m, repair_after_more_packets) {
+    enum { SourceLen = 10, RepairLen = 5, PayloadSize = 64 };
+
+    RS8MEncoder encoder(make_config(), buffer_pool, allocator);
+    RS8MDecoder decoder(make_config(), buffer_pool, allocator);
+
+    encode(encoder, SourceLen, RepairLen, PayloadSize);
+
+    CHECK(decoder.begin(SourceLen, RepairLen, PayloadSize));
+
+    for (size_t i = 2; i < SourceLen; i++) {
+        decoder.set(i, buffers[i]);
+    }
+    decoder.set(SourceLen, buffers[SourceLen]);
+
+    // two packets lost, one repair packet received
+    CHECK(!decoder.repair(0));
+    CHECK(!decoder.repair(1));
+
+    decoder.set(SourceLen + 3, buffers[SourceLen + 3]);
+
+    for (size_t i = 0; i < 2; i++) {
+        core::Slice<uint8_t> buf = decoder.repair(i);
+        CHECK(buf);
+        CHECK(memcmp(buffers[i].data(), buf.data(), PayloadSize) == 0);
+    }
+
+    // repair packets are not repaired
+    CHECK(!decoder.repair(SourceLen + 1));
+
+    decoder.end();
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+// Benchmarks for sending and receiving datagrams over loopback.
+//
+// Sender and receiver ports share one event loop, which is run in the
+// benchmark thread, so that the whole path, including system calls, is
+// accounted to it. Every iteration writes a burst of packets to sender
+// and runs the loop until receiver gets all of them.
+//
+// Arguments are batch size and payload size. Batch size 1 is the plain
+// libuv path, which receives one datagram per system call; larger sizes
+// use sendmmsg() and recvmmsg(), and GSO and GRO, where supported.
+//
+// Reported counters:
+//  - items_per_second: packets per second
+//  - cpu_ns_per_packet: user and system CPU time per packet
+
+#include <benchmark/benchmark.h>
+
+#include <sys/resource.h>
+#include <uv.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/panic.h"
+#include "roc_core/shared_ptr.h"
+#include "roc_netio/iclose_handler.h"
+#include "roc_netio/udp_receiver_port.h"
+#include "roc_netio/udp_sender_port.h"
+#include "roc_packet/address.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet_pool.h"
+
+namespace roc {
+namespace netio {
+
+namespace {
+
+enum { BurstSize = 64, BufferSize = 2048, MaxIdleRuns = 1000000 };
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, BufferSize, false);
+packet::PacketPool packet_pool(allocator, false);
+
+class CountingWriter : public packet::IWriter {
+public:
+    CountingWriter()
+        : count_(0) {
+    }
+
+    virtual void write(const packet::PacketPtr&) {
+        count_++;
+    }
+
+    size_t count() const {
+        return count_;
+    }
+
+private:
+    size_t count_;
+};
+
+class CloseHandler : public ICloseHandler {
+public:
+    CloseHandler()
+        : count_(0) {
+    }
+
+    virtual void handle_closed(BasicPort&) {
+        count_++;
+    }
+
+    size_t count() const {
+        return count_;
+    }
+
+private:
+    size_t count_;
+};
+
+double cpu_time_ns() {
+    rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) != 0) {
+        roc_panic("bench: getrusage() failed");
+    }
+
+    return (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1e9
+        + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) * 1e3;
+}
+
+packet::PacketPtr new_packet(const packet::Address& dst_addr, size_t payload_size) {
+    packet::PacketPtr pp = new (packet_pool) packet::Packet(packet_pool);
+    if (!pp) {
+        roc_panic("bench: can't allocate packet");
+    }
+
+    core::Slice<uint8_t> buf = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+    if (!buf) {
+        roc_panic("bench: can't allocate buffer");
+    }
+    buf.resize(payload_size);
+    memset(buf.data(), 0x5a, payload_size);
+
+    pp->add_flags(packet::Packet::FlagUDP);
+    pp->udp()->dst_addr = dst_addr;
+    pp->set_data(buf);
+
+    return pp;
+}
+
+void BM_UDP_Loopback(benchmark::State& state) {
+    const size_t batch_size = (size_t)state.range(0);
+    const size_t payload_size = (size_t)state.range(1);
+
+    uv_loop_t loop;
+    if (uv_loop_init(&loop) != 0) {
+        roc_panic("bench: uv_loop_init() failed");
+    }
+
+    packet::Address rx_addr;
+    packet::Address tx_addr;
+    if (!rx_addr.set_ipv4("127.0.0.1", 0) || !tx_addr.set_ipv4("127.0.0.1", 0)) {
+        roc_panic("bench: can't set address");
+    }
+
+    CountingWriter writer;
+    CloseHandler close_handler;
+
+    core::SharedPtr<UDPReceiverPort> receiver =
+        new (allocator) UDPReceiverPort(close_handler, rx_addr, loop, writer, packet_pool,
+                                        buffer_pool, allocator, batch_size);
+    core::SharedPtr<UDPSenderPort> sender =
+        new (allocator) UDPSenderPort(close_handler, tx_addr, loop, allocator,
+                                      batch_size);
+
+    if (!receiver || !sender || !receiver->open() || !sender->open()) {
+        roc_panic("bench: can't open ports");
+    }
+
+    rx_addr = receiver->address();
+
+    size_t n_expected = 0;
+    bool failed = false;
+
+    const double start_cpu = cpu_time_ns();
+
+    while (state.KeepRunning()) {
+        for (size_t n = 0; n < BurstSize; n++) {
+            sender->write(new_packet(rx_addr, payload_size));
+        }
+
+        n_expected += BurstSize;
+
+        size_t n_idle = 0;
+        size_t n_received = writer.count();
+
+        while (writer.count() < n_expected) {
+            uv_run(&loop, UV_RUN_NOWAIT);
+
+            if (writer.count() != n_received) {
+                n_received = writer.count();
+                n_idle = 0;
+            } else if (++n_idle == MaxIdleRuns) {
+                failed = true;
+                break;
+            }
+        }
+
+        if (failed) {
+            state.SkipWithError("packets were lost");
+            break;
+        }
+    }
+
+    const double cpu_ns = cpu_time_ns() - start_cpu;
+
+    receiver->async_close();
+    sender->async_close();
+
+    while (close_handler.count() != 2) {
+        uv_run(&loop, UV_RUN_ONCE);
+    }
+
+    if (uv_loop_close(&loop) != 0) {
+        roc_panic("bench: uv_loop_close() failed");
+    }
+
+    if (n_expected != 0) {
+        state.counters["cpu_ns_per_packet"] = cpu_ns / n_expected;
+    }
+
+    state.SetLabel(batch_size > 1 ? "batched" : "libuv");
+    state.SetItemsProcessed(int64_t(n_expected));
+    state.SetBytesProcessed(int64_t(n_expected * payload_size));
+}
+
+BENCHMARK(BM_UDP_Loopback)
+    ->Args({ 1, 200 })
+    ->Args({ 8, 200 })
+    ->Args({ 32, 200 })
+    ->Args({ 1, 1400 })
+    ->Args({ 8, 1400 })
+    ->Args({ 32, 1400 })
+    ->UseRealTime();
+
+} // namespace
+
+} // namespace netio
+} // namespace roc
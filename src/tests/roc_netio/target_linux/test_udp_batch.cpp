@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <errno.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "roc_netio/udp_batch.h"
+#include "roc_packet/address.h"
+
+namespace roc {
+namespace netio {
+
+namespace {
+
+enum { NumDatagrams = 20, DatagramSize = 100, RecvBufferSize = 65536 };
+
+uint8_t send_buf[NumDatagrams][DatagramSize];
+uint8_t recv_buf[UDPBatch::MaxSize][RecvBufferSize];
+
+} // namespace
+
+TEST_GROUP(udp_batch) {
+    packet::Address new_address(int port) {
+        packet::Address addr;
+        CHECK(addr.set_ipv4("127.0.0.1", port));
+        return addr;
+    }
+
+    int open_socket(packet::Address& addr) {
+        int fd = socket(AF_INET, SOCK_DGRAM, 0);
+        CHECK(fd >= 0);
+
+        CHECK(bind(fd, addr.saddr(), addr.slen()) == 0);
+
+        socklen_t len = addr.slen();
+        CHECK(getsockname(fd, addr.saddr(), &len) == 0);
+
+        return fd;
+    }
+
+    void fill_datagrams() {
+        for (size_t n = 0; n < NumDatagrams; n++) {
+            for (size_t i = 0; i < DatagramSize; i++) {
+                send_buf[n][i] = uint8_t((n * 7 + i) & 0xff);
+            }
+        }
+    }
+
+    void send_datagrams(int fd, const packet::Address& dst_addr, bool gso) {
+        UDPBatch batch;
+        batch.set_gso(gso);
+
+        for (size_t n = 0; n < NumDatagrams; n++) {
+            batch.add(send_buf[n], DatagramSize, &dst_addr);
+        }
+
+        if (gso) {
+            UNSIGNED_LONGS_EQUAL(1, batch.num_messages());
+        } else {
+            UNSIGNED_LONGS_EQUAL(NumDatagrams, batch.num_messages());
+        }
+
+        LONGS_EQUAL(NumDatagrams, batch.send(fd));
+    }
+
+    size_t recv_datagrams(int fd, const packet::Address& src_addr) {
+        size_t n_datagrams = 0;
+        size_t n_messages = 0;
+
+        while (n_datagrams < NumDatagrams) {
+            UDPBatch batch;
+
+            for (size_t n = 0; n < UDPBatch::MaxSize; n++) {
+                batch.add(recv_buf[n], RecvBufferSize, NULL);
+            }
+
+            const ssize_t n_msgs = batch.recv(fd);
+            CHECK(n_msgs > 0);
+
+            n_messages += (size_t)n_msgs;
+
+            for (size_t n = 0; n < (size_t)n_msgs; n++) {
+                CHECK(!batch.truncated(n));
+
+                packet::Address addr;
+                CHECK(batch.source_address(n, addr));
+                CHECK(addr == src_addr);
+
+                const size_t size = batch.received_size(n);
+                const size_t segment_size = batch.segment_size(n);
+
+                UNSIGNED_LONGS_EQUAL(DatagramSize, segment_size);
+                UNSIGNED_LONGS_EQUAL(0, size % segment_size);
+
+                for (size_t off = 0; off < size; off += segment_size) {
+                    CHECK(n_datagrams < NumDatagrams);
+                    CHECK(memcmp(recv_buf[n] + off, send_buf[n_datagrams], DatagramSize)
+                          == 0);
+                    n_datagrams++;
+                }
+            }
+        }
+
+        UDPBatch batch;
+        batch.add(recv_buf[0], RecvBufferSize, NULL);
+
+        LONGS_EQUAL(-1, batch.recv(fd));
+        LONGS_EQUAL(EAGAIN, errno);
+
+        return n_messages;
+    }
+};
+
+TEST(udp_batch, empty) {
+    UDPBatch batch;
+
+    UNSIGNED_LONGS_EQUAL(0, batch.size());
+    UNSIGNED_LONGS_EQUAL(0, batch.num_messages());
+    CHECK(!batch.gso());
+}
+
+TEST(udp_batch, no_gso) {
+    packet::Address addr = new_address(1234);
+
+    UDPBatch batch;
+
+    for (size_t n = 0; n < NumDatagrams; n++) {
+        batch.add(send_buf[n], DatagramSize, &addr);
+    }
+
+    UNSIGNED_LONGS_EQUAL(NumDatagrams, batch.size());
+    UNSIGNED_LONGS_EQUAL(NumDatagrams, batch.num_messages());
+}
+
+TEST(udp_batch, gso_coalesce) {
+    packet::Address addr = new_address(1234);
+
+    UDPBatch batch;
+    batch.set_gso(true);
+
+    for (size_t n = 0; n < NumDatagrams; n++) {
+        batch.add(send_buf[n], DatagramSize, &addr);
+    }
+
+    UNSIGNED_LONGS_EQUAL(NumDatagrams, batch.size());
+    UNSIGNED_LONGS_EQUAL(1, batch.num_messages());
+
+    batch.clear();
+
+    UNSIGNED_LONGS_EQUAL(0, batch.size());
+    UNSIGNED_LONGS_EQUAL(0, batch.num_messages());
+}
+
+TEST(udp_batch, gso_different_size) {
+    packet::Address addr = new_address(1234);
+
+    UDPBatch batch;
+    batch.set_gso(true);
+
+    batch.add(send_buf[0], DatagramSize, &addr);
+    batch.add(send_buf[1], DatagramSize, &addr);
+    batch.add(send_buf[2], DatagramSize / 2, &addr);
+    batch.add(send_buf[3], DatagramSize / 2, &addr);
+    batch.add(send_buf[4], DatagramSize, &addr);
+
+    UNSIGNED_LONGS_EQUAL(5, batch.size());
+    UNSIGNED_LONGS_EQUAL(3, batch.num_messages());
+}
+
+TEST(udp_batch, gso_different_address) {
+    packet::Address addr1 = new_address(1234);
+    packet::Address addr2 = new_address(1235);
+
+    UDPBatch batch;
+    batch.set_gso(true);
+
+    batch.add(send_buf[0], DatagramSize, &addr1);
+    batch.add(send_buf[1], DatagramSize, &addr1);
+    batch.add(send_buf[2], DatagramSize, &addr2);
+    batch.add(send_buf[3], DatagramSize, &addr1);
+
+    UNSIGNED_LONGS_EQUAL(4, batch.size());
+    UNSIGNED_LONGS_EQUAL(3, batch.num_messages());
+}
+
+TEST(udp_batch, gso_max_message_size) {
+    enum { Size = 8000 };
+
+    static uint8_t buf[Size];
+
+    packet::Address addr = new_address(1234);
+
+    UDPBatch batch;
+    batch.set_gso(true);
+
+    const size_t n_per_message = UDPBatch::MaxMessageSize / Size;
+
+    for (size_t n = 0; n < n_per_message + 1; n++) {
+        batch.add(buf, Size, &addr);
+    }
+
+    UNSIGNED_LONGS_EQUAL(n_per_message + 1, batch.size());
+    UNSIGNED_LONGS_EQUAL(2, batch.num_messages());
+}
+
+TEST(udp_batch, send_skip) {
+    packet::Address addr1 = new_address(1234);
+    packet::Address addr2 = new_address(1235);
+
+    UDPBatch batch;
+    batch.set_gso(true);
+
+    batch.add(send_buf[0], DatagramSize, &addr1);
+    batch.add(send_buf[1], DatagramSize, &addr1);
+    batch.add(send_buf[2], DatagramSize, &addr2);
+
+    UNSIGNED_LONGS_EQUAL(2, batch.skip());
+    UNSIGNED_LONGS_EQUAL(1, batch.skip());
+}
+
+TEST(udp_batch, loopback) {
+    fill_datagrams();
+
+    packet::Address rx_addr = new_address(0);
+    packet::Address tx_addr = new_address(0);
+
+    const int rx_fd = open_socket(rx_addr);
+    const int tx_fd = open_socket(tx_addr);
+
+    send_datagrams(tx_fd, rx_addr, false);
+    UNSIGNED_LONGS_EQUAL(NumDatagrams, recv_datagrams(rx_fd, tx_addr));
+
+    close(tx_fd);
+    close(rx_fd);
+}
+
+TEST(udp_batch, loopback_gso) {
+    fill_datagrams();
+
+    packet::Address rx_addr = new_address(0);
+    packet::Address tx_addr = new_address(0);
+
+    const int rx_fd = open_socket(rx_addr);
+    const int tx_fd = open_socket(tx_addr);
+
+    // receiver without gro gets datagrams segmented by kernel
+    if (UDPBatch::gso_supported(tx_fd)) {
+        send_datagrams(tx_fd, rx_addr, true);
+        UNSIGNED_LONGS_EQUAL(NumDatagrams, recv_datagrams(rx_fd, tx_addr));
+    }
+
+    close(tx_fd);
+    close(rx_fd);
+}
+
+TEST(udp_batch, loopback_gso_gro) {
+    fill_datagrams();
+
+    packet::Address rx_addr = new_address(0);
+    packet::Address tx_addr = new_address(0);
+
+    const int rx_fd = open_socket(rx_addr);
+    const int tx_fd = open_socket(tx_addr);
+
+    // receiver with gro gets coalesced message and splits it
+    if (UDPBatch::gso_supported(tx_fd) && UDPBatch::enable_gro(rx_fd)) {
+        send_datagrams(tx_fd, rx_addr, true);
+        UNSIGNED_LONGS_EQUAL(1, recv_datagrams(rx_fd, tx_addr));
+    }
+
+    close(tx_fd);
+    close(rx_fd);
+}
+
+} // namespace netio
+} // namespace roc
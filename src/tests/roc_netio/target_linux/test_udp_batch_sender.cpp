@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <errno.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <uv.h>
+
+#include "roc_core/buffer_pool.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_netio/udp_batch_sender.h"
+#include "roc_packet/address.h"
+#include "roc_packet/packet_pool.h"
+
+namespace roc {
+namespace netio {
+
+namespace {
+
+enum { BatchSize = 8, NumPackets = 20, MaxSteps = 8, BufferSize = 200 };
+
+core::HeapAllocator allocator;
+core::BufferPool<uint8_t> buffer_pool(allocator, BufferSize, true);
+packet::PacketPool packet_pool(allocator, true);
+
+// Batch sender with scripted sendmmsg() results.
+class MockSender : public UDPBatchSender {
+public:
+    MockSender()
+        : UDPBatchSender(BatchSize)
+        , n_steps_(0)
+        , n_calls_(0)
+        , n_sent_(0) {
+    }
+
+    // Send given number of messages.
+    void add_send(size_t n_msgs) {
+        add_step_(n_msgs, 0, false);
+    }
+
+    // Fail with given errno.
+    void add_error(int err) {
+        add_step_(0, err, false);
+    }
+
+    // Send messages to socket.
+    void add_real_send() {
+        add_step_(0, 0, true);
+    }
+
+    size_t num_calls() const {
+        return n_calls_;
+    }
+
+    size_t num_sent() const {
+        return n_sent_;
+    }
+
+private:
+    struct Step {
+        size_t n_msgs;
+        int err;
+        bool real;
+    };
+
+    void add_step_(size_t n_msgs, int err, bool real) {
+        CHECK(n_steps_ < MaxSteps);
+
+        steps_[n_steps_].n_msgs = n_msgs;
+        steps_[n_steps_].err = err;
+        steps_[n_steps_].real = real;
+        n_steps_++;
+    }
+
+    virtual ssize_t send_messages_(UDPBatch& batch) {
+        CHECK(n_calls_ < n_steps_);
+
+        const Step& step = steps_[n_calls_++];
+
+        if (step.real) {
+            const ssize_t ret = UDPBatchSender::send_messages_(batch);
+            if (ret > 0) {
+                n_sent_ += (size_t)ret;
+            }
+            return ret;
+        }
+
+        if (step.err != 0) {
+            errno = step.err;
+            return -1;
+        }
+
+        size_t n_datagrams = 0;
+        for (size_t n = 0; n < step.n_msgs; n++) {
+            n_datagrams += batch.skip();
+        }
+
+        n_sent_ += n_datagrams;
+
+        return (ssize_t)n_datagrams;
+    }
+
+    Step steps_[MaxSteps];
+    size_t n_steps_;
+
+    size_t n_calls_;
+    size_t n_sent_;
+};
+
+} // namespace
+
+TEST_GROUP(udp_batch_sender) {
+    uv_loop_t loop;
+    uv_udp_t handle;
+
+    packet::Address tx_addr;
+    packet::Address rx_addr;
+
+    int rx_fd;
+
+    packet::PacketPtr packets[NumPackets];
+
+    void setup() {
+        CHECK(uv_loop_init(&loop) == 0);
+
+        CHECK(tx_addr.set_ipv4("127.0.0.1", 0));
+        CHECK(rx_addr.set_ipv4("127.0.0.1", 0));
+
+        CHECK(uv_udp_init(&loop, &handle) == 0);
+        CHECK(uv_udp_bind(&handle, tx_addr.saddr(), 0) == 0);
+
+        int addrlen = (int)tx_addr.slen();
+        CHECK(uv_udp_getsockname(&handle, tx_addr.saddr(), &addrlen) == 0);
+
+        rx_fd = socket(AF_INET, SOCK_DGRAM, 0);
+        CHECK(rx_fd >= 0);
+        CHECK(bind(rx_fd, rx_addr.saddr(), rx_addr.slen()) == 0);
+
+        socklen_t len = rx_addr.slen();
+        CHECK(getsockname(rx_fd, rx_addr.saddr(), &len) == 0);
+
+        for (size_t n = 0; n < NumPackets; n++) {
+            packets[n] = new_packet(n);
+        }
+    }
+
+    void teardown() {
+        for (size_t n = 0; n < NumPackets; n++) {
+            packets[n] = NULL;
+        }
+
+        close(rx_fd);
+
+        uv_close((uv_handle_t*)&handle, NULL);
+        CHECK(uv_run(&loop, UV_RUN_DEFAULT) == 0);
+        CHECK(uv_loop_close(&loop) == 0);
+    }
+
+    // Packets have different sizes, so that every packet is a separate
+    // message even if GSO is enabled.
+    packet::PacketPtr new_packet(size_t num) {
+        packet::PacketPtr pp = new (packet_pool) packet::Packet(packet_pool);
+        CHECK(pp);
+
+        core::Slice<uint8_t> buf = new (buffer_pool) core::Buffer<uint8_t>(buffer_pool);
+        CHECK(buf);
+
+        buf.resize(num + 1);
+        for (size_t n = 0; n < buf.size(); n++) {
+            buf.data()[n] = uint8_t(num);
+        }
+
+        pp->add_flags(packet::Packet::FlagUDP);
+        pp->udp()->dst_addr = rx_addr;
+        pp->set_data(buf);
+
+        return pp;
+    }
+
+    void send_all(UDPBatchSender& sender) {
+        for (size_t off = 0; off < NumPackets;) {
+            const size_t n_packets = std::min((size_t)BatchSize, NumPackets - off);
+            const size_t n_sent = sender.send(packets + off, n_packets);
+
+            UNSIGNED_LONGS_EQUAL(n_packets, n_sent);
+            off += n_sent;
+        }
+    }
+
+    void recv_all() {
+        for (size_t n = 0; n < NumPackets; n++) {
+            uint8_t buf[BufferSize];
+
+            const ssize_t ret = recv(rx_fd, buf, sizeof(buf), MSG_DONTWAIT);
+
+            LONGS_EQUAL(n + 1, ret);
+            UNSIGNED_LONGS_EQUAL(n, buf[0]);
+        }
+
+        uint8_t buf[BufferSize];
+
+        LONGS_EQUAL(-1, recv(rx_fd, buf, sizeof(buf), MSG_DONTWAIT));
+        LONGS_EQUAL(EAGAIN, errno);
+    }
+};
+
+TEST(udp_batch_sender, open) {
+    UDPBatchSender sender(BatchSize);
+
+    UNSIGNED_LONGS_EQUAL(1, sender.batch_size());
+
+    CHECK(sender.open(handle, tx_addr));
+
+    UNSIGNED_LONGS_EQUAL(BatchSize, sender.batch_size());
+}
+
+TEST(udp_batch_sender, open_no_batching) {
+    UDPBatchSender sender(1);
+
+    CHECK(!sender.open(handle, tx_addr));
+
+    UNSIGNED_LONGS_EQUAL(1, sender.batch_size());
+    CHECK(!sender.gso());
+}
+
+TEST(udp_batch_sender, max_batch_size) {
+    UDPBatchSender sender(UDPBatchSender::MaxSize * 2);
+
+    CHECK(sender.open(handle, tx_addr));
+
+    UNSIGNED_LONGS_EQUAL(UDPBatchSender::MaxSize, sender.batch_size());
+}
+
+TEST(udp_batch_sender, ordering) {
+    UDPBatchSender sender(BatchSize);
+    CHECK(sender.open(handle, tx_addr));
+
+    send_all(sender);
+    recv_all();
+}
+
+TEST(udp_batch_sender, partial_send) {
+    MockSender sender;
+    CHECK(sender.open(handle, tx_addr));
+
+    // sendmmsg() may send only first messages, the rest is retried
+    sender.add_send(3);
+    sender.add_send(1);
+    sender.add_send(4);
+
+    UNSIGNED_LONGS_EQUAL(BatchSize, sender.send(packets, BatchSize));
+
+    UNSIGNED_LONGS_EQUAL(3, sender.num_calls());
+    UNSIGNED_LONGS_EQUAL(BatchSize, sender.num_sent());
+}
+
+TEST(udp_batch_sender, eagain) {
+    MockSender sender;
+    CHECK(sender.open(handle, tx_addr));
+
+    // socket buffer becomes full after first messages
+    sender.add_send(3);
+    sender.add_error(EAGAIN);
+
+    UNSIGNED_LONGS_EQUAL(3, sender.send(packets, BatchSize));
+
+    UNSIGNED_LONGS_EQUAL(2, sender.num_calls());
+    UNSIGNED_LONGS_EQUAL(3, sender.num_sent());
+
+    // socket buffer is full from the beginning
+    sender.add_error(EAGAIN);
+
+    UNSIGNED_LONGS_EQUAL(0, sender.send(packets + 3, BatchSize));
+
+    UNSIGNED_LONGS_EQUAL(3, sender.num_calls());
+    UNSIGNED_LONGS_EQUAL(3, sender.num_sent());
+}
+
+TEST(udp_batch_sender, eagain_ordering) {
+    MockSender sender;
+    CHECK(sender.open(handle, tx_addr));
+
+    // first batch is sent
+    sender.add_real_send();
+    UNSIGNED_LONGS_EQUAL(BatchSize, sender.send(packets, BatchSize));
+
+    // socket buffer is full, second batch is sent on next call
+    sender.add_error(EAGAIN);
+    UNSIGNED_LONGS_EQUAL(0, sender.send(packets + BatchSize, BatchSize));
+
+    sender.add_real_send();
+    UNSIGNED_LONGS_EQUAL(BatchSize, sender.send(packets + BatchSize, BatchSize));
+
+    // the same for last batch, which is smaller
+    const size_t n_last = NumPackets - BatchSize * 2;
+
+    sender.add_error(EAGAIN);
+    UNSIGNED_LONGS_EQUAL(0, sender.send(packets + BatchSize * 2, n_last));
+
+    sender.add_real_send();
+    UNSIGNED_LONGS_EQUAL(n_last, sender.send(packets + BatchSize * 2, n_last));
+
+    UNSIGNED_LONGS_EQUAL(5, sender.num_calls());
+    UNSIGNED_LONGS_EQUAL(NumPackets, sender.num_sent());
+
+    recv_all();
+}
+
+TEST(udp_batch_sender, error) {
+    MockSender sender;
+    CHECK(sender.open(handle, tx_addr));
+
+    // first message is dropped, the rest is sent
+    sender.add_error(EINVAL);
+    sender.add_send(BatchSize - 1);
+
+    UNSIGNED_LONGS_EQUAL(BatchSize, sender.send(packets, BatchSize));
+
+    UNSIGNED_LONGS_EQUAL(2, sender.num_calls());
+    UNSIGNED_LONGS_EQUAL(BatchSize - 1, sender.num_sent());
+}
+
+TEST(udp_batch_sender, gso_error) {
+    MockSender sender;
+    CHECK(sender.open(handle, tx_addr));
+
+    if (!sender.gso()) {
+        return;
+    }
+
+    // device can't segment datagrams, gso is disabled and batch is left
+    // to be sent without batching
+    sender.add_send(2);
+    sender.add_error(EIO);
+
+    UNSIGNED_LONGS_EQUAL(2, sender.send(packets, BatchSize));
+    CHECK(!sender.gso());
+
+    // without gso, the same error drops the message
+    sender.add_error(EIO);
+    sender.add_send(BatchSize - 1);
+
+    UNSIGNED_LONGS_EQUAL(BatchSize, sender.send(packets, BatchSize));
+    CHECK(!sender.gso());
+
+    UNSIGNED_LONGS_EQUAL(4, sender.num_calls());
+}
+
+} // namespace netio
+} // namespace roc
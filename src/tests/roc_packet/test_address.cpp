@@ -127,6 +127,32 @@ TEST(address, eq_ipv6) {
     CHECK(addr1 != addr4);
 }
 
+TEST(address, hash) {
+    Address addr1;
+    CHECK(addr1.set_ipv4("1.2.3.4", 123));
+
+    Address addr2;
+    CHECK(addr2.set_ipv4("1.2.3.4", 123));
+
+    Address addr3;
+    CHECK(addr3.set_ipv4("1.2.3.4", 456));
+
+    Address addr4;
+    CHECK(addr4.set_ipv6("2001:db8::1", 123));
+
+    Address addr5;
+    CHECK(addr5.set_ipv6("2001:db8::1", 123));
+
+    Address addr6;
+    CHECK(addr6.set_ipv6("2001:db8::2", 123));
+
+    CHECK(addr1.hash() == addr2.hash());
+    CHECK(addr1.hash() != addr3.hash());
+
+    CHECK(addr4.hash() == addr5.hash());
+    CHECK(addr4.hash() != addr6.hash());
+}
+
 TEST(address, multicast_ipv4) {
     {
         Address addr;
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_core/thread.h"
+#include "roc_packet/mpsc_queue.h"
+#include "roc_packet/packet_pool.h"
+
+namespace roc {
+namespace packet {
+
+namespace {
+
+core::HeapAllocator allocator;
+PacketPool pool(allocator, true);
+
+PacketPtr new_packet(source_t source, seqnum_t sn) {
+    PacketPtr packet = new (pool) Packet(pool);
+    CHECK(packet);
+
+    packet->add_flags(Packet::FlagRTP);
+    packet->rtp()->source = source;
+    packet->rtp()->seqnum = sn;
+
+    return packet;
+}
+
+class Writer : public core::Thread {
+public:
+    enum { NumPackets = 20000 };
+
+    Writer(MpscQueue& queue, source_t source)
+        : queue_(queue)
+        , source_(source) {
+    }
+
+private:
+    virtual void run() {
+        for (seqnum_t n = 0; n < NumPackets; n++) {
+            queue_.write(new_packet(source_, n));
+        }
+    }
+
+    MpscQueue& queue_;
+    const source_t source_;
+};
+
+} // namespace
+
+TEST_GROUP(mpsc_queue) {};
+
+TEST(mpsc_queue, empty) {
+    MpscQueue queue(allocator, 5, Overflow_DropNewest);
+    CHECK(queue.valid());
+
+    LONGS_EQUAL(8, queue.max_size());
+    LONGS_EQUAL(0, queue.size());
+
+    CHECK(!queue.read());
+}
+
+TEST(mpsc_queue, write_read) {
+    enum { NumPackets = 10 };
+
+    MpscQueue queue(allocator, NumPackets, Overflow_DropNewest);
+    CHECK(queue.valid());
+
+    PacketPtr packets[NumPackets];
+
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        packets[n] = new_packet(0, n);
+        queue.write(packets[n]);
+    }
+
+    LONGS_EQUAL(NumPackets, queue.size());
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        CHECK(queue.read() == packets[n]);
+        LONGS_EQUAL(1, packets[n]->getref());
+    }
+
+    LONGS_EQUAL(0, queue.size());
+    LONGS_EQUAL(0, queue.num_dropped());
+
+    CHECK(!queue.read());
+}
+
+TEST(mpsc_queue, wraparound) {
+    enum { MaxSize = 4, NumPackets = 1000 };
+
+    MpscQueue queue(allocator, MaxSize, Overflow_DropNewest);
+    CHECK(queue.valid());
+
+    seqnum_t wr_sn = 0;
+    seqnum_t rd_sn = 0;
+
+    while (rd_sn < NumPackets) {
+        for (size_t n = 0; n < MaxSize - 1; n++) {
+            queue.write(new_packet(0, wr_sn++));
+        }
+        for (size_t n = 0; n < MaxSize - 2; n++) {
+            PacketPtr pp = queue.read();
+            CHECK(pp);
+            LONGS_EQUAL(rd_sn++, pp->rtp()->seqnum);
+        }
+        while (PacketPtr pp = queue.read()) {
+            LONGS_EQUAL(rd_sn++, pp->rtp()->seqnum);
+        }
+    }
+
+    LONGS_EQUAL(0, queue.num_dropped());
+}
+
+TEST(mpsc_queue, drop_newest) {
+    enum { MaxSize = 4, NumPackets = 6 };
+
+    MpscQueue queue(allocator, MaxSize, Overflow_DropNewest);
+    CHECK(queue.valid());
+
+    PacketPtr packets[NumPackets];
+
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        packets[n] = new_packet(0, n);
+        queue.write(packets[n]);
+    }
+
+    LONGS_EQUAL(MaxSize, queue.size());
+    LONGS_EQUAL(NumPackets - MaxSize, queue.num_dropped());
+
+    for (size_t n = MaxSize; n < NumPackets; n++) {
+        LONGS_EQUAL(1, packets[n]->getref());
+    }
+
+    for (size_t n = 0; n < MaxSize; n++) {
+        CHECK(queue.read() == packets[n]);
+    }
+
+    CHECK(!queue.read());
+}
+
+TEST(mpsc_queue, drop_oldest) {
+    enum { MaxSize = 4, NumPackets = 6 };
+
+    MpscQueue queue(allocator, MaxSize, Overflow_DropOldest);
+    CHECK(queue.valid());
+
+    PacketPtr packets[NumPackets];
+
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        packets[n] = new_packet(0, n);
+        queue.write(packets[n]);
+    }
+
+    LONGS_EQUAL(MaxSize, queue.size());
+    LONGS_EQUAL(NumPackets - MaxSize, queue.num_dropped());
+
+    for (size_t n = 0; n < NumPackets - MaxSize; n++) {
+        LONGS_EQUAL(1, packets[n]->getref());
+    }
+
+    for (size_t n = NumPackets - MaxSize; n < NumPackets; n++) {
+        CHECK(queue.read() == packets[n]);
+    }
+
+    CHECK(!queue.read());
+}
+
+TEST(mpsc_queue, release_on_destroy) {
+    PacketPtr p1 = new_packet(0, 1);
+    PacketPtr p2 = new_packet(0, 2);
+
+    {
+        MpscQueue queue(allocator, 4, Overflow_DropNewest);
+        CHECK(queue.valid());
+
+        queue.write(p1);
+        queue.write(p2);
+
+        LONGS_EQUAL(2, p1->getref());
+        LONGS_EQUAL(2, p2->getref());
+    }
+
+    LONGS_EQUAL(1, p1->getref());
+    LONGS_EQUAL(1, p2->getref());
+}
+
+TEST(mpsc_queue, concurrent_writers) {
+    enum { NumWriters = 4, MaxSize = 64 };
+
+    MpscQueue queue(allocator, MaxSize, Overflow_DropNewest);
+    CHECK(queue.valid());
+
+    Writer w0(queue, 0), w1(queue, 1), w2(queue, 2), w3(queue, 3);
+    Writer* writers[NumWriters] = { &w0, &w1, &w2, &w3 };
+
+    for (size_t n = 0; n < NumWriters; n++) {
+        CHECK(writers[n]->start());
+    }
+
+    size_t n_read = 0;
+    long last_sn[NumWriters] = { -1, -1, -1, -1 };
+
+    while (n_read + queue.num_dropped() < Writer::NumPackets * NumWriters) {
+        PacketPtr pp = queue.read();
+        if (!pp) {
+            continue;
+        }
+
+        const size_t source = pp->rtp()->source;
+        CHECK(source < NumWriters);
+
+        // packets from every writer should be read in order
+        CHECK(pp->rtp()->seqnum > last_sn[source]);
+        last_sn[source] = pp->rtp()->seqnum;
+
+        n_read++;
+    }
+
+    for (size_t n = 0; n < NumWriters; n++) {
+        writers[n]->join();
+    }
+
+    CHECK(!queue.read());
+    LONGS_EQUAL(Writer::NumPackets * NumWriters, n_read + queue.num_dropped());
+}
+
+} // namespace packet
+} // namespace roc
@@ -0,0 +1,556 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_core/iallocator.h"
+#include "roc_packet/packet_pool.h"
+#include "roc_packet/seqnum_queue.h"
+
+namespace roc {
+namespace packet {
+
+namespace {
+
+core::HeapAllocator allocator;
+PacketPool pool(allocator, true);
+
+class MockAllocator : public core::IAllocator {
+public:
+    MockAllocator()
+        : fail_(false) {
+    }
+
+    virtual void* allocate(size_t size) {
+        if (fail_) {
+            return NULL;
+        }
+        return ha_.allocate(size);
+    }
+
+    virtual void deallocate(void* ptr) {
+        ha_.deallocate(ptr);
+    }
+
+    void set_fail(bool fail) {
+        fail_ = fail;
+    }
+
+private:
+    core::HeapAllocator ha_;
+    bool fail_;
+};
+
+} // namespace
+
+TEST_GROUP(seqnum_queue) {
+    PacketPtr new_packet(seqnum_t sn) {
+        PacketPtr packet = new(pool) Packet(pool);
+        CHECK(packet);
+
+        packet->add_flags(Packet::FlagRTP);
+        packet->rtp()->seqnum = sn;
+
+        return packet;
+    }
+};
+
+TEST(seqnum_queue, empty) {
+    SeqnumQueue queue(allocator, 0);
+
+    CHECK(!queue.tail());
+    CHECK(!queue.head());
+
+    CHECK(!queue.read());
+
+    LONGS_EQUAL(0, queue.size());
+}
+
+TEST(seqnum_queue, two_packets) {
+    SeqnumQueue queue(allocator, 0);
+
+    PacketPtr p1 = new_packet(1);
+    PacketPtr p2 = new_packet(2);
+
+    queue.write(p2);
+    queue.write(p1);
+
+    LONGS_EQUAL(2, queue.size());
+
+    CHECK(queue.tail() == p2);
+    CHECK(queue.head() == p1);
+
+    CHECK(queue.read() == p1);
+
+    LONGS_EQUAL(1, queue.size());
+
+    CHECK(queue.tail() == p2);
+    CHECK(queue.head() == p2);
+
+    CHECK(queue.read() == p2);
+
+    LONGS_EQUAL(0, queue.size());
+
+    CHECK(!queue.tail());
+    CHECK(!queue.head());
+
+    CHECK(!queue.read());
+
+    LONGS_EQUAL(0, queue.size());
+}
+
+TEST(seqnum_queue, many_packets) {
+    enum { NumPackets = 10 };
+
+    SeqnumQueue queue(allocator, 0);
+
+    PacketPtr packets[NumPackets];
+
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        packets[n] = new_packet(n);
+    }
+
+    for (ssize_t n = 0; n < NumPackets; n++) {
+        queue.write(packets[(n + NumPackets / 2) % NumPackets]);
+    }
+
+    LONGS_EQUAL(NumPackets, queue.size());
+
+    CHECK(queue.head() == packets[0]);
+    CHECK(queue.tail() == packets[NumPackets - 1]);
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        CHECK(queue.read() == packets[n]);
+    }
+
+    LONGS_EQUAL(0, queue.size());
+}
+
+TEST(seqnum_queue, out_of_order) {
+    SeqnumQueue queue(allocator, 0);
+
+    PacketPtr p1 = new_packet(1);
+    PacketPtr p2 = new_packet(2);
+
+    queue.write(p2);
+
+    LONGS_EQUAL(1, queue.size());
+
+    CHECK(queue.tail() == p2);
+    CHECK(queue.head() == p2);
+
+    CHECK(queue.read() == p2);
+
+    LONGS_EQUAL(0, queue.size());
+
+    queue.write(p1);
+
+    LONGS_EQUAL(1, queue.size());
+
+    CHECK(queue.tail() == p1);
+    CHECK(queue.head() == p1);
+
+    CHECK(queue.read() == p1);
+
+    CHECK(!queue.tail());
+    CHECK(!queue.head());
+
+    CHECK(!queue.read());
+}
+
+TEST(seqnum_queue, out_of_order_many_packets) {
+    enum { NumPackets = 20 };
+
+    SeqnumQueue queue(allocator, 0);
+
+    for (packet::seqnum_t n = 0; n < 7; ++n) {
+        queue.write(new_packet(n));
+    }
+
+    for (packet::seqnum_t n = 11; n < NumPackets; ++n) {
+        queue.write(new_packet(n));
+    }
+
+    for (packet::seqnum_t n = 0; n < 7; ++n) {
+        const packet::PacketPtr p = queue.read();
+
+        CHECK(p);
+        CHECK(p->rtp()->seqnum == n);
+    }
+
+    queue.write(new_packet(9));
+    queue.write(new_packet(10));
+
+    for (packet::seqnum_t n = 9; n < NumPackets; ++n) {
+        const packet::PacketPtr p = queue.read();
+
+        CHECK(p->rtp()->seqnum == n);
+
+        if (n == 10) {
+            queue.write(new_packet(8));
+            queue.write(new_packet(7));
+
+            CHECK(queue.read()->rtp()->seqnum == 7);
+            CHECK(queue.read()->rtp()->seqnum == 8);
+        }
+    }
+}
+
+TEST(seqnum_queue, one_duplicate) {
+    SeqnumQueue queue(allocator, 0);
+
+    PacketPtr p1 = new_packet(1);
+    PacketPtr p2 = new_packet(1);
+
+    queue.write(p1);
+    queue.write(p2);
+
+    LONGS_EQUAL(1, queue.size());
+
+    CHECK(queue.tail() == p1);
+    CHECK(queue.head() == p1);
+
+    CHECK(queue.read() == p1);
+
+    LONGS_EQUAL(0, queue.size());
+
+    CHECK(!queue.tail());
+    CHECK(!queue.head());
+
+    CHECK(!queue.read());
+}
+
+TEST(seqnum_queue, many_duplicates) {
+    const size_t NumPackets = 10;
+
+    SeqnumQueue queue(allocator, 0);
+
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        queue.write(new_packet(n));
+    }
+
+    LONGS_EQUAL(NumPackets, queue.size());
+
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        queue.write(new_packet(n));
+    }
+
+    LONGS_EQUAL(NumPackets, queue.size());
+
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        CHECK(queue.read()->rtp()->seqnum == n);
+    }
+
+    LONGS_EQUAL(0, queue.size());
+}
+
+TEST(seqnum_queue, max_size) {
+    SeqnumQueue queue(allocator, 2);
+
+    PacketPtr p1 = new_packet(1);
+    PacketPtr p2 = new_packet(2);
+    PacketPtr p3 = new_packet(3);
+
+    queue.write(p1);
+    queue.write(p2);
+    queue.write(p3);
+
+    LONGS_EQUAL(2, queue.size());
+
+    CHECK(queue.head() == p1);
+    CHECK(queue.tail() == p2);
+
+    CHECK(queue.read() == p1);
+
+    LONGS_EQUAL(1, queue.size());
+
+    queue.write(p3);
+
+    LONGS_EQUAL(2, queue.size());
+
+    CHECK(queue.head() == p2);
+    CHECK(queue.tail() == p3);
+}
+
+TEST(seqnum_queue, overflow_ordered1) {
+    const seqnum_t sn = seqnum_t(-1);
+
+    SeqnumQueue queue(allocator, 0);
+
+    PacketPtr p1 = new_packet(seqnum_t(sn - 10));
+    PacketPtr p2 = new_packet(sn);
+    PacketPtr p3 = new_packet(seqnum_t(sn + 10));
+
+    queue.write(p1);
+    queue.write(p2);
+    queue.write(p3);
+
+    LONGS_EQUAL(3, queue.size());
+
+    CHECK(queue.read() == p1);
+    CHECK(queue.read() == p2);
+    CHECK(queue.read() == p3);
+
+    LONGS_EQUAL(0, queue.size());
+
+    CHECK(!queue.read());
+}
+
+TEST(seqnum_queue, overflow_ordered2) {
+    const seqnum_t sn = seqnum_t(-1) >> 1;
+
+    SeqnumQueue queue(allocator, 0);
+
+    PacketPtr p1 = new_packet(seqnum_t(sn - 10));
+    PacketPtr p2 = new_packet(sn);
+    PacketPtr p3 = new_packet(seqnum_t(sn + 10));
+
+    queue.write(p1);
+    queue.write(p2);
+    queue.write(p3);
+
+    LONGS_EQUAL(3, queue.size());
+
+    CHECK(queue.read() == p1);
+    CHECK(queue.read() == p2);
+    CHECK(queue.read() == p3);
+
+    LONGS_EQUAL(0, queue.size());
+
+    CHECK(!queue.read());
+}
+
+TEST(seqnum_queue, overflow_sorting) {
+    const seqnum_t sn = seqnum_t(-1);
+
+    SeqnumQueue queue(allocator, 0);
+
+    PacketPtr p1 = new_packet(seqnum_t(sn - 10));
+    PacketPtr p2 = new_packet(sn);
+    PacketPtr p3 = new_packet(seqnum_t(sn + 10));
+
+    queue.write(p2);
+    queue.write(p1);
+    queue.write(p3);
+
+    LONGS_EQUAL(3, queue.size());
+
+    CHECK(queue.read() == p1);
+    CHECK(queue.read() == p2);
+    CHECK(queue.read() == p3);
+
+    LONGS_EQUAL(0, queue.size());
+
+    CHECK(!queue.read());
+}
+
+TEST(seqnum_queue, overflow_out_of_order) {
+    const seqnum_t sn = seqnum_t(-1);
+
+    SeqnumQueue queue(allocator, 0);
+
+    PacketPtr p1 = new_packet(seqnum_t(sn - 10));
+    PacketPtr p2 = new_packet(sn);
+    PacketPtr p3 = new_packet(sn / 2);
+
+    queue.write(p1);
+
+    LONGS_EQUAL(1, queue.size());
+    CHECK(queue.read() == p1);
+    LONGS_EQUAL(0, queue.size());
+
+    queue.write(p2);
+
+    LONGS_EQUAL(1, queue.size());
+    CHECK(queue.read() == p2);
+    LONGS_EQUAL(0, queue.size());
+
+    queue.write(p3);
+
+    LONGS_EQUAL(1, queue.size());
+    CHECK(queue.read() == p3);
+    LONGS_EQUAL(0, queue.size());
+
+    CHECK(!queue.read());
+}
+
+TEST(seqnum_queue, latest) {
+    SeqnumQueue queue(allocator, 0);
+
+    PacketPtr p1 = new_packet(1);
+    PacketPtr p2 = new_packet(3);
+    PacketPtr p3 = new_packet(2);
+    PacketPtr p4 = new_packet(4);
+
+    LONGS_EQUAL(0, queue.size());
+    CHECK(!queue.latest());
+
+    queue.write(p1);
+    LONGS_EQUAL(1, queue.size());
+    CHECK(queue.latest() == p1);
+
+    queue.write(p2);
+    LONGS_EQUAL(2, queue.size());
+    CHECK(queue.latest() == p2);
+
+    queue.write(p3);
+    LONGS_EQUAL(3, queue.size());
+    CHECK(queue.latest() == p2);
+
+    CHECK(queue.read());
+    LONGS_EQUAL(2, queue.size());
+    CHECK(queue.latest() == p2);
+
+    CHECK(queue.read());
+    LONGS_EQUAL(1, queue.size());
+    CHECK(queue.latest() == p2);
+
+    CHECK(queue.read());
+    LONGS_EQUAL(0, queue.size());
+    CHECK(queue.latest() == p2);
+
+    queue.write(p4);
+    LONGS_EQUAL(1, queue.size());
+    CHECK(queue.latest() == p4);
+}
+
+TEST(seqnum_queue, latest_grow_failed) {
+    MockAllocator mock_allocator;
+
+    SeqnumQueue queue(mock_allocator, 0);
+
+    PacketPtr p1 = new_packet(1);
+    PacketPtr p2 = new_packet(1000);
+
+    queue.write(p1);
+    LONGS_EQUAL(1, queue.size());
+    CHECK(queue.latest() == p1);
+
+    // packet doesn't fit into current capacity and is dropped
+    mock_allocator.set_fail(true);
+
+    queue.write(p2);
+    LONGS_EQUAL(1, queue.size());
+    CHECK(queue.latest() == p1);
+
+    mock_allocator.set_fail(false);
+
+    queue.write(p2);
+    LONGS_EQUAL(2, queue.size());
+    CHECK(queue.latest() == p2);
+}
+
+TEST(seqnum_queue, grow_in_order) {
+    enum { NumPackets = 1000 };
+
+    SeqnumQueue queue(allocator, 0);
+
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        queue.write(new_packet(seqnum_t(n - NumPackets / 2)));
+    }
+
+    LONGS_EQUAL(NumPackets, queue.size());
+
+    CHECK(queue.head()->rtp()->seqnum == seqnum_t(-NumPackets / 2));
+    CHECK(queue.tail()->rtp()->seqnum == seqnum_t(NumPackets / 2 - 1));
+
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        CHECK(queue.read()->rtp()->seqnum == seqnum_t(n - NumPackets / 2));
+    }
+
+    LONGS_EQUAL(0, queue.size());
+    CHECK(!queue.read());
+}
+
+TEST(seqnum_queue, grow_out_of_order) {
+    enum { NumPackets = 1000 };
+
+    SeqnumQueue queue(allocator, 0);
+
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        queue.write(new_packet(seqnum_t(NumPackets - 1 - n)));
+        queue.write(new_packet(seqnum_t(NumPackets - 1 - n)));
+    }
+
+    LONGS_EQUAL(NumPackets, queue.size());
+
+    CHECK(queue.head()->rtp()->seqnum == 0);
+    CHECK(queue.tail()->rtp()->seqnum == NumPackets - 1);
+
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        CHECK(queue.read()->rtp()->seqnum == n);
+    }
+
+    LONGS_EQUAL(0, queue.size());
+}
+
+TEST(seqnum_queue, gaps) {
+    SeqnumQueue queue(allocator, 0);
+
+    PacketPtr p1 = new_packet(seqnum_t(-5));
+    PacketPtr p2 = new_packet(20);
+    PacketPtr p3 = new_packet(300);
+
+    queue.write(p3);
+    queue.write(p1);
+    queue.write(p2);
+
+    LONGS_EQUAL(3, queue.size());
+
+    CHECK(queue.head() == p1);
+    CHECK(queue.tail() == p3);
+
+    CHECK(queue.read() == p1);
+    CHECK(queue.head() == p2);
+    CHECK(queue.tail() == p3);
+
+    CHECK(queue.read() == p2);
+    CHECK(queue.head() == p3);
+    CHECK(queue.tail() == p3);
+
+    CHECK(queue.read() == p3);
+    CHECK(!queue.head());
+    CHECK(!queue.tail());
+
+    LONGS_EQUAL(0, queue.size());
+}
+
+TEST(seqnum_queue, too_far) {
+    SeqnumQueue queue(allocator, 0);
+
+    PacketPtr p1 = new_packet(1000);
+    PacketPtr p2 = new_packet(2000);
+    PacketPtr p3 = new_packet(seqnum_t(1000 + 0x8000));
+    PacketPtr p4 = new_packet(seqnum_t(1000 - 0x8000 + 1000));
+
+    queue.write(p1);
+    queue.write(p2);
+
+    // would make queue span longer than half of seqnum space
+    queue.write(p3);
+    queue.write(p4);
+
+    LONGS_EQUAL(2, queue.size());
+
+    CHECK(queue.latest() == p2);
+
+    CHECK(queue.read() == p1);
+    CHECK(queue.read() == p2);
+
+    LONGS_EQUAL(0, queue.size());
+
+    // empty queue accepts any seqnum
+    queue.write(p3);
+
+    LONGS_EQUAL(1, queue.size());
+    CHECK(queue.read() == p3);
+}
+
+} // namespace packet
+} // namespace roc
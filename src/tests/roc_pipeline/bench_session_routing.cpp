@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+// Benchmarks for finding receiver session of incoming packet.
+//
+// Sessions are keyed by source address, like ReceiverSession. Packets come
+// from all sessions in round-robin. The argument is the number of sessions.
+//  - BM_Route_List: linear scan of session list
+//  - BM_Route_HashIndex: lookup in core::HashIndex, used by Receiver
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/hash_index.h"
+#include "roc_core/heap_allocator.h"
+#include "roc_core/list.h"
+#include "roc_core/panic.h"
+#include "roc_packet/address.h"
+
+namespace roc {
+namespace pipeline {
+
+namespace {
+
+enum { MaxSessions = 5000 };
+
+core::HeapAllocator allocator;
+
+struct Session : core::ListNode {
+    packet::Address address;
+
+    const packet::Address& key() const {
+        return address;
+    }
+
+    static size_t key_hash(const packet::Address& address) {
+        return address.hash();
+    }
+
+    static bool key_equal(const packet::Address& address1,
+                          const packet::Address& address2) {
+        return address1 == address2;
+    }
+};
+
+Session sessions[MaxSessions];
+packet::Address addresses[MaxSessions];
+
+void init_sessions(size_t n_sessions) {
+    for (size_t n = 0; n < n_sessions; n++) {
+        char ip[32];
+        snprintf(ip, sizeof(ip), "10.0.%d.%d", int(n / 250), int(n % 250 + 1));
+
+        if (!sessions[n].address.set_ipv4(ip, 10000 + int(n % 16) * 2)) {
+            roc_panic("bench: can't set address");
+        }
+
+        addresses[n] = sessions[n].address;
+    }
+}
+
+void BM_Route_List(benchmark::State& state) {
+    const size_t n_sessions = (size_t)state.range(0);
+
+    init_sessions(n_sessions);
+
+    core::List<Session, core::NoOwnership> list;
+    for (size_t n = 0; n < n_sessions; n++) {
+        list.push_back(sessions[n]);
+    }
+
+    size_t pos = 0;
+
+    while (state.KeepRunning()) {
+        const packet::Address& address = addresses[pos];
+        if (++pos == n_sessions) {
+            pos = 0;
+        }
+
+        Session* sess = list.front();
+        for (; sess; sess = list.nextof(*sess)) {
+            if (sess->address == address) {
+                break;
+            }
+        }
+
+        benchmark::DoNotOptimize(sess);
+    }
+
+    for (size_t n = 0; n < n_sessions; n++) {
+        list.remove(sessions[n]);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_Route_HashIndex(benchmark::State& state) {
+    const size_t n_sessions = (size_t)state.range(0);
+
+    init_sessions(n_sessions);
+
+    core::HashIndex<Session, packet::Address> index(allocator);
+    for (size_t n = 0; n < n_sessions; n++) {
+        if (!index.insert(sessions[n])) {
+            roc_panic("bench: can't insert session");
+        }
+    }
+
+    size_t pos = 0;
+
+    while (state.KeepRunning()) {
+        const packet::Address& address = addresses[pos];
+        if (++pos == n_sessions) {
+            pos = 0;
+        }
+
+        Session* sess = index.find(address);
+
+        benchmark::DoNotOptimize(sess);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Route_List)->Arg(1)->Arg(100)->Arg(MaxSessions);
+
+BENCHMARK(BM_Route_HashIndex)->Arg(1)->Arg(100)->Arg(MaxSessions);
+
+} // namespace
+
+} // namespace pipeline
+} // namespace roc
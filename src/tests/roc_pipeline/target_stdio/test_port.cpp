@@ -73,6 +73,42 @@ TEST(port, proto_ldpc_repair) {
     STRCMP_EQUAL("ldpc:1.2.3.4:123", port_to_str(port).c_str());
 }
 
+TEST(port, proto_rlc_source) {
+    PortConfig port;
+    CHECK(parse_port(Port_AudioSource, "rtp+rlc:1.2.3.4:123", port));
+
+    UNSIGNED_LONGS_EQUAL(Proto_RTP_RLC_Source, port.protocol);
+
+    STRCMP_EQUAL("rtp+rlc:1.2.3.4:123", port_to_str(port).c_str());
+}
+
+TEST(port, proto_rlc_repair) {
+    PortConfig port;
+    CHECK(parse_port(Port_AudioRepair, "rlc:1.2.3.4:123", port));
+
+    UNSIGNED_LONGS_EQUAL(Proto_RLC_Repair, port.protocol);
+
+    STRCMP_EQUAL("rlc:1.2.3.4:123", port_to_str(port).c_str());
+}
+
+TEST(port, proto_parity_source) {
+    PortConfig port;
+    CHECK(parse_port(Port_AudioSource, "rtp+parity:1.2.3.4:123", port));
+
+    UNSIGNED_LONGS_EQUAL(Proto_RTP_Parity_Source, port.protocol);
+
+    STRCMP_EQUAL("rtp+parity:1.2.3.4:123", port_to_str(port).c_str());
+}
+
+TEST(port, proto_parity_repair) {
+    PortConfig port;
+    CHECK(parse_port(Port_AudioRepair, "parity:1.2.3.4:123", port));
+
+    UNSIGNED_LONGS_EQUAL(Proto_Parity_Repair, port.protocol);
+
+    STRCMP_EQUAL("parity:1.2.3.4:123", port_to_str(port).c_str());
+}
+
 TEST(port, addr_zero) {
     PortConfig port;
     CHECK(parse_port(Port_AudioSource, "rtp:0.0.0.0:0", port));
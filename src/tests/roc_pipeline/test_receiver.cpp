@@ -101,6 +101,22 @@ TEST_GROUP(receiver) {
         port2.address = new_address(4);
         port2.protocol = Proto_RTP;
     }
+
+    // Reads frame and returns its flags.
+    unsigned read_flags(Receiver & receiver) {
+        audio::sample_t samples[SamplesPerFrame * NumCh];
+
+        audio::Frame frame(samples, SamplesPerFrame * NumCh);
+        CHECK(receiver.read(frame));
+
+        if (frame.flags() & audio::Frame::FlagBlank) {
+            for (size_t n = 0; n < SamplesPerFrame * NumCh; n++) {
+                DOUBLES_EQUAL(0.0, (double)samples[n], 0.0);
+            }
+        }
+
+        return frame.flags();
+    }
 };
 
 TEST(receiver, no_sessions) {
@@ -344,6 +360,104 @@ TEST(receiver, two_sessions_synchronous) {
     }
 }
 
+TEST(receiver, many_sessions_workers) {
+    enum { NumSessions = 4, NumWorkers = 3 };
+
+    config.common.num_workers = NumWorkers;
+
+    // frames are rendered by chunks of internal frame size
+    config.common.internal_frame_size = SamplesPerFrame;
+
+    Receiver receiver(config, codec_map, format_map, packet_pool, byte_buffer_pool,
+                      sample_buffer_pool, allocator);
+
+    CHECK(receiver.valid());
+    CHECK(receiver.add_port(port1));
+
+    FrameReader frame_reader(receiver, sample_buffer_pool);
+
+    PacketWriter* packet_writers[NumSessions];
+
+    for (size_t ns = 0; ns < NumSessions; ns++) {
+        packet_writers[ns] = new (allocator)
+            PacketWriter(allocator, receiver, rtp_composer, format_map, packet_pool,
+                         byte_buffer_pool, PayloadType, new_address(10 + (int)ns),
+                         port1.address);
+    }
+
+    for (size_t np = 0; np < Latency / SamplesPerPacket; np++) {
+        for (size_t ns = 0; ns < NumSessions; ns++) {
+            packet_writers[ns]->write_packets(1, SamplesPerPacket, ChMask);
+        }
+    }
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            frame_reader.read_samples(SamplesPerFrame * NumCh, NumSessions);
+
+            UNSIGNED_LONGS_EQUAL(NumSessions, receiver.num_sessions());
+        }
+
+        for (size_t ns = 0; ns < NumSessions; ns++) {
+            packet_writers[ns]->write_packets(1, SamplesPerPacket, ChMask);
+        }
+    }
+
+    for (size_t ns = 0; ns < NumSessions; ns++) {
+        allocator.destroy(*packet_writers[ns]);
+    }
+}
+
+TEST(receiver, silent_sessions_resampling) {
+    // resampler delays its output, so a frame may be blank only after
+    // several blank frames from depacketizer
+    enum { MaxBlankDelay = Latency * 2 / SamplesPerFrame, NumBlankFrames = 50 };
+
+    config.common.resampling = true;
+
+    Receiver receiver(config, codec_map, format_map, packet_pool, byte_buffer_pool,
+                      sample_buffer_pool, allocator);
+
+    CHECK(receiver.valid());
+    CHECK(receiver.add_port(port1));
+
+    PacketWriter packet_writer1(allocator, receiver, rtp_composer, format_map,
+                                packet_pool, byte_buffer_pool, PayloadType, src1,
+                                port1.address);
+
+    PacketWriter packet_writer2(allocator, receiver, rtp_composer, format_map,
+                                packet_pool, byte_buffer_pool, PayloadType, src2,
+                                port1.address);
+
+    for (size_t np = 0; np < Latency / SamplesPerPacket; np++) {
+        packet_writer1.write_packets(1, SamplesPerPacket, ChMask);
+        packet_writer2.write_packets(1, SamplesPerPacket, ChMask);
+    }
+
+    // second session becomes silent, first one keeps output non-blank
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            CHECK((read_flags(receiver) & audio::Frame::FlagBlank) == 0);
+
+            UNSIGNED_LONGS_EQUAL(2, receiver.num_sessions());
+        }
+
+        packet_writer1.write_packets(1, SamplesPerPacket, ChMask);
+    }
+
+    // first session becomes silent too, and output becomes blank
+    size_t n_frames = 0;
+    while ((read_flags(receiver) & audio::Frame::FlagBlank) == 0) {
+        CHECK(++n_frames < Latency / SamplesPerFrame + MaxBlankDelay);
+    }
+
+    for (size_t nf = 0; nf < NumBlankFrames; nf++) {
+        CHECK(read_flags(receiver) & audio::Frame::FlagBlank);
+
+        UNSIGNED_LONGS_EQUAL(2, receiver.num_sessions());
+    }
+}
+
 TEST(receiver, two_sessions_overlapping) {
     Receiver receiver(config, codec_map, format_map, packet_pool, byte_buffer_pool,
                       sample_buffer_pool, allocator);
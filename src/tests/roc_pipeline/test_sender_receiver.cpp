@@ -65,7 +65,13 @@ enum {
     FlagReedSolomon = (1 << 4),
 
     // enable LDPC-Staircase FEC scheme on sender
-    FlagLDPC = (1 << 5)
+    FlagLDPC = (1 << 5),
+
+    // enable sliding window RLC FEC scheme on sender
+    FlagRLC = (1 << 6),
+
+    // enable XOR parity FEC scheme on sender
+    FlagParity = (1 << 7)
 };
 
 core::HeapAllocator allocator;
@@ -165,6 +171,12 @@ TEST_GROUP(sender_receiver) {
         } else if (flags & FlagLDPC) {
             port_config.address = new_address(30);
             port_config.protocol = Proto_RTP_LDPC_Source;
+        } else if (flags & FlagRLC) {
+            port_config.address = new_address(40);
+            port_config.protocol = Proto_RTP_RLC_Source;
+        } else if (flags & FlagParity) {
+            port_config.address = new_address(50);
+            port_config.protocol = Proto_RTP_Parity_Source;
         } else {
             port_config.address = new_address(10);
             port_config.protocol = Proto_RTP;
@@ -180,6 +192,12 @@ TEST_GROUP(sender_receiver) {
         } else if (flags & FlagLDPC) {
             port_config.address = new_address(31);
             port_config.protocol = Proto_LDPC_Repair;
+        } else if (flags & FlagRLC) {
+            port_config.address = new_address(41);
+            port_config.protocol = Proto_RLC_Repair;
+        } else if (flags & FlagParity) {
+            port_config.address = new_address(51);
+            port_config.protocol = Proto_Parity_Repair;
         } else {
             port_config.protocol = Proto_None;
         }
@@ -208,6 +226,22 @@ TEST_GROUP(sender_receiver) {
         port_config.address = new_address(31);
         port_config.protocol = Proto_LDPC_Repair;
         CHECK(receiver.add_port(port_config));
+
+        port_config.address = new_address(40);
+        port_config.protocol = Proto_RTP_RLC_Source;
+        CHECK(receiver.add_port(port_config));
+
+        port_config.address = new_address(41);
+        port_config.protocol = Proto_RLC_Repair;
+        CHECK(receiver.add_port(port_config));
+
+        port_config.address = new_address(50);
+        port_config.protocol = Proto_RTP_Parity_Source;
+        CHECK(receiver.add_port(port_config));
+
+        port_config.address = new_address(51);
+        port_config.protocol = Proto_Parity_Repair;
+        CHECK(receiver.add_port(port_config));
     }
 
     SenderConfig sender_config(int flags) {
@@ -225,6 +259,14 @@ TEST_GROUP(sender_receiver) {
             config.fec_encoder.scheme = packet::FEC_LDPC_Staircase;
         }
 
+        if (flags & FlagRLC) {
+            config.fec_encoder.scheme = packet::FEC_RLC;
+        }
+
+        if (flags & FlagParity) {
+            config.fec_encoder.scheme = packet::FEC_Parity;
+        }
+
         config.fec_writer.n_source_packets = SourcePackets;
         config.fec_writer.n_repair_packets = RepairPackets;
 
@@ -290,5 +332,29 @@ TEST(sender_receiver, fec_drop_repair) {
 }
 #endif //! ROC_TARGET_OPENFEC
 
+TEST(sender_receiver, fec_rlc) {
+    send_receive(FlagRLC, 1);
+}
+
+TEST(sender_receiver, fec_rlc_interleaving) {
+    send_receive(FlagRLC | FlagInterleaving, 1);
+}
+
+TEST(sender_receiver, fec_rlc_loss) {
+    send_receive(FlagRLC | FlagLosses, 1);
+}
+
+TEST(sender_receiver, fec_rlc_drop_repair) {
+    send_receive(FlagRLC | FlagDropRepair, 1);
+}
+
+TEST(sender_receiver, fec_parity) {
+    send_receive(FlagParity, 1);
+}
+
+TEST(sender_receiver, fec_parity_loss) {
+    send_receive(FlagParity | FlagLosses, 1);
+}
+
 } // namespace pipeline
 } // namespace roc
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2020 Roc authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_allocator.h"
+#include "roc_core/helpers.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/unique_ptr.h"
+#include "roc_rtp/format_map.h"
+
+namespace roc {
+namespace rtp {
+
+namespace {
+
+enum { NumSamples = 32, MaxBufSize = NumSamples * 2 * 4 };
+
+struct FormatInfo {
+    PayloadType pt;
+    PayloadEncoding encoding;
+    size_t sample_rate;
+    packet::channel_mask_t channels;
+    double epsilon;
+};
+
+// ADPCM is lossy, its precision is checked in roc_audio tests.
+const FormatInfo formats[] = {
+    { PayloadType_L16_Stereo, PayloadEncoding_L16, 44100, 0x3, 1.0 / 32768 },
+    { PayloadType_L16_Mono, PayloadEncoding_L16, 44100, 0x1, 1.0 / 32768 },
+    { PayloadType_L16_Stereo_48000, PayloadEncoding_L16, 48000, 0x3, 1.0 / 32768 },
+    { PayloadType_L16_Mono_48000, PayloadEncoding_L16, 48000, 0x1, 1.0 / 32768 },
+    { PayloadType_L16_Stereo_96000, PayloadEncoding_L16, 96000, 0x3, 1.0 / 32768 },
+    { PayloadType_L16_Mono_96000, PayloadEncoding_L16, 96000, 0x1, 1.0 / 32768 },
+    { PayloadType_L24_Stereo_44100, PayloadEncoding_L24, 44100, 0x3, 1.0 / 8388608 },
+    { PayloadType_L24_Mono_44100, PayloadEncoding_L24, 44100, 0x1, 1.0 / 8388608 },
+    { PayloadType_L24_Stereo_48000, PayloadEncoding_L24, 48000, 0x3, 1.0 / 8388608 },
+    { PayloadType_L24_Mono_48000, PayloadEncoding_L24, 48000, 0x1, 1.0 / 8388608 },
+    { PayloadType_L24_Stereo_96000, PayloadEncoding_L24, 96000, 0x3, 1.0 / 8388608 },
+    { PayloadType_L24_Mono_96000, PayloadEncoding_L24, 96000, 0x1, 1.0 / 8388608 },
+    { PayloadType_F32_Stereo_44100, PayloadEncoding_Float32, 44100, 0x3, 0 },
+    { PayloadType_F32_Mono_44100, PayloadEncoding_Float32, 44100, 0x1, 0 },
+    { PayloadType_F32_Stereo_48000, PayloadEncoding_Float32, 48000, 0x3, 0 },
+    { PayloadType_F32_Mono_48000, PayloadEncoding_Float32, 48000, 0x1, 0 },
+    { PayloadType_F32_Stereo_96000, PayloadEncoding_Float32, 96000, 0x3, 0 },
+    { PayloadType_F32_Mono_96000, PayloadEncoding_Float32, 96000, 0x1, 0 },
+    { PayloadType_ADPCM_Stereo_44100, PayloadEncoding_ADPCM, 44100, 0x3, 0.25 },
+    { PayloadType_ADPCM_Mono_44100, PayloadEncoding_ADPCM, 44100, 0x1, 0.25 },
+    { PayloadType_ADPCM_Stereo_48000, PayloadEncoding_ADPCM, 48000, 0x3, 0.25 },
+    { PayloadType_ADPCM_Mono_48000, PayloadEncoding_ADPCM, 48000, 0x1, 0.25 },
+    { PayloadType_ADPCM_Stereo_96000, PayloadEncoding_ADPCM, 96000, 0x3, 0.25 },
+    { PayloadType_ADPCM_Mono_96000, PayloadEncoding_ADPCM, 96000, 0x1, 0.25 },
+    { PayloadType_Lossless_Stereo_44100, PayloadEncoding_Lossless, 44100, 0x3,
+      1.0 / 32768 },
+    { PayloadType_Lossless_Mono_44100, PayloadEncoding_Lossless, 44100, 0x1,
+      1.0 / 32768 },
+    { PayloadType_Lossless_Stereo_48000, PayloadEncoding_Lossless, 48000, 0x3,
+      1.0 / 32768 },
+    { PayloadType_Lossless_Mono_48000, PayloadEncoding_Lossless, 48000, 0x1,
+      1.0 / 32768 },
+    { PayloadType_Lossless_Stereo_96000, PayloadEncoding_Lossless, 96000, 0x3,
+      1.0 / 32768 },
+    { PayloadType_Lossless_Mono_96000, PayloadEncoding_Lossless, 96000, 0x1,
+      1.0 / 32768 },
+};
+
+core::HeapAllocator allocator;
+
+} // namespace
+
+TEST_GROUP(format_map) {};
+
+TEST(format_map, unknown) {
+    FormatMap format_map;
+
+    CHECK(!format_map.format(0));
+    CHECK(!format_map.format(127));
+}
+
+TEST(format_map, formats) {
+    FormatMap format_map;
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(formats); n++) {
+        const Format* format = format_map.format(formats[n].pt);
+        CHECK(format);
+
+        LONGS_EQUAL(formats[n].pt, format->payload_type);
+        LONGS_EQUAL(formats[n].encoding, format->encoding);
+        UNSIGNED_LONGS_EQUAL(formats[n].sample_rate, format->sample_rate);
+        UNSIGNED_LONGS_EQUAL(formats[n].channels, format->channel_mask);
+
+        core::UniquePtr<audio::IFrameEncoder> encoder(format->new_encoder(allocator),
+                                                      allocator);
+        CHECK(encoder);
+
+        const audio::sample_t input[NumSamples * 2] = {};
+
+        uint8_t frame[MaxBufSize];
+        CHECK(encoder->encoded_size(NumSamples) <= MaxBufSize);
+
+        encoder->begin(frame, encoder->encoded_size(NumSamples));
+        UNSIGNED_LONGS_EQUAL(NumSamples,
+                             encoder->write(input, NumSamples, formats[n].channels));
+        const size_t frame_size = encoder->end();
+
+        CHECK(frame_size <= encoder->encoded_size(NumSamples));
+        UNSIGNED_LONGS_EQUAL(NumSamples, format->get_num_samples(frame, frame_size));
+    }
+}
+
+TEST(format_map, odd_num_samples) {
+    enum { OddNumSamples = NumSamples - 1 };
+
+    FormatMap format_map;
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(formats); n++) {
+        const Format* format = format_map.format(formats[n].pt);
+        CHECK(format);
+
+        core::UniquePtr<audio::IFrameEncoder> encoder(format->new_encoder(allocator),
+                                                      allocator);
+        CHECK(encoder);
+
+        const audio::sample_t input[OddNumSamples * 2] = {};
+
+        uint8_t frame[MaxBufSize];
+        CHECK(encoder->encoded_size(OddNumSamples) <= MaxBufSize);
+
+        encoder->begin(frame, encoder->encoded_size(OddNumSamples));
+        UNSIGNED_LONGS_EQUAL(OddNumSamples,
+                             encoder->write(input, OddNumSamples, formats[n].channels));
+        const size_t frame_size = encoder->end();
+
+        UNSIGNED_LONGS_EQUAL(OddNumSamples, format->get_num_samples(frame, frame_size));
+    }
+}
+
+TEST(format_map, find) {
+    FormatMap format_map;
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(formats); n++) {
+        const Format* format = format_map.find(
+            formats[n].encoding, formats[n].sample_rate, formats[n].channels);
+        CHECK(format);
+
+        LONGS_EQUAL(formats[n].pt, format->payload_type);
+    }
+
+    CHECK(!format_map.find(PayloadEncoding_L16, 22050, 0x3));
+    CHECK(!format_map.find(PayloadEncoding_L16, 44100, 0x7));
+}
+
+TEST(format_map, encode_decode) {
+    FormatMap format_map;
+
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(formats); n++) {
+        const Format* format = format_map.format(formats[n].pt);
+        CHECK(format);
+
+        core::UniquePtr<audio::IFrameEncoder> encoder(format->new_encoder(allocator),
+                                                      allocator);
+        CHECK(encoder);
+
+        core::UniquePtr<audio::IFrameDecoder> decoder(format->new_decoder(allocator),
+                                                      allocator);
+        CHECK(decoder);
+
+        const size_t num_ch = packet::num_channels(formats[n].channels);
+
+        audio::sample_t input[NumSamples * 2];
+        for (size_t i = 0; i < NumSamples * num_ch; i++) {
+            input[i] = (audio::sample_t)i / (NumSamples * 2) - 0.5f;
+        }
+
+        uint8_t frame[MaxBufSize];
+        const size_t frame_size = encoder->encoded_size(NumSamples);
+        CHECK(frame_size <= MaxBufSize);
+
+        encoder->begin(frame, frame_size);
+        UNSIGNED_LONGS_EQUAL(NumSamples,
+                             encoder->write(input, NumSamples, formats[n].channels));
+        const size_t actual_size = encoder->end();
+        CHECK(actual_size <= frame_size);
+
+        audio::sample_t output[NumSamples * 2];
+
+        decoder->begin(0, frame, actual_size);
+        UNSIGNED_LONGS_EQUAL(NumSamples,
+                             decoder->read(output, NumSamples, formats[n].channels));
+        decoder->end();
+
+        for (size_t i = 0; i < NumSamples * num_ch; i++) {
+            DOUBLES_EQUAL((double)input[i], (double)output[i], formats[n].epsilon);
+        }
+    }
+}
+
+} // namespace rtp
+} // namespace roc
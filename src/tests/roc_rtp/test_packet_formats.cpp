@@ -64,7 +64,10 @@ TEST_GROUP(packet_formats) {
         UNSIGNED_LONGS_EQUAL(pi.pt, format.payload_type);
         UNSIGNED_LONGS_EQUAL(pi.samplerate, format.sample_rate);
         UNSIGNED_LONGS_EQUAL(pi.num_channels, packet::num_channels(format.channel_mask));
-        UNSIGNED_LONGS_EQUAL(pi.num_samples, format.get_num_samples(pi.payload_size));
+        UNSIGNED_LONGS_EQUAL(pi.num_samples,
+                             format.get_num_samples(pi.raw_data + pi.header_size
+                                                        + pi.extension_size,
+                                                    pi.payload_size));
     }
 
     void check_packet_fields(const packet::Packet& packet, const PacketInfo& pi) {
@@ -171,7 +174,7 @@ TEST_GROUP(packet_formats) {
             encoder.write(samples, pi.num_samples,
                           packet::channel_mask_t(1 << pi.num_channels) - 1));
 
-        encoder.end();
+        UNSIGNED_LONGS_EQUAL(pi.payload_size, encoder.end());
     }
 
     void check_parse_decode(const PacketInfo& pi) {
@@ -119,6 +119,14 @@ int main(int argc, char** argv) {
         config.resampler = audio::resampler_profile(audio::ResamplerProfile_High);
         break;
 
+    case resampler_profile_arg_cubic:
+        config.resampler = audio::resampler_profile(audio::ResamplerProfile_Cubic);
+        break;
+
+    case resampler_profile_arg_linear:
+        config.resampler = audio::resampler_profile(audio::ResamplerProfile_Linear);
+        break;
+
     default:
         break;
     }
@@ -165,6 +165,16 @@ int main(int argc, char** argv) {
             audio::resampler_profile(audio::ResamplerProfile_High);
         break;
 
+    case resampler_profile_arg_cubic:
+        config.default_session.resampler =
+            audio::resampler_profile(audio::ResamplerProfile_Cubic);
+        break;
+
+    case resampler_profile_arg_linear:
+        config.default_session.resampler =
+            audio::resampler_profile(audio::ResamplerProfile_Linear);
+        break;
+
     default:
         break;
     }
@@ -186,6 +196,14 @@ int main(int argc, char** argv) {
         config.default_session.resampler.window_size = (size_t)args.resampler_window_arg;
     }
 
+    if (args.workers_given) {
+        if (args.workers_arg < 0) {
+            roc_log(LogError, "invalid --workers: should be >= 0");
+            return 1;
+        }
+        config.common.num_workers = (size_t)args.workers_arg;
+    }
+
     sndio::Config sink_config;
 
     sink_config.channels = config.common.output_channels;
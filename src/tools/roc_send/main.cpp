@@ -19,6 +19,7 @@
 #include "roc_pipeline/parse_port.h"
 #include "roc_pipeline/port_utils.h"
 #include "roc_pipeline/sender.h"
+#include "roc_rtp/format_map.h"
 #include "roc_sndio/backend_dispatcher.h"
 #include "roc_sndio/print_drivers.h"
 #include "roc_sndio/pump.h"
@@ -128,6 +129,7 @@ int main(int argc, char** argv) {
             return 1;
         }
         config.fec_writer.n_source_packets = (size_t)args.nbsrc_arg;
+        config.rlc_writer.window_length = (size_t)args.nbsrc_arg;
     }
 
     if (args.nbrpr_given) {
@@ -142,6 +144,53 @@ int main(int argc, char** argv) {
         config.fec_writer.n_repair_packets = (size_t)args.nbrpr_arg;
     }
 
+    rtp::FormatMap format_map;
+
+    rtp::PayloadEncoding payload_encoding = rtp::PayloadEncoding_L16;
+
+    switch ((unsigned)args.encoding_arg) {
+    case encoding_arg_l16:
+        payload_encoding = rtp::PayloadEncoding_L16;
+        break;
+
+    case encoding_arg_l24:
+        payload_encoding = rtp::PayloadEncoding_L24;
+        break;
+
+    case encoding_arg_f32:
+        payload_encoding = rtp::PayloadEncoding_Float32;
+        break;
+
+    case encoding_arg_adpcm:
+        payload_encoding = rtp::PayloadEncoding_ADPCM;
+        break;
+
+    case encoding_arg_lossless:
+        payload_encoding = rtp::PayloadEncoding_Lossless;
+        break;
+
+    default:
+        roc_panic("unexpected encoding");
+    }
+
+    size_t packet_sample_rate = pipeline::DefaultSampleRate;
+    if (args.packet_rate_given) {
+        if (args.packet_rate_arg <= 0) {
+            roc_log(LogError, "invalid --packet-rate: should be > 0");
+            return 1;
+        }
+        packet_sample_rate = (size_t)args.packet_rate_arg;
+    }
+
+    const rtp::Format* format =
+        format_map.find(payload_encoding, packet_sample_rate, config.input_channels);
+    if (!format) {
+        roc_log(LogError, "invalid --packet-rate: not supported by --encoding: rate=%lu",
+                (unsigned long)packet_sample_rate);
+        return 1;
+    }
+    config.payload_type = format->payload_type;
+
     config.resampling = !args.no_resampling_flag;
 
     switch ((unsigned)args.resampler_profile_arg) {
@@ -157,6 +206,14 @@ int main(int argc, char** argv) {
         config.resampler = audio::resampler_profile(audio::ResamplerProfile_High);
         break;
 
+    case resampler_profile_arg_cubic:
+        config.resampler = audio::resampler_profile(audio::ResamplerProfile_Cubic);
+        break;
+
+    case resampler_profile_arg_linear:
+        config.resampler = audio::resampler_profile(audio::ResamplerProfile_Linear);
+        break;
+
     default:
         roc_panic("unexpected resampler profile");
     }
@@ -216,7 +273,6 @@ int main(int argc, char** argv) {
     config.input_sample_rate = source->sample_rate();
 
     fec::CodecMap codec_map;
-    rtp::FormatMap format_map;
 
     netio::Transceiver trx(packet_pool, byte_buffer_pool, allocator);
     if (!trx.valid()) {